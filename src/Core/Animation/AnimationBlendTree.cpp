@@ -0,0 +1,209 @@
+#include <Core/Animation/AnimationBlendTree.hpp>
+
+#include <Core/Animation/KeyFramedValueInterpolators.hpp>
+#include <Core/Math/Interpolation.hpp>
+#include <Core/Utils/Log.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+namespace Ra {
+namespace Core {
+namespace Animation {
+
+using namespace Utils; // log
+
+void AnimationBlendTree::clear() {
+    m_nodes.clear();
+    m_root     = InvalidNode;
+    m_compiled = false;
+    m_instructions.clear();
+    m_buffers.clear();
+}
+
+AnimationBlendTree::NodeId AnimationBlendTree::addNode( Node&& node ) {
+    for ( auto input : node.m_inputs ) {
+        CORE_ASSERT( input == InvalidNode || input < m_nodes.size(), "Invalid input node." );
+        CORE_UNUSED( input );
+    }
+    m_nodes.push_back( std::move( node ) );
+    m_compiled = false;
+    return NodeId( m_nodes.size() - 1 );
+}
+
+AnimationBlendTree::NodeId
+AnimationBlendTree::addClip( size_t clip, Scalar speed, Scalar offset, bool loop ) {
+    Node node;
+    node.m_type      = NodeType::CLIP;
+    node.m_inputs[0] = InvalidNode;
+    node.m_inputs[1] = InvalidNode;
+    node.m_inputs[2] = InvalidNode;
+    node.m_clip      = clip;
+    node.m_speed     = speed;
+    node.m_offset    = offset;
+    node.m_loop      = loop;
+    return addNode( std::move( node ) );
+}
+
+AnimationBlendTree::NodeId AnimationBlendTree::addCrossfade( NodeId a, NodeId b, Scalar weight ) {
+    Node node;
+    node.m_type      = NodeType::CROSSFADE;
+    node.m_inputs[0] = a;
+    node.m_inputs[1] = b;
+    node.m_inputs[2] = InvalidNode;
+    node.m_weight    = weight;
+    return addNode( std::move( node ) );
+}
+
+AnimationBlendTree::NodeId
+AnimationBlendTree::addAdditive( NodeId base, NodeId additive, NodeId reference, Scalar weight ) {
+    Node node;
+    node.m_type      = NodeType::ADDITIVE;
+    node.m_inputs[0] = base;
+    node.m_inputs[1] = additive;
+    node.m_inputs[2] = reference;
+    node.m_weight    = weight;
+    return addNode( std::move( node ) );
+}
+
+AnimationBlendTree::NodeId
+AnimationBlendTree::addMasked( NodeId base, NodeId layer, const BoneMask& mask, Scalar weight ) {
+    Node node;
+    node.m_type      = NodeType::MASKED;
+    node.m_inputs[0] = base;
+    node.m_inputs[1] = layer;
+    node.m_inputs[2] = InvalidNode;
+    node.m_weight    = weight;
+    node.m_mask      = mask;
+    return addNode( std::move( node ) );
+}
+
+void AnimationBlendTree::setRoot( NodeId node ) {
+    CORE_ASSERT( node < m_nodes.size(), "Invalid root node." );
+    m_root     = node;
+    m_compiled = false;
+}
+
+void AnimationBlendTree::setClipTime( NodeId node, Scalar speed, Scalar offset ) {
+    CORE_ASSERT( m_nodes[node].m_type == NodeType::CLIP, "Not a clip node." );
+    m_nodes[node].m_speed  = speed;
+    m_nodes[node].m_offset = offset;
+}
+
+bool AnimationBlendTree::compile() {
+    m_compiled = false;
+    m_instructions.clear();
+    m_buffers.clear();
+    if ( m_root >= m_nodes.size() ) {
+        LOG( logERROR ) << "AnimationBlendTree: no root node.";
+        return false;
+    }
+
+    // count the uses of the nodes contributing to the root.
+    // Inputs are created before their node, so nodes are processed in reverse order.
+    std::vector<uint> uses( m_nodes.size(), 0 );
+    uses[m_root] = 1;
+    for ( NodeId n = m_root + 1; n-- > 0; ) {
+        if ( uses[n] == 0 ) continue;
+        for ( auto input : m_nodes[n].m_inputs ) {
+            if ( input == InvalidNode ) continue;
+            if ( input >= n ) {
+                LOG( logERROR ) << "AnimationBlendTree: node " << n << " has an invalid input.";
+                return false;
+            }
+            ++uses[input];
+        }
+    }
+
+    // emit the instructions in topological order, reusing the buffers of the consumed inputs
+    std::vector<uint> output( m_nodes.size(), 0 );
+    std::vector<uint> freeBuffers;
+    uint bufferCount = 0;
+    for ( NodeId n = 0; n <= m_root; ++n ) {
+        if ( uses[n] == 0 ) continue;
+        Instruction instruction;
+        instruction.m_node = n;
+        if ( freeBuffers.empty() ) { instruction.m_output = bufferCount++; }
+        else {
+            instruction.m_output = freeBuffers.back();
+            freeBuffers.pop_back();
+        }
+        output[n] = instruction.m_output;
+        for ( int k = 0; k < 3; ++k ) {
+            const NodeId input      = m_nodes[n].m_inputs[k];
+            instruction.m_inputs[k] = input == InvalidNode ? 0 : output[input];
+            if ( input != InvalidNode && --uses[input] == 0 ) {
+                freeBuffers.push_back( output[input] );
+            }
+        }
+        m_instructions.push_back( instruction );
+    }
+    m_buffers.resize( bufferCount );
+    m_compiled = true;
+    return true;
+}
+
+void AnimationBlendTree::evaluate( const std::vector<Clip>& clips, Scalar t, Pose& pose ) {
+    CORE_ASSERT( m_compiled, "AnimationBlendTree must be compiled before evaluation." );
+    const size_t boneCount = pose.size();
+    for ( auto& buffer : m_buffers )
+        buffer.resize( boneCount );
+
+    for ( const auto& instruction : m_instructions ) {
+        auto& node      = m_nodes[instruction.m_node];
+        Pose& out       = m_buffers[instruction.m_output];
+        const Pose& in0 = m_buffers[instruction.m_inputs[0]];
+        const Pose& in1 = m_buffers[instruction.m_inputs[1]];
+        const Pose& in2 = m_buffers[instruction.m_inputs[2]];
+        const Scalar w  = std::clamp( node.m_weight, 0_ra, 1_ra );
+
+        switch ( node.m_type ) {
+        case NodeType::CLIP: {
+            CORE_ASSERT( node.m_clip < clips.size(), "Invalid clip index." );
+            const auto& clip = clips[node.m_clip];
+            CORE_ASSERT( clip.size() == boneCount, "Clip and pose sizes mismatch." );
+            Scalar time = node.m_offset + node.m_speed * t;
+            if ( node.m_loop ) {
+                Scalar lastTime = 0_ra;
+                for ( const auto& boneAnim : clip )
+                    lastTime = std::max( lastTime, boneAnim.getKeyFrames().back().first );
+                if ( lastTime > 0_ra ) {
+                    time = std::fmod( time, lastTime );
+                    if ( time < 0_ra ) time += lastTime;
+                }
+            }
+            sampleKeyFramedValues( clip, time, node.m_cursors, out );
+            break;
+        }
+        case NodeType::CROSSFADE:
+            for ( size_t i = 0; i < boneCount; ++i ) {
+                out[i] = w == 0_ra   ? in0[i]
+                         : w == 1_ra ? in1[i]
+                                     : Math::linearInterpolate( in0[i], in1[i], w );
+            }
+            break;
+        case NodeType::ADDITIVE:
+            for ( size_t i = 0; i < boneCount; ++i ) {
+                Transform delta = in2[i].inverse( Eigen::Affine ) * in1[i];
+                if ( w != 1_ra ) {
+                    delta = Math::linearInterpolate( Transform( Transform::Identity() ), delta, w );
+                }
+                out[i] = in0[i] * delta;
+            }
+            break;
+        case NodeType::MASKED:
+            for ( size_t i = 0; i < boneCount; ++i ) {
+                const Scalar wi = i < node.m_mask.size() ? w * node.m_mask[i] : 0_ra;
+                out[i]          = wi <= 0_ra   ? in0[i]
+                                  : wi >= 1_ra ? in1[i]
+                                               : Math::linearInterpolate( in0[i], in1[i], wi );
+            }
+            break;
+        }
+    }
+    pose = m_buffers[m_instructions.back().m_output];
+}
+
+} // namespace Animation
+} // namespace Core
+} // namespace Ra
@@ -0,0 +1,147 @@
+#pragma once
+
+#include <Core/Animation/KeyFramedValue.hpp>
+#include <Core/Animation/Pose.hpp>
+#include <Core/RaCore.hpp>
+#include <Core/Types.hpp>
+
+#include <vector>
+
+namespace Ra {
+namespace Core {
+namespace Animation {
+
+/**
+ * \brief Blend tree and layer stack for skeleton-based animations.
+ *
+ * The tree is made of nodes producing local poses:
+ *  - clip nodes sample an animation clip (a list of per-bone keyframed transforms),
+ *  - crossfade nodes interpolate between two poses,
+ *  - additive nodes add the difference between a pose and a reference pose onto a base pose,
+ *  - masked nodes blend a layer onto a base pose with per-bone weights, e.g. for partial-body
+ *    layers.
+ *
+ * Node weights and clip times can be changed at any time. Changing the structure of the tree
+ * requires to compile() it again: compilation flattens the tree into a list of instructions
+ * working on pose buffers, which are allocated once and reused by evaluate() every frame.
+ *
+ * Each tree keeps its own evaluation state, so that the trees of different skeletons can be
+ * evaluated in parallel, e.g. in their skeleton's animation task.
+ */
+class RA_CORE_API AnimationBlendTree
+{
+  public:
+    /// Animation clips, one keyframed transform per bone.
+    using Clip = std::vector<KeyFramedValue<Transform>>;
+
+    /// Index of a node of the tree.
+    using NodeId = uint;
+
+    /// Per-bone blending weights of a masked layer.
+    using BoneMask = std::vector<Scalar>;
+
+    /// Return true if the tree has no node.
+    bool empty() const { return m_nodes.empty(); }
+
+    /// Remove all the nodes.
+    void clear();
+
+    /// \name Tree construction
+    /// The inputs of a node must be created before the node.
+    /// \{
+
+    /**
+     * Add a node sampling clips[clip] (see evaluate()) at time offset + speed * t.
+     * Looping clips are played repeatedly, others are clamped to their keyframes.
+     */
+    NodeId addClip( size_t clip, Scalar speed = 1_ra, Scalar offset = 0_ra, bool loop = true );
+
+    /// Add a node interpolating between poses \p a (weight 0) and \p b (weight 1).
+    NodeId addCrossfade( NodeId a, NodeId b, Scalar weight = 0_ra );
+
+    /**
+     * Add a node adding the difference between \p additive and \p reference to \p base:
+     *    pose[i] = base[i] * ( reference[i]^-1 * additive[i] )^weight.
+     */
+    NodeId addAdditive( NodeId base, NodeId additive, NodeId reference, Scalar weight = 1_ra );
+
+    /**
+     * Add a node blending \p layer onto \p base with the per-bone weights weight * mask[i].
+     * Bones outside the mask keep the \p base pose.
+     */
+    NodeId addMasked( NodeId base, NodeId layer, const BoneMask& mask, Scalar weight = 1_ra );
+
+    /// Set the node producing the output pose.
+    void setRoot( NodeId node );
+    NodeId getRoot() const { return m_root; }
+
+    /// Flatten the tree into the instruction list used by evaluate().
+    /// \returns false if the tree is invalid (no root, or node inputs created after the node).
+    bool compile();
+    bool isCompiled() const { return m_compiled; }
+    /// \}
+
+    /// \name Node parameters
+    /// \{
+
+    /// Set the blending weight of a crossfade, additive or masked node.
+    void setWeight( NodeId node, Scalar weight ) { m_nodes[node].m_weight = weight; }
+    Scalar getWeight( NodeId node ) const { return m_nodes[node].m_weight; }
+
+    /// Set the speed and time offset of a clip node.
+    void setClipTime( NodeId node, Scalar speed, Scalar offset );
+    /// \}
+
+    /// Return the number of instructions of the compiled tree.
+    size_t getInstructionCount() const { return m_instructions.size(); }
+
+    /// Return the number of pose buffers used by the compiled tree.
+    size_t getBufferCount() const { return m_buffers.size(); }
+
+    /**
+     * Evaluate the compiled tree at time \p t, clip nodes sampling \p clips.
+     * \param pose the output local pose, must have one transform per bone.
+     */
+    void evaluate( const std::vector<Clip>& clips, Scalar t, Pose& pose );
+
+  private:
+    enum class NodeType { CLIP, CROSSFADE, ADDITIVE, MASKED };
+
+    struct Node {
+        NodeType m_type;
+        /// Input nodes (unused ones are set to InvalidNode).
+        NodeId m_inputs[3];
+        Scalar m_weight { 1_ra };
+        /// \name Clip parameters.
+        /// \{
+        size_t m_clip { 0 };
+        Scalar m_speed { 1_ra };
+        Scalar m_offset { 0_ra };
+        bool m_loop { true };
+        /// Per-bone keyframe cursors.
+        std::vector<size_t> m_cursors;
+        /// \}
+        BoneMask m_mask;
+    };
+
+    /// Instructions work on pose buffers: m_buffers[m_output] = op( m_buffers[m_inputs[k]] ).
+    struct Instruction {
+        NodeId m_node;
+        uint m_output;
+        uint m_inputs[3];
+    };
+
+    static constexpr NodeId InvalidNode = NodeId( -1 );
+
+    NodeId addNode( Node&& node );
+
+    std::vector<Node> m_nodes;
+    NodeId m_root { InvalidNode };
+    bool m_compiled { false };
+    std::vector<Instruction> m_instructions;
+    std::vector<Pose> m_buffers;
+};
+
+} // namespace Animation
+} // namespace Core
+} // namespace Ra
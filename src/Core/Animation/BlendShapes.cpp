@@ -0,0 +1,144 @@
+#include <Core/Animation/BlendShapes.hpp>
+
+#include <algorithm>
+
+namespace Ra {
+namespace Core {
+namespace Animation {
+
+BlendShape makeBlendShape( const std::string& name,
+                           const Vector3Array& basePositions,
+                           const Vector3Array& targetPositions,
+                           const Vector3Array& baseNormals,
+                           const Vector3Array& targetNormals,
+                           const Vector3Array& baseTangents,
+                           const Vector3Array& targetTangents,
+                           Scalar epsilon ) {
+    CORE_ASSERT( basePositions.size() == targetPositions.size(), "Vertex count mismatch." );
+    const bool hasNormals =
+        !targetNormals.empty() && baseNormals.size() == basePositions.size() &&
+        targetNormals.size() == basePositions.size();
+    const bool hasTangents =
+        !targetTangents.empty() && baseTangents.size() == basePositions.size() &&
+        targetTangents.size() == basePositions.size();
+
+    BlendShape shape;
+    shape.m_name      = name;
+    const Scalar eps2 = epsilon * epsilon;
+    for ( uint i = 0; i < uint( basePositions.size() ); ++i ) {
+        const Vector3 dp = targetPositions[i] - basePositions[i];
+        const Vector3 dn =
+            hasNormals ? Vector3( targetNormals[i] - baseNormals[i] ) : Vector3::Zero();
+        const Vector3 dt =
+            hasTangents ? Vector3( targetTangents[i] - baseTangents[i] ) : Vector3::Zero();
+        if ( dp.squaredNorm() <= eps2 && dn.squaredNorm() <= eps2 && dt.squaredNorm() <= eps2 )
+            continue;
+        shape.m_indices.push_back( i );
+        shape.m_positionDeltas.push_back( dp );
+        if ( hasNormals ) shape.m_normalDeltas.push_back( dn );
+        if ( hasTangents ) shape.m_tangentDeltas.push_back( dt );
+    }
+    return shape;
+}
+
+BlendShapeDeformer::BlendShapeDeformer( std::vector<BlendShape> shapes,
+                                        const Vector3Array& basePositions,
+                                        const Vector3Array& baseNormals,
+                                        const Vector3Array& baseTangents ) :
+    m_shapes( std::move( shapes ) ) {
+    for ( const auto& shape : m_shapes ) {
+        CORE_ASSERT( shape.m_positionDeltas.size() == shape.m_indices.size(),
+                     "Invalid blendshape." );
+        m_affected.insert( m_affected.end(), shape.m_indices.begin(), shape.m_indices.end() );
+    }
+    std::sort( m_affected.begin(), m_affected.end() );
+    m_affected.erase( std::unique( m_affected.begin(), m_affected.end() ), m_affected.end() );
+
+    const bool hasNormals  = baseNormals.size() == basePositions.size();
+    const bool hasTangents = baseTangents.size() == basePositions.size();
+    for ( auto v : m_affected ) {
+        m_basePositions.push_back( basePositions[v] );
+        if ( hasNormals ) m_baseNormals.push_back( baseNormals[v] );
+        if ( hasTangents ) m_baseTangents.push_back( baseTangents[v] );
+    }
+}
+
+std::vector<Scalar> BlendShapeDeformer::getDefaultWeights() const {
+    std::vector<Scalar> weights;
+    weights.reserve( m_shapes.size() );
+    for ( const auto& shape : m_shapes )
+        weights.push_back( shape.m_defaultWeight );
+    return weights;
+}
+
+void BlendShapeDeformer::apply( const std::vector<Scalar>& weights,
+                                Vector3Array& positions,
+                                Vector3Array& normals,
+                                Vector3Array& tangents ) const {
+    CORE_ASSERT( weights.size() >= m_shapes.size(), "Missing blendshape weights." );
+    const bool doNormals  = !normals.empty() && !m_baseNormals.empty();
+    const bool doTangents = !tangents.empty() && !m_baseTangents.empty();
+
+    // reset the affected vertices
+    const int affectedCount = int( m_affected.size() );
+#pragma omp parallel for
+    for ( int k = 0; k < affectedCount; ++k ) {
+        const uint v = m_affected[k];
+        positions[v] = m_basePositions[k];
+        if ( doNormals ) normals[v] = m_baseNormals[k];
+        if ( doTangents ) tangents[v] = m_baseTangents[k];
+    }
+
+    // accumulate the active blendshapes, indices are unique within a blendshape
+    for ( size_t s = 0; s < m_shapes.size(); ++s ) {
+        const Scalar w = weights[s];
+        if ( w == 0_ra ) continue;
+        const auto& shape        = m_shapes[s];
+        const bool shapeNormals  = doNormals && !shape.m_normalDeltas.empty();
+        const bool shapeTangents = doTangents && !shape.m_tangentDeltas.empty();
+        const int count          = int( shape.m_indices.size() );
+#pragma omp parallel for
+        for ( int k = 0; k < count; ++k ) {
+            const uint v = shape.m_indices[k];
+            positions[v] += w * shape.m_positionDeltas[k];
+            if ( shapeNormals ) normals[v] += w * shape.m_normalDeltas[k];
+            if ( shapeTangents ) tangents[v] += w * shape.m_tangentDeltas[k];
+        }
+    }
+
+    if ( doNormals || doTangents ) {
+#pragma omp parallel for
+        for ( int k = 0; k < affectedCount; ++k ) {
+            const uint v = m_affected[k];
+            if ( doNormals ) normals[v].normalize();
+            if ( doTangents ) tangents[v].normalize();
+        }
+    }
+}
+
+void BlendShapeDeformer::addPositionDeltas( const std::vector<Scalar>& weights,
+                                            Vector3Array& positions ) const {
+    CORE_ASSERT( weights.size() >= m_shapes.size(), "Missing blendshape weights." );
+    for ( size_t s = 0; s < m_shapes.size(); ++s ) {
+        const Scalar w = weights[s];
+        if ( w == 0_ra ) continue;
+        const auto& shape = m_shapes[s];
+        const int count   = int( shape.m_indices.size() );
+#pragma omp parallel for
+        for ( int k = 0; k < count; ++k ) {
+            positions[shape.m_indices[k]] += w * shape.m_positionDeltas[k];
+        }
+    }
+}
+
+void BlendShapeDeformer::resetPositions( Vector3Array& positions ) const {
+    const int affectedCount = int( m_affected.size() );
+#pragma omp parallel for
+    for ( int k = 0; k < affectedCount; ++k ) {
+        positions[m_affected[k]] = m_basePositions[k];
+    }
+}
+
+} // namespace Animation
+} // namespace Core
+} // namespace Ra
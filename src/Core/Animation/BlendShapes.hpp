@@ -0,0 +1,113 @@
+#pragma once
+
+#include <Core/Containers/VectorArray.hpp>
+#include <Core/RaCore.hpp>
+#include <Core/Types.hpp>
+
+#include <string>
+#include <vector>
+
+namespace Ra {
+namespace Core {
+namespace Animation {
+
+/**
+ * \brief A blendshape (a.k.a. morph target), stored as sparse deltas w.r.t.\ the base mesh.
+ *
+ * Only the vertices moved by the blendshape are stored: m_indices are the (sorted) indices of
+ * these vertices, and the deltas arrays give, for each of them, the offset to add to the base
+ * attribute when the blendshape weight is 1.
+ * Normal and tangent deltas are optional (empty arrays).
+ */
+struct RA_CORE_API BlendShape {
+    std::string m_name;
+    std::vector<uint> m_indices;
+    Vector3Array m_positionDeltas;
+    Vector3Array m_normalDeltas;
+    Vector3Array m_tangentDeltas;
+    /// Weight used when the blendshape is not animated.
+    Scalar m_defaultWeight { 0_ra };
+};
+
+/**
+ * Build the sparse blendshape morphing the base attributes into the target attributes.
+ * Vertices whose deltas are all smaller than \p epsilon are not stored.
+ * \note Normals and tangents may be empty, in which case no delta is stored for them.
+ */
+RA_CORE_API BlendShape makeBlendShape( const std::string& name,
+                                       const Vector3Array& basePositions,
+                                       const Vector3Array& targetPositions,
+                                       const Vector3Array& baseNormals    = {},
+                                       const Vector3Array& targetNormals  = {},
+                                       const Vector3Array& baseTangents   = {},
+                                       const Vector3Array& targetTangents = {},
+                                       Scalar epsilon                     = 1e-6_ra );
+
+/**
+ * \brief Applies weighted blendshapes onto a mesh.
+ *
+ * The deformer keeps the base attributes of the vertices moved by at least one of its
+ * blendshapes. apply() only writes these vertices: they are reset to their base value, then
+ * the deltas of the blendshapes with a non-zero weight are accumulated, one blendshape after the
+ * other, in parallel over the vertices of each blendshape.
+ */
+class RA_CORE_API BlendShapeDeformer
+{
+  public:
+    BlendShapeDeformer() = default;
+
+    /// Build the deformer for \p shapes, defined w.r.t.\ the given base attributes.
+    BlendShapeDeformer( std::vector<BlendShape> shapes,
+                        const Vector3Array& basePositions,
+                        const Vector3Array& baseNormals  = {},
+                        const Vector3Array& baseTangents = {} );
+
+    bool empty() const { return m_shapes.empty(); }
+
+    const std::vector<BlendShape>& getBlendShapes() const { return m_shapes; }
+
+    /// Return the default weights of the blendshapes.
+    std::vector<Scalar> getDefaultWeights() const;
+
+    /// Return the sorted indices of the vertices moved by at least one blendshape.
+    const std::vector<uint>& getAffectedVertices() const { return m_affected; }
+
+    /**
+     * Apply the blendshapes, blendshape i having weight weights[i].
+     * The attributes of the affected vertices are overwritten, the other ones are left untouched:
+     * the arrays are typically initialized as copies of the base attributes once, and then
+     * deformed in place each frame.
+     * Normals and tangents of the affected vertices are normalized. Empty normal or tangent
+     * arrays are skipped.
+     */
+    void apply( const std::vector<Scalar>& weights,
+                Vector3Array& positions,
+                Vector3Array& normals,
+                Vector3Array& tangents ) const;
+
+    /**
+     * Add the position deltas of the blendshapes, blendshape i having weight weights[i], to
+     * \p positions.
+     * For deformations which do not start from the base positions (e.g. cage deformation, which
+     * is computed from weights on the base positions), so that the deltas are applied on top.
+     */
+    void addPositionDeltas( const std::vector<Scalar>& weights, Vector3Array& positions ) const;
+
+    /**
+     * Reset the positions of the affected vertices to their base value, e.g.\ to compute
+     * deformation weights on the base positions from blended positions.
+     */
+    void resetPositions( Vector3Array& positions ) const;
+
+  private:
+    std::vector<BlendShape> m_shapes;
+    std::vector<uint> m_affected;
+    /// Base attributes of the affected vertices.
+    Vector3Array m_basePositions;
+    Vector3Array m_baseNormals;
+    Vector3Array m_baseTangents;
+};
+
+} // namespace Animation
+} // namespace Core
+} // namespace Ra
@@ -0,0 +1,163 @@
+#include <Core/Animation/CageDeformation.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+#include <vector>
+
+namespace Ra {
+namespace Core {
+namespace Animation {
+
+namespace {
+/// Computations are done in double precision, since coordinates are computed once.
+constexpr double mvcEpsilon = 1e-8;
+constexpr double mvcPi      = 3.14159265358979323846;
+
+/// Compute the mean value coordinates of \p point into \p w, using \p d and \p u as buffers.
+void meanValueCoordinates( const Vector3Array& cageVertices,
+                           const VectorArray<Vector3ui>& cageTriangles,
+                           const Vector3& point,
+                           std::vector<double>& w,
+                           std::vector<double>& d,
+                           std::vector<Eigen::Vector3d>& u ) {
+    const size_t n = cageVertices.size();
+    std::fill( w.begin(), w.end(), 0. );
+    const Eigen::Vector3d x = point.cast<double>();
+    for ( size_t j = 0; j < n; ++j ) {
+        const Eigen::Vector3d v = cageVertices[j].cast<double>() - x;
+        d[j]                    = v.norm();
+        // the point is a cage vertex
+        if ( d[j] < mvcEpsilon ) {
+            w[j] = 1.;
+            return;
+        }
+        u[j] = v / d[j];
+    }
+
+    for ( const auto& t : cageTriangles ) {
+        double l[3], theta[3], c[3], s[3];
+        for ( int k = 0; k < 3; ++k ) {
+            l[k]     = ( u[t[( k + 1 ) % 3]] - u[t[( k + 2 ) % 3]] ).norm();
+            theta[k] = 2. * std::asin( std::min( l[k] / 2., 1. ) );
+        }
+        const double h = ( theta[0] + theta[1] + theta[2] ) / 2.;
+        // the point lies on the triangle, use its barycentric coordinates
+        if ( mvcPi - h < mvcEpsilon ) {
+            std::fill( w.begin(), w.end(), 0. );
+            for ( int k = 0; k < 3; ++k ) {
+                w[t[k]] = std::sin( theta[k] ) * d[t[( k + 1 ) % 3]] * d[t[( k + 2 ) % 3]];
+            }
+            break;
+        }
+        for ( int k = 0; k < 3; ++k ) {
+            c[k] = 2. * std::sin( h ) * std::sin( h - theta[k] ) /
+                       ( std::sin( theta[( k + 1 ) % 3] ) * std::sin( theta[( k + 2 ) % 3] ) ) -
+                   1.;
+        }
+        const double sign = u[t[0]].dot( u[t[1]].cross( u[t[2]] ) ) < 0. ? -1. : 1.;
+        bool coplanar     = false;
+        for ( int k = 0; k < 3; ++k ) {
+            s[k] = sign * std::sqrt( std::max( 0., 1. - c[k] * c[k] ) );
+            coplanar |= std::abs( s[k] ) <= mvcEpsilon;
+        }
+        // the point lies on the plane of the triangle, outside of it: no contribution
+        if ( coplanar ) { continue; }
+        for ( int k = 0; k < 3; ++k ) {
+            const int k1 = ( k + 1 ) % 3;
+            const int k2 = ( k + 2 ) % 3;
+            w[t[k]] += ( theta[k] - c[k1] * theta[k2] - c[k2] * theta[k1] ) /
+                       ( d[t[k]] * std::sin( theta[k1] ) * s[k2] );
+        }
+    }
+
+    double sum = 0.;
+    for ( auto wj : w )
+        sum += wj;
+    for ( auto& wj : w )
+        wj /= sum;
+}
+} // namespace
+
+Vector3Array getCageVertices( const Cage& cage ) {
+    const auto& pose = cage.getPose( HandleArray::SpaceType::MODEL );
+    Vector3Array vertices( pose.size() );
+    for ( size_t i = 0; i < pose.size(); ++i ) {
+        vertices[i] = pose[i].translation();
+    }
+    return vertices;
+}
+
+CageWeights computeMeanValueCoordinates( const Vector3Array& cageVertices,
+                                         const VectorArray<Vector3ui>& cageTriangles,
+                                         const Vector3Array& points,
+                                         Scalar threshold ) {
+    const size_t n      = cageVertices.size();
+    const int numPoints = int( points.size() );
+    std::vector<std::vector<std::pair<int, Scalar>>> rows( points.size() );
+
+#pragma omp parallel
+    {
+        std::vector<double> w( n );
+        std::vector<double> d( n );
+        std::vector<Eigen::Vector3d> u( n );
+#pragma omp for
+        for ( int i = 0; i < numPoints; ++i ) {
+            meanValueCoordinates( cageVertices, cageTriangles, points[i], w, d, u );
+            // prune the negligible coordinates, then renormalize the remaining ones
+            double kept = 0.;
+            for ( size_t j = 0; j < n; ++j ) {
+                if ( std::abs( w[j] ) > threshold ) { kept += w[j]; }
+            }
+            const bool prune = std::abs( kept ) > mvcEpsilon;
+            auto& row        = rows[i];
+            for ( size_t j = 0; j < n; ++j ) {
+                if ( w[j] == 0. || ( prune && std::abs( w[j] ) <= threshold ) ) { continue; }
+                row.emplace_back( int( j ), Scalar( prune ? w[j] / kept : w[j] ) );
+            }
+        }
+    }
+
+    CageWeights weights( int( points.size() ), int( n ) );
+    Eigen::VectorXi nonZeros( points.size() );
+    for ( size_t i = 0; i < rows.size(); ++i ) {
+        nonZeros[i] = int( rows[i].size() );
+    }
+    weights.reserve( nonZeros );
+    for ( size_t i = 0; i < rows.size(); ++i ) {
+        for ( const auto& [j, wij] : rows[i] ) {
+            weights.insert( int( i ), j ) = wij;
+        }
+    }
+    weights.makeCompressed();
+    return weights;
+}
+
+CageWeights
+computeMeanValueCoordinates( const Cage& cage, const Vector3Array& points, Scalar threshold ) {
+    return computeMeanValueCoordinates(
+        getCageVertices( cage ), cage.m_triangle, points, threshold );
+}
+
+void cageDeformation( const CageWeights& weights,
+                      const Vector3Array& cageVertices,
+                      Vector3Array& points ) {
+    CORE_ASSERT( weights.cols() == int( cageVertices.size() ), "Weights and cage mismatch." );
+    points.resize( weights.rows() );
+#pragma omp parallel for
+    for ( int i = 0; i < int( weights.rows() ); ++i ) {
+        Vector3 p = Vector3::Zero();
+        for ( CageWeights::InnerIterator it( weights, i ); it; ++it ) {
+            p += it.value() * cageVertices[it.col()];
+        }
+        points[i] = p;
+    }
+}
+
+void cageDeformation( const CageWeights& weights, const Cage& cage, Vector3Array& points ) {
+    cageDeformation( weights, getCageVertices( cage ), points );
+}
+
+} // namespace Animation
+} // namespace Core
+} // namespace Ra
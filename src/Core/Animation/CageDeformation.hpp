@@ -0,0 +1,67 @@
+#pragma once
+
+#include <Core/Animation/Cage.hpp>
+#include <Core/Containers/VectorArray.hpp>
+#include <Core/RaCore.hpp>
+#include <Core/Types.hpp>
+
+#include <Eigen/Sparse>
+
+namespace Ra {
+namespace Core {
+namespace Animation {
+
+/// The cage coordinates of a set of points: row i gives the weights of the cage vertices for
+/// point i. Stored row-major so that each point is deformed independently.
+using CageWeights = Eigen::SparseMatrix<Scalar, Eigen::RowMajor>;
+
+/// \name Cage Deformation
+/// \{
+
+/// Return the vertices of \p cage, i.e.\ the translations of its model-space transforms.
+RA_CORE_API Vector3Array getCageVertices( const Cage& cage );
+
+// clang-format off
+/**
+ * \brief Computes the mean value coordinates of \p points w.r.t.\ a closed triangular cage.
+ *
+ * Formula from: "Mean Value Coordinates for Closed Triangular Meshes"
+ * 2005 - Ju, Schaefer & Warren.
+ *
+ * The coordinates \f$\lambda_{ij}\f$ of point \f$\mathbf{p}_i\f$ reproduce it from the cage
+ * vertices: \f$\mathbf{p}_i = \sum_{j}\lambda_{ij}\mathbf{c}_j\f$, with \f$\sum_j\lambda_{ij}=1\f$.
+ * Coordinates smaller than \p threshold (in absolute value) are pruned, and the remaining ones of
+ * the point are renormalized, so that the deformation operator stays sparse for large cages.
+ *
+ * \note The cage triangles must be consistently oriented.
+ * \note Parallelized loop inside (using openmp).
+ */
+// clang-format on
+RA_CORE_API CageWeights computeMeanValueCoordinates( const Vector3Array& cageVertices,
+                                                     const VectorArray<Vector3ui>& cageTriangles,
+                                                     const Vector3Array& points,
+                                                     Scalar threshold = 0_ra );
+
+/// Same as above, for the current pose of \p cage.
+RA_CORE_API CageWeights computeMeanValueCoordinates( const Cage& cage,
+                                                     const Vector3Array& points,
+                                                     Scalar threshold = 0_ra );
+
+/**
+ * \brief Deforms the points from the cage coordinates \p weights and the deformed cage vertices:
+ * \f$\mathbf{p}_i = \sum_{j}\lambda_{ij}\mathbf{c}_j\f$.
+ * \note \p points is resized to the number of rows of \p weights.
+ * \note Parallelized loop inside (using openmp).
+ */
+RA_CORE_API void cageDeformation( const CageWeights& weights,
+                                  const Vector3Array& cageVertices,
+                                  Vector3Array& points );
+
+/// Same as above, for the current pose of \p cage.
+RA_CORE_API void
+cageDeformation( const CageWeights& weights, const Cage& cage, Vector3Array& points );
+/// \}
+
+} // namespace Animation
+} // namespace Core
+} // namespace Ra
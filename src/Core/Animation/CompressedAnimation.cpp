@@ -0,0 +1,441 @@
+#include <Core/Animation/CompressedAnimation.hpp>
+
+#include <Core/Math/Interpolation.hpp>
+#include <Core/Utils/Log.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <istream>
+#include <limits>
+#include <ostream>
+#include <tuple>
+
+namespace Ra {
+namespace Core {
+namespace Animation {
+
+using namespace Utils; // log
+
+namespace {
+constexpr char ClipMagic[4]    = { 'R', 'a', 'C', 'A' };
+constexpr uint32_t ClipVersion = 1;
+
+/// The smallest three components of a unit quaternion are in [-QuatRange, QuatRange].
+constexpr Scalar QuatRange = 1_ra / Scalar( M_SQRT2 );
+constexpr int QuatBits     = 0x7fff;
+
+/// Smallest three quantization of the unit quaternion \p q.
+/// The index of the largest component is stored in the top bits of the first two values.
+std::array<uint16_t, 3> quantizeRotation( Quaternion q ) {
+    q.normalize();
+    Vector4 c = q.coeffs();
+    int largest;
+    c.cwiseAbs().maxCoeff( &largest );
+    if ( c[largest] < 0_ra ) c = -c;
+    std::array<uint16_t, 3> res;
+    for ( int k = 0, j = 0; k < 4; ++k ) {
+        if ( k == largest ) continue;
+        const Scalar v = std::clamp( ( c[k] / QuatRange + 1_ra ) * 0.5_ra, 0_ra, 1_ra );
+        res[j++]       = uint16_t( std::lround( v * QuatBits ) );
+    }
+    res[0] |= uint16_t( ( largest >> 1 ) << 15 );
+    res[1] |= uint16_t( ( largest & 1 ) << 15 );
+    return res;
+}
+
+Quaternion dequantizeRotation( const std::array<uint16_t, 3>& key ) {
+    const int largest = ( ( key[0] >> 15 ) << 1 ) | ( key[1] >> 15 );
+    Vector4 c;
+    Scalar sum = 0_ra;
+    for ( int k = 0, j = 0; k < 4; ++k ) {
+        if ( k == largest ) continue;
+        c[k] = ( Scalar( key[j++] & QuatBits ) / QuatBits * 2_ra - 1_ra ) * QuatRange;
+        sum += c[k] * c[k];
+    }
+    c[largest] = std::sqrt( std::max( 0_ra, 1_ra - sum ) );
+    return Quaternion( c ).normalized();
+}
+
+std::array<uint16_t, 3> quantizeVector( const Vector3& v,
+                                        const Eigen::Vector3f& min,
+                                        const Eigen::Vector3f& extent ) {
+    std::array<uint16_t, 3> res;
+    for ( int k = 0; k < 3; ++k ) {
+        const Scalar u =
+            extent[k] > 0.f ? std::clamp( ( v[k] - min[k] ) / extent[k], 0_ra, 1_ra ) : 0_ra;
+        res[k] = uint16_t( std::lround( u * 0xffff ) );
+    }
+    return res;
+}
+
+Vector3 dequantizeVector( const std::array<uint16_t, 3>& key,
+                          const Eigen::Vector3f& min,
+                          const Eigen::Vector3f& extent ) {
+    Vector3 res;
+    for ( int k = 0; k < 3; ++k )
+        res[k] = Scalar( min[k] ) + Scalar( extent[k] ) * Scalar( key[k] ) / Scalar( 0xffff );
+    return res;
+}
+
+/// Return (i, j, dt) as KeyFramedValue::findRange, using and updating \p cursor.
+std::tuple<size_t, size_t, Scalar>
+findKeys( const std::vector<float>& times, Scalar t, size_t& cursor ) {
+    const size_t n = times.size();
+    if ( n == 1 || t <= times.front() ) {
+        cursor = 0;
+        return { 0, 0, 0_ra };
+    }
+    if ( t >= times.back() ) {
+        cursor = n - 1;
+        return { n - 1, n - 1, 0_ra };
+    }
+    auto isLower = [&times, t]( size_t i ) { return times[i] <= t && t < times[i + 1]; };
+    if ( cursor + 1 >= n || !isLower( cursor ) ) {
+        if ( cursor + 2 < n && isLower( cursor + 1 ) ) { ++cursor; }
+        else {
+            cursor = size_t( std::upper_bound( times.begin(), times.end(), float( t ) ) -
+                             times.begin() ) -
+                     1;
+            cursor = std::min( cursor, n - 2 );
+        }
+    }
+    const Scalar t0 = times[cursor];
+    const Scalar t1 = times[cursor + 1];
+    return { cursor, cursor + 1, ( t - t0 ) / ( t1 - t0 ) };
+}
+
+/**
+ * Keyframe reduction: return the indices of the samples to keep so that the interpolation of the
+ * kept samples (given by \p values) is within \p tolerance of \p reference at all the sample
+ * times. \p error( a, b ) returns the distance between two values.
+ */
+template <typename T, typename Interpolate, typename Error>
+std::vector<size_t> reduceKeys( const std::vector<Scalar>& times,
+                                const std::vector<T>& reference,
+                                const std::vector<T>& values,
+                                Scalar tolerance,
+                                const Interpolate& interpolate,
+                                const Error& error ) {
+    const size_t n = times.size();
+    // constant track
+    bool constant = true;
+    for ( size_t i = 0; i < n && constant; ++i )
+        constant = error( values[0], reference[i] ) <= tolerance;
+    if ( constant ) return { 0 };
+
+    // recursive split of the segments at their largest error
+    std::vector<bool> keep( n, false );
+    keep[0] = keep[n - 1] = true;
+    std::vector<std::pair<size_t, size_t>> segments { { 0, n - 1 } };
+    while ( !segments.empty() ) {
+        const auto [a, b] = segments.back();
+        segments.pop_back();
+        Scalar maxError = 0_ra;
+        size_t split    = a;
+        for ( size_t i = a + 1; i < b; ++i ) {
+            const Scalar dt = ( times[i] - times[a] ) / ( times[b] - times[a] );
+            const Scalar e  = error( interpolate( values[a], values[b], dt ), reference[i] );
+            if ( e > maxError ) {
+                maxError = e;
+                split    = i;
+            }
+        }
+        if ( maxError > tolerance ) {
+            keep[split] = true;
+            segments.emplace_back( a, split );
+            segments.emplace_back( split, b );
+        }
+    }
+    std::vector<size_t> res;
+    for ( size_t i = 0; i < n; ++i ) {
+        if ( keep[i] ) res.push_back( i );
+    }
+    return res;
+}
+
+template <typename T>
+void writeValue( std::ostream& out, const T& v ) {
+    out.write( reinterpret_cast<const char*>( &v ), sizeof( T ) );
+}
+
+template <typename T>
+void writeVector( std::ostream& out, const std::vector<T>& v ) {
+    writeValue( out, uint64_t( v.size() ) );
+    out.write( reinterpret_cast<const char*>( v.data() ),
+               std::streamsize( v.size() * sizeof( T ) ) );
+}
+
+template <typename T>
+bool readValue( std::istream& in, T& v ) {
+    return bool( in.read( reinterpret_cast<char*>( &v ), sizeof( T ) ) );
+}
+
+/// Return the number of bytes left in \p in, or max() if the stream cannot tell.
+uint64_t remainingSize( std::istream& in ) {
+    const auto pos = in.tellg();
+    if ( pos < 0 ) return std::numeric_limits<uint64_t>::max();
+    in.seekg( 0, std::ios::end );
+    const auto end = in.tellg();
+    in.clear();
+    in.seekg( pos );
+    if ( end < pos ) return std::numeric_limits<uint64_t>::max();
+    return uint64_t( end - pos );
+}
+
+template <typename T>
+bool readVector( std::istream& in, std::vector<T>& v ) {
+    uint64_t size;
+    // guard against corrupted sizes before allocating
+    if ( !readValue( in, size ) || size > ( uint64_t( 1 ) << 32 ) ||
+         size > remainingSize( in ) / sizeof( T ) )
+        return false;
+    v.resize( size );
+    return bool(
+        in.read( reinterpret_cast<char*>( v.data() ), std::streamsize( size * sizeof( T ) ) ) );
+}
+} // namespace
+
+CompressedAnimation::CompressedAnimation( const std::vector<KeyFramedValue<Transform>>& channels,
+                                          const std::vector<std::string>& names,
+                                          const Tolerances& tolerances ) {
+    m_channels.resize( channels.size() );
+    m_startTime = std::numeric_limits<Scalar>::max();
+    m_endTime   = std::numeric_limits<Scalar>::lowest();
+    for ( const auto& channel : channels ) {
+        m_startTime = std::min( m_startTime, channel.getKeyFrames().front().first );
+        m_endTime   = std::max( m_endTime, channel.getKeyFrames().back().first );
+    }
+    if ( channels.empty() ) { m_startTime = m_endTime = 0_ra; }
+
+    auto angle = []( const Quaternion& a, const Quaternion& b ) {
+        return a.angularDistance( b );
+    };
+    auto distance = []( const Vector3& a, const Vector3& b ) { return ( a - b ).norm(); };
+    auto slerp    = []( const Quaternion& a, const Quaternion& b, Scalar t ) {
+        return Math::linearInterpolate( a, b, t );
+    };
+    auto lerp = []( const Vector3& a, const Vector3& b, Scalar t ) {
+        return Math::linearInterpolate( a, b, t );
+    };
+
+#pragma omp parallel for schedule( dynamic )
+    for ( int c = 0; c < int( channels.size() ); ++c ) {
+        const auto& keyframes = channels[c].getKeyFrames();
+        const size_t n        = keyframes.size();
+        auto& channel         = m_channels[c];
+        if ( size_t( c ) < names.size() ) channel.m_name = names[c];
+        channel.m_startTime = float( keyframes.front().first );
+        channel.m_endTime   = float( keyframes.back().first );
+
+        // decompose the keyframes as in Math::linearInterpolate<Transform>
+        std::vector<Scalar> times( n );
+        std::vector<Quaternion> rotations( n );
+        std::vector<Vector3> translations( n );
+        std::vector<Vector3> scales( n );
+        for ( size_t i = 0; i < n; ++i ) {
+            Matrix3 R, S;
+            keyframes[i].second.computeRotationScaling( &R, &S );
+            times[i]        = keyframes[i].first;
+            rotations[i]    = Quaternion( R );
+            translations[i] = keyframes[i].second.translation();
+            scales[i]       = S.diagonal();
+            // keep the quaternions in the same hemisphere for interpolation
+            if ( i > 0 && rotations[i].dot( rotations[i - 1] ) < 0_ra ) {
+                rotations[i].coeffs() = -rotations[i].coeffs();
+            }
+        }
+
+        auto compressRotations = [&]( Track& track ) {
+            std::vector<QuantizedKey> quantized( n );
+            std::vector<Quaternion> values( n );
+            for ( size_t i = 0; i < n; ++i ) {
+                quantized[i] = quantizeRotation( rotations[i] );
+                values[i]    = dequantizeRotation( quantized[i] );
+            }
+            for ( auto i :
+                  reduceKeys( times, rotations, values, tolerances.m_rotation, slerp, angle ) ) {
+                track.m_times.push_back( float( times[i] ) );
+                track.m_keys.push_back( quantized[i] );
+            }
+        };
+        auto compressVectors = [&]( const std::vector<Vector3>& reference,
+                                    Scalar tolerance,
+                                    Track& track ) {
+            Eigen::Vector3f min = Eigen::Vector3f::Constant( std::numeric_limits<float>::max() );
+            Eigen::Vector3f max = Eigen::Vector3f::Constant( std::numeric_limits<float>::lowest() );
+            for ( const auto& v : reference ) {
+                min = min.cwiseMin( v.cast<float>() );
+                max = max.cwiseMax( v.cast<float>() );
+            }
+            track.m_min    = min;
+            track.m_extent = max - min;
+            std::vector<QuantizedKey> quantized( n );
+            std::vector<Vector3> values( n );
+            for ( size_t i = 0; i < n; ++i ) {
+                quantized[i] = quantizeVector( reference[i], track.m_min, track.m_extent );
+                values[i]    = dequantizeVector( quantized[i], track.m_min, track.m_extent );
+            }
+            for ( auto i : reduceKeys( times, reference, values, tolerance, lerp, distance ) ) {
+                track.m_times.push_back( float( times[i] ) );
+                track.m_keys.push_back( quantized[i] );
+            }
+        };
+        compressRotations( channel.m_rotation );
+        compressVectors( translations, tolerances.m_translation, channel.m_translation );
+        compressVectors( scales, tolerances.m_scale, channel.m_scale );
+    }
+}
+
+size_t CompressedAnimation::getKeyFrameCount() const {
+    size_t count = 0;
+    for ( const auto& channel : m_channels ) {
+        count += channel.m_rotation.m_keys.size() + channel.m_translation.m_keys.size() +
+                 channel.m_scale.m_keys.size();
+    }
+    return count;
+}
+
+size_t CompressedAnimation::getMemorySize() const {
+    size_t size = sizeof( *this ) + m_channels.size() * sizeof( Channel );
+    for ( const auto& channel : m_channels ) {
+        for ( const auto* track :
+              { &channel.m_rotation, &channel.m_translation, &channel.m_scale } )
+            size += track->m_keys.size() * ( sizeof( float ) + sizeof( QuantizedKey ) );
+    }
+    return size;
+}
+
+Quaternion
+CompressedAnimation::sampleRotation( const Track& track, Scalar t, size_t& cursor ) const {
+    auto [i, j, dt] = findKeys( track.m_times, t, cursor );
+    const Quaternion q0 = dequantizeRotation( track.m_keys[i] );
+    if ( i == j ) return q0;
+    return Math::linearInterpolate( q0, dequantizeRotation( track.m_keys[j] ), dt );
+}
+
+Vector3 CompressedAnimation::sampleVector( const Track& track, Scalar t, size_t& cursor ) const {
+    auto [i, j, dt]  = findKeys( track.m_times, t, cursor );
+    const Vector3 v0 = dequantizeVector( track.m_keys[i], track.m_min, track.m_extent );
+    if ( i == j ) return v0;
+    return Math::linearInterpolate(
+        v0, dequantizeVector( track.m_keys[j], track.m_min, track.m_extent ), dt );
+}
+
+Transform CompressedAnimation::sampleChannel( size_t c, Scalar t, size_t cursors[3] ) const {
+    const auto& channel = m_channels[c];
+    Transform T;
+    T.fromPositionOrientationScale( sampleVector( channel.m_translation, t, cursors[1] ),
+                                    sampleRotation( channel.m_rotation, t, cursors[0] ),
+                                    sampleVector( channel.m_scale, t, cursors[2] ) );
+    return T;
+}
+
+void CompressedAnimation::sample( Scalar t, Pose& pose, std::vector<size_t>& cursors ) const {
+    CORE_ASSERT( pose.size() >= m_channels.size(), "Pose too small." );
+    cursors.resize( 3 * m_channels.size(), 0 );
+    for ( size_t c = 0; c < m_channels.size(); ++c ) {
+        pose[c] = sampleChannel( c, t, &cursors[3 * c] );
+    }
+}
+
+void CompressedAnimation::sample( Scalar t,
+                                  Pose& pose,
+                                  std::vector<size_t>& cursors,
+                                  const std::vector<int>& targets ) const {
+    CORE_ASSERT( targets.size() == m_channels.size(), "One target per channel is needed." );
+    cursors.resize( 3 * m_channels.size(), 0 );
+    for ( size_t c = 0; c < m_channels.size(); ++c ) {
+        if ( targets[c] < 0 ) continue;
+        CORE_ASSERT( size_t( targets[c] ) < pose.size(), "Pose too small." );
+        pose[targets[c]] = sampleChannel( c, t, &cursors[3 * c] );
+    }
+}
+
+KeyFramedValue<Transform> CompressedAnimation::getChannel( size_t i ) const {
+    const auto& channel = m_channels[i];
+    std::vector<float> times { channel.m_startTime, channel.m_endTime };
+    for ( const auto* track : { &channel.m_rotation, &channel.m_translation, &channel.m_scale } )
+        times.insert( times.end(), track->m_times.begin(), track->m_times.end() );
+    std::sort( times.begin(), times.end() );
+    times.erase( std::unique( times.begin(), times.end() ), times.end() );
+
+    size_t cursors[3] = { 0, 0, 0 };
+    KeyFramedValue<Transform> res( times[0], sampleChannel( i, times[0], cursors ) );
+    for ( size_t k = 1; k < times.size(); ++k )
+        res.insertKeyFrame( times[k], sampleChannel( i, times[k], cursors ) );
+    return res;
+}
+
+std::vector<KeyFramedValue<Transform>> CompressedAnimation::getChannels() const {
+    std::vector<KeyFramedValue<Transform>> res;
+    res.reserve( m_channels.size() );
+    for ( size_t i = 0; i < m_channels.size(); ++i )
+        res.push_back( getChannel( i ) );
+    return res;
+}
+
+void CompressedAnimation::write( std::ostream& out ) const {
+    out.write( ClipMagic, 4 );
+    writeValue( out, ClipVersion );
+    writeValue( out, uint64_t( m_channels.size() ) );
+    writeValue( out, float( m_startTime ) );
+    writeValue( out, float( m_endTime ) );
+    for ( const auto& channel : m_channels ) {
+        writeVector( out, std::vector<char>( channel.m_name.begin(), channel.m_name.end() ) );
+        writeValue( out, channel.m_startTime );
+        writeValue( out, channel.m_endTime );
+        for ( const auto* track :
+              { &channel.m_rotation, &channel.m_translation, &channel.m_scale } ) {
+            writeVector( out, track->m_times );
+            writeVector( out, track->m_keys );
+            writeValue( out, track->m_min );
+            writeValue( out, track->m_extent );
+        }
+    }
+}
+
+bool CompressedAnimation::read( std::istream& in ) {
+    *this = CompressedAnimation();
+    char magic[4];
+    uint32_t version;
+    uint64_t count;
+    float start, end;
+    if ( !in.read( magic, 4 ) || !std::equal( magic, magic + 4, ClipMagic ) ||
+         !readValue( in, version ) || version != ClipVersion || !readValue( in, count ) ||
+         !readValue( in, start ) || !readValue( in, end ) ) {
+        LOG( logERROR ) << "CompressedAnimation: invalid clip header.";
+        return false;
+    }
+    // a channel takes at least its name size, its times and the sizes and ranges of its tracks
+    constexpr uint64_t minChannelSize =
+        sizeof( uint64_t ) + 2 * sizeof( float ) +
+        3 * ( 2 * sizeof( uint64_t ) + 2 * sizeof( Eigen::Vector3f ) );
+    if ( count > remainingSize( in ) / minChannelSize ) {
+        LOG( logERROR ) << "CompressedAnimation: invalid channel count.";
+        return false;
+    }
+    std::vector<Channel> channels( count );
+    for ( auto& channel : channels ) {
+        std::vector<char> name;
+        bool ok = readVector( in, name ) && readValue( in, channel.m_startTime ) &&
+                  readValue( in, channel.m_endTime );
+        for ( auto* track : { &channel.m_rotation, &channel.m_translation, &channel.m_scale } ) {
+            ok = ok && readVector( in, track->m_times ) && readVector( in, track->m_keys ) &&
+                 readValue( in, track->m_min ) && readValue( in, track->m_extent ) &&
+                 !track->m_times.empty() && track->m_times.size() == track->m_keys.size();
+        }
+        if ( !ok ) {
+            LOG( logERROR ) << "CompressedAnimation: truncated or invalid clip.";
+            return false;
+        }
+        channel.m_name.assign( name.begin(), name.end() );
+    }
+    m_channels  = std::move( channels );
+    m_startTime = start;
+    m_endTime   = end;
+    return true;
+}
+
+} // namespace Animation
+} // namespace Core
+} // namespace Ra
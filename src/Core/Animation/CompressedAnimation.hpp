@@ -0,0 +1,141 @@
+#pragma once
+
+#include <Core/Animation/KeyFramedValue.hpp>
+#include <Core/Animation/Pose.hpp>
+#include <Core/RaCore.hpp>
+#include <Core/Types.hpp>
+
+#include <array>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+namespace Ra {
+namespace Core {
+namespace Animation {
+
+/// Compression tolerances of CompressedAnimation, in bone space.
+struct CompressionTolerances {
+    /// Maximal rotation error, in radians.
+    Scalar m_rotation { 1e-3_ra };
+    /// Maximal translation error, in model units.
+    Scalar m_translation { 1e-3_ra };
+    /// Maximal error on the scale factors.
+    Scalar m_scale { 1e-3_ra };
+};
+
+/**
+ * \brief Compressed skeletal animation clip.
+ *
+ * Each channel (i.e. the local transformation of a bone, as a KeyFramedValue<Transform>) is
+ * decomposed into rotation, translation and scale tracks, which are compressed independently:
+ *  - keyframe reduction: the keyframes that can be linearly interpolated (slerp for rotations)
+ *    from their neighbours within the tolerance are removed, constant tracks keep a single key.
+ *    The error is measured in bone space, at the times of the input keyframes, and takes
+ *    quantization into account.
+ *  - quantization: rotations are stored as the 3 smallest components of the unit quaternion
+ *    (15 bits each, 48 bits per key), translations and scales as 16 bits per component in the
+ *    track range.
+ *
+ * sample() decompresses the clip at a given time directly into a Pose, so that clips are played
+ * without being converted back to keyframed values (see Asset::AnimationData::getClip()).
+ * getChannels() does this conversion, e.g. to edit the clip. Clips can be saved to and loaded
+ * from binary streams.
+ */
+class RA_CORE_API CompressedAnimation
+{
+  public:
+    using Tolerances = CompressionTolerances;
+
+    CompressedAnimation() = default;
+
+    /**
+     * Compress \p channels, named \p names (may be empty).
+     */
+    CompressedAnimation( const std::vector<KeyFramedValue<Transform>>& channels,
+                         const std::vector<std::string>& names = {},
+                         const Tolerances& tolerances          = Tolerances() );
+
+    size_t getChannelCount() const { return m_channels.size(); }
+    const std::string& getChannelName( size_t i ) const { return m_channels[i].m_name; }
+
+    /// Time of the first and last keyframes over all the channels.
+    Scalar getStartTime() const { return m_startTime; }
+    Scalar getEndTime() const { return m_endTime; }
+
+    /// Return the number of keyframes stored for all the tracks of all the channels.
+    size_t getKeyFrameCount() const;
+
+    /// Return the size of the compressed data, in bytes.
+    size_t getMemorySize() const;
+
+    /**
+     * Decompress the clip at time \p t into \p pose, pose[i] being the transformation of
+     * channel i.
+     * \param cursors playback cursors of the tracks, resized if needed. Keep them from one call
+     *        to the other so that monotonic sampling does not search the keyframes.
+     */
+    void sample( Scalar t, Pose& pose, std::vector<size_t>& cursors ) const;
+
+    /**
+     * Decompress the clip at time \p t into \p pose, pose[targets[i]] being the transformation
+     * of channel i, e.g. to sample a clip whose channels are not ordered as the skeleton bones.
+     * Channels with a negative target are skipped, the other transformations of \p pose are left
+     * unchanged.
+     */
+    void sample( Scalar t,
+                 Pose& pose,
+                 std::vector<size_t>& cursors,
+                 const std::vector<int>& targets ) const;
+
+    /// Return channel \p i as a keyframed value, with a keyframe at each time one of its tracks
+    /// has a keyframe, and at the times of the first and last input keyframes.
+    KeyFramedValue<Transform> getChannel( size_t i ) const;
+
+    /// Return all the channels as keyframed values.
+    std::vector<KeyFramedValue<Transform>> getChannels() const;
+
+    /// Write the clip to the binary stream \p out.
+    void write( std::ostream& out ) const;
+
+    /// Read a clip written by write() from \p in.
+    /// \returns false, leaving the clip empty, if the stream does not contain a valid clip.
+    bool read( std::istream& in );
+
+  private:
+    /// Quantized values of a track, 3 components per key.
+    using QuantizedKey = std::array<uint16_t, 3>;
+
+    struct Track {
+        std::vector<float> m_times;
+        std::vector<QuantizedKey> m_keys;
+        /// Quantization range, for translation and scale tracks.
+        Eigen::Vector3f m_min { Eigen::Vector3f::Zero() };
+        Eigen::Vector3f m_extent { Eigen::Vector3f::Zero() };
+    };
+
+    struct Channel {
+        std::string m_name;
+        /// Time of the first and last input keyframes.
+        float m_startTime { 0.f };
+        float m_endTime { 0.f };
+        Track m_rotation;
+        Track m_translation;
+        Track m_scale;
+    };
+
+    /// Sample channel \p c at time \p t, with the cursors of its rotation, translation and
+    /// scale tracks.
+    Transform sampleChannel( size_t c, Scalar t, size_t cursors[3] ) const;
+    Quaternion sampleRotation( const Track& track, Scalar t, size_t& cursor ) const;
+    Vector3 sampleVector( const Track& track, Scalar t, size_t& cursor ) const;
+
+    std::vector<Channel> m_channels;
+    Scalar m_startTime { 0_ra };
+    Scalar m_endTime { 0_ra };
+};
+
+} // namespace Animation
+} // namespace Core
+} // namespace Ra
@@ -0,0 +1,116 @@
+#include <Core/Animation/CrowdSkinning.hpp>
+
+#include <Core/Animation/HandleArray.hpp>
+
+#include <algorithm>
+#include <unordered_set>
+
+namespace Ra {
+namespace Core {
+namespace Animation {
+
+namespace {
+/// Number of vertices skinned by a task of CrowdSkinning::skin.
+constexpr size_t BlockSize = 1024;
+} // namespace
+
+SharedSkinningRefData makeSharedSkinningRefData( SkinningRefData&& refData ) {
+    if ( refData.m_packedWeights.getVertexCount() != refData.m_referenceMesh.vertices().size() ) {
+        refData.m_packedWeights = PackedSkinningWeights( refData.m_weights );
+    }
+    return std::make_shared<const SkinningRefData>( std::move( refData ) );
+}
+
+uint CrowdSkinning::addInstance( SharedSkinningRefData refData ) {
+    CORE_ASSERT( refData, "CrowdSkinning: null reference data" );
+    CORE_ASSERT( refData->m_packedWeights.getVertexCount() ==
+                     refData->m_referenceMesh.vertices().size(),
+                 "CrowdSkinning: packed weights are required, see makeSharedSkinningRefData" );
+    Instance instance;
+    instance.m_offset      = m_positions.size();
+    instance.m_firstMatrix = m_matrices.size();
+    instance.m_pose        = refData->m_skeleton.getPose( HandleArray::SpaceType::MODEL );
+    instance.m_refData     = std::move( refData );
+
+    const auto& mesh = instance.m_refData->m_referenceMesh;
+    m_positions.insert( m_positions.end(), mesh.vertices().begin(), mesh.vertices().end() );
+    m_normals.insert( m_normals.end(), mesh.normals().begin(), mesh.normals().end() );
+    m_normals.resize( m_positions.size(), Vector3::Zero() );
+    m_matrices.resize( m_matrices.size() + instance.m_pose.size() );
+    m_instances.push_back( std::move( instance ) );
+    return uint( m_instances.size() - 1 );
+}
+
+void CrowdSkinning::clear() {
+    m_instances.clear();
+    m_positions.clear();
+    m_normals.clear();
+    m_matrices.clear();
+}
+
+size_t CrowdSkinning::getRefDataCount() const {
+    std::unordered_set<const SkinningRefData*> refData;
+    for ( const auto& instance : m_instances )
+        refData.insert( instance.m_refData.get() );
+    return refData.size();
+}
+
+void CrowdSkinning::setPose( uint instance, const Pose& modelPose ) {
+    CORE_ASSERT( modelPose.size() == m_instances[instance].m_pose.size(),
+                 "CrowdSkinning: pose size mismatch" );
+    m_instances[instance].m_pose = modelPose;
+}
+
+void CrowdSkinning::skin() {
+    // skinning matrices of all the instances
+    std::vector<std::pair<uint, uint>> bones; // (instance, bone)
+    bones.reserve( m_matrices.size() );
+    for ( uint i = 0; i < m_instances.size(); ++i ) {
+        for ( uint b = 0; b < m_instances[i].m_pose.size(); ++b )
+            bones.emplace_back( i, b );
+    }
+#pragma omp parallel for
+    for ( int k = 0; k < int( bones.size() ); ++k ) {
+        const auto& instance = m_instances[bones[k].first];
+        const uint b         = bones[k].second;
+        const auto& refData  = *instance.m_refData;
+        m_matrices[instance.m_firstMatrix + b] =
+            ( refData.m_meshTransformInverse * instance.m_pose[b] * refData.m_bindMatrices[b] )
+                .affine();
+    }
+
+    // vertex blocks of all the instances
+    std::vector<std::pair<uint, size_t>> blocks; // (instance, first vertex)
+    for ( uint i = 0; i < m_instances.size(); ++i ) {
+        for ( size_t v = 0; v < getVertexCount( i ); v += BlockSize )
+            blocks.emplace_back( i, v );
+    }
+#pragma omp parallel for schedule( dynamic )
+    for ( int k = 0; k < int( blocks.size() ); ++k ) {
+        const auto& instance  = m_instances[blocks[k].first];
+        const auto& refData   = *instance.m_refData;
+        const auto& packed    = refData.m_packedWeights;
+        const auto& vertices  = refData.m_referenceMesh.vertices();
+        const auto& normals   = refData.m_referenceMesh.normals();
+        const auto* M         = m_matrices.data() + instance.m_firstMatrix;
+        const int n           = packed.getInfluenceCount();
+        const uint16_t* bone  = packed.getBones().data();
+        const uint16_t* qw    = packed.getQuantizedWeights().data();
+        const bool hasNormals = normals.size() == vertices.size();
+
+        const size_t begin = blocks[k].second;
+        const size_t end   = std::min( begin + BlockSize, vertices.size() );
+        for ( size_t v = begin; v < end; ++v ) {
+            Eigen::Matrix<Scalar, 3, 4> m = Eigen::Matrix<Scalar, 3, 4>::Zero();
+            for ( size_t j = v * n; j < ( v + 1 ) * n; ++j ) {
+                m.noalias() += PackedSkinningWeights::dequantize( qw[j] ) * M[bone[j]];
+            }
+            m_positions[instance.m_offset + v] = m.leftCols<3>() * vertices[v] + m.col( 3 );
+            if ( hasNormals ) m_normals[instance.m_offset + v] = m.leftCols<3>() * normals[v];
+        }
+    }
+}
+
+} // namespace Animation
+} // namespace Core
+} // namespace Ra
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <Core/Animation/Pose.hpp>
+#include <Core/Animation/SkinningData.hpp>
+#include <Core/Containers/AlignedStdVector.hpp>
+#include <Core/Containers/VectorArray.hpp>
+#include <Core/RaCore.hpp>
+#include <Core/Types.hpp>
+
+#include <memory>
+#include <vector>
+
+namespace Ra {
+namespace Core {
+namespace Animation {
+
+/// Skinning reference data shared by several skinned instances.
+using SharedSkinningRefData = std::shared_ptr<const SkinningRefData>;
+
+/// Freeze \p refData so that it can be shared by many instances.
+/// The packed skinning weights are built if they are not set yet.
+RA_CORE_API SharedSkinningRefData makeSharedSkinningRefData( SkinningRefData&& refData );
+
+/**
+ * \brief Batched Linear Blend Skinning of many instances of a few skinned assets.
+ *
+ * Instances only hold a reference to their (shared, immutable) SkinningRefData and their current
+ * pose, so that memory scales with the number of unique assets rather than with the number of
+ * instances. The skinned positions and normals of all the instances are written to single pooled
+ * buffers, instance after instance.
+ *
+ * skin() processes all the instances in one parallel pass: skinning matrices are computed for
+ * all the bones of all the instances, then vertices are skinned by blocks with the packed
+ * weights (see PackedSkinningWeights).
+ */
+class RA_CORE_API CrowdSkinning
+{
+  public:
+    /// Add an instance of \p refData, in its rest pose, and return its index.
+    /// \note Invalidates the pointers to the pooled buffers.
+    uint addInstance( SharedSkinningRefData refData );
+
+    /// Remove all the instances.
+    void clear();
+
+    size_t getInstanceCount() const { return m_instances.size(); }
+
+    /// Return the number of distinct SkinningRefData used by the instances.
+    size_t getRefDataCount() const;
+
+    /// Set the model space pose of \p instance.
+    void setPose( uint instance, const Pose& modelPose );
+    const Pose& getPose( uint instance ) const { return m_instances[instance].m_pose; }
+
+    const SharedSkinningRefData& getRefData( uint instance ) const {
+        return m_instances[instance].m_refData;
+    }
+
+    /// Skin all the instances with their current pose.
+    void skin();
+
+    /// \name Pooled output buffers.
+    /// \{
+    const Vector3Array& getPositions() const { return m_positions; }
+    const Vector3Array& getNormals() const { return m_normals; }
+    /// Index of the first vertex of \p instance in the pooled buffers.
+    size_t getOffset( uint instance ) const { return m_instances[instance].m_offset; }
+    size_t getVertexCount( uint instance ) const {
+        return m_instances[instance].m_refData->m_referenceMesh.vertices().size();
+    }
+    /// \}
+
+  private:
+    struct Instance {
+        SharedSkinningRefData m_refData;
+        Pose m_pose;
+        size_t m_offset;
+        /// Index of the first skinning matrix of the instance.
+        size_t m_firstMatrix;
+    };
+
+    std::vector<Instance> m_instances;
+    Vector3Array m_positions;
+    Vector3Array m_normals;
+    /// Skinning matrices of all the instances.
+    AlignedStdVector<Eigen::Matrix<Scalar, 3, 4>> m_matrices;
+};
+
+} // namespace Animation
+} // namespace Core
+} // namespace Ra
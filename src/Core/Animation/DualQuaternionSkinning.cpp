@@ -2,6 +2,7 @@
 #include <Core/Animation/HandleArray.hpp>
 #include <Core/Animation/Skeleton.hpp>
 #include <Core/Animation/SkinningData.hpp>
+#include <Core/Containers/FrameArena.hpp>
 #include <Core/CoreMacros.hpp>
 #include <Core/Geometry/IndexedGeometry.hpp>
 #include <Core/Math/DualQuaternion.hpp>
@@ -25,9 +26,9 @@ DQList computeDQ( const Pose& pose, const Sparse& weight ) {
                DualQuaternion( Quaternion( 0, 0, 0, 0 ), Quaternion( 0, 0, 0, 0 ) ) );
 
     // Stores the first non-zero quaternion for each vertex.
-    std::vector<uint> firstNonZero( weight.rows(), std::numeric_limits<uint>::max() );
+    FrameVector<uint> firstNonZero( weight.rows(), std::numeric_limits<uint>::max() );
     // Contains the converted dual quaternions from the pose
-    std::vector<DualQuaternion> poseDQ( pose.size() );
+    FrameVector<DualQuaternion> poseDQ( pose.size() );
 
     // Loop through all transforms Tj
     for ( int j = 0; j < weight.outerSize(); ++j ) {
@@ -73,6 +74,37 @@ DQList computeDQ( const Pose& pose, const Sparse& weight ) {
     return DQ;
 }
 
+DQList computeDQ( const Pose& pose, const PackedSkinningWeights& weights ) {
+    CORE_ASSERT( pose.size() == weights.getBoneCount(), "pose/weight size mismatch." );
+    // dual quaternions as 8D vectors (q0 then qe coefficients), blended with packet math.
+    using DQCoeffs = Eigen::Matrix<Scalar, 8, 1>;
+    FrameVector<DQCoeffs> poseDQ( pose.size() );
+#pragma omp parallel for
+    for ( int j = 0; j < int( pose.size() ); ++j ) {
+        const DualQuaternion dq( pose[j] );
+        poseDQ[j] << dq.getQ0().coeffs(), dq.getQe().coeffs();
+    }
+
+    DQList DQ( weights.getVertexCount() );
+    const int n          = weights.getInfluenceCount();
+    const uint16_t* bone = weights.getBones().data();
+    const uint16_t* qw   = weights.getQuantizedWeights().data();
+#pragma omp parallel for
+    for ( int i = 0; i < int( DQ.size() ); ++i ) {
+        // influences are sorted, the first one is the most influent.
+        const auto& pivot = poseDQ[bone[i * n]];
+        DQCoeffs dq       = DQCoeffs::Zero();
+        for ( int k = i * n; k < ( i + 1 ) * n; ++k ) {
+            const auto& q  = poseDQ[bone[k]];
+            const Scalar w = PackedSkinningWeights::dequantize( qw[k] );
+            dq.noalias() += Math::signNZ( q.head<4>().dot( pivot.head<4>() ) ) * w * q;
+        }
+        DQ[i] = DualQuaternion( Quaternion( dq.head<4>() ), Quaternion( dq.tail<4>() ) );
+        DQ[i].normalize();
+    }
+    return DQ;
+}
+
 // alternate naive version, for reference purposes.
 // See Kavan , Collins, Zara and O'Sullivan, 2008
 DQList computeDQ_naive( const Pose& pose, const Sparse& weight ) {
@@ -134,7 +166,12 @@ void dualQuaternionSkinning( const SkinningRefData& refData,
         pose[i] = refData.m_meshTransformInverse * pose[i] * refData.m_bindMatrices[i];
     }
     // compute the dual quaternion for each vertex
-    const auto DQ = computeDQ( pose, refData.m_weights );
+    const auto& packed = refData.m_packedWeights;
+    const auto DQ =
+        packed.getVertexCount() == refData.m_referenceMesh.vertices().size() &&
+                packed.getBoneCount() == pose.size()
+            ? computeDQ( pose, packed )
+            : computeDQ( pose, refData.m_weights );
     // apply DQS
     const auto& vertices = refData.m_referenceMesh.vertices();
     const auto& normals  = refData.m_referenceMesh.normals();
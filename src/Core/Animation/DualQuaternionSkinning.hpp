@@ -1,6 +1,7 @@
 #pragma once
 
 #include <Core/Animation/HandleWeight.hpp>
+#include <Core/Animation/PackedSkinningWeights.hpp>
 #include <Core/Animation/Pose.hpp>
 #include <Core/Containers/AlignedStdVector.hpp>
 #include <Core/Containers/VectorArray.hpp>
@@ -29,6 +30,12 @@ using DQList = AlignedStdVector<DualQuaternion>;
 // clang-format on
 DQList RA_CORE_API computeDQ( const Pose& pose, const WeightMatrix& weight );
 
+/**
+ * \brief Vertex-major version of computeDQ, using packed weights.
+ * The sign of each bone dual quaternion is chosen w.r.t. the most influent bone of the vertex.
+ */
+DQList RA_CORE_API computeDQ( const Pose& pose, const PackedSkinningWeights& weights );
+
 /**
  * \brief Default non-optimized, non-parallel implementation of computeDQ.
  */
@@ -53,6 +60,7 @@ Vector3Array RA_CORE_API applyDualQuaternions( const DQList& DQ, const Vector3Ar
  * \f$\mathbf{v}_i^t = \mathbf{Q}_i(\mathbf{v}_i^0)\f$
  *
  * \note Assumes frameData is well sized.
+ * \note Uses refData.m_packedWeights if it has been set for the reference mesh.
  * \note Parallelized loop inside (using openmp).
  */
 // clang-format on
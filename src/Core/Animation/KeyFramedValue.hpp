@@ -195,17 +195,56 @@ class KeyFramedValue : public KeyFramedValueBase
             } );
 
         // here upper > begin() since before first case is already taken into account.
-        auto lower = upper;
-        --lower;
-        if ( Math::areApproxEqual( lower->first, t ) ) {
-            const size_t i = std::distance( m_keyframes.begin(), lower );
-            return { i, i, 0_ra };
+        return rangeFromLower( t, size_t( std::distance( m_keyframes.begin(), upper ) ) - 1 );
+    }
+
+    /**
+     * Same as findRange( t ), using and updating the playback cursor \p cursor.
+     * The cursor stores the index of the keyframe preceding the last requested time, so that
+     * for monotonic times (i.e. animation playback) the range is found in constant time
+     * instead of a binary search over all the keyframes.
+     * \note The cursor can be initialized to any value (e.g. 0).
+     */
+    std::tuple<size_t, size_t, Scalar> findRange( Scalar t, size_t& cursor ) const {
+        const size_t n = m_keyframes.size();
+        if ( t < m_keyframes.front().first ) {
+            cursor = 0;
+            return { 0, 0, 0_ra };
         }
-        // in-between
-        const size_t i  = std::distance( m_keyframes.begin(), lower );
-        const Scalar t0 = lower->first;
-        const Scalar t1 = upper->first;
-        return { i, i + 1, ( t - t0 ) / ( t1 - t0 ) };
+        if ( t > m_keyframes.back().first ) {
+            cursor = n - 1;
+            return { n - 1, n - 1, 0_ra };
+        }
+        auto isLower = [this, n, t]( size_t i ) {
+            return m_keyframes[i].first <= t && ( i + 1 == n || t < m_keyframes[i + 1].first );
+        };
+        // same keyframe interval, or the next one
+        if ( cursor >= n || !isLower( cursor ) ) {
+            if ( cursor + 1 < n && isLower( cursor + 1 ) ) { ++cursor; }
+            else {
+                auto upper = std::upper_bound(
+                    m_keyframes.begin(), m_keyframes.end(), t, []( Scalar a, const auto& b ) {
+                        return a < b.first;
+                    } );
+                cursor = size_t( std::distance( m_keyframes.begin(), upper ) ) - 1;
+            }
+        }
+        return rangeFromLower( t, cursor );
+    }
+
+    /**
+     * \returns the value at time \p t, interpolated by \p interpolate from the keyframes
+     *          around \p t, found with the playback cursor \p cursor (see findRange).
+     * \param interpolate a function (or functor, resolved at compile time) such that
+     *        interpolate( v0, v1, dt ) returns the value at \p dt between \p v0 and \p v1,
+     *        e.g. Ra::Core::Math::linearInterpolate.
+     */
+    template <typename InterpolateFunction>
+    inline VALUE_TYPE
+    at( const Scalar& t, size_t& cursor, const InterpolateFunction& interpolate ) const {
+        auto [i, j, dt] = findRange( t, cursor );
+        if ( i == j ) { return m_keyframes[i].second; }
+        return interpolate( m_keyframes[i].second, m_keyframes[j].second, dt );
     }
     /// \}
 
@@ -230,6 +269,18 @@ class KeyFramedValue : public KeyFramedValueBase
     /// \}
 
   protected:
+    /// Return the range given by findRange, \p lower being the index of the last keyframe whose
+    /// time is lower or equal to \p t.
+    std::tuple<size_t, size_t, Scalar> rangeFromLower( Scalar t, size_t lower ) const {
+        if ( Math::areApproxEqual( m_keyframes[lower].first, t ) ) {
+            return { lower, lower, 0_ra };
+        }
+        // in-between
+        const Scalar t0 = m_keyframes[lower].first;
+        const Scalar t1 = m_keyframes[lower + 1].first;
+        return { lower, lower + 1, ( t - t0 ) / ( t1 - t0 ) };
+    }
+
     /// The list of keyframes.
     KeyFrames m_keyframes;
 };
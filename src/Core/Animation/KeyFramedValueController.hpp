@@ -11,7 +11,7 @@ namespace Animation {
 /**
  * The KeyFrameController class provides a way to call callback functions on
  * KeyFramedValues upon keyframe insertion, modification or a modification of
- * the current time.
+ * the current time, and after the keyframes have been edited through m_value.
  */
 class KeyFramedValueController
 {
@@ -19,16 +19,19 @@ class KeyFramedValueController
     using KeyFrame       = Ra::Core::Animation::KeyFramedValueBase;
     using InsertCallback = std::function<void( const Scalar& /*t*/ )>;
     using UpdateCallback = std::function<void( const Scalar& /*t*/ )>;
+    using ChangeCallback = std::function<void()>;
 
     KeyFramedValueController(
         KeyFrame* value         = nullptr,
         std::string&& name      = "__INVALID__",
         InsertCallback inserter = []( const Scalar& ) {},
-        UpdateCallback updater  = []( const Scalar& ) {} ) :
+        UpdateCallback updater  = []( const Scalar& ) {},
+        ChangeCallback notifier = []() {} ) :
         m_value( value ),
         m_name( std::move( name ) ),
         m_inserter( inserter ),
-        m_updater( updater ) {}
+        m_updater( updater ),
+        m_notifier( notifier ) {}
 
     /**
      * Calls the InsertCallback to insert a keyframe at tie \p t.
@@ -40,6 +43,12 @@ class KeyFramedValueController
      */
     void updateKeyFrame( Scalar t ) { m_updater( t ); }
 
+    /**
+     * Calls the ChangeCallback, to be done after removing or moving keyframes
+     * of m_value.
+     */
+    void notifyChange() { m_notifier(); }
+
     /**
      * The KeyFramedValue to manage.
      */
@@ -59,6 +68,11 @@ class KeyFramedValueController
      * The callback fonction to call for value update.
      */
     UpdateCallback m_updater;
+
+    /**
+     * The callback fonction to call after the keyframes have been edited.
+     */
+    ChangeCallback m_notifier;
 };
 
 } // namespace Animation
@@ -5,6 +5,9 @@
 #include <Core/Animation/PoseOperation.hpp>
 #include <Core/Math/Interpolation.hpp>
 
+#include <type_traits>
+#include <vector>
+
 namespace Ra {
 namespace Core {
 namespace Animation {
@@ -51,6 +54,45 @@ inline Pose linearInterpolate<Pose>( const KeyFramedValue<Pose>& keyframes, Scal
 }
 /// \}
 
+/**
+ * Linear interpolation functor, for KeyFramedValue::at( t, cursor, interpolate ) and
+ * sampleKeyFramedValues.
+ * As for linearInterpolate, booleans and integers are step interpolated.
+ */
+struct LinearInterpolator {
+    template <typename T>
+    inline T operator()( const T& v0, const T& v1, Scalar dt ) const {
+        if constexpr ( std::is_same_v<T, bool> || std::is_same_v<T, int> ) {
+            CORE_UNUSED( v1 );
+            CORE_UNUSED( dt );
+            return v0;
+        }
+        else if constexpr ( std::is_same_v<T, Pose> ) { return interpolatePoses( v0, v1, dt ); }
+        else { return Core::Math::linearInterpolate( v0, v1, dt ); }
+    }
+};
+
+/**
+ * Sample all the \p channels (e.g. the per-bone animations of a skeleton) at time \p t, and
+ * write the value of channel i in values[i] (e.g. a Pose).
+ * \param cursors the playback cursors of the channels (see KeyFramedValue::findRange), resized
+ *        to the number of channels if needed. Keep them from one call to the other so that
+ *        monotonic sampling does not search the keyframes.
+ * \param interpolate the interpolation functor, resolved at compile time.
+ */
+template <typename T, typename Container, typename InterpolateFunction = LinearInterpolator>
+inline void sampleKeyFramedValues( const std::vector<KeyFramedValue<T>>& channels,
+                                   Scalar t,
+                                   std::vector<size_t>& cursors,
+                                   Container& values,
+                                   const InterpolateFunction& interpolate = {} ) {
+    CORE_ASSERT( values.size() >= channels.size(), "Output too small." );
+    cursors.resize( channels.size(), 0 );
+    for ( size_t i = 0; i < channels.size(); ++i ) {
+        values[i] = channels[i].at( t, cursors[i], interpolate );
+    }
+}
+
 } // namespace Animation
 } // namespace Core
 } // namespace Ra
@@ -1,8 +1,10 @@
 #include <Core/Animation/HandleArray.hpp>
 #include <Core/Animation/HandleWeight.hpp>
 #include <Core/Animation/LinearBlendSkinning.hpp>
+#include <Core/Animation/PackedSkinningWeights.hpp>
 #include <Core/Animation/Skeleton.hpp>
 #include <Core/Animation/SkinningData.hpp>
+#include <Core/Containers/FrameArena.hpp>
 #include <Core/CoreMacros.hpp>
 #include <Core/Geometry/IndexedGeometry.hpp>
 #include <Core/Types.hpp>
@@ -16,10 +18,14 @@ namespace Ra {
 namespace Core {
 namespace Animation {
 
-void linearBlendSkinning( const SkinningRefData& refData,
-                          const Vector3Array& tangents,
-                          const Vector3Array& bitangents,
-                          SkinningFrameData& frameData ) {
+namespace {
+/// Skinning matrix, i.e. the 3x4 upper part of an affine transform.
+using SkinningMatrix = Eigen::Matrix<Scalar, 3, 4>;
+
+void sparseLinearBlendSkinning( const SkinningRefData& refData,
+                                const Vector3Array& tangents,
+                                const Vector3Array& bitangents,
+                                SkinningFrameData& frameData ) {
     const auto& W          = refData.m_weights;
     const auto& vertices   = refData.m_referenceMesh.vertices();
     const auto& normals    = refData.m_referenceMesh.normals();
@@ -52,6 +58,52 @@ void linearBlendSkinning( const SkinningRefData& refData,
     }
 }
 
+void packedLinearBlendSkinning( const SkinningRefData& refData,
+                                const Vector3Array& tangents,
+                                const Vector3Array& bitangents,
+                                SkinningFrameData& frameData ) {
+    const auto& packed   = refData.m_packedWeights;
+    const auto& vertices = refData.m_referenceMesh.vertices();
+    const auto& normals  = refData.m_referenceMesh.normals();
+    const auto& pose     = frameData.m_skeleton.getPose( HandleArray::SpaceType::MODEL );
+
+    // prepare the pose w.r.t. the bind matrices and the mesh transform, in the frame arena
+    FrameVector<SkinningMatrix> M( pose.size() );
+#pragma omp parallel for
+    for ( int j = 0; j < int( pose.size() ); ++j ) {
+        M[j] = ( refData.m_meshTransformInverse * pose[j] * refData.m_bindMatrices[j] ).affine();
+    }
+
+    const int n          = packed.getInfluenceCount();
+    const uint16_t* bone = packed.getBones().data();
+    const uint16_t* qw   = packed.getQuantizedWeights().data();
+#pragma omp parallel for
+    for ( int i = 0; i < int( packed.getVertexCount() ); ++i ) {
+        // blend the matrices, fixed size Eigen expressions are vectorized
+        SkinningMatrix m = SkinningMatrix::Zero();
+        for ( int k = i * n; k < ( i + 1 ) * n; ++k ) {
+            m.noalias() += PackedSkinningWeights::dequantize( qw[k] ) * M[bone[k]];
+        }
+        const auto R                    = m.leftCols<3>();
+        frameData.m_currentPosition[i]  = R * vertices[i] + m.col( 3 );
+        frameData.m_currentNormal[i]    = R * normals[i];
+        frameData.m_currentTangent[i]   = R * tangents[i];
+        frameData.m_currentBitangent[i] = R * bitangents[i];
+    }
+}
+} // namespace
+
+void linearBlendSkinning( const SkinningRefData& refData,
+                          const Vector3Array& tangents,
+                          const Vector3Array& bitangents,
+                          SkinningFrameData& frameData ) {
+    if ( refData.m_packedWeights.getVertexCount() == refData.m_referenceMesh.vertices().size() &&
+         refData.m_packedWeights.getBoneCount() == frameData.m_skeleton.size() ) {
+        packedLinearBlendSkinning( refData, tangents, bitangents, frameData );
+    }
+    else { sparseLinearBlendSkinning( refData, tangents, bitangents, frameData ); }
+}
+
 } // namespace Animation
 } // namespace Core
 } // namespace Ra
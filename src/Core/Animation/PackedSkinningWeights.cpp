@@ -0,0 +1,76 @@
+#include <Core/Animation/PackedSkinningWeights.hpp>
+
+#include <Core/Utils/Log.hpp>
+
+#include <Eigen/SparseCore>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace Ra {
+namespace Core {
+namespace Animation {
+
+using namespace Utils; // log
+
+PackedSkinningWeights::PackedSkinningWeights( const WeightMatrix& weights, int maxInfluences ) {
+    CORE_ASSERT( maxInfluences == 4 || maxInfluences == 8,
+                 "PackedSkinningWeights: 4 or 8 influences per vertex" );
+    if ( weights.cols() > std::numeric_limits<uint16_t>::max() + 1 ) {
+        LOG( logERROR ) << "PackedSkinningWeights: too many bones (" << weights.cols() << ").";
+        return;
+    }
+    // per-vertex access
+    using RowMajorWeights      = Eigen::SparseMatrix<Scalar, Eigen::RowMajor>;
+    const RowMajorWeights rows = weights;
+
+    int maxCount = 0;
+    for ( int i = 0; i < rows.outerSize(); ++i )
+        maxCount = std::max( maxCount, int( rows.row( i ).nonZeros() ) );
+    if ( maxCount > maxInfluences ) {
+        LOG( logDEBUG ) << "PackedSkinningWeights: up to " << maxCount
+                        << " influences per vertex, only the " << maxInfluences
+                        << " largest are kept.";
+    }
+
+    m_influenceCount = maxCount <= 4 ? 4 : maxInfluences;
+    m_vertexCount    = size_t( rows.rows() );
+    m_boneCount      = size_t( rows.cols() );
+    m_bones.assign( m_vertexCount * m_influenceCount, 0 );
+    m_weights.assign( m_vertexCount * m_influenceCount, 0 );
+
+#pragma omp parallel for
+    for ( int i = 0; i < int( m_vertexCount ); ++i ) {
+        std::vector<SingleWeight> influences;
+        for ( RowMajorWeights::InnerIterator it( rows, i ); it; ++it ) {
+            if ( it.value() > 0_ra ) influences.emplace_back( uint( it.col() ), it.value() );
+        }
+        const size_t count = std::min( influences.size(), size_t( m_influenceCount ) );
+        std::partial_sort( influences.begin(),
+                           influences.begin() + count,
+                           influences.end(),
+                           []( const SingleWeight& a, const SingleWeight& b ) {
+                               return a.second > b.second ||
+                                      ( a.second == b.second && a.first < b.first );
+                           } );
+        Scalar sum = 0_ra;
+        for ( size_t k = 0; k < count; ++k )
+            sum += influences[k].second;
+        if ( sum <= 0_ra ) continue;
+
+        // quantize, the rounding error goes to the largest weight so that weights sum up to 1.
+        const size_t offset = size_t( i ) * m_influenceCount;
+        int total           = 0;
+        for ( size_t k = 0; k < count; ++k ) {
+            const int w           = int( std::lround( influences[k].second / sum * 0xffff ) );
+            m_bones[offset + k]   = uint16_t( influences[k].first );
+            m_weights[offset + k] = uint16_t( w );
+            total += w;
+        }
+        m_weights[offset] = uint16_t( int( m_weights[offset] ) + 0xffff - total );
+    }
+}
+
+} // namespace Animation
+} // namespace Core
+} // namespace Ra
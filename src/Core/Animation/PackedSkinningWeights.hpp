@@ -0,0 +1,78 @@
+#pragma once
+
+#include <Core/Animation/HandleWeight.hpp>
+#include <Core/CoreMacros.hpp>
+#include <Core/RaCore.hpp>
+#include <Core/Types.hpp>
+
+#include <cstdint>
+#include <vector>
+
+namespace Ra {
+namespace Core {
+namespace Animation {
+
+/**
+ * \brief Skinning weights packed per vertex, for vertex-major skinning kernels.
+ *
+ * Each vertex stores a fixed number of influences (4 or 8): a 16 bits bone index and a 16 bits
+ * quantized weight. Bone indices and weights are stored in two separate arrays (SoA), each
+ * vertex using getInfluenceCount() consecutive entries. Influences of a vertex are sorted by
+ * decreasing weight, and unused influences have a zero weight (and bone 0), so that kernels can
+ * loop over all influences without branching.
+ *
+ * Compared to the WeightMatrix, which is stored by bone, skinning a vertex only reads contiguous
+ * memory and writes its own outputs, which allows to vectorize the blending and to process
+ * vertices in parallel without scattered writes.
+ */
+class RA_CORE_API PackedSkinningWeights
+{
+  public:
+    /// Maximum number of influences per vertex.
+    static constexpr int MaxInfluences = 8;
+
+    PackedSkinningWeights() = default;
+
+    /**
+     * Pack \p weights.
+     * Vertices influenced by more than \p maxInfluences bones (4 or 8) only keep their largest
+     * weights. Weights are renormalized to sum up to 1 after quantization.
+     * The number of influences per vertex is 4 if no vertex needs more, \p maxInfluences otherwise.
+     */
+    explicit PackedSkinningWeights( const WeightMatrix& weights,
+                                    int maxInfluences = MaxInfluences );
+
+    /// Number of influences stored per vertex.
+    int getInfluenceCount() const { return m_influenceCount; }
+    size_t getVertexCount() const { return m_vertexCount; }
+    size_t getBoneCount() const { return m_boneCount; }
+    bool empty() const { return m_vertexCount == 0; }
+
+    /// Bone indices, getInfluenceCount() per vertex.
+    const std::vector<uint16_t>& getBones() const { return m_bones; }
+    /// Quantized weights, getInfluenceCount() per vertex.
+    const std::vector<uint16_t>& getQuantizedWeights() const { return m_weights; }
+
+    /// Return the bone of the \p k-th influence of vertex \p i.
+    uint getBone( size_t i, int k ) const { return m_bones[i * m_influenceCount + k]; }
+    /// Return the weight of the \p k-th influence of vertex \p i.
+    Scalar getWeight( size_t i, int k ) const {
+        return dequantize( m_weights[i * m_influenceCount + k] );
+    }
+
+    /// Return the weight corresponding to the quantized weight \p w.
+    static Scalar dequantize( uint16_t w ) {
+        return Scalar( w ) * ( Scalar( 1 ) / Scalar( 0xffff ) );
+    }
+
+  private:
+    int m_influenceCount { 0 };
+    size_t m_vertexCount { 0 };
+    size_t m_boneCount { 0 };
+    std::vector<uint16_t> m_bones;
+    std::vector<uint16_t> m_weights;
+};
+
+} // namespace Animation
+} // namespace Core
+} // namespace Ra
@@ -1,47 +1,219 @@
 #include <Core/Animation/RotationCenterSkinning.hpp>
 
-#include <array>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <random>
+#include <sstream>
 #include <unordered_map>
 
 #include <Core/Animation/DualQuaternionSkinning.hpp>
 #include <Core/Animation/HandleWeight.hpp>
 #include <Core/Animation/Pose.hpp>
 #include <Core/Animation/SkinningData.hpp>
+#include <Core/Containers/SmallVector.hpp>
 #include <Core/Geometry/TopologicalMesh.hpp>
 #include <Core/Utils/Log.hpp>
+#include <Core/Utils/StdUtils.hpp>
 
 namespace Ra {
 namespace Core {
 namespace Animation {
 
-using namespace Utils; // log
+using namespace Utils; // log, hash_combine
 
-Scalar weightSimilarity( const Eigen::SparseVector<Scalar>& v1w,
-                         const Eigen::SparseVector<Scalar>& v2w,
-                         Scalar sigma ) {
+namespace {
+/// Non-zero weights of a vertex or a face, sorted by handle index.
+using CompactWeights  = std::vector<SingleWeight>;
+using RowMajorWeights = Eigen::SparseMatrix<Scalar, Eigen::RowMajor>;
+
+CompactWeights compactWeights( const RowMajorWeights& W, int row ) {
+    CompactWeights res;
+    for ( RowMajorWeights::InnerIterator it( W, row ); it; ++it ) {
+        if ( it.value() > 0 ) res.emplace_back( uint( it.col() ), it.value() );
+    }
+    return res;
+}
+
+/// Return the number of \p handles (sorted) influencing \p w.
+size_t commonHandles( const CompactWeights& w, const std::vector<uint>& handles ) {
+    size_t count = 0;
+    auto it1     = w.begin();
+    auto it2     = handles.begin();
+    while ( it1 != w.end() && it2 != handles.end() ) {
+        if ( it1->first < *it2 ) { ++it1; }
+        else if ( *it2 < it1->first ) { ++it2; }
+        else {
+            ++count;
+            ++it1;
+            ++it2;
+        }
+    }
+    return count;
+}
+
+Scalar weightSimilarity( const CompactWeights& w1, const CompactWeights& w2, Scalar sigma ) {
     const Scalar sigmaSq = sigma * sigma;
 
+    // weights of the handles influencing both
+    SmallVector<std::pair<Scalar, Scalar>, 8> common;
+    for ( auto it1 = w1.begin(), it2 = w2.begin(); it1 != w1.end() && it2 != w2.end(); ) {
+        if ( it1->first < it2->first ) { ++it1; }
+        else if ( it2->first < it1->first ) { ++it2; }
+        else {
+            common.push_back( { it1->second, it2->second } );
+            ++it1;
+            ++it2;
+        }
+    }
+
+    // the sum over j != k is symmetric, sum over j < k only.
     Scalar result = 0;
-    // Iterating over non zero coefficients
-    for ( Eigen::SparseVector<Scalar>::InnerIterator it1( v1w ); it1; ++it1 ) {
-        const uint j      = it1.index();
-        const Scalar& W1j = it1.value();              // This one is necessarily non zero
-        const Scalar& W2j = v2w.coeff( it1.index() ); // This one may be 0.
-
-        if ( W2j > 0 ) {
-            for ( Eigen::SparseVector<Scalar>::InnerIterator it2( v2w ); it2; ++it2 ) {
-                const uint k      = it2.index();
-                const Scalar& W1k = v1w.coeff( it2.index() );
-                const Scalar& W2k = it2.value();
-                if ( j != k && W1k > 0 ) {
-                    const Scalar diff =
-                        std::exp( -Math::ipow<2>( ( W1j * W2k ) - ( W1k * W2j ) ) / ( sigmaSq ) );
-                    result += W1j * W1k * W2j * W2k * diff;
-                }
-            }
+    for ( size_t j = 0; j < common.size(); ++j ) {
+        const Scalar W1j = common[j].first;
+        const Scalar W2j = common[j].second;
+        for ( size_t k = j + 1; k < common.size(); ++k ) {
+            const Scalar W1k  = common[k].first;
+            const Scalar W2k  = common[k].second;
+            const Scalar diff =
+                std::exp( -Math::ipow<2>( ( W1j * W2k ) - ( W1k * W2j ) ) / sigmaSq );
+            result += W1j * W1k * W2j * W2k * diff;
+        }
+    }
+    return 2 * result;
+}
+
+/// Integral over a set of faces with similar weights.
+struct FaceIntegral {
+    /// Sum of area * centroid.
+    Vector3 m_areaCentroid { Vector3::Zero() };
+    Scalar m_area { 0 };
+    /// Area weighted mean of the face weights.
+    CompactWeights m_weights;
+};
+
+/// Faces influenced by the same handles.
+struct FaceCluster {
+    std::vector<uint> m_handles;
+    std::vector<FaceIntegral> m_integrals;
+};
+
+std::string corCacheFile( const std::string& cacheDirectory, uint64_t key ) {
+    std::ostringstream name;
+    name << cacheDirectory << "/cor_" << std::hex << key << ".bin";
+    return name.str();
+}
+
+constexpr char CoRCacheMagic[4] = { 'R', 'C', 'o', 'R' };
+
+/// Size of a cache file of \p nVerts centers: magic, count, Scalar size, centers and checksum.
+constexpr size_t corCacheFileSize( size_t nVerts ) {
+    return 4 + sizeof( uint64_t ) + sizeof( uint8_t ) + nVerts * 3 * sizeof( Scalar ) +
+           sizeof( uint64_t );
+}
+
+/// Checksum of the centers, stored at the end of the cache file.
+uint64_t corChecksum( const Vector3Array& CoR ) {
+    uint64_t sum = fnvOffsetBasis;
+    for ( const auto& c : CoR )
+        sum = fnv1a( c.data(), 3 * sizeof( Scalar ), sum );
+    return sum;
+}
+
+bool loadCoR( const std::string& file, size_t nVerts, Vector3Array& CoR ) {
+    std::error_code error;
+    const auto fileSize = std::filesystem::file_size( file, error );
+    if ( error ) return false;
+    if ( fileSize != corCacheFileSize( nVerts ) ) {
+        LOG( logWARNING ) << "CoR: invalid cache file size " << file;
+        return false;
+    }
+    std::ifstream in( file, std::ios::binary );
+    if ( !in ) return false;
+    char magic[4];
+    uint64_t count;
+    uint8_t scalarSize;
+    in.read( magic, 4 );
+    in.read( reinterpret_cast<char*>( &count ), sizeof( count ) );
+    in.read( reinterpret_cast<char*>( &scalarSize ), sizeof( scalarSize ) );
+    if ( !in || !std::equal( magic, magic + 4, CoRCacheMagic ) || count != nVerts ||
+         scalarSize != sizeof( Scalar ) ) {
+        LOG( logWARNING ) << "CoR: invalid cache file " << file;
+        return false;
+    }
+    Vector3Array res( nVerts );
+    for ( auto& c : res )
+        in.read( reinterpret_cast<char*>( c.data() ), 3 * sizeof( Scalar ) );
+    uint64_t checksum;
+    in.read( reinterpret_cast<char*>( &checksum ), sizeof( checksum ) );
+    if ( !in || checksum != corChecksum( res ) ) {
+        LOG( logWARNING ) << "CoR: corrupted cache file " << file;
+        return false;
+    }
+    CoR = std::move( res );
+    return true;
+}
+
+void saveCoR( const std::string& file, const Vector3Array& CoR ) {
+    // written to a temporary file, then renamed, so that concurrent or interrupted writes never
+    // leave a partial cache file
+    std::ostringstream tmpName;
+    tmpName << file << ".tmp" << std::hex << std::random_device {}();
+    const std::string tmpFile = tmpName.str();
+    {
+        std::ofstream out( tmpFile, std::ios::binary );
+        const uint64_t count     = CoR.size();
+        const uint8_t scalarSize = sizeof( Scalar );
+        const uint64_t checksum  = corChecksum( CoR );
+        out.write( CoRCacheMagic, 4 );
+        out.write( reinterpret_cast<const char*>( &count ), sizeof( count ) );
+        out.write( reinterpret_cast<const char*>( &scalarSize ), sizeof( scalarSize ) );
+        for ( const auto& c : CoR )
+            out.write( reinterpret_cast<const char*>( c.data() ), 3 * sizeof( Scalar ) );
+        out.write( reinterpret_cast<const char*>( &checksum ), sizeof( checksum ) );
+        out.close();
+        if ( !out ) {
+            LOG( logWARNING ) << "CoR: unable to write cache file " << file;
+            std::error_code error;
+            std::filesystem::remove( tmpFile, error );
+            return;
         }
     }
-    return result;
+    std::error_code error;
+    std::filesystem::rename( tmpFile, file, error );
+    if ( error ) {
+        LOG( logWARNING ) << "CoR: unable to write cache file " << file << ": " << error.message();
+        std::filesystem::remove( tmpFile, error );
+    }
+}
+
+} // namespace
+
+uint64_t hashCoRInputs( const SkinningRefData& data, Scalar sigma, Scalar weightEpsilon ) {
+    const auto& vertices = data.m_referenceMesh.vertices();
+    const auto& indices  = data.m_referenceMesh.getIndices();
+    const auto& W        = data.m_weights;
+
+    const uint64_t sizes[]    = {
+        vertices.size(), indices.size(), uint64_t( W.rows() ), uint64_t( W.cols() ) };
+    const Scalar parameters[] = { sigma, weightEpsilon };
+
+    uint64_t key = fnv1a( sizes, sizeof( sizes ) );
+    key          = fnv1a( parameters, sizeof( parameters ), key );
+    key          = fnv1a( vertices.data(), sizeof( Vector3 ) * vertices.size(), key );
+    key          = fnv1a( indices.data(), sizeof( Vector3ui ) * indices.size(), key );
+    for ( int k = 0; k < W.outerSize(); ++k ) {
+        for ( WeightMatrix::InnerIterator it( W, k ); it; ++it ) {
+            const int64_t coeff[] = { it.row(), it.col() };
+            const Scalar value    = it.value();
+            key                   = fnv1a( coeff, sizeof( coeff ), key );
+            key                   = fnv1a( &value, sizeof( value ), key );
+        }
+    }
+    return key;
 }
 
 void computeCoR( SkinningRefData& dataInOut, Scalar sigma, Scalar weightEpsilon ) {
@@ -75,7 +247,7 @@ void computeCoR( SkinningRefData& dataInOut, Scalar sigma, Scalar weightEpsilon
 
     // Squash weight matrix to fit TopologicalMesh (access through handle indices)
     // Store the weights as row major here because we are going to query the per-vertex weights.
-    Eigen::SparseMatrix<Scalar, Eigen::RowMajor> subdivW;
+    RowMajorWeights subdivW;
     const int numCols = dataInOut.m_weights.cols();
     subdivW.resize( topoMesh.n_vertices(), numCols );
     const auto& V = triMesh.vertices();
@@ -92,8 +264,8 @@ void computeCoR( SkinningRefData& dataInOut, Scalar sigma, Scalar weightEpsilon
     do {
         maxWeightDistance = 0;
 
-        // Stores the edges to split
-        std::vector<Geometry::TopologicalMesh::EdgeHandle> edgesToSplit;
+        // Stores the edges to split, with their weight distance.
+        std::vector<std::pair<Scalar, Geometry::TopologicalMesh::EdgeHandle>> edgesToSplit;
 
         // Compute all weights distances for all edges.
         for ( auto e_it = topoMesh.edges_begin(); e_it != topoMesh.edges_end(); ++e_it ) {
@@ -105,39 +277,30 @@ void computeCoR( SkinningRefData& dataInOut, Scalar sigma, Scalar weightEpsilon
             Scalar weightDistance = ( subdivW.row( v0 ) - subdivW.row( v1 ) ).squaredNorm();
 
             maxWeightDistance = std::max( maxWeightDistance, weightDistance );
-            if ( weightDistance > wEps2 ) { edgesToSplit.push_back( *e_it ); }
+            if ( weightDistance > wEps2 ) { edgesToSplit.emplace_back( weightDistance, *e_it ); }
         }
         LOG( logDEBUG ) << "Max weight distance is " << sqrt( maxWeightDistance );
 
         // sort edges to split according to growing weightDistance to avoid
         // creating edges larger than weightDistance
-        std::sort(
-            edgesToSplit.begin(),
-            edgesToSplit.end(),
-            [&topoMesh, &subdivW]( const auto& a, const auto& b ) {
-                const auto& a0 = topoMesh.to_vertex_handle( topoMesh.halfedge_handle( a, 0 ) );
-                const auto& a1 = topoMesh.to_vertex_handle( topoMesh.halfedge_handle( a, 1 ) );
-                Scalar la = ( subdivW.row( a0.idx() ) - subdivW.row( a1.idx() ) ).squaredNorm();
-                const auto& b0 = topoMesh.to_vertex_handle( topoMesh.halfedge_handle( b, 0 ) );
-                const auto& b1 = topoMesh.to_vertex_handle( topoMesh.halfedge_handle( b, 1 ) );
-                Scalar lb = ( subdivW.row( b0.idx() ) - subdivW.row( b1.idx() ) ).squaredNorm();
-                return ( la > lb );
-            } );
+        std::sort( edgesToSplit.begin(),
+                   edgesToSplit.end(),
+                   []( const auto& a, const auto& b ) { return a.first > b.first; } );
 
         // We found some edges over the limit, so we split them.
         if ( !edgesToSplit.empty() ) {
             LOG( logDEBUG ) << "Splitting " << edgesToSplit.size() << " edges";
             int startIndex = subdivW.rows();
 
-            Eigen::SparseMatrix<Scalar, Eigen::RowMajor> newWeights(
-                startIndex + edgesToSplit.size(), numCols );
+            RowMajorWeights newWeights( startIndex + edgesToSplit.size(), numCols );
 
             newWeights.topRows( startIndex ) = subdivW;
             subdivW                          = newWeights;
 
             int i = 0;
             // Split ALL the edges !
-            for ( const auto& edge : edgesToSplit ) {
+            for ( const auto& e : edgesToSplit ) {
+                const auto& edge = e.second;
                 int v0 = topoMesh.to_vertex_handle( topoMesh.halfedge_handle( edge, 0 ) ).idx();
                 int v1 = topoMesh.to_vertex_handle( topoMesh.halfedge_handle( edge, 1 ) ).idx();
 
@@ -156,17 +319,35 @@ void computeCoR( SkinningRefData& dataInOut, Scalar sigma, Scalar weightEpsilon
     // Second step : evaluate the integrals over all triangles for all vertices.
     //
 
-    // naive implementation : iterate over all the triangles (of the subdivided mesh)
-    // for all vertices (of the original mesh).
+    // The similarity of a vertex and a face is zero unless they share at least two handles, so
+    // faces are clustered by their influencing handles and only the clusters sharing two handles
+    // with a vertex are visited.
+    // Within a cluster, faces whose weights fall in the same weightEpsilon cell are merged in a
+    // single integral (summed area and area weighted centroid and weights), which is within the
+    // tolerance the subdivision step already allows between adjacent vertices.
     const uint nVerts = V.size();
     dataInOut.m_CoR.clear();
     dataInOut.m_CoR.resize( nVerts, Vector3::Zero() );
 
-    // first precompute triangle data
-    std::map<Geometry::TopologicalMesh::FaceHandle,
-             std::tuple<Vector3, Scalar, Eigen::SparseVector<Scalar>>>
-        triangleData;
-    for ( auto f_it = topoMesh.faces_begin(); f_it != topoMesh.faces_end(); ++f_it ) {
+    std::vector<CompactWeights> vertexWeights( subdivW.rows() );
+#pragma omp parallel for
+    for ( int i = 0; i < int( subdivW.rows() ); ++i ) {
+        vertexWeights[i] = compactWeights( subdivW, i );
+    }
+
+    struct CellHash {
+        size_t operator()( const std::vector<int>& cell ) const {
+            size_t seed = 0;
+            for ( auto c : cell )
+                hash_combine( seed, c );
+            return seed;
+        }
+    };
+    std::map<std::vector<uint>, size_t> clusterIndex;
+    std::vector<FaceCluster> clusters;
+    std::vector<std::unordered_map<std::vector<int>, size_t, CellHash>> cells;
+    size_t nFaces = 0;
+    for ( auto f_it = topoMesh.faces_begin(); f_it != topoMesh.faces_end(); ++f_it, ++nFaces ) {
         // get needed data
         const auto& he0        = topoMesh.halfedge_handle( *f_it );
         const auto& he1        = topoMesh.next_halfedge_handle( he0 );
@@ -179,36 +360,90 @@ void computeCoR( SkinningRefData& dataInOut, Scalar sigma, Scalar weightEpsilon
         const auto& p2         = topoMesh.point( v2 );
         const Vector3 centroid = ( p0 + p1 + p2 ) / 3.f;
         const Scalar area      = ( ( ( p1 - p0 ).cross( p2 - p0 ) ).norm() * 0.5 );
-        const Eigen::SparseVector<Scalar> triWeight =
+        const Eigen::SparseVector<Scalar> sparseWeight =
             ( 1 / 3.f ) *
             ( subdivW.row( v0.idx() ) + subdivW.row( v1.idx() ) + subdivW.row( v2.idx() ) );
-        triangleData[*f_it] = std::make_tuple( centroid, area, triWeight );
+        CompactWeights triWeight;
+        for ( Eigen::SparseVector<Scalar>::InnerIterator it( sparseWeight ); it; ++it ) {
+            if ( it.value() > 0 ) triWeight.emplace_back( uint( it.index() ), it.value() );
+        }
+        if ( triWeight.size() < 2 || area <= 0 ) continue;
+
+        std::vector<uint> handles;
+        std::vector<int> cell;
+        for ( const auto& w : triWeight ) {
+            handles.push_back( w.first );
+            cell.push_back( weightEpsilon > 0 ? int( std::floor( w.second / weightEpsilon ) )
+                                              : int( nFaces ) );
+        }
+        auto clusterIt = clusterIndex.find( handles );
+        if ( clusterIt == clusterIndex.end() ) {
+            clusterIt = clusterIndex.emplace( handles, clusters.size() ).first;
+            clusters.push_back( { handles, {} } );
+            cells.emplace_back();
+        }
+        auto& cluster = clusters[clusterIt->second];
+        auto cellIt   = cells[clusterIt->second].find( cell );
+        if ( cellIt == cells[clusterIt->second].end() ) {
+            cellIt = cells[clusterIt->second].emplace( cell, cluster.m_integrals.size() ).first;
+            cluster.m_integrals.emplace_back();
+            cluster.m_integrals.back().m_weights = triWeight;
+            for ( auto& w : cluster.m_integrals.back().m_weights )
+                w.second = 0;
+        }
+        auto& integral = cluster.m_integrals[cellIt->second];
+        integral.m_areaCentroid += area * centroid;
+        integral.m_area += area;
+        for ( size_t k = 0; k < triWeight.size(); ++k )
+            integral.m_weights[k].second += area * triWeight[k].second;
     }
+    size_t nIntegrals = 0;
+    for ( auto& cluster : clusters ) {
+        for ( auto& integral : cluster.m_integrals ) {
+            for ( auto& w : integral.m_weights )
+                w.second /= integral.m_area;
+        }
+        nIntegrals += cluster.m_integrals.size();
+    }
+    LOG( logDEBUG ) << "CoR: " << nFaces << " faces merged in " << nIntegrals << " integrals, "
+                    << clusters.size() << " clusters";
 
-#pragma omp parallel for
+#pragma omp parallel for schedule( dynamic, 64 )
     for ( int i = 0; i < int( nVerts ); ++i ) {
         Vector3 cor( 0, 0, 0 );
-        Scalar sumweight                     = 0;
-        const Eigen::SparseVector<Scalar> Wi = subdivW.row( mapV2I[V[i]] );
-
-        // Sum the cor and weights over all triangles of the subdivided mesh.
-        for ( auto f_it = topoMesh.faces_begin(); f_it != topoMesh.faces_end(); ++f_it ) {
-            const auto& triData     = triangleData[*f_it];
-            const Vector3& centroid = std::get<0>( triData );
-            Scalar area             = std::get<1>( triData );
-            const auto& triWeight   = std::get<2>( triData );
-            const Scalar s          = weightSimilarity( Wi, triWeight, sigma );
-            cor += s * area * centroid;
-            sumweight += s * area;
+        Scalar sumweight = 0;
+        const auto& Wi   = vertexWeights[mapV2I.at( V[i] )];
+        if ( Wi.size() < 2 ) continue;
+
+        // Sum the cor and weights over all the face integrals that may contribute.
+        for ( const auto& cluster : clusters ) {
+            if ( commonHandles( Wi, cluster.m_handles ) < 2 ) continue;
+            for ( const auto& integral : cluster.m_integrals ) {
+                const Scalar s = weightSimilarity( Wi, integral.m_weights, sigma );
+                cor += s * integral.m_areaCentroid;
+                sumweight += s * integral.m_area;
+            }
         }
 
         // Avoid division by 0
         if ( sumweight > 0 ) { dataInOut.m_CoR[i] = cor / sumweight; }
+    }
+}
 
-#if defined CORE_DEBUG
-        if ( i % 100 == 0 ) { LOG( logDEBUG ) << "CoR: " << i << " / " << nVerts; }
-#endif // CORE_DEBUG
+void computeCoR( SkinningRefData& dataInOut,
+                 Scalar sigma,
+                 Scalar weightEpsilon,
+                 const std::string& cacheDirectory ) {
+    const std::string file =
+        corCacheFile( cacheDirectory, hashCoRInputs( dataInOut, sigma, weightEpsilon ) );
+    std::error_code error;
+    std::filesystem::create_directories( cacheDirectory, error );
+    if ( loadCoR( file, dataInOut.m_referenceMesh.vertices().size(), dataInOut.m_CoR ) ) {
+        LOG( logDEBUG ) << "CoR loaded from " << file;
+        return;
     }
+    computeCoR( dataInOut, sigma, weightEpsilon );
+    saveCoR( file, dataInOut.m_CoR );
 }
 
 void centerOfRotationSkinning( const SkinningRefData& refData,
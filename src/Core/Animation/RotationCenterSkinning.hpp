@@ -4,6 +4,9 @@
 #include <Core/CoreMacros.hpp>
 #include <Core/RaCore.hpp>
 
+#include <cstdint>
+#include <string>
+
 namespace Ra {
 namespace Core {
 namespace Animation {
@@ -31,6 +34,10 @@ struct SkinningFrameData;
  * and \f$\mathbf{v}_t = \frac{1}{3}(\mathbf{p}_{t_0}+\mathbf{p}_{t_1}+\mathbf{p}_{t_2})\f$
  * , \f$t_j\f$ being the \f$j\f$-th vertex of triangle \f$t\f$ and \f$\mathcal{A}_t\f$ its area.
  *
+ * Triangles are clustered by influencing handles, and only the clusters sharing two handles
+ * with a vertex contribute (the similarity is zero otherwise). Within a cluster, triangles whose
+ * weights are closer than weightEpsilon are integrated together.
+ *
  * \note Parallelized loop inside (using openmp).
  */
 // clang-format on
@@ -38,6 +45,27 @@ void RA_CORE_API computeCoR( SkinningRefData& dataInOut,
                              Scalar sigma         = 0.1_ra,
                              Scalar weightEpsilon = 0.1_ra );
 
+/**
+ * \brief Same as computeCoR, with a disk cache.
+ *
+ * The centers of rotation are loaded from \p cacheDirectory if they have already been computed
+ * for the same mesh, weights and parameters (see hashCoRInputs), and are saved there otherwise.
+ * The directory is created if needed, e.g. Resources::getCachePath().
+ * Cache files are written to a temporary file renamed once complete, and are checked against
+ * their size and checksum when loaded, invalid ones being recomputed.
+ */
+void RA_CORE_API computeCoR( SkinningRefData& dataInOut,
+                             Scalar sigma,
+                             Scalar weightEpsilon,
+                             const std::string& cacheDirectory );
+
+/// Return the hash of the reference mesh, weights and parameters used to compute the centers of
+/// rotation, which is the key of the CoR disk cache.
+/// \note The hash (64 bits FNV-1a) is stable across runs and platforms of the same endianness.
+uint64_t RA_CORE_API hashCoRInputs( const SkinningRefData& data,
+                                    Scalar sigma,
+                                    Scalar weightEpsilon );
+
 // clang-format off
 /**
  * \brief Applies Center-of-Rotation skinning to the current frame.
@@ -2,21 +2,67 @@
 #include <Core/Math/LinearAlgebra.hpp> // Math::clamp
 
 #include <algorithm>
+#include <atomic>
 #include <stack>
 
 namespace Ra {
 namespace Core {
 namespace Animation {
 
+namespace {
+/// Pose versions are unique among all the skeletons.
+uint64_t nextPoseVersion() {
+    static std::atomic<uint64_t> version { 0 };
+    return ++version;
+}
+} // namespace
+
 /// CONSTRUCTOR
-Skeleton::Skeleton() : HandleArray(), m_graph(), m_modelSpace() {}
+Skeleton::Skeleton() :
+    HandleArray(), m_graph(), m_modelSpace(), m_poseVersion( nextPoseVersion() ) {}
 
-Skeleton::Skeleton( const uint n ) : HandleArray( n ), m_graph( n ), m_modelSpace( n ) {}
+Skeleton::Skeleton( const uint n ) :
+    HandleArray( n ), m_graph( n ), m_modelSpace( n ), m_poseVersion( nextPoseVersion() ) {}
 
 void Skeleton::clear() {
     m_pose.clear();
     m_graph.clear();
     m_modelSpace.clear();
+    m_order.clear();
+    touchPose();
+}
+
+void Skeleton::touchPose() {
+    m_poseVersion = nextPoseVersion();
+}
+
+void Skeleton::updateTopology() {
+    if ( m_order.size() == size() ) return;
+    const uint n = size();
+    m_order.clear();
+    m_order.reserve( n );
+    m_subtreeEnd.assign( n, 0 );
+    m_position.assign( n, 0 );
+    // iterative depth-first traversal, the stack holds (bone, visited)
+    std::stack<std::pair<uint, bool>> stack;
+    for ( uint r = n; r-- > 0; ) {
+        if ( m_graph.isRoot( r ) ) stack.emplace( r, false );
+    }
+    while ( !stack.empty() ) {
+        const auto [bone, visited] = stack.top();
+        stack.pop();
+        if ( visited ) {
+            m_subtreeEnd[m_position[bone]] = uint( m_order.size() );
+            continue;
+        }
+        m_position[bone] = uint( m_order.size() );
+        m_order.push_back( bone );
+        stack.emplace( bone, true );
+        const auto& children = m_graph.children()[bone];
+        for ( auto it = children.rbegin(); it != children.rend(); ++it )
+            stack.emplace( *it, false );
+    }
+    CORE_ASSERT( m_order.size() == n, "Invalid skeleton hierarchy." );
 }
 
 const Pose& Skeleton::getPose( const SpaceType MODE ) const {
@@ -30,24 +76,24 @@ void Skeleton::setPose( const Pose& pose, const SpaceType MODE ) {
     CORE_ASSERT( ( size() == pose.size() ), "Size mismatching" );
     static_assert( std::is_same<bool, typename std::underlying_type<SpaceType>::type>::value,
                    "SpaceType is not a boolean" );
+    touchPose();
+    const auto& parents = m_graph.parents();
     if ( MODE == SpaceType::LOCAL ) {
+        updateTopology();
         m_pose = pose;
         m_modelSpace.resize( m_pose.size() );
-        for ( uint i = 0; i < m_graph.size(); ++i ) {
-            if ( m_graph.isRoot( i ) ) { m_modelSpace[i] = m_pose[i]; }
-            for ( const auto& child : m_graph.children()[i] ) {
-                m_modelSpace[child] = m_modelSpace[i] * m_pose[child];
-            }
+        for ( const uint i : m_order ) {
+            const int p     = parents[i];
+            m_modelSpace[i] = p < 0 ? m_pose[i] : m_modelSpace[p] * m_pose[i];
         }
     }
     else {
+        // bones are independent
         m_modelSpace = pose;
         m_pose.resize( m_modelSpace.size() );
-        for ( uint i = 0; i < m_graph.size(); ++i ) {
-            if ( m_graph.isRoot( i ) ) { m_pose[i] = m_modelSpace[i]; }
-            for ( const auto& child : m_graph.children()[i] ) {
-                m_pose[child] = m_modelSpace[i].inverse() * m_modelSpace[child];
-            }
+        for ( uint i = 0; i < size(); ++i ) {
+            const int p = parents[i];
+            m_pose[i] = p < 0 ? m_modelSpace[i] : m_modelSpace[p].inverse() * m_modelSpace[i];
         }
     }
 }
@@ -102,39 +148,31 @@ void Skeleton::setTransform( const uint i, const Transform& T, const SpaceType M
 }
 
 void Skeleton::setLocalTransform( const uint i, const Transform& T ) {
+    touchPose();
+    updateTopology();
     m_pose[i] = T;
-    // Compute the model space pose
-    if ( m_graph.isRoot( i ) ) { m_modelSpace[i] = m_pose[i]; }
-    else { m_modelSpace[i] = m_modelSpace[m_graph.parents()[i]] * T; }
-    if ( !m_graph.isLeaf( i ) ) {
-        std::stack<uint> stack;
-        stack.push( i );
-        while ( !stack.empty() ) {
-            uint parent = stack.top();
-            stack.pop();
-            for ( const auto& child : m_graph.children()[parent] ) {
-                m_modelSpace[child] = m_modelSpace[parent] * m_pose[child];
-                stack.push( child );
-            }
-        }
+    // Compute the model space pose of the subtree
+    const auto& parents = m_graph.parents();
+    const uint begin    = m_position[i];
+    const uint end      = m_subtreeEnd[begin];
+    for ( uint k = begin; k < end; ++k ) {
+        const uint b    = m_order[k];
+        const int p     = parents[b];
+        m_modelSpace[b] = p < 0 ? m_pose[b] : m_modelSpace[p] * m_pose[b];
     }
 }
 
 void Skeleton::setModelTransform( const uint i, const Transform& T ) {
+    touchPose();
     m_modelSpace[i] = T;
     // Compute the local space pose
     if ( m_graph.isRoot( i ) ) { m_pose[i] = m_modelSpace[i]; }
     else { m_pose[i] = m_modelSpace[m_graph.parents()[i]].inverse() * T; }
+    // only the children local transforms depend on the model transform of bone i
     if ( !m_graph.isLeaf( i ) ) {
-        std::stack<uint> stack;
-        stack.push( i );
-        while ( !stack.empty() ) {
-            uint parent = stack.top();
-            stack.pop();
-            for ( const auto& child : m_graph.children()[parent] ) {
-                m_pose[child] = m_modelSpace[parent].inverse() * m_modelSpace[child];
-                stack.push( child );
-            }
+        const Transform inverse = T.inverse();
+        for ( const auto& child : m_graph.children()[i] ) {
+            m_pose[child] = inverse * m_modelSpace[child];
         }
     }
 }
@@ -143,6 +181,8 @@ uint Skeleton::addRoot( const Transform& T, const Label label ) {
     m_pose.push_back( T );
     m_modelSpace.push_back( T );
     m_label.push_back( label );
+    m_order.clear();
+    touchPose();
     return m_graph.addRoot();
 }
 
@@ -161,6 +201,8 @@ uint Skeleton::addBone( const uint parent,
         m_pose.push_back( m_modelSpace[parent].inverse() * T );
     }
     m_label.push_back( label );
+    m_order.clear();
+    touchPose();
     return m_graph.addNode( parent );
 }
 
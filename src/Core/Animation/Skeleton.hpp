@@ -6,8 +6,10 @@
 #include <Core/CoreMacros.hpp>
 #include <Core/RaCore.hpp>
 #include <Core/Types.hpp>
+#include <cstdint>
 #include <iosfwd>
 #include <memory>
+#include <vector>
 
 namespace Ra {
 namespace Core {
@@ -26,6 +28,13 @@ namespace Animation {
  * During the editing of the transformation of a skeleton bone, the transformations
  * of all the bones are updated accroding to the Manipulation scheme
  * (cf Ra::Core:Animation::Skeleton::Manipulation).
+ *
+ * The hierarchy is compiled into a depth-first ordering of the bones, so that local to model
+ * space conversions are a single linear pass over the pose, and editing a bone only updates
+ * the contiguous range of its descendants.
+ *
+ * Each modification of the pose gives it a new version number (see getPoseVersion()), so that
+ * users of the skeleton can detect pose changes without comparing poses.
  */
 class RA_CORE_API Skeleton : public HandleArray
 {
@@ -89,6 +98,13 @@ class RA_CORE_API Skeleton : public HandleArray
     /// Projects point \p pos, given in Model Space, onto the bone with index \p boneIdx.
     Vector3 projectOnBone( uint boneIdx, const Vector3& pos ) const;
 
+    /**
+     * Return the version of the pose, which changes each time the pose is modified.
+     * Versions are unique among all the skeletons, copies keeping the version of the original.
+     * \note Setting a pose equal to the current one still changes the version.
+     */
+    inline uint64_t getPoseVersion() const { return m_poseVersion; }
+
     /// Stream insertion operator.
     friend std::ostream& operator<<( std::ostream& os, const Skeleton& skeleton );
 
@@ -102,11 +118,17 @@ class RA_CORE_API Skeleton : public HandleArray
 
     /**
      * Sets the \p i-th transform to T, given in Model space.
-     * \note Updates the Local-space transform of the descendants.
+     * \note Updates the Local-space transform of the children.
      * \note This method keeps the Model-space transforms of the descendants untouched.
      */
     void setModelTransform( uint i, const Transform& T );
 
+    /// Compile the hierarchy into m_order and m_subtreeEnd if the graph has changed.
+    void updateTopology();
+
+    /// Give a new version to the pose.
+    void touchPose();
+
   public:
     /// The Joint hierarchy.
     AdjacencyList m_graph;
@@ -117,6 +139,16 @@ class RA_CORE_API Skeleton : public HandleArray
   protected:
     /// Skeleton pose in MODEL space.
     ModelPose m_modelSpace;
+
+    /// Bone indices in depth-first order: bones come after their parent, and the descendants
+    /// of bone m_order[k] are the bones m_order[k+1 .. m_subtreeEnd[k]-1].
+    std::vector<uint> m_order;
+    std::vector<uint> m_subtreeEnd;
+    /// Position of each bone in m_order.
+    std::vector<uint> m_position;
+
+    /// Version of the pose.
+    uint64_t m_poseVersion;
 };
 
 } // namespace Animation
@@ -1,6 +1,8 @@
 #pragma once
 
+#include <Core/Animation/CageDeformation.hpp>
 #include <Core/Animation/HandleWeight.hpp>
+#include <Core/Animation/PackedSkinningWeights.hpp>
 #include <Core/Animation/Pose.hpp>
 #include <Core/Animation/Skeleton.hpp>
 #include <Core/Geometry/TriangleMesh.hpp>
@@ -27,11 +29,18 @@ struct SkinningRefData {
     /// The matrix of skinning weights.
     WeightMatrix m_weights;
 
+    /// The optional packed skinning weights, built from m_weights.
+    /// When set for the reference mesh, LBS and DQS use the vertex-major kernels.
+    PackedSkinningWeights m_packedWeights;
+
     /// The optionnal centers of rotations for CoR skinning.
     Vector3Array m_CoR;
 
     /// The optional matrix of weights for STBS skinning.
     WeightMatrix m_weightSTBS;
+
+    /// The optional cage coordinates of the reference mesh vertices for cage deformation.
+    CageWeights m_cageWeights;
 };
 
 /// \brief Pose data for one frame.
@@ -12,6 +12,40 @@ AnimationData::AnimationData( const std::string& name ) :
 
 AnimationData::~AnimationData() {}
 
+Core::Animation::CompressedAnimation AnimationData::compress(
+    const Core::Animation::CompressedAnimation::Tolerances& tolerances ) const {
+    if ( m_clip ) { return *m_clip; }
+    std::vector<Core::Animation::KeyFramedValue<Transform>> channels;
+    std::vector<std::string> names;
+    channels.reserve( m_keyFrame.size() );
+    names.reserve( m_keyFrame.size() );
+    for ( const auto& handle : m_keyFrame ) {
+        channels.push_back( handle.m_anim );
+        names.push_back( handle.m_name );
+    }
+    return Core::Animation::CompressedAnimation( channels, names, tolerances );
+}
+
+std::vector<HandleAnimation> AnimationData::getHandleData() const {
+    if ( !m_clip ) { return m_keyFrame; }
+    const uint size = m_clip->getChannelCount();
+    std::vector<HandleAnimation> frameList( size );
+#pragma omp parallel for
+    for ( int i = 0; i < int( size ); ++i ) {
+        auto& handle           = frameList[i];
+        handle.m_name          = m_clip->getChannelName( i );
+        handle.m_anim          = m_clip->getChannel( i );
+        const auto& keyFrames  = handle.m_anim.getKeyFrames();
+        handle.m_animationTime = AnimationTime( keyFrames.front().first, keyFrames.back().first );
+    }
+    return frameList;
+}
+
+void AnimationData::setHandleData( Core::Animation::CompressedAnimation clip ) {
+    m_keyFrame.clear();
+    m_clip = std::make_shared<const Core::Animation::CompressedAnimation>( std::move( clip ) );
+}
+
 } // namespace Asset
 } // namespace Core
 } // namespace Ra
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <Core/Animation/CompressedAnimation.hpp>
 #include <Core/Animation/KeyFramedValue.hpp>
 #include <Core/Asset/AnimationTime.hpp>
 #include <Core/Asset/AssetData.hpp>
@@ -33,6 +34,20 @@ struct RA_CORE_API HandleAnimation {
     AnimationTime m_animationTime;
 };
 
+/**
+ * A MorphAnimation stores the animated blendshape weights of a mesh.
+ */
+struct RA_CORE_API MorphAnimation {
+    /// The animated mesh's name.
+    std::string m_meshName;
+
+    /// The keyframed weights, one per blendshape of the mesh.
+    std::vector<Core::Animation::KeyFramedValue<Scalar>> m_weights;
+
+    /// The AnimationTime for the weights.
+    AnimationTime m_animationTime;
+};
+
 /**
  * The AnimationData class stores all the HandleAnimation related to an
  * animation of an object, one per animation Handle.
@@ -80,17 +95,54 @@ class RA_CORE_API AnimationData : public AssetData
     /**
      * \returns the number of HandleAnimations.
      */
-    inline uint getFramesSize() const { return m_keyFrame.size(); }
+    inline uint getFramesSize() const;
 
     /**
      * \returns the list of HandleAnimations, i.e. the whole animation frames.
+     * \note If the animation is stored as a compressed clip, the clip is decompressed.
      */
-    inline std::vector<HandleAnimation> getHandleData() const { return m_keyFrame; }
+    std::vector<HandleAnimation> getHandleData() const;
 
     /**
      * Sets the animation frames.
      */
     inline void setHandleData( const std::vector<HandleAnimation>& frameList );
+
+    /**
+     * \returns the compressed animation frames.
+     * \note An animation already stored as a compressed clip is returned as is.
+     */
+    Core::Animation::CompressedAnimation
+    compress( const Core::Animation::CompressedAnimation::Tolerances& tolerances = {} ) const;
+
+    /**
+     * Sets the animation frames from the compressed clip \p clip, which is kept compressed.
+     */
+    void setHandleData( Core::Animation::CompressedAnimation clip );
+
+    /**
+     * \returns the compressed clip of the animation, nullptr if the animation frames are
+     * HandleAnimations.
+     */
+    inline const std::shared_ptr<const Core::Animation::CompressedAnimation>& getClip() const {
+        return m_clip;
+    }
+    /// \}
+
+    /// \name Blendshape weights
+    /// \{
+
+    /**
+     * \returns the list of MorphAnimations, one per animated mesh.
+     */
+    inline const std::vector<MorphAnimation>& getMorphData() const { return m_morph; }
+
+    /**
+     * Sets the animated blendshape weights.
+     */
+    inline void setMorphData( std::vector<MorphAnimation> morphList ) {
+        m_morph = std::move( morphList );
+    }
     /// \}
 
     /**
@@ -107,9 +159,20 @@ class RA_CORE_API AnimationData : public AssetData
 
     /// The animation frames.
     std::vector<HandleAnimation> m_keyFrame;
+
+    /// The compressed animation frames, used instead of m_keyFrame if not null.
+    std::shared_ptr<const Core::Animation::CompressedAnimation> m_clip;
+
+    /// The animated blendshape weights.
+    std::vector<MorphAnimation> m_morph;
 };
 
+inline uint AnimationData::getFramesSize() const {
+    return m_clip ? m_clip->getChannelCount() : m_keyFrame.size();
+}
+
 inline void AnimationData::setHandleData( const std::vector<HandleAnimation>& frameList ) {
+    m_clip.reset();
     const uint size = frameList.size();
     m_keyFrame.resize( size );
 #pragma omp parallel for
@@ -125,7 +188,9 @@ inline void AnimationData::displayInfo() const {
     LOG( logDEBUG ) << " Start Time        : " << m_time.getStart();
     LOG( logDEBUG ) << " End   Time        : " << m_time.getEnd();
     LOG( logDEBUG ) << " Time Step         : " << m_dt;
-    LOG( logDEBUG ) << " Animated Object # : " << m_keyFrame.size();
+    LOG( logDEBUG ) << " Animated Object # : " << getFramesSize();
+    LOG( logDEBUG ) << " Compressed        : " << ( m_clip ? "YES" : "NO" );
+    LOG( logDEBUG ) << " Animated Mesh #   : " << m_morph.size();
 }
 
 } // namespace Asset
@@ -72,6 +72,7 @@ void GeometryData::displayInfo() const {
     LOG( logINFO ) << " Tex.Coord. ?   : " << hasAttrib( MeshAttrib::VERTEX_TEXCOORD );
     LOG( logINFO ) << " Color ?        : " << hasAttrib( MeshAttrib::VERTEX_COLOR );
     LOG( logINFO ) << " Material ?     : " << ( ( !hasMaterial() ) ? "NO" : "YES" );
+    LOG( logINFO ) << " Blendshape #   : " << m_blendShapes.size();
 
     if ( hasMaterial() ) { m_material->displayInfo(); }
 }
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <Core/Animation/BlendShapes.hpp>
 #include <Core/Asset/AssetData.hpp>
 #include <Core/Asset/MaterialData.hpp>
 #include <Core/Containers/VectorArray.hpp>
@@ -126,6 +127,12 @@ class RA_CORE_API GeometryData : public AssetData
     /// Return the number of primitives in the geometry data
     inline int getPrimitiveCount() const;
 
+    /// Return the blendshapes (morph targets) of the object.
+    inline const std::vector<Animation::BlendShape>& getBlendShapes() const;
+
+    /// Set the blendshapes (morph targets) of the object.
+    inline void setBlendShapes( std::vector<Animation::BlendShape> blendShapes );
+
     /// \}
 
     /// Print stast info to the Debug output.
@@ -146,6 +153,9 @@ class RA_CORE_API GeometryData : public AssetData
 
     /// The MaterialData for the object.
     std::shared_ptr<MaterialData> m_material;
+
+    /// The blendshapes of the object, as sparse deltas w.r.t. its vertex attributes.
+    std::vector<Animation::BlendShape> m_blendShapes;
 };
 
 inline void GeometryData::setName( const std::string& name ) {
@@ -248,6 +258,12 @@ inline void GeometryData::setPrimitiveCount( int n ) {
 inline int GeometryData::getPrimitiveCount() const {
     return m_primitiveCount;
 }
+inline const std::vector<Animation::BlendShape>& GeometryData::getBlendShapes() const {
+    return m_blendShapes;
+}
+inline void GeometryData::setBlendShapes( std::vector<Animation::BlendShape> blendShapes ) {
+    m_blendShapes = std::move( blendShapes );
+}
 
 } // namespace Asset
 } // namespace Core
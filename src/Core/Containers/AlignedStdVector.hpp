@@ -10,7 +10,9 @@ namespace Core {
 /// Shortcut for the ubiquitous aligned std::vector
 /// Uses Eigen's aligned allocator, as stated in
 /// http://eigen.tuxfamily.org/dox/group__TopicStlContainers.html
-template <typename T>
-using AlignedStdVector = std::vector<T, Eigen::aligned_allocator<T>>;
+/// The allocator can be changed, e.g. to FrameAllocator for per-frame temporaries, as long as it
+/// enforces the alignment of T.
+template <typename T, typename Allocator = Eigen::aligned_allocator<T>>
+using AlignedStdVector = std::vector<T, Allocator>;
 } // namespace Core
 } // namespace Ra
@@ -0,0 +1,97 @@
+#include <Core/Containers/FrameArena.hpp>
+#include <Core/CoreMacros.hpp>
+
+#include <atomic>
+
+namespace Ra {
+namespace Core {
+
+namespace {
+std::atomic<uint64_t> currentFrame { 0 };
+
+size_t roundUp( size_t size ) {
+    return ( size + FrameArena::s_granularity - 1 ) & ~( FrameArena::s_granularity - 1 );
+}
+} // namespace
+
+FrameArena::FrameArena( size_t chunkSize ) : m_chunkSize( chunkSize ) {}
+
+void* FrameArena::allocate( size_t size, size_t alignment ) {
+    CORE_ASSERT( alignment > 0 && ( alignment & ( alignment - 1 ) ) == 0,
+                 "Alignment must be a power of two." );
+    size = roundUp( size );
+    while ( m_current < m_chunks.size() ) {
+        const auto& chunk = m_chunks[m_current];
+        const auto base   = reinterpret_cast<std::uintptr_t>( chunk.m_begin );
+        const auto begin  = ( base + m_offset + alignment - 1 ) & ~std::uintptr_t( alignment - 1 );
+        if ( begin + size <= base + chunk.m_size ) {
+            m_usedSize += begin + size - ( base + m_offset );
+            m_offset = begin + size - base;
+            return reinterpret_cast<void*>( begin );
+        }
+        // the end of the chunk is lost until the next reset
+        ++m_current;
+        m_offset = 0;
+    }
+    addChunk( size + alignment );
+    return allocate( size, alignment );
+}
+
+void FrameArena::deallocate( void* p, size_t size ) {
+    size = roundUp( size );
+    if ( m_current < m_chunks.size() &&
+         static_cast<char*>( p ) + size == m_chunks[m_current].m_begin + m_offset ) {
+        m_offset -= size;
+        m_usedSize -= size;
+    }
+}
+
+void FrameArena::reset() {
+    if ( m_chunks.size() > 1 ) {
+        const size_t capacity = getCapacity();
+        m_chunks.clear();
+        addChunk( capacity );
+    }
+    m_current  = 0;
+    m_offset   = 0;
+    m_usedSize = 0;
+}
+
+size_t FrameArena::getCapacity() const {
+    size_t capacity = 0;
+    for ( const auto& chunk : m_chunks ) {
+        capacity += chunk.m_size;
+    }
+    return capacity;
+}
+
+void FrameArena::addChunk( size_t size ) {
+    size = roundUp( std::max( size, m_chunkSize ) );
+    std::unique_ptr<char[]> data( new char[size + s_granularity - 1] );
+    const auto begin = ( reinterpret_cast<std::uintptr_t>( data.get() ) + s_granularity - 1 ) &
+                       ~std::uintptr_t( s_granularity - 1 );
+    m_chunks.push_back( { std::move( data ), reinterpret_cast<char*>( begin ), size } );
+    m_current = m_chunks.size() - 1;
+    m_offset  = 0;
+}
+
+FrameArena& FrameArena::getThreadArena() {
+    thread_local FrameArena arena;
+    const auto frame = currentFrame.load( std::memory_order_acquire );
+    if ( arena.m_frame != frame ) {
+        arena.reset();
+        arena.m_frame = frame;
+    }
+    return arena;
+}
+
+void FrameArena::nextFrame() {
+    currentFrame.fetch_add( 1, std::memory_order_acq_rel );
+}
+
+uint64_t FrameArena::getFrame() {
+    return currentFrame.load( std::memory_order_acquire );
+}
+
+} // namespace Core
+} // namespace Ra
@@ -0,0 +1,151 @@
+#pragma once
+
+#include <Core/Containers/AlignedStdVector.hpp>
+#include <Core/Containers/VectorArray.hpp>
+#include <Core/RaCore.hpp>
+
+#include <Eigen/Core>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace Ra {
+namespace Core {
+
+/**
+ * \brief Monotonic memory arena for per-frame temporaries.
+ *
+ * Memory is allocated by bumping an offset in large chunks, and released all at once by reset().
+ * Deallocation only gives back the memory of the last allocation (e.g. when a vector grows).
+ * Sizes are rounded up to s_granularity, so that allocations released in reverse order give all
+ * their memory back, alignment included.
+ * Allocations are thus cheap, and do not contend with other threads on the global heap.
+ *
+ * Each thread has its own arena (see getThreadArena()), reset at its first access of each frame,
+ * frames being started by nextFrame() (called by Engine::RadiumEngine::endFrameSync()).
+ * Memory allocated from a thread arena is thus only valid during the current frame, and must only
+ * be allocated and released by the thread owning the arena (other threads, e.g. of a parallel
+ * loop, may access the allocated elements).
+ * As allocations released in reverse order give their memory back, functions may use frame
+ * containers for their temporaries even when no frame is ever started.
+ * \see FrameAllocator, FrameVector, FrameVectorArray
+ */
+class RA_CORE_API FrameArena
+{
+  public:
+    /// Create an arena allocating chunks of (at least) \p chunkSize bytes.
+    explicit FrameArena( size_t chunkSize = size_t( 1 ) << 20 );
+    FrameArena( const FrameArena& )            = delete;
+    FrameArena& operator=( const FrameArena& ) = delete;
+    ~FrameArena()                              = default;
+
+    /// Granularity of the allocations, and alignment of the chunks.
+    static constexpr size_t s_granularity =
+        std::max<size_t>( EIGEN_MAX_ALIGN_BYTES, alignof( std::max_align_t ) );
+
+    /// Allocate \p size bytes aligned on \p alignment, which must be a power of two.
+    void* allocate( size_t size, size_t alignment );
+
+    /// Give back the memory of \p p, only effective if \p p is the last allocation.
+    void deallocate( void* p, size_t size );
+
+    /// Release all the allocations. Chunks are kept for the next allocations, and merged in a
+    /// single chunk if several were needed.
+    void reset();
+
+    /// Return the number of bytes allocated since the last reset (including alignment padding).
+    size_t getUsedSize() const { return m_usedSize; }
+
+    /// Return the total size of the chunks.
+    size_t getCapacity() const;
+
+    /// Return the arena of the calling thread, reset if a frame started since its last access.
+    static FrameArena& getThreadArena();
+
+    /// Start a new frame, thread arenas being reset at their next access.
+    static void nextFrame();
+
+    /// Return the number of frames started by nextFrame().
+    static uint64_t getFrame();
+
+  private:
+    struct Chunk {
+        std::unique_ptr<char[]> m_data;
+        /// Beginning of m_data aligned on s_granularity.
+        char* m_begin;
+        size_t m_size;
+    };
+
+    /// Add a chunk able to store \p size bytes, and make it the current one.
+    void addChunk( size_t size );
+
+    std::vector<Chunk> m_chunks;
+    /// Current chunk and offset in it.
+    size_t m_current { 0 };
+    size_t m_offset { 0 };
+    size_t m_chunkSize;
+    size_t m_usedSize { 0 };
+    /// Frame of the last reset, for thread arenas.
+    uint64_t m_frame { 0 };
+};
+
+/**
+ * \brief Allocator using a FrameArena, by default the arena of the thread creating it.
+ *
+ * Memory is aligned as with Eigen::aligned_allocator, so that fixed size Eigen types can be stored.
+ * Containers using this allocator must not outlive the frame, nor be resized by other threads
+ * when using a thread arena.
+ */
+template <typename T>
+class FrameAllocator
+{
+  public:
+    using value_type = T;
+
+    /// Allocator using the arena of the calling thread.
+    FrameAllocator() : m_arena( &FrameArena::getThreadArena() ) {}
+
+    /// Allocator using \p arena.
+    explicit FrameAllocator( FrameArena& arena ) noexcept : m_arena( &arena ) {}
+
+    template <typename U>
+    FrameAllocator( const FrameAllocator<U>& other ) noexcept : m_arena( other.getArena() ) {}
+
+    T* allocate( std::size_t n ) {
+        return static_cast<T*>( m_arena->allocate( n * sizeof( T ), s_alignment ) );
+    }
+
+    void deallocate( T* p, std::size_t n ) noexcept { m_arena->deallocate( p, n * sizeof( T ) ); }
+
+    FrameArena* getArena() const noexcept { return m_arena; }
+
+    template <typename U>
+    bool operator==( const FrameAllocator<U>& other ) const noexcept {
+        return m_arena == other.getArena();
+    }
+
+    template <typename U>
+    bool operator!=( const FrameAllocator<U>& other ) const noexcept {
+        return m_arena != other.getArena();
+    }
+
+  private:
+    static constexpr std::size_t s_alignment =
+        std::max<std::size_t>( alignof( T ), EIGEN_MAX_ALIGN_BYTES );
+
+    FrameArena* m_arena;
+};
+
+/// AlignedStdVector allocated in the frame arena of the calling thread.
+template <typename T>
+using FrameVector = AlignedStdVector<T, FrameAllocator<T>>;
+
+/// VectorArray allocated in the frame arena of the calling thread.
+template <typename V>
+using FrameVectorArray = VectorArray<V, FrameAllocator<V>>;
+
+} // namespace Core
+} // namespace Ra
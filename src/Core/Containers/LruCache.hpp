@@ -0,0 +1,150 @@
+#pragma once
+
+#include <Core/RaCore.hpp>
+
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+
+namespace Ra {
+namespace Core {
+
+/**
+ * \brief Thread-safe key/value cache with a memory budget and least recently used eviction.
+ *
+ * Each value is weighted by its memory size, given by a size function. Inserting a value evicts
+ * the least recently used ones until the cache fits in the budget, values larger than the whole
+ * budget are not stored. Values are shared, so that they stay valid for their users once evicted.
+ *
+ * All the functions lock the cache, so that it can be filled by a background task while it is
+ * used by the main thread.
+ *
+ * \tparam Key the key type, must be hashable.
+ * \tparam Value the value type.
+ */
+template <typename Key, typename Value>
+class LruCache
+{
+  public:
+    using ValuePtr     = std::shared_ptr<const Value>;
+    using SizeFunction = std::function<size_t( const Value& )>;
+
+    /// Create a cache with the given memory budget (in bytes), the size of the values being
+    /// given by \p sizeFunction (sizeof(Value) by default).
+    explicit LruCache( size_t budget, SizeFunction sizeFunction = nullptr ) :
+        m_budget( budget ),
+        m_sizeFunction( sizeFunction ? std::move( sizeFunction )
+                                     : []( const Value& ) { return sizeof( Value ); } ) {}
+
+    LruCache( const LruCache& )            = delete;
+    LruCache& operator=( const LruCache& ) = delete;
+
+    /// Return the value stored for \p key, and mark it as the most recently used one, or nullptr
+    /// if the key is not in the cache.
+    ValuePtr get( const Key& key ) {
+        std::lock_guard<std::mutex> lock( m_mutex );
+        auto it = m_entries.find( key );
+        if ( it == m_entries.end() ) { return nullptr; }
+        m_order.splice( m_order.begin(), m_order, it->second );
+        return it->second->m_value;
+    }
+
+    /// Return true if \p key is in the cache, without changing the eviction order.
+    bool contains( const Key& key ) const {
+        std::lock_guard<std::mutex> lock( m_mutex );
+        return m_entries.find( key ) != m_entries.end();
+    }
+
+    /// Store \p value for \p key, replacing any previous value, and evict the least recently used
+    /// values to fit in the budget.
+    /// \returns false if the value is larger than the budget, and thus not stored.
+    bool insert( const Key& key, Value value ) {
+        const size_t size = m_sizeFunction( value );
+        auto ptr          = std::make_shared<const Value>( std::move( value ) );
+        std::lock_guard<std::mutex> lock( m_mutex );
+        eraseEntry( key );
+        if ( size > m_budget ) { return false; }
+        m_order.push_front( { key, std::move( ptr ), size } );
+        m_entries[key] = m_order.begin();
+        m_memorySize += size;
+        evict();
+        return true;
+    }
+
+    /// Remove \p key from the cache.
+    void erase( const Key& key ) {
+        std::lock_guard<std::mutex> lock( m_mutex );
+        eraseEntry( key );
+    }
+
+    /// Remove all the values.
+    void clear() {
+        std::lock_guard<std::mutex> lock( m_mutex );
+        m_entries.clear();
+        m_order.clear();
+        m_memorySize = 0;
+    }
+
+    /// Set the memory budget (in bytes), evicting values if needed.
+    void setBudget( size_t budget ) {
+        std::lock_guard<std::mutex> lock( m_mutex );
+        m_budget = budget;
+        evict();
+    }
+
+    /// Return the memory budget (in bytes).
+    size_t getBudget() const {
+        std::lock_guard<std::mutex> lock( m_mutex );
+        return m_budget;
+    }
+
+    /// Return the memory size (in bytes) of the stored values.
+    size_t getMemorySize() const {
+        std::lock_guard<std::mutex> lock( m_mutex );
+        return m_memorySize;
+    }
+
+    /// Return the number of stored values.
+    size_t size() const {
+        std::lock_guard<std::mutex> lock( m_mutex );
+        return m_entries.size();
+    }
+
+  private:
+    struct Entry {
+        Key m_key;
+        ValuePtr m_value;
+        size_t m_size;
+    };
+    using EntryList = std::list<Entry>;
+
+    void eraseEntry( const Key& key ) {
+        auto it = m_entries.find( key );
+        if ( it == m_entries.end() ) { return; }
+        m_memorySize -= it->second->m_size;
+        m_order.erase( it->second );
+        m_entries.erase( it );
+    }
+
+    void evict() {
+        while ( m_memorySize > m_budget && !m_order.empty() ) {
+            m_memorySize -= m_order.back().m_size;
+            m_entries.erase( m_order.back().m_key );
+            m_order.pop_back();
+        }
+    }
+
+    mutable std::mutex m_mutex;
+    size_t m_budget;
+    size_t m_memorySize { 0 };
+    SizeFunction m_sizeFunction;
+    /// Entries, from the most to the least recently used.
+    EntryList m_order;
+    std::unordered_map<Key, typename EntryList::iterator> m_entries;
+};
+
+} // namespace Core
+} // namespace Ra
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <Core/CoreMacros.hpp>
+#include <Core/RaCore.hpp>
+
+#include <algorithm>
+#include <array>
+#include <initializer_list>
+#include <vector>
+
+namespace Ra {
+namespace Core {
+
+/**
+ * \brief Vector with inline storage for its first \p N elements.
+ *
+ * As long as the size does not exceed \p N, no memory is allocated, which makes it well suited
+ * to the short per-element lists built in tight loops (e.g. the wedges around a vertex).
+ * Elements are moved to heap storage when the capacity is exceeded.
+ *
+ * \tparam T element type, must be default constructible.
+ * \tparam N number of inline elements.
+ */
+template <typename T, size_t N>
+class SmallVector
+{
+  public:
+    using value_type     = T;
+    using iterator       = T*;
+    using const_iterator = const T*;
+
+    SmallVector() = default;
+    SmallVector( std::initializer_list<T> init ) {
+        for ( const auto& v : init )
+            push_back( v );
+    }
+    SmallVector( const SmallVector& other ) { *this = other; }
+    SmallVector( SmallVector&& other ) noexcept { *this = std::move( other ); }
+
+    SmallVector& operator=( const SmallVector& other ) {
+        m_inline = other.m_inline;
+        m_heap   = other.m_heap;
+        m_size   = other.m_size;
+        return *this;
+    }
+    SmallVector& operator=( SmallVector&& other ) noexcept {
+        m_inline     = std::move( other.m_inline );
+        m_heap       = std::move( other.m_heap );
+        m_size       = other.m_size;
+        other.m_size = 0;
+        other.m_heap.clear();
+        return *this;
+    }
+
+    size_t size() const { return m_size; }
+    bool empty() const { return m_size == 0; }
+    /// Return true if the elements are stored inline.
+    bool isInline() const { return m_size <= N; }
+
+    T* data() { return isInline() ? m_inline.data() : m_heap.data(); }
+    const T* data() const { return isInline() ? m_inline.data() : m_heap.data(); }
+
+    iterator begin() { return data(); }
+    iterator end() { return data() + m_size; }
+    const_iterator begin() const { return data(); }
+    const_iterator end() const { return data() + m_size; }
+
+    T& operator[]( size_t i ) {
+        CORE_ASSERT( i < m_size, "SmallVector: out of bound access" );
+        return data()[i];
+    }
+    const T& operator[]( size_t i ) const {
+        CORE_ASSERT( i < m_size, "SmallVector: out of bound access" );
+        return data()[i];
+    }
+
+    void push_back( const T& v ) {
+        if ( m_size < N ) { m_inline[m_size] = v; }
+        else {
+            // switch to heap storage
+            if ( m_size == N ) {
+                m_heap.reserve( 2 * N );
+                m_heap.assign( m_inline.begin(), m_inline.end() );
+            }
+            m_heap.push_back( v );
+        }
+        ++m_size;
+    }
+
+    /// Insert \p v at \p pos, shifting the following elements.
+    iterator insert( const_iterator pos, const T& v ) {
+        const size_t i = size_t( pos - begin() );
+        push_back( v );
+        std::rotate( begin() + i, end() - 1, end() );
+        return begin() + i;
+    }
+
+    void clear() {
+        m_heap.clear();
+        m_size = 0;
+    }
+
+  private:
+    std::array<T, N> m_inline {};
+    std::vector<T> m_heap;
+    size_t m_size { 0 };
+};
+
+} // namespace Core
+} // namespace Ra
@@ -24,6 +24,7 @@ auto VariableSet::operator=( const VariableSet& other ) -> VariableSet& {
     m_variables              = other.m_variables;
     m_typeIndexToVtableIndex = other.m_typeIndexToVtableIndex;
     m_storedType             = other.m_storedType;
+    ++m_layoutVersion;
     return *this;
 }
 
@@ -31,11 +32,14 @@ auto VariableSet::operator=( VariableSet&& other ) noexcept -> VariableSet& {
     m_variables              = std::move( other.m_variables );
     m_typeIndexToVtableIndex = std::move( other.m_typeIndexToVtableIndex );
     m_storedType             = std::move( other.m_storedType );
+    ++m_layoutVersion;
+    ++other.m_layoutVersion;
     return *this;
 }
 
 void VariableSet::clear() {
     m_variables.clear();
+    ++m_layoutVersion;
 }
 
 void VariableSet::mergeKeepVariables( const VariableSet& from ) {
@@ -43,6 +47,7 @@ void VariableSet::mergeKeepVariables( const VariableSet& from ) {
         const auto& index = from.m_typeIndexToVtableIndex.at( type );
         from.m_vtable->m_mergeKeepFunctions[index]( from, *this );
     }
+    ++m_layoutVersion;
 }
 
 void VariableSet::mergeReplaceVariables( const VariableSet& from ) {
@@ -50,6 +55,7 @@ void VariableSet::mergeReplaceVariables( const VariableSet& from ) {
         const auto& index = from.m_typeIndexToVtableIndex.at( type );
         from.m_vtable->m_mergeReplaceFunctions[index]( from, *this );
     }
+    ++m_layoutVersion;
 }
 
 size_t VariableSet::size() const {
@@ -169,6 +169,15 @@ class RA_CORE_API VariableSet
     /// \return constant vector of type_index
     auto getStoredTypes() const -> const std::vector<std::type_index>& { return m_storedType; }
 
+    /// \brief Gets the version of the layout of the container.
+    /// The layout version changes each time a variable is inserted or removed, or a reference
+    /// variable (std::reference_wrapper) is set, but not when the value of a variable is modified.
+    /// References to the stored values obtained for a given layout version are thus valid as long
+    /// as the layout version is unchanged.
+    /// \note Modifications done through the containers returned by getAllVariables() are not
+    /// tracked.
+    size_t getLayoutVersion() const { return m_layoutVersion; }
+
     /// \}
     // ------------------------------------------------------------------------------------------
     // Per variable operations
@@ -482,6 +491,8 @@ class RA_CORE_API VariableSet
     std::unordered_map<std::type_index, size_t> m_typeIndexToVtableIndex;
     /// cache for m_variables keys, could be removed by c++ 20 range view
     std::vector<std::type_index> m_storedType;
+    /// \see getLayoutVersion
+    size_t m_layoutVersion { 0 };
 
     /// \brief Initialize an empty storage for variables of type T
     /// \tparam T
@@ -525,6 +536,7 @@ void VariableSet::removeVariableStorage() {
     auto type = std::type_index { typeid( T ) };
     m_variables.erase( type );
     m_typeIndexToVtableIndex.erase( type );
+    ++m_layoutVersion;
 
     auto newEnd = std::remove( m_storedType.begin(), m_storedType.end(), type );
     m_storedType.erase( newEnd, m_storedType.end() );
@@ -540,7 +552,9 @@ auto VariableSet::insertVariable( const std::string& name, const T& value )
     // If it is the first parameter of the given type, first register the type
     if ( !typeAccess ) { typeAccess = addVariableType<T>(); }
     // insert the parameter.
-    return ( *typeAccess )->insert( { name, value } );
+    auto inserted = ( *typeAccess )->insert( { name, value } );
+    if ( inserted.second ) { ++m_layoutVersion; }
+    return inserted;
 }
 
 template <typename T>
@@ -572,14 +586,17 @@ auto VariableSet::setVariable( const std::string& name, const T& value )
     // If it is the first parameter of the given type, first register the type
     if ( !typeAccess ) { typeAccess = addVariableType<T>(); }
     // insert the parameter.
-
-    return ( *typeAccess )->insert_or_assign( name, value );
+    auto inserted = ( *typeAccess )->insert_or_assign( name, value );
+    // re-targeting a reference changes the layout, as the referenced value moves
+    if ( inserted.second || !std::is_same_v<unwrap_t<T>, T> ) { ++m_layoutVersion; }
+    return inserted;
 }
 
 template <typename T>
 bool VariableSet::deleteVariable( const std::string& name ) {
     if ( auto typeAccess = existsVariableType<T>(); typeAccess ) {
         auto removed = ( *typeAccess )->erase( name );
+        if ( removed > 0 ) { ++m_layoutVersion; }
         // remove the type related function when the container has no more data of this type
         if ( numberOf<T>() == 0 ) { deleteAllVariables<T>(); }
         return removed > 0;
@@ -29,9 +29,11 @@ struct VectorArrayTypeHelper : public VectorArrayTypeHelperInternal<
  * \brief This class implements ContainerIntrospectionInterface for AlignedStdVector.
  *
  * It provides Eigen::Map functionality if the underlying component allows it (i.e. fixed size).
+ * \tparam Allocator the allocator of the storage, must enforce the alignment of V.
  */
-template <typename V>
-class VectorArray : public AlignedStdVector<V>, public Utils::ContainerIntrospectionInterface
+template <typename V, typename Allocator = Eigen::aligned_allocator<V>>
+class VectorArray : public AlignedStdVector<V, Allocator>,
+                    public Utils::ContainerIntrospectionInterface
 {
   private:
     using TypeHelper = VectorArrayTypeHelper<V>;
@@ -49,7 +51,7 @@ class VectorArray : public AlignedStdVector<V>, public Utils::ContainerIntrospec
     using ConstMatrixMap = Eigen::Map<const Matrix>;
 
     /** Inheriting constructors from std::vector */
-    using AlignedStdVector<V>::AlignedStdVector;
+    using AlignedStdVector<V, Allocator>::AlignedStdVector;
 
     /** \name Container Introsection implementation */
     /// \{
@@ -89,30 +91,30 @@ template <typename V>
 struct VectorArrayTypeHelperInternal<V, true, false> {
     using component_type                    = V; // arithmetic types are component types
     static constexpr int NumberOfComponents = 1;
-    static inline component_type* getData( VectorArray<V>* v ) { return v->data(); }
-    static inline const component_type* getConstData( const VectorArray<V>* v ) {
-        return v->data();
-    }
+    template <typename Array>
+    static inline component_type* getData( Array* v ) { return v->data(); }
+    template <typename Array>
+    static inline const component_type* getConstData( const Array* v ) { return v->data(); }
 };
 
 template <typename V>
 struct VectorArrayTypeHelperInternal<V, false, true> {
     using component_type                    = typename V::Scalar;   // use eigen scalar as component
     static constexpr int NumberOfComponents = V::RowsAtCompileTime; // i.e. -1 for dynamic size
-    static inline component_type* getData( VectorArray<V>* v ) { return v->data()->data(); }
-    static inline const component_type* getConstData( const VectorArray<V>* v ) {
-        return v->data()->data();
-    }
+    template <typename Array>
+    static inline component_type* getData( Array* v ) { return v->data()->data(); }
+    template <typename Array>
+    static inline const component_type* getConstData( const Array* v ) { return v->data()->data(); }
 };
 
 template <typename V>
 struct VectorArrayTypeHelperInternal<V, false, false> {
     using component_type                    = V;
     static constexpr int NumberOfComponents = 0; // no component for other types, i.e. not mappable
-    static inline component_type* getData( VectorArray<V>* v ) { return v->data(); }
-    static inline const component_type* getConstData( const VectorArray<V>* v ) {
-        return v->data();
-    }
+    template <typename Array>
+    static inline component_type* getData( Array* v ) { return v->data(); }
+    template <typename Array>
+    static inline const component_type* getConstData( const Array* v ) { return v->data(); }
 };
 
 // Convenience aliases
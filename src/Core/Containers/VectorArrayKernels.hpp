@@ -0,0 +1,289 @@
+#pragma once
+
+#include <Core/Containers/VectorArray.hpp>
+#include <Core/CoreMacros.hpp>
+#include <Core/RaCore.hpp>
+#include <Core/Types.hpp>
+#include <Core/Utils/Attribs.hpp>
+
+#include <algorithm>
+#include <vector>
+
+namespace Ra {
+namespace Core {
+/**
+ * Bulk map/reduce operations on VectorArray and Utils::Attrib.
+ *
+ * All the kernels work on the Eigen::Map of the arrays (VectorArray::getMap()), so that Eigen
+ * vectorizes the inner loops. The arrays are split in contiguous blocks of
+ * Kernels::BlockSize elements that are processed in parallel (using OpenMP when available).
+ *
+ * Attrib overloads take care of the write lock: the attrib must not be locked when calling them,
+ * and observers are notified once the kernel is done.
+ */
+namespace Kernels {
+
+/// Number of elements processed by a single task of the parallel kernels.
+/// Arrays smaller than this are processed sequentially.
+constexpr Eigen::Index BlockSize = 4096;
+
+/// Call \p f( begin, size ) on consecutive blocks covering [0, n), in parallel.
+template <typename BlockFunctor>
+inline void forEachBlock( Eigen::Index n, const BlockFunctor& f );
+
+/// \name Map kernels
+/// \{
+
+/// Apply \p f to each element of \p in and store the result in \p out.
+/// \p out is resized to \p in size. \p in and \p out may be the same array.
+template <typename V, typename Functor>
+inline void transform( const VectorArray<V>& in, VectorArray<V>& out, const Functor& f );
+
+/// Apply \p f to each element of \p inout.
+template <typename V, typename Functor>
+inline void transform( VectorArray<V>& inout, const Functor& f );
+
+/// Apply the affine transformation \p t to each point of \p points.
+inline void applyTransform( Vector3Array& points, const Transform& t );
+
+/// Apply the linear transformation \p m to each vector of \p vectors.
+inline void applyLinear( Vector3Array& vectors, const Matrix3& m );
+
+/// Transform \p normals with the normal matrix of \p t (i.e. the inverse transpose of its linear
+/// part), and normalize them.
+inline void applyNormalTransform( Vector3Array& normals, const Transform& t );
+
+/// Normalize each vector of \p vectors. Null vectors are left untouched.
+template <typename V>
+inline void normalize( VectorArray<V>& vectors );
+
+/// Store in \p out the linear interpolation \f$ (1-t) a + t b \f$ of \p a and \p b.
+/// \p out is resized to \p a size.
+/// \note \p a and \p b must have the same size.
+template <typename V>
+inline void lerp( const VectorArray<V>& a,
+                  const VectorArray<V>& b,
+                  Scalar t,
+                  VectorArray<V>& out );
+/// \}
+
+/// \name Reduce kernels
+/// \{
+
+/// Return the component-wise minimum of \p in.
+/// \warning \p in must not be empty.
+template <typename V>
+inline Eigen::Matrix<typename VectorArray<V>::component_type, VectorArray<V>::NumberOfComponents, 1>
+minCoeffs( const VectorArray<V>& in );
+
+/// Return the component-wise maximum of \p in.
+/// \warning \p in must not be empty.
+template <typename V>
+inline Eigen::Matrix<typename VectorArray<V>::component_type, VectorArray<V>::NumberOfComponents, 1>
+maxCoeffs( const VectorArray<V>& in );
+
+/// Return the axis aligned bounding box of \p points (empty box if \p points is empty).
+inline Aabb computeAabb( const Vector3Array& points );
+
+/// \copydoc computeAabb( const Vector3Array& )
+/// Mapped content is read in place (see Utils::Attrib::setMappedData).
+inline Aabb computeAabb( const Utils::Attrib<Vector3>& points );
+/// \}
+
+/// \name Attrib overloads
+/// Lock the attrib, run the kernel on its data and unlock it (which notifies the observers).
+/// \{
+template <typename V, typename Functor>
+inline void transform( Utils::Attrib<V>& attrib, const Functor& f );
+inline void applyTransform( Utils::Attrib<Vector3>& points, const Transform& t );
+inline void applyLinear( Utils::Attrib<Vector3>& vectors, const Matrix3& m );
+inline void applyNormalTransform( Utils::Attrib<Vector3>& normals, const Transform& t );
+template <typename V>
+inline void normalize( Utils::Attrib<V>& vectors );
+/// \}
+
+/////////////////// Implementation ///////////////////
+
+template <typename BlockFunctor>
+void forEachBlock( Eigen::Index n, const BlockFunctor& f ) {
+    const int nBlocks = int( ( n + BlockSize - 1 ) / BlockSize );
+#pragma omp parallel for if ( nBlocks > 1 )
+    for ( int b = 0; b < nBlocks; ++b ) {
+        const Eigen::Index begin = Eigen::Index( b ) * BlockSize;
+        f( begin, std::min( BlockSize, n - begin ) );
+    }
+}
+
+template <typename V, typename Functor>
+void transform( const VectorArray<V>& in, VectorArray<V>& out, const Functor& f ) {
+    out.resize( in.size() );
+    forEachBlock( Eigen::Index( in.size() ),
+                  [&in, &out, &f]( Eigen::Index begin, Eigen::Index size ) {
+                      for ( Eigen::Index i = begin; i < begin + size; ++i ) {
+                          out[i] = f( in[i] );
+                      }
+                  } );
+}
+
+template <typename V, typename Functor>
+void transform( VectorArray<V>& inout, const Functor& f ) {
+    transform( inout, inout, f );
+}
+
+void applyTransform( Vector3Array& points, const Transform& t ) {
+    if ( points.empty() ) return;
+    auto map             = points.getMap();
+    const Matrix3 linear = t.linear();
+    const Vector3 trans  = t.translation();
+    forEachBlock( map.cols(), [&map, &linear, &trans]( Eigen::Index begin, Eigen::Index size ) {
+        auto block = map.middleCols( begin, size );
+        block      = ( linear * block ).colwise() + trans;
+    } );
+}
+
+void applyLinear( Vector3Array& vectors, const Matrix3& m ) {
+    if ( vectors.empty() ) return;
+    auto map = vectors.getMap();
+    forEachBlock( map.cols(), [&map, &m]( Eigen::Index begin, Eigen::Index size ) {
+        auto block = map.middleCols( begin, size );
+        block      = m * block;
+    } );
+}
+
+void applyNormalTransform( Vector3Array& normals, const Transform& t ) {
+    if ( normals.empty() ) return;
+    auto map                   = normals.getMap();
+    const Matrix3 normalMatrix = t.linear().inverse().transpose();
+    forEachBlock( map.cols(), [&map, &normalMatrix]( Eigen::Index begin, Eigen::Index size ) {
+        auto block = map.middleCols( begin, size );
+        block            = normalMatrix * block;
+        const auto norms = block.colwise().norm().eval();
+        block.array().rowwise() /= ( norms.array() > 0_ra ).select( norms.array(), 1_ra );
+    } );
+}
+
+template <typename V>
+void normalize( VectorArray<V>& vectors ) {
+    static_assert( VectorArray<V>::NumberOfComponents > 1,
+                   "normalize requires fixed size vector elements" );
+    if ( vectors.empty() ) return;
+    using Component = typename VectorArray<V>::component_type;
+    auto map        = vectors.getMap();
+    forEachBlock( map.cols(), [&map]( Eigen::Index begin, Eigen::Index size ) {
+        auto block = map.middleCols( begin, size );
+        // unlike Vector::normalize(), colwise().normalize() does not check for null vectors.
+        const auto norms = block.colwise().norm().eval();
+        block.array().rowwise() /= ( norms.array() > Component( 0 ) ).select( norms.array(), 1 );
+    } );
+}
+
+template <typename V>
+void lerp( const VectorArray<V>& a, const VectorArray<V>& b, Scalar t, VectorArray<V>& out ) {
+    CORE_ASSERT( a.size() == b.size(), "lerp: arrays must have the same size" );
+    out.resize( a.size() );
+    if ( a.empty() ) return;
+    const auto mapA = a.getMap();
+    const auto mapB = b.getMap();
+    auto mapOut     = out.getMap();
+    using Component = typename VectorArray<V>::component_type;
+    const Component s( t );
+    forEachBlock( mapA.cols(), [&]( Eigen::Index begin, Eigen::Index size ) {
+        const auto blockA = mapA.middleCols( begin, size );
+        const auto blockB = mapB.middleCols( begin, size );
+        mapOut.middleCols( begin, size ) = blockA + s * ( blockB - blockA );
+    } );
+}
+
+namespace internal {
+/// Per-block reduction of the columns of \p map followed by a sequential reduction of the partial
+/// results.
+template <typename Map, typename BlockReduce, typename Reduce>
+inline Eigen::Matrix<typename Map::Scalar, Map::RowsAtCompileTime, 1>
+reduceCoeffs( const Map& map, const BlockReduce& blockReduce, const Reduce& reduce ) {
+    using Result      = Eigen::Matrix<typename Map::Scalar, Map::RowsAtCompileTime, 1>;
+    const int nBlocks = int( ( map.cols() + BlockSize - 1 ) / BlockSize );
+    AlignedStdVector<Result> partial( nBlocks );
+    forEachBlock( map.cols(), [&]( Eigen::Index begin, Eigen::Index size ) {
+        partial[begin / BlockSize] = blockReduce( map.middleCols( begin, size ) );
+    } );
+    Result res = partial[0];
+    for ( int b = 1; b < nBlocks; ++b ) {
+        res = reduce( res, partial[b] );
+    }
+    return res;
+}
+
+template <typename Map>
+inline Eigen::Matrix<typename Map::Scalar, Map::RowsAtCompileTime, 1>
+minCoeffs( const Map& map ) {
+    return reduceCoeffs(
+        map,
+        []( const auto& block ) { return block.rowwise().minCoeff().eval(); },
+        []( const auto& a, const auto& b ) { return a.cwiseMin( b ).eval(); } );
+}
+
+template <typename Map>
+inline Eigen::Matrix<typename Map::Scalar, Map::RowsAtCompileTime, 1>
+maxCoeffs( const Map& map ) {
+    return reduceCoeffs(
+        map,
+        []( const auto& block ) { return block.rowwise().maxCoeff().eval(); },
+        []( const auto& a, const auto& b ) { return a.cwiseMax( b ).eval(); } );
+}
+} // namespace internal
+
+template <typename V>
+Eigen::Matrix<typename VectorArray<V>::component_type, VectorArray<V>::NumberOfComponents, 1>
+minCoeffs( const VectorArray<V>& in ) {
+    CORE_ASSERT( !in.empty(), "Cannot reduce an empty array" );
+    return internal::minCoeffs( in.getMap() );
+}
+
+template <typename V>
+Eigen::Matrix<typename VectorArray<V>::component_type, VectorArray<V>::NumberOfComponents, 1>
+maxCoeffs( const VectorArray<V>& in ) {
+    CORE_ASSERT( !in.empty(), "Cannot reduce an empty array" );
+    return internal::maxCoeffs( in.getMap() );
+}
+
+Aabb computeAabb( const Vector3Array& points ) {
+    if ( points.empty() ) return Aabb {};
+    return Aabb { minCoeffs( points ), maxCoeffs( points ) };
+}
+
+Aabb computeAabb( const Utils::Attrib<Vector3>& points ) {
+    if ( points.getSize() == 0 ) return Aabb {};
+    const auto map = points.getMap();
+    return Aabb { internal::minCoeffs( map ), internal::maxCoeffs( map ) };
+}
+
+template <typename V, typename Functor>
+void transform( Utils::Attrib<V>& attrib, const Functor& f ) {
+    transform( attrib.getDataWithLock(), f );
+    attrib.unlock();
+}
+
+void applyTransform( Utils::Attrib<Vector3>& points, const Transform& t ) {
+    applyTransform( points.getDataWithLock(), t );
+    points.unlock();
+}
+
+void applyLinear( Utils::Attrib<Vector3>& vectors, const Matrix3& m ) {
+    applyLinear( vectors.getDataWithLock(), m );
+    vectors.unlock();
+}
+
+void applyNormalTransform( Utils::Attrib<Vector3>& normals, const Transform& t ) {
+    applyNormalTransform( normals.getDataWithLock(), t );
+    normals.unlock();
+}
+
+template <typename V>
+void normalize( Utils::Attrib<V>& vectors ) {
+    normalize( vectors.getDataWithLock() );
+    vectors.unlock();
+}
+
+} // namespace Kernels
+} // namespace Core
+} // namespace Ra
@@ -27,7 +27,7 @@ MultiIndexedGeometry& MultiIndexedGeometry::operator=( const MultiIndexedGeometr
     invalidateAabb();
     AttribArrayGeometry::operator=( other );
     deepCopy( other );
-    notify();
+    notifyChange();
     return *this;
 }
 
@@ -35,7 +35,7 @@ MultiIndexedGeometry& MultiIndexedGeometry::operator=( MultiIndexedGeometry&& ot
     invalidateAabb();
     AttribArrayGeometry::operator=( std::move( other ) );
     m_indices = std::move( other.m_indices );
-    notify();
+    notifyChange();
     return *this;
 }
 
@@ -43,14 +43,38 @@ void MultiIndexedGeometry::clear() {
     invalidateAabb();
     AttribArrayGeometry::clear();
     deepClear();
-    notify();
+    notifyChange();
 }
 
 void MultiIndexedGeometry::copy( const MultiIndexedGeometry& other ) {
     invalidateAabb();
     AttribArrayGeometry::copyBaseGeometry( other );
     deepCopy( other );
-    notify();
+    notifyChange();
+}
+
+void MultiIndexedGeometry::beginNotificationBatch() {
+    ++m_notificationBatchDepth;
+    vertexAttribs().beginNotificationBatch();
+}
+
+void MultiIndexedGeometry::endNotificationBatch() {
+    CORE_ASSERT( m_notificationBatchDepth > 0, "no notification batch to end" );
+    vertexAttribs().endNotificationBatch();
+    if ( --m_notificationBatchDepth == 0 ) { flushNotifications(); }
+}
+
+void MultiIndexedGeometry::flushNotifications() {
+    vertexAttribs().flushNotifications();
+    if ( m_notificationPending ) {
+        m_notificationPending = false;
+        notify();
+    }
+}
+
+void MultiIndexedGeometry::notifyChange() {
+    if ( m_notificationBatchDepth > 0 ) { m_notificationPending = true; }
+    else { notify(); }
 }
 
 /// \todo Implement MultiIndexedGeometry::checkConsistency
@@ -64,6 +88,7 @@ bool MultiIndexedGeometry::append( const MultiIndexedGeometry& other ) {
         {
             m_indices[key] = std::make_pair(
                 value.first, std::unique_ptr<GeometryIndexLayerBase> { value.second->clone() } );
+            m_indices[key].second->setMemoryCategory( vertexAttribs().getMemoryCategory() );
 
             dataHasBeenCopied = true;
         }
@@ -79,7 +104,7 @@ bool MultiIndexedGeometry::append( const MultiIndexedGeometry& other ) {
 
     if ( dataHasBeenCopied ) {
         invalidateAabb();
-        notify();
+        notifyChange();
     }
     return true;
 }
@@ -182,7 +207,8 @@ void MultiIndexedGeometry::unlockFirstLayerOccurrence( const LayerSemantic& sema
         if ( key.first.find( semanticName ) != key.first.end() ) {
             CORE_ASSERT( value.first, "try to release unlocked layer" );
             value.first = false;
-            notify();
+            value.second->updateMemoryUsage();
+            notifyChange();
             return;
         }
     }
@@ -194,7 +220,8 @@ void MultiIndexedGeometry::unlockFirstLayerOccurrence( const LayerSemanticCollec
         if ( key.first == semantics ) {
             CORE_ASSERT( value.first, "try to release unlocked layer" );
             value.first = false;
-            notify();
+            value.second->updateMemoryUsage();
+            notifyChange();
             return;
         }
     }
@@ -205,7 +232,8 @@ void MultiIndexedGeometry::unlockLayer( const LayerKeyType& layerKey ) {
     auto& p = m_indices.at( layerKey );
     CORE_ASSERT( p.first, "try to release unlocked layer" );
     p.first = false;
-    notify();
+    p.second->updateMemoryUsage();
+    notifyChange();
 }
 
 //////////////////////////////////////////////////////////////////////
@@ -218,7 +246,11 @@ MultiIndexedGeometry::addLayer( std::unique_ptr<GeometryIndexLayerBase>&& layer,
     LayerKeyType key { layer->semantics(), layerName };
     std::pair<LayerKeyType, EntryType> elt { key, std::make_pair( false, std::move( layer ) ) };
     auto [pos, inserted] = m_indices.insert( std::move( elt ) );
-    notify();
+    if ( inserted ) {
+        pos->second.second->setMemoryCategory( vertexAttribs().getMemoryCategory() );
+        pos->second.second->updateMemoryUsage();
+    }
+    notifyChange();
 
     if ( withLock ) {
         CORE_ASSERT( !pos->second.first, "try to get already locked layer" );
@@ -236,6 +268,21 @@ void MultiIndexedGeometry::deepCopy( const MultiIndexedGeometry& other ) {
     for ( const auto& [key, value] : other.m_indices ) {
         m_indices[key] = std::make_pair(
             value.first, std::unique_ptr<GeometryIndexLayerBase> { value.second->clone() } );
+        m_indices[key].second->setMemoryCategory( vertexAttribs().getMemoryCategory() );
+    }
+}
+
+void MultiIndexedGeometry::setMemoryCategory( Utils::MemoryCategory category ) {
+    AttribArrayGeometry::setMemoryCategory( category );
+    for ( auto& [key, value] : m_indices ) {
+        value.second->setMemoryCategory( category );
+    }
+}
+
+void MultiIndexedGeometry::addMemoryUsage( Utils::MemoryUsage& usage ) const {
+    AttribArrayGeometry::addMemoryUsage( usage );
+    for ( const auto& [key, value] : m_indices ) {
+        value.second->getTrackedMemory().addTo( usage );
     }
 }
 
@@ -264,6 +311,7 @@ void PointCloudIndexLayer::linearIndices( const AttribArrayGeometry& attr ) {
     auto nbVert = attr.vertices().size();
     collection().resize( nbVert );
     collection().getMap() = IndexContainerType::Matrix::LinSpaced( nbVert, 0, nbVert - 1 );
+    updateMemoryUsage();
 }
 
 } // namespace Geometry
@@ -3,6 +3,7 @@
 #include <Core/Containers/VectorArray.hpp>
 #include <Core/Geometry/TriangleMesh.hpp>
 #include <Core/Utils/ContainerIntrospectionInterface.hpp>
+#include <Core/Utils/MemoryAccounting.hpp>
 #include <Core/Utils/ObjectWithSemantic.hpp>
 #include <Core/Utils/StdMapIterators.hpp>
 
@@ -40,11 +41,28 @@ class RA_CORE_API GeometryIndexLayerBase : public Utils::ObservableVoid,
     /// \brief Compare if two layers have the same content
     virtual inline bool operator==( const GeometryIndexLayerBase& other ) const;
 
+    /// \brief Return the memory allocated for the indices, in bytes.
+    virtual size_t getMemorySize() const = 0;
+
+    /// \brief Set the category the memory of the indices is accounted in
+    /// (Utils::MemoryCategory::CpuAttributes by default).
+    void setMemoryCategory( Utils::MemoryCategory category ) { m_memory.setCategory( category ); }
+
+    /// \brief Return the accounted memory of the indices.
+    const Utils::TrackedMemory& getTrackedMemory() const { return m_memory; }
+
+    /// \brief Update the accounted memory, to be called when the indices may have been
+    /// reallocated.
+    void updateMemoryUsage() const { m_memory.set( getMemorySize() ); }
+
   protected:
     /// \brief Hidden constructor that must be called by inheriting classes to define the object
     ///        semantics.
     template <class... SemanticNames>
     inline GeometryIndexLayerBase( SemanticNames... names ) : ObjectWithSemantic( names... ) {}
+
+  private:
+    mutable Utils::TrackedMemory m_memory { Utils::MemoryCategory::CpuAttributes };
 };
 
 /// \brief Typed index collection
@@ -69,6 +87,8 @@ struct GeometryIndexLayer : public GeometryIndexLayerBase {
 
     inline size_t getBufferSize() const override final;
 
+    inline size_t getMemorySize() const override final;
+
     /// \warning it's meaningful only if the attrib do not contain heap
     /// allocated data.
     inline int getStride() const override final;
@@ -166,6 +186,12 @@ class RA_CORE_API MultiIndexedGeometry : public AttribArrayGeometry, public Util
     /// \return true if all fields have been copied
     bool append( const MultiIndexedGeometry& other );
 
+    /// Set the category the memory of the attributes and of the index layers is accounted in.
+    void setMemoryCategory( Utils::MemoryCategory category ) override;
+
+    /// Add the memory of the attributes and of the index layers to \p usage.
+    void addMemoryUsage( Utils::MemoryUsage& usage ) const override;
+
     //////////////////////////////////////////////////////////////////////
     //////////////////////////////////////////////////////////////////////
 
@@ -376,6 +402,33 @@ class RA_CORE_API MultiIndexedGeometry : public AttribArrayGeometry, public Util
     /// \snippet tests/unittest/Core/indexview.cpp Iterating over layer keys
     [[nodiscard]] inline auto layerKeys() const;
 
+    /// \name Notification batching
+    /// \{
+
+    /// \brief Batch the notifications of the geometry and of its vertex attribs until
+    /// endNotificationBatch().
+    ///
+    /// While batching, the observers of the geometry are notified at most once, when the batch
+    /// ends, and the vertex attribs are batched (see Utils::AttribManager::beginNotificationBatch).
+    /// Batches can be nested.
+    void beginNotificationBatch();
+
+    /// End the batch started by beginNotificationBatch(), notifying the pending changes.
+    void endNotificationBatch();
+
+    /// Notify the pending changes without ending the batch, e.g. at frame synchronization.
+    void flushNotifications();
+
+    /// Return a scope batching the notifications (see beginNotificationBatch()).
+    Utils::ScopedNotificationBatch<MultiIndexedGeometry> getScopedNotificationBatch() {
+        return Utils::ScopedNotificationBatch<MultiIndexedGeometry> { this };
+    }
+    /// \}
+
+  protected:
+    /// Notify the observers of a change, or record it while batching.
+    void notifyChange();
+
   private:
     /// \brief Duplicate attributes stored as pointers
     void deepCopy( const MultiIndexedGeometry& other );
@@ -395,6 +448,10 @@ class RA_CORE_API MultiIndexedGeometry : public AttribArrayGeometry, public Util
     /// require c++20, so we need to implement them explicitely here
     /// https://en.cppreference.com/w/cpp/container/unordered_map/find
     std::unordered_map<LayerKeyType, EntryType, KeyHash> m_indices;
+
+    /// Number of nested notification batches.
+    int m_notificationBatchDepth { 0 };
+    bool m_notificationPending { false };
 };
 
 /// \name Predefined index layers
@@ -601,6 +658,7 @@ inline bool GeometryIndexLayer<T>::append( const GeometryIndexLayerBase& other )
         const auto& othercasted = static_cast<const GeometryIndexLayer<T>&>( other );
         m_collection.insert(
             m_collection.end(), othercasted.collection().begin(), othercasted.collection().end() );
+        updateMemoryUsage();
         return true;
     }
     return false;
@@ -630,6 +688,11 @@ inline size_t GeometryIndexLayer<T>::getBufferSize() const {
     return m_collection.size() * sizeof( IndexType );
 }
 
+template <typename T>
+inline size_t GeometryIndexLayer<T>::getMemorySize() const {
+    return m_collection.capacity() * sizeof( IndexType );
+}
+
 template <typename T>
 inline int GeometryIndexLayer<T>::getStride() const {
     return sizeof( IndexType );
@@ -644,6 +707,8 @@ template <typename T>
 inline std::unique_ptr<GeometryIndexLayerBase> GeometryIndexLayer<T>::clone() {
     auto copy          = std::make_unique<GeometryIndexLayer<T>>( *this );
     copy->m_collection = m_collection;
+    copy->setMemoryCategory( getTrackedMemory().getCategory() );
+    copy->updateMemoryUsage();
     return copy;
 }
 
@@ -762,14 +827,16 @@ inline void IndexedGeometry<T>::setIndices( IndexContainerType&& indices ) {
     auto& abstractLayer = getLayerWithLock( m_mainIndexLayerKey );
     static_cast<IndexedGeometry<T>::DefaultLayerType&>( abstractLayer ).collection() =
         std::move( indices );
-    notify();
+    // release the lock, which also updates the accounted memory and notifies the change
+    unlockLayer( m_mainIndexLayerKey );
 }
 
 template <typename T>
 inline void IndexedGeometry<T>::setIndices( const IndexContainerType& indices ) {
     auto& abstractLayer = getLayerWithLock( m_mainIndexLayerKey );
     static_cast<IndexedGeometry<T>::DefaultLayerType&>( abstractLayer ).collection() = indices;
-    notify();
+    // release the lock, which also updates the accounted memory and notifies the change
+    unlockLayer( m_mainIndexLayerKey );
 }
 
 template <typename T>
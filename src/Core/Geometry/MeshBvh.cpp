@@ -0,0 +1,357 @@
+#include <Core/Geometry/MeshBvh.hpp>
+
+#include <Core/Containers/FrameArena.hpp>
+#include <Core/Geometry/DistanceQueries.hpp>
+#include <Core/Geometry/RayCast.hpp>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+
+namespace Ra {
+namespace Core {
+namespace Geometry {
+
+MeshBvh::MeshBvh( const TriangleMesh& mesh, int leafSize ) :
+    m_mesh( mesh ), m_leafSize( std::max( 1, leafSize ) ) {
+    const auto& vertices = m_mesh.vertices();
+    const auto& indices  = m_mesh.getIndices();
+    const int n          = int( indices.size() );
+    m_triangles.resize( indices.size() );
+    if ( n == 0 ) return;
+
+    Vector3Array centroids( indices.size() );
+#pragma omp parallel for
+    for ( int i = 0; i < n; ++i ) {
+        const auto& t  = indices[i];
+        centroids[i]   = ( vertices[t[0]] + vertices[t[1]] + vertices[t[2]] ) / 3_ra;
+        m_triangles[i] = uint( i );
+    }
+    // a binary tree with at least one triangle per leaf has less than 2n nodes.
+    m_nodes.reserve( 2 * indices.size() );
+    build( 0, n, centroids );
+    refit();
+}
+
+int MeshBvh::build( int begin, int end, const Vector3Array& centroids ) {
+    const int nodeIndex = int( m_nodes.size() );
+    m_nodes.emplace_back();
+    m_nodes[nodeIndex].m_begin = begin;
+    m_nodes[nodeIndex].m_count = end - begin;
+    if ( end - begin <= m_leafSize ) return nodeIndex;
+
+    // median split along the largest extent of the centroids
+    Aabb centroidBox;
+    for ( int i = begin; i < end; ++i )
+        centroidBox.extend( centroids[m_triangles[i]] );
+    int axis;
+    centroidBox.sizes().maxCoeff( &axis );
+    const int middle = begin + ( end - begin ) / 2;
+    std::nth_element( m_triangles.begin() + begin,
+                      m_triangles.begin() + middle,
+                      m_triangles.begin() + end,
+                      [&centroids, axis]( uint a, uint b ) {
+                          return centroids[a][axis] < centroids[b][axis];
+                      } );
+
+    // m_nodes may be reallocated by the recursive calls, do not keep references on nodes.
+    const int left              = build( begin, middle, centroids );
+    const int right             = build( middle, end, centroids );
+    m_nodes[nodeIndex].m_left  = left;
+    m_nodes[nodeIndex].m_right = right;
+    return nodeIndex;
+}
+
+Aabb MeshBvh::computeLeafAabb( const Node& node ) const {
+    const auto& vertices = m_mesh.vertices();
+    const auto& indices  = m_mesh.getIndices();
+    Aabb aabb;
+    for ( int i = node.m_begin; i < node.m_begin + node.m_count; ++i ) {
+        const auto& t = indices[m_triangles[i]];
+        aabb.extend( vertices[t[0]] );
+        aabb.extend( vertices[t[1]] );
+        aabb.extend( vertices[t[2]] );
+    }
+    return aabb;
+}
+
+void MeshBvh::refit() {
+    CORE_ASSERT( m_triangles.size() == m_mesh.getIndices().size(),
+                 "Mesh triangles have changed since the BVH construction" );
+    // leaves are independent
+#pragma omp parallel for
+    for ( int i = 0; i < int( m_nodes.size() ); ++i ) {
+        if ( m_nodes[i].isLeaf() ) m_nodes[i].m_aabb = computeLeafAabb( m_nodes[i] );
+    }
+    // children are after their parent
+    for ( int i = int( m_nodes.size() ) - 1; i >= 0; --i ) {
+        auto& node = m_nodes[i];
+        if ( !node.isLeaf() ) {
+            node.m_aabb = m_nodes[node.m_left].m_aabb.merged( m_nodes[node.m_right].m_aabb );
+        }
+    }
+}
+
+bool MeshBvh::contains( const Vector3& p ) const {
+    if ( m_nodes.empty() ) return false;
+    // a direction unlikely to be aligned with the mesh edges, hits on edges would count twice.
+    const Ray ray( p, Vector3 { 2_ra, 3_ra, 4_ra }.normalized() );
+    const auto& vertices = m_mesh.vertices();
+    const auto& indices  = m_mesh.getIndices();
+    FrameVector<Scalar> hits;
+    std::vector<int> stack { 0 };
+    while ( !stack.empty() ) {
+        const auto& node = m_nodes[stack.back()];
+        stack.pop_back();
+        Scalar t;
+        Vector3 n;
+        if ( !RayCastAabb( ray, node.m_aabb, t, n ) ) continue;
+        if ( !node.isLeaf() ) {
+            stack.push_back( node.m_left );
+            stack.push_back( node.m_right );
+            continue;
+        }
+        for ( int i = node.m_begin; i < node.m_begin + node.m_count; ++i ) {
+            const auto& tri = indices[m_triangles[i]];
+            RayCastTriangle( ray, vertices[tri[0]], vertices[tri[1]], vertices[tri[2]], hits );
+        }
+    }
+    return hits.size() % 2 == 1;
+}
+
+namespace {
+/// Minimal number of independent node pairs before starting the parallel traversal.
+constexpr size_t MinParallelTasks = 64;
+
+using NodePair = std::pair<int, int>;
+
+/// Bounding box of \p aabb transformed by \p t.
+inline Aabb transformedAabb( const Aabb& aabb, const Transform& t ) {
+    const Vector3 center  = t * aabb.center();
+    const Vector3 extents = t.linear().cwiseAbs() * ( aabb.sizes() / 2_ra );
+    return { center - extents, center + extents };
+}
+
+/// Traversal of the pairs of nodes of two BVHs, placed in world space.
+/// Node boxes and triangles are only transformed when the traversal reaches them, so that the
+/// cost of a query does not grow with the parts of the meshes that are pruned.
+class PairQuery
+{
+  public:
+    PairQuery( const MeshBvh& bvh1,
+               const Transform& t1,
+               const MeshBvh& bvh2,
+               const Transform& t2 ) :
+        m_bvh { &bvh1, &bvh2 }, m_transform { &t1, &t2 } {}
+
+    /// Return the node pairs to process independently, i.e. the node pairs at a depth of the
+    /// pair tree that gives enough parallelism. Pairs further than \p bound() are pruned.
+    template <typename Bound>
+    std::vector<NodePair> makeTasks( const Bound& bound ) const {
+        std::vector<NodePair> tasks;
+        if ( m_bvh[0]->getNodes().empty() || m_bvh[1]->getNodes().empty() ) return tasks;
+        if ( lowerBound( { 0, 0 } ) <= bound() ) tasks.push_back( { 0, 0 } );
+        bool expanded = true;
+        while ( expanded && !tasks.empty() && tasks.size() < MinParallelTasks ) {
+            std::vector<NodePair> next;
+            expanded = false;
+            for ( const auto& p : tasks ) {
+                if ( isLeafPair( p ) ) {
+                    next.push_back( p );
+                    continue;
+                }
+                expanded = true;
+                for ( const auto& c : children( p ) )
+                    if ( lowerBound( c ) <= bound() ) next.push_back( c );
+            }
+            tasks = std::move( next );
+        }
+        return tasks;
+    }
+
+    /// Depth first traversal of the pairs below \p root, closest pairs first.
+    /// \p leaves( triangle1, triangle2, distanceOutput ) is called on each triangle pair of the
+    /// leaf pairs closer than \p bound(). The traversal is interrupted when \p stop is true.
+    template <typename Bound, typename Leaves>
+    void descend( const NodePair& root,
+                  const Bound& bound,
+                  const Leaves& leaves,
+                  const std::atomic<bool>& stop ) const {
+        // pairs are stacked with their lower bound, computed once
+        std::vector<std::pair<NodePair, Scalar>> stack { { root, lowerBound( root ) } };
+        while ( !stack.empty() && !stop ) {
+            const auto [p, d] = stack.back();
+            stack.pop_back();
+            if ( d > bound() ) continue;
+            if ( isLeafPair( p ) ) {
+                forEachTrianglePair( p, leaves );
+                continue;
+            }
+            const auto c       = children( p );
+            const Scalar dc[2] = { lowerBound( c[0] ), lowerBound( c[1] ) };
+            const int first    = dc[0] < dc[1] ? 0 : 1;
+            stack.push_back( { c[1 - first], dc[1 - first] } );
+            stack.push_back( { c[first], dc[first] } );
+        }
+    }
+
+  private:
+    /// Bounding box of \p node of the mesh \p m, in world space.
+    Aabb worldAabb( int m, int node ) const {
+        return transformedAabb( m_bvh[m]->getNodes()[node].m_aabb, *m_transform[m] );
+    }
+
+    /// Lower bound of the squared distance between the triangles of two nodes.
+    Scalar lowerBound( const NodePair& p ) const {
+        return worldAabb( 0, p.first ).squaredExteriorDistance( worldAabb( 1, p.second ) );
+    }
+
+    bool isLeafPair( const NodePair& p ) const {
+        return m_bvh[0]->getNodes()[p.first].isLeaf() && m_bvh[1]->getNodes()[p.second].isLeaf();
+    }
+
+    /// Children pairs of \p p: the largest inner node is split.
+    std::array<NodePair, 2> children( const NodePair& p ) const {
+        const auto& n1    = m_bvh[0]->getNodes()[p.first];
+        const auto& n2    = m_bvh[1]->getNodes()[p.second];
+        const Scalar size1 = worldAabb( 0, p.first ).diagonal().squaredNorm();
+        const Scalar size2 = worldAabb( 1, p.second ).diagonal().squaredNorm();
+        const bool split1  = !n1.isLeaf() && ( n2.isLeaf() || size1 >= size2 );
+        if ( split1 ) return { { { n1.m_left, p.second }, { n1.m_right, p.second } } };
+        return { { { p.first, n2.m_left }, { p.first, n2.m_right } } };
+    }
+
+    template <typename Leaves>
+    void forEachTrianglePair( const NodePair& p, const Leaves& leaves ) const {
+        const auto& n1 = m_bvh[0]->getNodes()[p.first];
+        const auto& n2 = m_bvh[1]->getNodes()[p.second];
+        Vector3 a[3], b[3];
+        for ( int i = n1.m_begin; i < n1.m_begin + n1.m_count; ++i ) {
+            const uint t1 = m_bvh[0]->getTriangles()[i];
+            getTriangle( 0, t1, a );
+            for ( int j = n2.m_begin; j < n2.m_begin + n2.m_count; ++j ) {
+                const uint t2 = m_bvh[1]->getTriangles()[j];
+                getTriangle( 1, t2, b );
+                leaves( t1, t2, triangleToTriSq( a, b ) );
+            }
+        }
+    }
+
+    void getTriangle( int m, uint t, Vector3 out[3] ) const {
+        const auto& tri = m_bvh[m]->getMesh().getIndices()[t];
+        for ( int k = 0; k < 3; ++k )
+            out[k] = *m_transform[m] * m_bvh[m]->getMesh().vertices()[tri[k]];
+    }
+
+    const MeshBvh* m_bvh[2];
+    const Transform* m_transform[2];
+};
+
+/// Atomic min of a scalar.
+inline void atomicMin( std::atomic<Scalar>& a, Scalar v ) {
+    Scalar current = a.load();
+    while ( v < current && !a.compare_exchange_weak( current, v ) ) {}
+}
+} // namespace
+
+MeshToMeshOutput meshToMeshSq( const MeshBvh& bvh1,
+                               const Transform& t1,
+                               const MeshBvh& bvh2,
+                               const Transform& t2,
+                               Scalar maxSqrDistance ) {
+    const PairQuery query( bvh1, t1, bvh2, t2 );
+    // best distance found by any task, shared for pruning
+    std::atomic<Scalar> best { maxSqrDistance };
+    const std::atomic<bool> stop { false };
+    const auto bound = [&best]() { return best.load( std::memory_order_relaxed ); };
+
+    const auto tasks = query.makeTasks( bound );
+    std::vector<MeshToMeshOutput> results( tasks.size() );
+#pragma omp parallel for schedule( dynamic, 1 )
+    for ( int task = 0; task < int( tasks.size() ); ++task ) {
+        auto& res = results[task];
+        query.descend(
+            tasks[task],
+            bound,
+            [&res, &best]( uint tri1, uint tri2, const TriangleToTriangleOutput& out ) {
+                if ( out.sqrDistance < res.sqrDistance && out.sqrDistance <= best.load() ) {
+                    res.sqrDistance     = out.sqrDistance;
+                    res.triangles       = { tri1, tri2 };
+                    res.closestPoint[0] = out.closestPoint[0];
+                    res.closestPoint[1] = out.closestPoint[1];
+                    atomicMin( best, out.sqrDistance );
+                }
+            },
+            stop );
+    }
+
+    MeshToMeshOutput ret;
+    for ( const auto& res : results ) {
+        if ( res.sqrDistance < ret.sqrDistance ) ret = res;
+    }
+    return ret;
+}
+
+std::vector<TrianglePair> meshPairsWithin( const MeshBvh& bvh1,
+                                           const Transform& t1,
+                                           const MeshBvh& bvh2,
+                                           const Transform& t2,
+                                           Scalar epsilon ) {
+    const PairQuery query( bvh1, t1, bvh2, t2 );
+    const Scalar sqrEpsilon = epsilon * epsilon;
+    const std::atomic<bool> stop { false };
+    const auto bound = [sqrEpsilon]() { return sqrEpsilon; };
+
+    const auto tasks = query.makeTasks( bound );
+    std::vector<std::vector<TrianglePair>> results( tasks.size() );
+#pragma omp parallel for schedule( dynamic, 1 )
+    for ( int task = 0; task < int( tasks.size() ); ++task ) {
+        auto& res = results[task];
+        query.descend(
+            tasks[task],
+            bound,
+            [&res, sqrEpsilon]( uint tri1, uint tri2, const TriangleToTriangleOutput& out ) {
+                if ( out.sqrDistance <= sqrEpsilon ) res.emplace_back( tri1, tri2 );
+            },
+            stop );
+    }
+
+    std::vector<TrianglePair> ret;
+    for ( const auto& res : results )
+        ret.insert( ret.end(), res.begin(), res.end() );
+    std::sort( ret.begin(), ret.end() );
+    return ret;
+}
+
+bool meshesIntersect( const MeshBvh& bvh1,
+                      const Transform& t1,
+                      const MeshBvh& bvh2,
+                      const Transform& t2 ) {
+    const PairQuery query( bvh1, t1, bvh2, t2 );
+    std::atomic<bool> found { false };
+    const auto bound = []() { return 0_ra; };
+
+    const auto tasks = query.makeTasks( bound );
+#pragma omp parallel for schedule( dynamic, 1 )
+    for ( int task = 0; task < int( tasks.size() ); ++task ) {
+        // all tasks are interrupted as soon as an intersection is found
+        query.descend(
+            tasks[task],
+            bound,
+            [&found]( uint, uint, const TriangleToTriangleOutput& out ) {
+                if ( out.sqrDistance <= 0_ra ) found = true;
+            },
+            found );
+    }
+    if ( found ) return true;
+
+    // no surface contact, one mesh may still be inside the other.
+    if ( bvh1.getNodes().empty() || bvh2.getNodes().empty() ) return false;
+    const Vector3 p1 = t1 * bvh1.getMesh().vertices()[bvh1.getMesh().getIndices()[0][0]];
+    const Vector3 p2 = t2 * bvh2.getMesh().vertices()[bvh2.getMesh().getIndices()[0][0]];
+    return bvh1.contains( t1.inverse() * p2 ) || bvh2.contains( t2.inverse() * p1 );
+}
+
+} // namespace Geometry
+} // namespace Core
+} // namespace Ra
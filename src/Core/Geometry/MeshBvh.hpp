@@ -0,0 +1,115 @@
+#pragma once
+
+#include <Core/Geometry/IndexedGeometry.hpp>
+#include <Core/RaCore.hpp>
+#include <Core/Types.hpp>
+
+#include <limits>
+#include <vector>
+
+namespace Ra {
+namespace Core {
+namespace Geometry {
+
+/**
+ * \brief Bounding volume hierarchy over the triangles of a TriangleMesh.
+ *
+ * Nodes store axis aligned boxes in mesh space. Queries take a transform per mesh, and test the
+ * world space axis aligned boxes of the transformed node boxes, so that a BVH is built once and
+ * used for any rigid or affine placement of its mesh.
+ *
+ * The BVH keeps a reference to the mesh, which must outlive the BVH. When the mesh vertices move
+ * (e.g. deforming or skinned meshes) but the triangles do not change, call refit() instead of
+ * rebuilding the hierarchy.
+ */
+class RA_CORE_API MeshBvh
+{
+  public:
+    /// BVH node. Children of an inner node always have larger indices than the node.
+    struct Node {
+        /// Bounding box of the node triangles, in mesh space.
+        Aabb m_aabb;
+        /// Index of the children in the node array, -1 for leaves.
+        int m_left { -1 };
+        int m_right { -1 };
+        /// Range of the node triangles in getTriangles().
+        int m_begin { 0 };
+        int m_count { 0 };
+
+        bool isLeaf() const { return m_left < 0; }
+    };
+
+    /// Build the hierarchy of \p mesh, with at most \p leafSize triangles per leaf.
+    explicit MeshBvh( const TriangleMesh& mesh, int leafSize = 4 );
+
+    /// Update the node boxes from the current mesh vertices, the hierarchy is kept.
+    /// \note The mesh triangles must not have changed since construction.
+    void refit();
+
+    const TriangleMesh& getMesh() const { return m_mesh; }
+    const std::vector<Node>& getNodes() const { return m_nodes; }
+    /// Triangle indices, ordered so that each node covers a contiguous range.
+    const std::vector<uint>& getTriangles() const { return m_triangles; }
+
+    /// Return true if \p p, in mesh space, is inside the mesh, from the parity of the crossings
+    /// of a ray starting at \p p. The mesh must be closed.
+    bool contains( const Vector3& p ) const;
+
+  private:
+    int build( int begin, int end, const Vector3Array& centroids );
+    Aabb computeLeafAabb( const Node& node ) const;
+
+    const TriangleMesh& m_mesh;
+    int m_leafSize;
+    std::vector<Node> m_nodes;
+    std::vector<uint> m_triangles;
+};
+
+/// A pair of triangles, the first one in the first mesh of the query, the second one in the
+/// second mesh.
+using TrianglePair = std::pair<uint, uint>;
+
+/// Result of meshToMeshSq.
+struct MeshToMeshOutput {
+    /// Squared distance, max() if no triangle pair was closer than the query bound.
+    Scalar sqrDistance { std::numeric_limits<Scalar>::max() };
+    /// Closest triangles.
+    TrianglePair triangles { 0, 0 };
+    /// Closest points, in world space, on the first and second mesh.
+    Vector3 closestPoint[2];
+};
+
+/**
+ * Compute the squared distance between the meshes of \p bvh1 and \p bvh2 placed with \p t1 and
+ * \p t2.
+ * \param maxSqrDistance triangle pairs further than this bound are ignored, which speeds up the
+ * query when only close meshes matter.
+ */
+RA_CORE_API MeshToMeshOutput
+meshToMeshSq( const MeshBvh& bvh1,
+              const Transform& t1,
+              const MeshBvh& bvh2,
+              const Transform& t2,
+              Scalar maxSqrDistance = std::numeric_limits<Scalar>::max() );
+
+/**
+ * Return all the triangle pairs of the meshes of \p bvh1 and \p bvh2, placed with \p t1 and \p t2,
+ * that are at most \p epsilon apart (e.g. contact candidates). Pairs are sorted.
+ */
+RA_CORE_API std::vector<TrianglePair> meshPairsWithin( const MeshBvh& bvh1,
+                                                       const Transform& t1,
+                                                       const MeshBvh& bvh2,
+                                                       const Transform& t2,
+                                                       Scalar epsilon );
+
+/// Return true if the meshes of \p bvh1 and \p bvh2, placed with \p t1 and \p t2, intersect, i.e.
+/// some triangles are in contact or interpenetrate, or one mesh is inside the other.
+/// \note The inclusion test assumes closed meshes, see MeshBvh::contains().
+RA_CORE_API bool meshesIntersect( const MeshBvh& bvh1,
+                                  const Transform& t1,
+                                  const MeshBvh& bvh2,
+                                  const Transform& t2 );
+
+} // namespace Geometry
+} // namespace Core
+} // namespace Ra
@@ -0,0 +1,175 @@
+#include <Core/Geometry/NormalStencil.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+namespace Ra {
+namespace Core {
+namespace Geometry {
+
+NormalStencil::NormalStencil( const Vector3Array& positions,
+                              const VectorArray<Vector3ui>& triangles,
+                              const Vector3Array& normals,
+                              Weighting weighting ) :
+    m_weighting( weighting ), m_triangles( triangles ) {
+    const uint vertexCount = uint( positions.size() );
+
+    // find the duplicated vertices sharing their normal, each one is represented by the first
+    // one of its group.
+    std::vector<uint> representative( vertexCount );
+    std::iota( representative.begin(), representative.end(), 0 );
+    if ( normals.size() == positions.size() ) {
+        std::vector<uint> sorted( representative );
+        const auto less = [&positions]( uint a, uint b ) {
+            return std::lexicographical_compare( positions[a].data(),
+                                                 positions[a].data() + 3,
+                                                 positions[b].data(),
+                                                 positions[b].data() + 3 );
+        };
+        std::sort( sorted.begin(), sorted.end(), less );
+        for ( auto begin = sorted.begin(); begin != sorted.end(); ) {
+            auto end = std::find_if(
+                begin, sorted.end(), [&]( uint v ) { return positions[v] != positions[*begin]; } );
+            for ( auto it = begin + 1; it < end; ++it ) {
+                for ( auto other = begin; other < it; ++other ) {
+                    if ( normals[*it].isApprox( normals[*other] ) ) {
+                        representative[*it] = representative[*other];
+                        break;
+                    }
+                }
+            }
+            begin = end;
+        }
+    }
+
+    // corners of the representatives
+    std::vector<uint> sharedOffsets( vertexCount + 1, 0 );
+    for ( const auto& t : m_triangles ) {
+        for ( int c = 0; c < 3; ++c ) {
+            ++sharedOffsets[representative[t[c]] + 1];
+        }
+    }
+    std::partial_sum( sharedOffsets.begin(), sharedOffsets.end(), sharedOffsets.begin() );
+    std::vector<uint> sharedCorners( sharedOffsets.back() );
+    std::vector<uint> fill( sharedOffsets.begin(), sharedOffsets.end() - 1 );
+    for ( uint t = 0; t < m_triangles.size(); ++t ) {
+        for ( uint c = 0; c < 3; ++c ) {
+            sharedCorners[fill[representative[m_triangles[t][c]]]++] = 3 * t + c;
+        }
+    }
+
+    // each vertex gets the corners of its representative
+    m_offsets.resize( vertexCount + 1, 0 );
+    for ( uint v = 0; v < vertexCount; ++v ) {
+        const uint r     = representative[v];
+        m_offsets[v + 1] = m_offsets[v] + sharedOffsets[r + 1] - sharedOffsets[r];
+    }
+    m_corners.resize( m_offsets.back() );
+    for ( uint v = 0; v < vertexCount; ++v ) {
+        const uint r = representative[v];
+        std::copy( sharedCorners.begin() + sharedOffsets[r],
+                   sharedCorners.begin() + sharedOffsets[r + 1],
+                   m_corners.begin() + m_offsets[v] );
+    }
+
+    m_faceNormals.resize( m_triangles.size(), Vector3::Zero() );
+    if ( m_weighting == Weighting::ANGLE ) { m_cornerAngles.resize( 3 * m_triangles.size() ); }
+    m_updatedTriangles.resize( m_triangles.size(), 0 );
+    m_updatedVertices.resize( vertexCount, 0 );
+}
+
+inline void NormalStencil::computeTriangle( const Vector3Array& positions, uint t ) {
+    const auto& tri   = m_triangles[t];
+    const Vector3& p0 = positions[tri[0]];
+    const Vector3& p1 = positions[tri[1]];
+    const Vector3& p2 = positions[tri[2]];
+    const Vector3 e01 = p1 - p0;
+    const Vector3 e02 = p2 - p0;
+    const Vector3 n   = e01.cross( e02 );
+    switch ( m_weighting ) {
+    case Weighting::AREA:
+        // twice the area, the constant factor vanishes with normalization
+        m_faceNormals[t] = n;
+        break;
+    case Weighting::ANGLE: {
+        const Vector3 e12         = p2 - p1;
+        const Scalar norm         = n.norm();
+        m_cornerAngles[3 * t]     = std::atan2( norm, e01.dot( e02 ) );
+        m_cornerAngles[3 * t + 1] = std::atan2( norm, -e01.dot( e12 ) );
+        m_cornerAngles[3 * t + 2] = std::atan2( norm, e02.dot( e12 ) );
+        m_faceNormals[t]          = norm > 0_ra ? Vector3( n / norm ) : Vector3::Zero();
+        break;
+    }
+    case Weighting::UNIFORM:
+    default:
+        m_faceNormals[t] = n.normalized();
+        break;
+    }
+}
+
+inline Vector3 NormalStencil::gather( uint v ) const {
+    Vector3 n = Vector3::Zero();
+    if ( m_weighting == Weighting::ANGLE ) {
+        for ( uint k = m_offsets[v]; k < m_offsets[v + 1]; ++k ) {
+            const uint c = m_corners[k];
+            n += m_cornerAngles[c] * m_faceNormals[c / 3];
+        }
+    }
+    else {
+        for ( uint k = m_offsets[v]; k < m_offsets[v + 1]; ++k ) {
+            n += m_faceNormals[m_corners[k] / 3];
+        }
+    }
+    return n.normalized();
+}
+
+void NormalStencil::computeNormals( const Vector3Array& positions, Vector3Array& normals ) {
+    CORE_ASSERT( normals.size() == getVertexCount(), "Invalid normal array." );
+    const int triangleCount = int( m_triangles.size() );
+#pragma omp parallel for
+    for ( int t = 0; t < triangleCount; ++t ) {
+        computeTriangle( positions, uint( t ) );
+    }
+    const int vertexCount = int( getVertexCount() );
+#pragma omp parallel for
+    for ( int v = 0; v < vertexCount; ++v ) {
+        normals[v] = gather( uint( v ) );
+    }
+    std::fill( m_updatedTriangles.begin(), m_updatedTriangles.end(), 1 );
+    std::fill( m_updatedVertices.begin(), m_updatedVertices.end(), 1 );
+}
+
+size_t NormalStencil::computeNormals( const Vector3Array& positions,
+                                      const std::vector<bool>& moved,
+                                      Vector3Array& normals ) {
+    CORE_ASSERT( normals.size() == getVertexCount(), "Invalid normal array." );
+    CORE_ASSERT( moved.size() == getVertexCount(), "Invalid moved flags." );
+    const int triangleCount = int( m_triangles.size() );
+#pragma omp parallel for
+    for ( int t = 0; t < triangleCount; ++t ) {
+        const auto& tri       = m_triangles[t];
+        const bool updated    = moved[tri[0]] || moved[tri[1]] || moved[tri[2]];
+        m_updatedTriangles[t] = updated;
+        if ( updated ) { computeTriangle( positions, uint( t ) ); }
+    }
+    const int vertexCount = int( getVertexCount() );
+    int count             = 0;
+#pragma omp parallel for reduction( + : count )
+    for ( int v = 0; v < vertexCount; ++v ) {
+        bool updated = false;
+        for ( uint k = m_offsets[v]; k < m_offsets[v + 1] && !updated; ++k ) {
+            updated = m_updatedTriangles[m_corners[k] / 3] != 0;
+        }
+        m_updatedVertices[v] = updated;
+        if ( updated ) {
+            normals[v] = gather( uint( v ) );
+            ++count;
+        }
+    }
+    return size_t( count );
+}
+
+} // namespace Geometry
+} // namespace Core
+} // namespace Ra
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <Core/Containers/VectorArray.hpp>
+#include <Core/RaCore.hpp>
+#include <Core/Types.hpp>
+
+#include <vector>
+
+namespace Ra {
+namespace Core {
+namespace Geometry {
+
+/**
+ * \brief Precomputed per-vertex stencils to recompute the vertex normals of a deforming
+ * triangle mesh.
+ *
+ * The stencil of a vertex is the list of the triangle corners contributing to its normal, stored
+ * in compressed sparse rows. Vertices duplicated at the same position with the same normal (e.g.
+ * along texture seams) share their corners, so that normals are smooth across the duplicates,
+ * while vertices with different normals (sharp edges) keep their own faces.
+ *
+ * Normals are computed in two passes: a pass over the triangles computing the face normals
+ * (and corner angles), then a gather pass over the vertices summing the normals of the faces of
+ * their stencil. Both passes can be restricted to the part of the mesh that moved.
+ *
+ * The stencil only depends on the triangles (and on the positions and normals used to find the
+ * duplicated vertices), so it is built once and used for any deformation of the mesh.
+ */
+class RA_CORE_API NormalStencil
+{
+  public:
+    /// How face normals are weighted in the vertex normals.
+    enum class Weighting {
+        UNIFORM = 0, ///< Unit face normals.
+        AREA,        ///< Face normals weighted by the face areas.
+        ANGLE        ///< Unit face normals weighted by the corner angles.
+    };
+
+    NormalStencil() = default;
+
+    /**
+     * Build the stencil of the given triangles.
+     * \param normals the reference normals, used to find duplicated vertices sharing their
+     *        normal. If empty, vertices at the same position are not merged.
+     */
+    NormalStencil( const Vector3Array& positions,
+                   const VectorArray<Vector3ui>& triangles,
+                   const Vector3Array& normals = {},
+                   Weighting weighting         = Weighting::AREA );
+
+    Weighting getWeighting() const { return m_weighting; }
+
+    size_t getVertexCount() const { return m_offsets.empty() ? 0 : m_offsets.size() - 1; }
+
+    size_t getTriangleCount() const { return m_triangles.size(); }
+
+    /// Return the range [begin, end) of the stencil of vertex \p v in getCorners().
+    std::pair<uint, uint> getStencil( uint v ) const { return { m_offsets[v], m_offsets[v + 1] }; }
+
+    /// Return the corners of the stencils, corner c being corner c % 3 of triangle c / 3.
+    const std::vector<uint>& getCorners() const { return m_corners; }
+
+    /// Recompute all the normals from \p positions.
+    void computeNormals( const Vector3Array& positions, Vector3Array& normals );
+
+    /**
+     * Recompute the normals depending on the positions of the vertices flagged in \p moved, i.e.
+     * the normals of the vertices having in their stencil a triangle with a moved vertex.
+     * Other normals are left untouched.
+     * \returns the number of recomputed normals.
+     */
+    size_t computeNormals( const Vector3Array& positions,
+                           const std::vector<bool>& moved,
+                           Vector3Array& normals );
+
+    /// Return true if the normal of \p v was recomputed by the last call to computeNormals().
+    bool wasUpdated( uint v ) const { return m_updatedVertices[v] != 0; }
+
+  private:
+    /// Compute the normal (and angles) of triangle \p t.
+    inline void computeTriangle( const Vector3Array& positions, uint t );
+
+    /// Sum the contributions of the stencil of vertex \p v.
+    inline Vector3 gather( uint v ) const;
+
+    Weighting m_weighting { Weighting::AREA };
+    VectorArray<Vector3ui> m_triangles;
+    /// Stencils, in compressed sparse rows.
+    std::vector<uint> m_offsets;
+    std::vector<uint> m_corners;
+
+    /// Per-frame data, allocated once.
+    Vector3Array m_faceNormals;
+    std::vector<Scalar> m_cornerAngles;
+    std::vector<uint8_t> m_updatedTriangles;
+    std::vector<uint8_t> m_updatedVertices;
+};
+
+} // namespace Geometry
+} // namespace Core
+} // namespace Ra
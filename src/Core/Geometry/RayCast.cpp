@@ -271,11 +271,14 @@ bool RayCastCylinder( const Ray& r,
     return false;
 }
 
-bool RayCastTriangle( const Ray& ray,
+namespace {
+// Implementations shared by the overloads using heap and frame arena containers.
+template <typename Hits>
+bool rayCastTriangle( const Ray& ray,
                       const Vector3& a,
                       const Vector3& b,
                       const Vector3& c,
-                      std::vector<Scalar>& hitsOut ) {
+                      Hits& hitsOut ) {
     const Vector3 ab = b - a;
     const Vector3 ac = c - a;
 
@@ -318,17 +321,18 @@ bool RayCastTriangle( const Ray& ray,
     return ( t >= 0 );
 }
 
-bool RayCastTriangleMesh( const Ray& r,
+template <typename Hits, typename Triangles>
+bool rayCastTriangleMesh( const Ray& r,
                           const TriangleMesh& mesh,
-                          std::vector<Scalar>& hitsOut,
-                          std::vector<Vector3ui>& trianglesIdxOut ) {
+                          Hits& hitsOut,
+                          Triangles& trianglesIdxOut ) {
     bool hit = false;
     for ( size_t i = 0; i < mesh.getIndices().size(); ++i ) {
         const auto& t    = mesh.getIndices()[i];
         const Vector3& a = mesh.vertices()[t[0]];
         const Vector3& b = mesh.vertices()[t[1]];
         const Vector3& c = mesh.vertices()[t[2]];
-        if ( RayCastTriangle( r, a, b, c, hitsOut ) ) {
+        if ( rayCastTriangle( r, a, b, c, hitsOut ) ) {
             trianglesIdxOut.push_back( t );
             hit = true;
         }
@@ -336,6 +340,37 @@ bool RayCastTriangleMesh( const Ray& r,
 
     return hit;
 }
+} // namespace
+
+bool RayCastTriangle( const Ray& ray,
+                      const Vector3& a,
+                      const Vector3& b,
+                      const Vector3& c,
+                      std::vector<Scalar>& hitsOut ) {
+    return rayCastTriangle( ray, a, b, c, hitsOut );
+}
+
+bool RayCastTriangle( const Ray& ray,
+                      const Vector3& a,
+                      const Vector3& b,
+                      const Vector3& c,
+                      FrameVector<Scalar>& hitsOut ) {
+    return rayCastTriangle( ray, a, b, c, hitsOut );
+}
+
+bool RayCastTriangleMesh( const Ray& r,
+                          const TriangleMesh& mesh,
+                          std::vector<Scalar>& hitsOut,
+                          std::vector<Vector3ui>& trianglesIdxOut ) {
+    return rayCastTriangleMesh( r, mesh, hitsOut, trianglesIdxOut );
+}
+
+bool RayCastTriangleMesh( const Ray& r,
+                          const TriangleMesh& mesh,
+                          FrameVector<Scalar>& hitsOut,
+                          FrameVector<Vector3ui>& trianglesIdxOut ) {
+    return rayCastTriangleMesh( r, mesh, hitsOut, trianglesIdxOut );
+}
 } // namespace Geometry
 } // namespace Core
 } // namespace Ra
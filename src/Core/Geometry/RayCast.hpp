@@ -1,5 +1,6 @@
 #pragma once
 
+#include <Core/Containers/FrameArena.hpp>
 #include <Core/RaCore.hpp>
 #include <Core/Types.hpp>
 #include <Eigen/Core>
@@ -48,10 +49,24 @@ bool RA_CORE_API RayCastTriangle( const Ray& r,
                                   const Core::Vector3& c,
                                   std::vector<Scalar>& hitsOut );
 
+/// Same as above, storing the hits in the frame arena of the calling thread.
+bool RA_CORE_API RayCastTriangle( const Ray& r,
+                                  const Core::Vector3& a,
+                                  const Core::Vector3& b,
+                                  const Core::Vector3& c,
+                                  FrameVector<Scalar>& hitsOut );
+
 bool RA_CORE_API RayCastTriangleMesh( const Ray& r,
                                       const TriangleMesh& mesh,
                                       std::vector<Scalar>& hitsOut,
                                       std::vector<Vector3ui>& trianglesIdxOut );
+
+/// Same as above, storing the hits in the frame arena of the calling thread, to avoid heap
+/// allocations when picking every frame.
+bool RA_CORE_API RayCastTriangleMesh( const Ray& r,
+                                      const TriangleMesh& mesh,
+                                      FrameVector<Scalar>& hitsOut,
+                                      FrameVector<Vector3ui>& trianglesIdxOut );
 } // namespace Geometry
 } // namespace Core
 } // namespace Ra
@@ -0,0 +1,350 @@
+#include <Core/Geometry/SignedDistanceField.hpp>
+
+#include <Core/Geometry/DistanceQueries.hpp>
+#include <Core/Utils/Log.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace Ra {
+namespace Core {
+namespace Geometry {
+
+namespace {
+/// Voxels of the narrow band are processed by bricks of BrickSize^3 voxels.
+constexpr int BrickSize = 8;
+
+/// Regular grid with samples at integer coordinates.
+struct SampleGrid {
+    Vector3i m_size;
+    /// Position of sample (0, 0, 0).
+    Vector3 m_origin;
+    Scalar m_voxelSize;
+
+    size_t count() const { return size_t( m_size.prod() ); }
+    size_t linear( int i, int j, int k ) const {
+        return size_t( i ) + size_t( m_size.x() ) * ( size_t( j ) + size_t( m_size.y() ) * k );
+    }
+    Vector3 position( int i, int j, int k ) const {
+        return m_origin + m_voxelSize * Vector3 { Scalar( i ), Scalar( j ), Scalar( k ) };
+    }
+    /// Continuous grid coordinates of \p p.
+    Vector3 toGrid( const Vector3& p ) const { return ( p - m_origin ) / m_voxelSize; }
+};
+
+/// Edge function of \p p with respect to the edge (a, b).
+/// It is computed from the ordered endpoints, so that (a, b) and (b, a) give exactly opposite
+/// values and shared edges are classified consistently.
+inline Scalar edgeFunction( const Vector2& a, const Vector2& b, const Vector2& p ) {
+    const bool swap  = b.x() < a.x() || ( b.x() == a.x() && b.y() < a.y() );
+    const Vector2& u = swap ? b : a;
+    const Vector2& v = swap ? a : b;
+    const Scalar e =
+        ( v.x() - u.x() ) * ( p.y() - u.y() ) - ( v.y() - u.y() ) * ( p.x() - u.x() );
+    return swap ? -e : e;
+}
+
+/// Top-left fill rule: exactly one of (a, b) and (b, a) is a top-left edge, so that points on
+/// an edge shared by two triangles are counted once.
+inline bool isTopLeft( const Vector2& a, const Vector2& b ) {
+    const Vector2 d = b - a;
+    return d.y() > 0_ra || ( d.y() == 0_ra && d.x() < 0_ra );
+}
+
+inline bool isInside( Scalar e, const Vector2& a, const Vector2& b ) {
+    return e > 0_ra || ( e == 0_ra && isTopLeft( a, b ) );
+}
+
+inline Scalar triangleDistance( const TriangleMesh& mesh, int t, const Vector3& p ) {
+    const auto& tri = mesh.getIndices()[t];
+    const auto& v   = mesh.vertices();
+    return std::sqrt( pointToTriSq( p, v[tri[0]], v[tri[1]], v[tri[2]] ).distanceSquared );
+}
+
+/// Exact distances of the samples closer than \p band to the mesh.
+void computeNarrowBand( const TriangleMesh& mesh,
+                        const SampleGrid& grid,
+                        Scalar band,
+                        std::vector<Scalar>& distance,
+                        std::vector<int>& closest ) {
+    const auto& vertices = mesh.vertices();
+    const auto& indices  = mesh.getIndices();
+    const Vector3i nBricks = ( grid.m_size.array() + ( BrickSize - 1 ) ) / BrickSize; // ceil
+    std::vector<std::vector<int>> bricks( size_t( nBricks.prod() ) );
+
+    // bucket triangles in the bricks they can be closer than band
+    const Scalar gridBand = band / grid.m_voxelSize;
+    for ( int t = 0; t < int( indices.size() ); ++t ) {
+        Aabb box;
+        for ( int k = 0; k < 3; ++k )
+            box.extend( grid.toGrid( vertices[indices[t][k]] ) );
+        const Vector3i lo = ( box.min().array() - gridBand )
+                                .floor()
+                                .cast<int>()
+                                .max( 0 )
+                                .min( grid.m_size.array() - 1 ) /
+                            BrickSize;
+        const Vector3i hi = ( box.max().array() + gridBand )
+                                .ceil()
+                                .cast<int>()
+                                .max( 0 )
+                                .min( grid.m_size.array() - 1 ) /
+                            BrickSize;
+        for ( int k = lo.z(); k <= hi.z(); ++k )
+            for ( int j = lo.y(); j <= hi.y(); ++j )
+                for ( int i = lo.x(); i <= hi.x(); ++i )
+                    bricks[size_t( i + nBricks.x() * ( j + nBricks.y() * k ) )].push_back( t );
+    }
+
+#pragma omp parallel for schedule( dynamic, 1 )
+    for ( int b = 0; b < int( bricks.size() ); ++b ) {
+        const auto& triangles = bricks[b];
+        if ( triangles.empty() ) continue;
+        const Vector3i brick { b % nBricks.x(),
+                               ( b / nBricks.x() ) % nBricks.y(),
+                               b / ( nBricks.x() * nBricks.y() ) };
+        const Vector3i lo = brick * BrickSize;
+        const Vector3i hi = ( lo.array() + BrickSize ).min( grid.m_size.array() );
+        for ( int k = lo.z(); k < hi.z(); ++k )
+            for ( int j = lo.y(); j < hi.y(); ++j )
+                for ( int i = lo.x(); i < hi.x(); ++i ) {
+                    const Vector3 p = grid.position( i, j, k );
+                    Scalar best     = std::numeric_limits<Scalar>::max();
+                    int bestTri     = -1;
+                    for ( auto t : triangles ) {
+                        const Scalar d = triangleDistance( mesh, t, p );
+                        if ( d < best ) {
+                            best    = d;
+                            bestTri = t;
+                        }
+                    }
+                    // all the triangles closer than band are in the brick list, so the
+                    // distance is exact
+                    if ( best <= band ) {
+                        distance[grid.linear( i, j, k )] = best;
+                        closest[grid.linear( i, j, k )]  = bestTri;
+                    }
+                }
+    }
+}
+
+/// Propagate the closest triangles to the whole grid with jump flooding.
+/// Samples with \p closest set before the call are left untouched.
+void jumpFlooding( const TriangleMesh& mesh,
+                   const SampleGrid& grid,
+                   std::vector<Scalar>& distance,
+                   std::vector<int>& closest ) {
+    const std::vector<bool> exact = [&closest]() {
+        std::vector<bool> ret( closest.size() );
+        for ( size_t i = 0; i < closest.size(); ++i )
+            ret[i] = closest[i] >= 0;
+        return ret;
+    }();
+    std::vector<Scalar> nextDistance( distance.size() );
+    std::vector<int> nextClosest( closest.size() );
+
+    int step = 1;
+    while ( 2 * step < grid.m_size.maxCoeff() )
+        step *= 2;
+    // JFA+1: an additional pass of step 1 fixes most of the propagation errors.
+    std::vector<int> steps;
+    for ( ; step >= 1; step /= 2 )
+        steps.push_back( step );
+    steps.push_back( 1 );
+
+    for ( const int s : steps ) {
+#pragma omp parallel for
+        for ( int k = 0; k < grid.m_size.z(); ++k ) {
+            for ( int j = 0; j < grid.m_size.y(); ++j ) {
+                for ( int i = 0; i < grid.m_size.x(); ++i ) {
+                    const size_t idx = grid.linear( i, j, k );
+                    Scalar best      = distance[idx];
+                    int bestTri      = closest[idx];
+                    if ( !exact[idx] ) {
+                        const Vector3 p = grid.position( i, j, k );
+                        for ( int dz = -s; dz <= s; dz += s )
+                            for ( int dy = -s; dy <= s; dy += s )
+                                for ( int dx = -s; dx <= s; dx += s ) {
+                                    const Vector3i n { i + dx, j + dy, k + dz };
+                                    if ( ( n.array() < 0 ).any() ||
+                                         ( n.array() >= grid.m_size.array() ).any() )
+                                        continue;
+                                    const int t = closest[grid.linear( n.x(), n.y(), n.z() )];
+                                    if ( t < 0 || t == bestTri ) continue;
+                                    const Scalar d = triangleDistance( mesh, t, p );
+                                    if ( d < best ) {
+                                        best    = d;
+                                        bestTri = t;
+                                    }
+                                }
+                    }
+                    nextDistance[idx] = best;
+                    nextClosest[idx]  = bestTri;
+                }
+            }
+        }
+        std::swap( distance, nextDistance );
+        std::swap( closest, nextClosest );
+    }
+}
+
+/// Add one vote to the samples that are inside the mesh according to the parity of the
+/// crossings of rays parallel to \p axis.
+void voteInside( const TriangleMesh& mesh,
+                 const SampleGrid& grid,
+                 int axis,
+                 std::vector<uint8_t>& votes ) {
+    const int u          = ( axis + 1 ) % 3;
+    const int v          = ( axis + 2 ) % 3;
+    const auto& vertices = mesh.vertices();
+    const auto& indices  = mesh.getIndices();
+
+    // (row, crossing coordinate along axis), rows are indexed by (ju, jv).
+    using Crossing = std::pair<size_t, Scalar>;
+    std::vector<Crossing> crossings;
+
+#pragma omp parallel
+    {
+        std::vector<Crossing> local;
+#pragma omp for nowait
+        for ( int t = 0; t < int( indices.size() ); ++t ) {
+            Vector3 q[3];
+            Vector2 p[3];
+            for ( int c = 0; c < 3; ++c ) {
+                q[c] = grid.toGrid( vertices[indices[t][c]] );
+                p[c] = { q[c][u], q[c][v] };
+            }
+            Scalar area = edgeFunction( p[0], p[1], p[2] );
+            if ( area == 0_ra ) continue;
+            // counter clockwise order in the (u, v) plane
+            if ( area < 0_ra ) {
+                std::swap( q[1], q[2] );
+                std::swap( p[1], p[2] );
+            }
+            const Vector2 lo = p[0].cwiseMin( p[1] ).cwiseMin( p[2] );
+            const Vector2 hi = p[0].cwiseMax( p[1] ).cwiseMax( p[2] );
+            const int u0     = std::max( 0, int( std::ceil( lo.x() ) ) );
+            const int u1     = std::min( grid.m_size[u] - 1, int( std::floor( hi.x() ) ) );
+            const int v0     = std::max( 0, int( std::ceil( lo.y() ) ) );
+            const int v1     = std::min( grid.m_size[v] - 1, int( std::floor( hi.y() ) ) );
+            for ( int jv = v0; jv <= v1; ++jv ) {
+                for ( int ju = u0; ju <= u1; ++ju ) {
+                    const Vector2 s { Scalar( ju ), Scalar( jv ) };
+                    const Scalar e0 = edgeFunction( p[1], p[2], s );
+                    const Scalar e1 = edgeFunction( p[2], p[0], s );
+                    const Scalar e2 = edgeFunction( p[0], p[1], s );
+                    if ( isInside( e0, p[1], p[2] ) && isInside( e1, p[2], p[0] ) &&
+                         isInside( e2, p[0], p[1] ) ) {
+                        const Scalar sum = e0 + e1 + e2;
+                        const Scalar x =
+                            ( e0 * q[0][axis] + e1 * q[1][axis] + e2 * q[2][axis] ) / sum;
+                        local.emplace_back( size_t( ju ) + size_t( grid.m_size[u] ) * jv, x );
+                    }
+                }
+            }
+        }
+#pragma omp critical
+        crossings.insert( crossings.end(), local.begin(), local.end() );
+    }
+    std::sort( crossings.begin(), crossings.end() );
+
+    // rows start in the sorted crossings
+    std::vector<size_t> rowStarts;
+    for ( size_t c = 0; c < crossings.size(); ++c ) {
+        if ( c == 0 || crossings[c].first != crossings[c - 1].first ) rowStarts.push_back( c );
+    }
+    rowStarts.push_back( crossings.size() );
+
+#pragma omp parallel for schedule( dynamic, 16 )
+    for ( int r = 0; r < int( rowStarts.size() ) - 1; ++r ) {
+        const size_t begin = rowStarts[r];
+        const size_t end   = rowStarts[r + 1];
+        const size_t row   = crossings[begin].first;
+        Vector3i idx;
+        idx[u]      = int( row % size_t( grid.m_size[u] ) );
+        idx[v]      = int( row / size_t( grid.m_size[u] ) );
+        size_t c    = begin;
+        bool inside = false;
+        for ( int i = 0; i < grid.m_size[axis]; ++i ) {
+            while ( c < end && crossings[c].second < Scalar( i ) ) {
+                inside = !inside;
+                ++c;
+            }
+            idx[axis] = i;
+            if ( inside ) ++votes[grid.linear( idx.x(), idx.y(), idx.z() )];
+        }
+    }
+}
+} // namespace
+
+SignedDistanceField::SignedDistanceField( const TriangleMesh& mesh,
+                                          Scalar voxelSize,
+                                          int padding,
+                                          int bandWidth ) {
+    CORE_ASSERT( voxelSize > 0_ra, "SignedDistanceField: voxel size must be positive" );
+    const Aabb aabb = mesh.computeAabb();
+    if ( mesh.getIndices().empty() || aabb.isEmpty() ) {
+        LOG( Utils::logWARNING ) << "SignedDistanceField: empty mesh, no distance computed";
+        return;
+    }
+
+    SampleGrid grid;
+    grid.m_voxelSize = voxelSize;
+    grid.m_origin    = aabb.min() - Scalar( padding ) * voxelSize * Vector3::Ones();
+    grid.m_size      = ( aabb.sizes() / voxelSize ).array().ceil().cast<int>() + 2 * padding + 1;
+
+    std::vector<Scalar> distance( grid.count(), std::numeric_limits<Scalar>::max() );
+    std::vector<int> closest( grid.count(), -1 );
+
+    const Scalar band = Scalar( std::max( 1, bandWidth ) ) * voxelSize;
+    computeNarrowBand( mesh, grid, band, distance, closest );
+    jumpFlooding( mesh, grid, distance, closest );
+
+    std::vector<uint8_t> votes( grid.count(), 0 );
+    for ( int axis = 0; axis < 3; ++axis )
+        voteInside( mesh, grid, axis, votes );
+
+    // samples are at the bin centers
+    m_grid.setSize( grid.m_size );
+    m_grid.setBinSize( voxelSize * Vector3::Ones() );
+    m_gridToModel = Translation( grid.m_origin - 0.5_ra * voxelSize * Vector3::Ones() );
+    auto& data    = m_grid.data();
+#pragma omp parallel for
+    for ( int i = 0; i < int( data.size() ); ++i ) {
+        data[i] = votes[i] >= 2 ? -distance[i] : distance[i];
+    }
+}
+
+Utils::optional<Scalar> SignedDistanceField::getDistance( const Vector3& p ) const {
+    const Vector3i& size = m_grid.size();
+    if ( ( size.array() == 0 ).any() ) return {};
+    // grid coordinates, with bin centers at integer coordinates
+    const Vector3 q = m_gridToModel.inverse( Eigen::Isometry ) * p / m_grid.binSize().x() -
+                      0.5_ra * Vector3::Ones();
+    if ( ( q.array() < 0_ra ).any() || ( q.array() > ( size.array() - 1 ).cast<Scalar>() ).any() )
+        return {};
+
+    const Vector3i i0 = q.cast<int>().cwiseMin( ( size.array() - 2 ).max( 0 ).matrix() );
+    const Vector3 f   = ( q - i0.cast<Scalar>() ).cwiseMin( Vector3::Ones() );
+    const auto& data  = m_grid.data();
+    auto value        = [&]( int dx, int dy, int dz ) {
+        const Vector3i i = ( i0 + Vector3i { dx, dy, dz } ).cwiseMin( size - Vector3i::Ones() );
+        return data[size_t( i.x() ) + size_t( size.x() ) * ( i.y() + size_t( size.y() ) * i.z() )];
+    };
+    Scalar res = 0_ra;
+    for ( int dz = 0; dz < 2; ++dz )
+        for ( int dy = 0; dy < 2; ++dy )
+            for ( int dx = 0; dx < 2; ++dx ) {
+                const Scalar w = ( dx ? f.x() : 1_ra - f.x() ) * ( dy ? f.y() : 1_ra - f.y() ) *
+                                 ( dz ? f.z() : 1_ra - f.z() );
+                if ( w > 0_ra ) res += w * value( dx, dy, dz );
+            }
+    return res;
+}
+
+} // namespace Geometry
+} // namespace Core
+} // namespace Ra
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <Core/Geometry/IndexedGeometry.hpp>
+#include <Core/Geometry/Volume.hpp>
+#include <Core/RaCore.hpp>
+#include <Core/Types.hpp>
+#include <Core/Utils/StdOptional.hpp>
+
+namespace Ra {
+namespace Core {
+namespace Geometry {
+
+/**
+ * \brief Signed distance field of a TriangleMesh, sampled on a VolumeGrid.
+ *
+ * Distances are negative inside the mesh, and sampled at the center of the grid bins. The grid
+ * covers the mesh bounding box, extended by a few voxels of padding.
+ *
+ * Construction is parallel (OpenMP) and runs in three steps:
+ *  - narrow band: voxels closer than the band width to a triangle get the exact distance
+ *    (pointToTriSq), triangles are bucketed in bricks of voxels processed in parallel.
+ *  - far field: the closest triangles of the band are propagated to the rest of the grid by jump
+ *    flooding, and distances are recomputed exactly to the propagated triangles.
+ *  - sign: inside/outside is given by the parity of ray crossings along each grid axis, and the
+ *    majority of the three axes is kept, which is robust to small holes and grazing rays.
+ *
+ * The grid can be used as is as a volume (e.g. rendered with Engine::Data::VolumeObject) with
+ * getGridToModel() as its model transform.
+ */
+class RA_CORE_API SignedDistanceField
+{
+  public:
+    /**
+     * Compute the distance field of \p mesh.
+     * \param voxelSize size of the grid bins, in mesh units.
+     * \param padding number of voxels added around the mesh bounding box.
+     * \param bandWidth width, in voxels, of the narrow band of exact distances.
+     */
+    SignedDistanceField( const TriangleMesh& mesh,
+                         Scalar voxelSize,
+                         int padding   = 2,
+                         int bandWidth = 2 );
+
+    /// The sampled distances.
+    const VolumeGrid& getGrid() const { return m_grid; }
+    VolumeGrid& getGrid() { return m_grid; }
+
+    /// Transformation from the grid space (i.e. VolumeGrid::getValue positions) to the mesh space.
+    const Transform& getGridToModel() const { return m_gridToModel; }
+
+    /// Return the trilinear interpolation of the distance at \p p (mesh space), or nothing if
+    /// \p p is outside of the grid.
+    Utils::optional<Scalar> getDistance( const Vector3& p ) const;
+
+  private:
+    VolumeGrid m_grid;
+    Transform m_gridToModel { Transform::Identity() };
+};
+
+} // namespace Geometry
+} // namespace Core
+} // namespace Ra
@@ -5,6 +5,7 @@
 
 #include <Eigen/StdVector>
 
+#include <algorithm>
 #include <utility>
 #include <vector>
 
@@ -447,6 +448,7 @@ void TopologicalMesh::updatePositions(
         m_wedges.m_data[i].getWedgeData().m_position              = vertices[i];
         point( m_wedges.m_data[i].getWedgeData().m_vertexHandle ) = vertices[i];
     }
+    m_wedges.invalidateHashIndex();
 }
 
 void TopologicalMesh::updateNormals( const Ra::Core::Geometry::MultiIndexedGeometry& triMesh ) {
@@ -492,12 +494,14 @@ void TopologicalMesh::updateWedgeNormals() {
     for ( auto& w : m_wedges.m_data ) {
         w.getWedgeData().m_vector3Attrib[m_normalsIndex].normalize();
     }
+    m_wedges.invalidateHashIndex();
 }
 
 void TopologicalMesh::copyPointsPositionToWedges() {
     for ( auto& w : m_wedges.m_data ) {
-        w.m_wedgeData.m_position = point( w.m_wedgeData.m_vertexHandle );
+        w.getWedgeData().m_position = point( w.m_wedgeData.m_vertexHandle );
     }
+    m_wedges.invalidateHashIndex();
 }
 
 template <typename T>
@@ -951,13 +955,16 @@ void TopologicalMesh::garbage_collection() {
     // Wedge Ref count is already up to date, do not del again !
 
     auto offset = m_wedges.computeCleanupOffset();
-    for ( HalfedgeIter he_it = halfedges_begin(); he_it != halfedges_end(); ++he_it ) {
-        if ( !status( *he_it ).deleted() ) {
-            auto index = property( m_wedgeIndexPph, *he_it );
-            if ( index.isValid() ) { property( m_wedgeIndexPph, *he_it ) = index - offset[index]; }
+    // each halfedge is updated independently
+#pragma omp parallel for
+    for ( int i = 0; i < int( n_halfedges() ); ++i ) {
+        const HalfedgeHandle heh( i );
+        if ( !status( heh ).deleted() ) {
+            auto index = property( m_wedgeIndexPph, heh );
+            if ( index.isValid() ) { property( m_wedgeIndexPph, heh ) = index - offset[index]; }
         }
     }
-    m_wedges.garbageCollection();
+    m_wedges.garbageCollection( offset );
     base::garbage_collection();
 
     for ( HalfedgeIter he_it = halfedges_begin(); he_it != halfedges_end(); ++he_it ) {
@@ -989,33 +996,119 @@ void TopologicalMesh::delete_face( FaceHandle _fh, bool _delete_isolated_vertice
 
 TopologicalMesh::WedgeIndex
 TopologicalMesh::WedgeCollection::add( const TopologicalMesh::WedgeData& wd ) {
+    updateHashIndex();
+
+    Wedge w { wd };
+    const size_t hash = w.getHash();
+    // return the first equal wedge, as a linear search would do, so that all the halfedges with
+    // the same data end up on the same wedge.
     WedgeIndex idx;
-    auto itr = std::find( m_data.begin(), m_data.end(), Wedge { wd } );
+    auto range = m_hashIndex.equal_range( hash );
+    for ( auto itr = range.first; itr != range.second; ++itr ) {
+        const auto& candidate = m_data[itr->second];
+        if ( ( idx.isInvalid() || itr->second < idx ) && candidate == w ) { idx = itr->second; }
+    }
 
-    if ( itr == m_data.end() ) {
+    if ( idx.isInvalid() ) {
         idx = m_data.size();
-        m_data.emplace_back( wd );
+        m_data.push_back( std::move( w ) );
+        m_hashIndex.emplace( hash, idx );
+    }
+    else { m_data[idx].incrementRefCount(); }
+    return idx;
+}
+
+void TopologicalMesh::WedgeCollection::updateHashIndex() {
+    // too many outdated entries, rebuild from scratch
+    if ( m_hashIndex.size() > 2 * m_data.size() + 64 ) invalidateHashIndex();
+
+    if ( !m_hashIndexIsValid ) {
+        // hashes are computed in parallel, and cached in the wedges
+#pragma omp parallel for
+        for ( int i = 0; i < int( m_data.size() ); ++i ) {
+            m_data[i].getHash();
+        }
+        m_hashIndex.clear();
+        m_hashIndex.reserve( m_data.size() );
+        for ( size_t i = 0; i < m_data.size(); ++i ) {
+            m_hashIndex.emplace( m_data[i].getHash(), WedgeIndex { i } );
+        }
+        m_hashIndexIsValid = true;
     }
     else {
-        itr->incrementRefCount();
-        idx = std::distance( m_data.begin(), itr );
+        for ( const auto& idx : m_dirtyWedges ) {
+            if ( idx.isInvalid() || size_t( idx ) >= m_data.size() ) continue;
+            const size_t hash = m_data[idx].getHash();
+            auto range        = m_hashIndex.equal_range( hash );
+            if ( std::none_of( range.first, range.second, [&idx]( const auto& entry ) {
+                     return entry.second == idx;
+                 } ) ) {
+                m_hashIndex.emplace( hash, idx );
+            }
+        }
     }
-    return idx;
+    m_dirtyWedges.clear();
 }
 
 std::vector<int> TopologicalMesh::WedgeCollection::computeCleanupOffset() const {
+    // parallel prefix sum of the deleted flags: per block count, scan of the block counts, and
+    // per block scan.
+    constexpr int blockSize = 4096;
+    const int n             = int( m_data.size() );
+    const int nBlocks       = ( n + blockSize - 1 ) / blockSize;
     std::vector<int> ret( m_data.size(), 0 );
-    int currentOffset = 0;
-    for ( size_t i = 0; i < m_data.size(); ++i ) {
-        if ( m_data[i].isDeleted() ) {
-            ++currentOffset;
-            ret[i] = -1;
+    std::vector<int> blockOffset( nBlocks + 1, 0 );
+
+#pragma omp parallel for if ( nBlocks > 1 )
+    for ( int b = 0; b < nBlocks; ++b ) {
+        const int end = std::min( n, ( b + 1 ) * blockSize );
+        int count     = 0;
+        for ( int i = b * blockSize; i < end; ++i ) {
+            if ( m_data[i].isDeleted() ) ++count;
+        }
+        blockOffset[b + 1] = count;
+    }
+    for ( int b = 0; b < nBlocks; ++b ) {
+        blockOffset[b + 1] += blockOffset[b];
+    }
+
+#pragma omp parallel for if ( nBlocks > 1 )
+    for ( int b = 0; b < nBlocks; ++b ) {
+        const int end     = std::min( n, ( b + 1 ) * blockSize );
+        int currentOffset = blockOffset[b];
+        for ( int i = b * blockSize; i < end; ++i ) {
+            if ( m_data[i].isDeleted() ) {
+                ++currentOffset;
+                ret[i] = -1;
+            }
+            else { ret[i] = currentOffset; }
         }
-        else { ret[i] = currentOffset; }
     }
     return ret;
 }
 
+void TopologicalMesh::WedgeCollection::garbageCollection( const std::vector<int>& offset ) {
+    CORE_ASSERT( offset.size() == m_data.size(), "offset does not match the wedge collection" );
+    if ( m_data.empty() ) return;
+    // the last remaining wedge gives the new size
+    size_t newSize = 0;
+    for ( auto it = offset.rbegin(); it != offset.rend(); ++it ) {
+        if ( *it >= 0 ) {
+            newSize = size_t( offset.rend() - it ) - size_t( *it );
+            break;
+        }
+    }
+
+    AlignedStdVector<Wedge> data( newSize );
+#pragma omp parallel for
+    for ( int i = 0; i < int( m_data.size() ); ++i ) {
+        if ( offset[i] >= 0 ) data[i - offset[i]] = std::move( m_data[i] );
+    }
+    m_data = std::move( data );
+    // indices have changed
+    invalidateHashIndex();
+}
+
 } // namespace Geometry
 } // namespace Core
 } // namespace Ra
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <Core/Containers/SmallVector.hpp>
 #include <Core/Containers/VectorArray.hpp>
 #include <Core/Geometry/OpenMesh.hpp>
 #include <Core/Geometry/StandardAttribNames.hpp>
@@ -9,6 +10,7 @@
 #include <Core/Utils/Index.hpp>
 #include <Core/Utils/Log.hpp>
 #include <Core/Utils/StdOptional.hpp>
+#include <Core/Utils/StdUtils.hpp>
 
 #include <OpenMesh/Core/Mesh/PolyMesh_ArrayKernelT.hh>
 #include <OpenMesh/Core/Mesh/Traits.hh>
@@ -19,6 +21,7 @@
 #include <Eigen/Core>
 #include <Eigen/Geometry>
 
+#include <algorithm>
 #include <set>
 #include <typeinfo>
 #include <unordered_map>
@@ -66,6 +69,8 @@ class RA_CORE_API TopologicalMesh : public OpenMesh::PolyMesh_ArrayKernelT<Topol
     class WedgeData;
     using WedgeIndex       = Ra::Core::Utils::Index;
     using WedgeAttribIndex = Ra::Core::Utils::Index;
+    /// Short list of wedge indices, allocation free for usual vertex valences.
+    using WedgeIndexList = SmallVector<WedgeIndex, 8>;
 
     /**
      * Construct an empty topological mesh, only initialize mandatory properties.
@@ -241,10 +246,11 @@ class RA_CORE_API TopologicalMesh : public OpenMesh::PolyMesh_ArrayKernelT<Topol
     ///\}
 
     /**
-     * Return the set of WedgeIndex incident to a given Vertex \a vh.
-     * only valid non deleted wedges are present in the set.
+     * Return the WedgeIndex incident to a given Vertex \a vh, sorted in increasing order and
+     * without duplicates.
+     * only valid non deleted wedges are present in the list.
      */
-    inline std::set<WedgeIndex> getVertexWedges( OpenMesh::VertexHandle vh ) const;
+    inline WedgeIndexList getVertexWedges( OpenMesh::VertexHandle vh ) const;
 
     /**
      * get the wedge index associated with an halfedge
@@ -376,6 +382,9 @@ class RA_CORE_API TopologicalMesh : public OpenMesh::PolyMesh_ArrayKernelT<Topol
         inline bool operator!=( const WedgeData& lhs ) const;
         inline bool operator<( const WedgeData& lhs ) const;
 
+        /// Hash of the data compared by operator==, i.e. equal wedge data have the same hash.
+        inline size_t computeHash() const;
+
         template <typename T>
         inline VectorArray<T>& getAttribArray();
         template <typename T>
@@ -413,26 +422,49 @@ class RA_CORE_API TopologicalMesh : public OpenMesh::PolyMesh_ArrayKernelT<Topol
         explicit Wedge() {}
         explicit Wedge( const WedgeData& wd ) : m_wedgeData { wd }, m_refCount { 1 } {};
         const WedgeData& getWedgeData() const { return m_wedgeData; }
-        void setWedgeData( const WedgeData& wedgeData ) { m_wedgeData = wedgeData; }
-        void setWedgeData( WedgeData&& wedgeData ) { m_wedgeData = std::move( wedgeData ); }
+        void setWedgeData( const WedgeData& wedgeData ) {
+            m_wedgeData   = wedgeData;
+            m_hashIsValid = false;
+        }
+        void setWedgeData( WedgeData&& wedgeData ) {
+            m_wedgeData   = std::move( wedgeData );
+            m_hashIsValid = false;
+        }
         void incrementRefCount() { ++m_refCount; }
         void decrementRefCount() {
             if ( m_refCount ) --m_refCount;
         }
         /// comparison ignore refCount
-        bool operator==( const Wedge& lhs ) const { return m_wedgeData == lhs.m_wedgeData; }
+        bool operator==( const Wedge& lhs ) const {
+            return getHash() == lhs.getHash() && m_wedgeData == lhs.m_wedgeData;
+        }
 
         bool isDeleted() const { return m_refCount == 0; }
         unsigned int getRefCount() const { return m_refCount; }
 
+        /// Return the hash of the wedge data, computed on first call after a modification.
+        size_t getHash() const {
+            if ( !m_hashIsValid ) {
+                m_hash        = m_wedgeData.computeHash();
+                m_hashIsValid = true;
+            }
+            return m_hash;
+        }
+
         friend WedgeCollection;
         friend TopologicalMesh;
 
       private:
-        WedgeData& getWedgeData() { return m_wedgeData; }
+        /// Non const access invalidates the hash.
+        WedgeData& getWedgeData() {
+            m_hashIsValid = false;
+            return m_wedgeData;
+        }
 
         WedgeData m_wedgeData {};
         unsigned int m_refCount { 0 };
+        mutable size_t m_hash { 0 };
+        mutable bool m_hashIsValid { false };
     };
 
     /**
@@ -449,6 +481,7 @@ class RA_CORE_API TopologicalMesh : public OpenMesh::PolyMesh_ArrayKernelT<Topol
          * Add wd to the wedge collection, and return the index.
          * If a wedge with same data is already present, it's index is returned,
          * otherwise a new wedge is added to the wedges collection.
+         * The search uses the wedge hash index, so it runs in constant expected time.
          * \param wd Data to insert.
          * \return the index of the inserted (or found) wedge.
          */
@@ -523,6 +556,8 @@ class RA_CORE_API TopologicalMesh : public OpenMesh::PolyMesh_ArrayKernelT<Topol
 
         /// return the offset ot apply to each wedgeindex so that
         /// after garbageCollection all indices are valid and coherent.
+        /// deleted wedges have an offset of -1.
+        /// Computed with a parallel prefix sum.
         std::vector<int> computeCleanupOffset() const;
         /// \todo removeDuplicateWedge
         /// merge wedges with same data
@@ -533,9 +568,19 @@ class RA_CORE_API TopologicalMesh : public OpenMesh::PolyMesh_ArrayKernelT<Topol
 
         /// remove unreferenced wedge, halfedges need to be reindexed.
         inline void garbageCollection();
+        /// remove unreferenced wedge, given the result of computeCleanupOffset.
+        /// Remaining wedges are moved in parallel to their new location.
+        void garbageCollection( const std::vector<int>& offset );
 
         inline void clean();
 
+        /// Mark the hash of wedge \a idx as outdated, to be called when its data is modified
+        /// without a WedgeCollection setter.
+        inline void invalidateHash( const WedgeIndex& idx );
+        /// Mark the whole hash index as outdated, to be called after bulk modifications of
+        /// m_data. The index is rebuilt on next add.
+        inline void invalidateHashIndex();
+
         // return a new wedgeData with uninit values.
         inline WedgeData newWedgeData() const;
         inline WedgeData newWedgeData( TopologicalMesh::VertexHandle vh,
@@ -558,6 +603,19 @@ class RA_CORE_API TopologicalMesh : public OpenMesh::PolyMesh_ArrayKernelT<Topol
         template <typename T>
         inline std::vector<std::string>& getNameArray();
         AlignedStdVector<Wedge> m_data;
+
+      private:
+        /// Bring the hash index up to date with m_data.
+        void updateHashIndex();
+
+        /// wedge data hash -> wedge index.
+        /// Entries of modified wedges are kept until the next rebuild, and are discarded at
+        /// lookup by comparing with the current wedge hash.
+        std::unordered_multimap<size_t, WedgeIndex> m_hashIndex;
+        /// True if all the wedges of m_data are in m_hashIndex, up to m_dirtyWedges.
+        bool m_hashIndexIsValid { false };
+        /// Wedges modified since the last update of m_hashIndex.
+        std::vector<WedgeIndex> m_dirtyWedges;
     };
 
     // internal function to build Core Mesh attribs correspondance to wedge attribs.
@@ -693,6 +751,33 @@ inline bool TopologicalMesh::WedgeData::operator<( const TopologicalMesh::WedgeD
     return false;
 }
 
+namespace internal {
+inline void hashCombineScalar( size_t& seed, Scalar v ) {
+    // -0 and +0 are equal, but have different hashes
+    Utils::hash_combine( seed, v == 0_ra ? 0_ra : v );
+}
+template <typename T>
+inline void hashCombineVector( size_t& seed, const T& v ) {
+    for ( int i = 0; i < T::RowsAtCompileTime; i++ ) {
+        hashCombineScalar( seed, v[i] );
+    }
+}
+} // namespace internal
+
+inline size_t TopologicalMesh::WedgeData::computeHash() const {
+    size_t seed = 0;
+    internal::hashCombineVector( seed, m_position );
+    for ( const auto& v : m_floatAttrib )
+        internal::hashCombineScalar( seed, v );
+    for ( const auto& v : m_vector2Attrib )
+        internal::hashCombineVector( seed, v );
+    for ( const auto& v : m_vector3Attrib )
+        internal::hashCombineVector( seed, v );
+    for ( const auto& v : m_vector4Attrib )
+        internal::hashCombineVector( seed, v );
+    return seed;
+}
+
 #define GET_ATTRIB_ARRAY_HELPER( TYPE, NAME )                                                  \
     template <>                                                                                \
     inline VectorArray<TYPE>& TopologicalMesh::WedgeData::getAttribArray<TYPE>() {             \
@@ -794,6 +879,8 @@ inline T& TopologicalMesh::WedgeCollection::getWedgeData( const TopologicalMesh:
 template <typename T>
 inline T& TopologicalMesh::WedgeCollection::getWedgeAttrib( const TopologicalMesh::WedgeIndex& idx,
                                                             int attribIndex ) {
+    // returned reference may be used to modify the wedge
+    invalidateHash( idx );
     return m_data[idx].getWedgeData().getAttribArray<T>()[attribIndex];
 }
 
@@ -811,7 +898,10 @@ inline void TopologicalMesh::WedgeCollection::setWedgeData( const TopologicalMes
             wd.m_vector4Attrib.size() == m_vector4AttribNames.size() ) ) {
         LOG( logWARNING ) << "Warning, topological mesh set wedge: number of attribs inconsistency";
     }
-    if ( idx.isValid() ) m_data[idx].setWedgeData( wd );
+    if ( idx.isValid() ) {
+        m_data[idx].setWedgeData( wd );
+        invalidateHash( idx );
+    }
 }
 
 template <typename T>
@@ -843,6 +933,7 @@ TopologicalMesh::WedgeCollection::setWedgeAttrib( const TopologicalMesh::WedgeIn
         if ( itr != nameArray.end() ) {
             auto attrIndex = std::distance( nameArray.begin(), itr );
             m_data[idx].getWedgeData().getAttribArray<T>()[attrIndex] = value;
+            invalidateHash( idx );
             return true;
         }
         else {
@@ -859,6 +950,7 @@ TopologicalMesh::WedgeCollection::setWedgeAttrib( const TopologicalMesh::WedgeIn
                                                   const int& attrIndex,
                                                   const T& value ) {
     m_data[idx].getWedgeData().getAttribArray<T>()[attrIndex] = value;
+    invalidateHash( idx );
 }
 
 template <typename T>
@@ -875,6 +967,7 @@ TopologicalMesh::WedgeCollection::setWedgePosition( const TopologicalMesh::Wedge
                                                     const Vector3& value ) {
     if ( idx.isValid() ) {
         m_data[idx].getWedgeData().m_position = value;
+        invalidateHash( idx );
         return true;
     }
     return false;
@@ -935,17 +1028,26 @@ TopologicalMesh::WedgeCollection::addAttrib( const std::string& name, const T& v
                      "inconsistent wedge attrib" );
         w.getWedgeData().getAttribArray<T>().push_back( value );
     }
+    invalidateHashIndex();
     return index;
 }
 
 inline void TopologicalMesh::WedgeCollection::garbageCollection() {
-    m_data.erase( std::remove_if( m_data.begin(),
-                                  m_data.end(),
-                                  []( const Wedge& w ) { return w.isDeleted(); } ),
-                  m_data.end() );
+    garbageCollection( computeCleanupOffset() );
+}
+
+inline void TopologicalMesh::WedgeCollection::invalidateHash( const WedgeIndex& idx ) {
+    if ( m_hashIndexIsValid ) m_dirtyWedges.push_back( idx );
+}
+
+inline void TopologicalMesh::WedgeCollection::invalidateHashIndex() {
+    m_hashIndexIsValid = false;
+    m_dirtyWedges.clear();
 }
 
 inline void TopologicalMesh::WedgeCollection::clean() {
+    invalidateHashIndex();
+    m_hashIndex.clear();
     m_data.clear();
     m_floatAttribNames.clear();
     m_vector2AttribNames.clear();
@@ -1271,6 +1373,8 @@ void TopologicalMesh::initWithWedge(
             }
         }
     }
+    // wedges have been filled directly
+    m_wedges.invalidateHashIndex();
     LOG( logDEBUG ) << "TopologicalMesh: load end with  " << m_wedges.size() << " wedges ";
 }
 
@@ -1331,13 +1435,17 @@ TopologicalMesh::getOutputTriangleMeshIndexPropHandle() const {
     return m_outputTriangleMeshIndexPph;
 }
 
-inline std::set<TopologicalMesh::WedgeIndex>
+inline TopologicalMesh::WedgeIndexList
 TopologicalMesh::getVertexWedges( OpenMesh::VertexHandle vh ) const {
-    std::set<TopologicalMesh::WedgeIndex> ret;
+    WedgeIndexList ret;
 
     for ( ConstVertexIHalfedgeIter vh_it = cvih_iter( vh ); vh_it.is_valid(); ++vh_it ) {
         auto widx = property( m_wedgeIndexPph, *vh_it );
-        if ( widx.isValid() && !m_wedges.getWedge( widx ).isDeleted() ) ret.insert( widx );
+        if ( widx.isValid() && !m_wedges.getWedge( widx ).isDeleted() ) {
+            // sorted insertion, lists are short
+            auto itr = std::lower_bound( ret.begin(), ret.end(), widx );
+            if ( itr == ret.end() || *itr != widx ) ret.insert( itr, widx );
+        }
     }
     return ret;
 }
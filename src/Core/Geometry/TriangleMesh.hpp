@@ -1,6 +1,7 @@
 #pragma once
 
 #include <Core/Containers/VectorArray.hpp>
+#include <Core/Containers/VectorArrayKernels.hpp>
 #include <Core/Geometry/AbstractGeometry.hpp>
 #include <Core/Geometry/StandardAttribNames.hpp>
 #include <Core/RaCore.hpp>
@@ -206,10 +207,29 @@ class RA_CORE_API AttribArrayGeometry : public AbstractGeometry
     /// Release lock on vertices normals
     inline void normalsUnlock();
 
+    /// \name Memory accounting
+    /// \{
+
+    /// Set the category the memory of the geometry (attributes, and indices of the derived
+    /// geometries) is accounted in.
+    virtual void setMemoryCategory( Utils::MemoryCategory category ) {
+        m_vertexAttribs.setMemoryCategory( category );
+    }
+
+    /// Add the memory of the geometry (attributes, and indices of the derived geometries) to
+    /// \p usage.
+    virtual void addMemoryUsage( Utils::MemoryUsage& usage ) const {
+        m_vertexAttribs.addMemoryUsage( usage );
+    }
+    /// \}
+
   private:
     /// Sets the default attribs.
     inline void initDefaultAttribs();
 
+    /// Return true if \p other has as many vertices, without copying mapped vertices.
+    inline bool sameVertexCount( const AttribArrayGeometry& other ) const;
+
     /// Append the data of \p attr to the attribute with the same name.
     /// \warning There is no check on the existence of *this's attribute.
     /// \warning There is no error check on the handles attribute type.
@@ -284,7 +304,7 @@ inline void AttribArrayGeometry::copyBaseGeometry( const AttribArrayGeometry& ot
 template <typename... Handles>
 inline bool AttribArrayGeometry::copyAttributes( const AttribArrayGeometry& input,
                                                  Handles... attribs ) {
-    if ( vertices().size() != input.vertices().size() ) return false;
+    if ( !sameVertexCount( input ) ) return false;
     // copy attribs
     m_vertexAttribs.copyAttributes( input.m_vertexAttribs, attribs... );
     invalidateAabb();
@@ -292,7 +312,7 @@ inline bool AttribArrayGeometry::copyAttributes( const AttribArrayGeometry& inpu
 }
 
 inline bool AttribArrayGeometry::copyAllAttributes( const AttribArrayGeometry& input ) {
-    if ( vertices().size() != input.vertices().size() ) return false;
+    if ( !sameVertexCount( input ) ) return false;
     // copy attribs
     m_vertexAttribs.copyAllAttributes( input.m_vertexAttribs );
     invalidateAabb();
@@ -301,11 +321,7 @@ inline bool AttribArrayGeometry::copyAllAttributes( const AttribArrayGeometry& i
 
 inline Aabb AttribArrayGeometry::computeAabb() const {
     if ( !isAabbValid() ) {
-        Aabb aabb;
-        for ( const auto& v : vertices() ) {
-            aabb.extend( v );
-        }
-        setAabb( aabb );
+        setAabb( Kernels::computeAabb( m_vertexAttribs.getAttrib( m_verticesHandle ) ) );
     }
 
     return getAabb();
@@ -446,11 +462,16 @@ inline void AttribArrayGeometry::initDefaultAttribs() {
     invalidateAabb();
 }
 
+inline bool AttribArrayGeometry::sameVertexCount( const AttribArrayGeometry& other ) const {
+    return m_vertexAttribs.getAttrib( m_verticesHandle ).getSize() ==
+           other.m_vertexAttribs.getAttrib( other.m_verticesHandle ).getSize();
+}
+
 template <typename T>
 inline void AttribArrayGeometry::append_attrib( Utils::AttribBase* attr ) {
     auto h         = m_vertexAttribs.findAttrib<T>( attr->getName() );
     auto& v0       = m_vertexAttribs.getAttrib( h ).getDataWithLock();
-    const auto& v1 = attr->cast<T>().data();
+    const auto v1  = attr->cast<T>().view();
     v0.insert( v0.end(), v1.cbegin(), v1.cend() );
     m_vertexAttribs.getAttrib( h ).unlock();
     invalidateAabb();
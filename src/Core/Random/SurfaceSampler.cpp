@@ -0,0 +1,280 @@
+#include <Core/Random/SurfaceSampler.hpp>
+
+#include <Core/Containers/VectorArrayKernels.hpp>
+#include <Core/Geometry/StandardAttribNames.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <unordered_map>
+
+namespace Ra {
+namespace Core {
+namespace Random {
+
+AliasTable::AliasTable( const std::vector<Scalar>& weights ) :
+    m_probability( weights.size(), 1_ra ), m_alias( weights.size() ) {
+    const size_t n = weights.size();
+    if ( n == 0 ) return;
+
+    Scalar sum = 0_ra;
+    for ( const auto& w : weights ) {
+        CORE_ASSERT( w >= 0_ra, "AliasTable: weights must be non-negative" );
+        sum += w;
+    }
+    if ( sum <= 0_ra ) {
+        // degenerated distribution: uniform.
+        for ( size_t i = 0; i < n; ++i )
+            m_alias[i] = i;
+        return;
+    }
+
+    // scaled probabilities, average is 1
+    std::vector<Scalar> scaled( n );
+    std::vector<size_t> small, large;
+    small.reserve( n );
+    large.reserve( n );
+    for ( size_t i = 0; i < n; ++i ) {
+        scaled[i] = weights[i] * Scalar( n ) / sum;
+        if ( scaled[i] < 1_ra ) { small.push_back( i ); }
+        else { large.push_back( i ); }
+    }
+
+    while ( !small.empty() && !large.empty() ) {
+        const size_t s = small.back();
+        small.pop_back();
+        const size_t l = large.back();
+
+        m_probability[s] = scaled[s];
+        m_alias[s]       = l;
+
+        scaled[l] = ( scaled[l] + scaled[s] ) - 1_ra;
+        if ( scaled[l] < 1_ra ) {
+            large.pop_back();
+            small.push_back( l );
+        }
+    }
+    // remaining entries have probability 1 (up to rounding errors).
+    for ( auto i : large ) {
+        m_probability[i] = 1_ra;
+        m_alias[i]       = i;
+    }
+    for ( auto i : small ) {
+        m_probability[i] = 1_ra;
+        m_alias[i]       = i;
+    }
+}
+
+size_t AliasTable::sample( Scalar u1, Scalar u2 ) const {
+    CORE_ASSERT( !m_probability.empty(), "AliasTable: empty table" );
+    const size_t i = std::min( size_t( u1 * Scalar( size() ) ), size() - 1 );
+    return u2 < m_probability[i] ? i : m_alias[i];
+}
+
+namespace {
+/// Number of samples drawn with the same random generator.
+constexpr size_t SampleBlockSize = 1024;
+
+/// Per-cell data of the Poisson disk hashed grid.
+struct GridCell {
+    Vector3i m_coords;
+    size_t m_begin; ///< first candidate (in sorted order)
+    size_t m_end;   ///< last candidate + 1
+};
+
+/// Cell coordinates are packed on 21 bits per axis.
+constexpr int CellBits = 21;
+
+inline uint64_t cellKey( const Vector3i& c ) {
+    return ( uint64_t( c.x() ) << ( 2 * CellBits ) ) | ( uint64_t( c.y() ) << CellBits ) |
+           uint64_t( c.z() );
+}
+} // namespace
+
+SurfaceSampler::SurfaceSampler( const Geometry::TriangleMesh& mesh ) : m_mesh( mesh ) {
+    const auto& vertices = m_mesh.vertices();
+    const auto& indices  = m_mesh.getIndices();
+    std::vector<Scalar> areas( indices.size() );
+#pragma omp parallel for
+    for ( int i = 0; i < int( indices.size() ); ++i ) {
+        const auto& t = indices[i];
+        areas[i] = 0.5_ra * ( vertices[t[1]] - vertices[t[0]] )
+                                .cross( vertices[t[2]] - vertices[t[0]] )
+                                .norm();
+    }
+    for ( const auto& a : areas )
+        m_area += a;
+    m_triangleTable = AliasTable( areas );
+}
+
+SurfaceSampler::SampleArray SurfaceSampler::sampleUniform( size_t n, uint seed ) const {
+    SampleArray samples( n );
+    if ( m_triangleTable.size() == 0 ) {
+        samples.clear();
+        return samples;
+    }
+    const auto& vertices = m_mesh.vertices();
+    const auto& indices  = m_mesh.getIndices();
+
+    // One generator per block of samples, so that the result does not depend on the number of
+    // threads.
+    const int nBlocks = int( ( n + SampleBlockSize - 1 ) / SampleBlockSize );
+#pragma omp parallel for
+    for ( int b = 0; b < nBlocks; ++b ) {
+        std::seed_seq seq { seed, uint( b ) };
+        std::mt19937 gen( seq );
+        std::uniform_real_distribution<Scalar> dis( 0_ra, 1_ra );
+
+        const size_t end = std::min( n, ( size_t( b ) + 1 ) * SampleBlockSize );
+        for ( size_t i = size_t( b ) * SampleBlockSize; i < end; ++i ) {
+            auto& s      = samples[i];
+            s.m_triangle = uint( m_triangleTable.sample( dis( gen ), dis( gen ) ) );
+
+            // uniform barycentric coordinates
+            const Scalar su = std::sqrt( dis( gen ) );
+            const Scalar u2 = dis( gen );
+            s.m_barycentric = Vector3 { 1_ra - su, u2 * su, su * ( 1_ra - u2 ) };
+
+            const auto& t = indices[s.m_triangle];
+            s.m_position  = s.m_barycentric[0] * vertices[t[0]] +
+                           s.m_barycentric[1] * vertices[t[1]] +
+                           s.m_barycentric[2] * vertices[t[2]];
+        }
+    }
+    return samples;
+}
+
+SurfaceSampler::SampleArray
+SurfaceSampler::samplePoissonDisk( Scalar radius, uint seed, Scalar oversampling ) const {
+    CORE_ASSERT( radius > 0_ra, "Poisson disk radius must be positive" );
+    // Maximal number of points with minimal distance radius (hexagonal packing).
+    const Scalar maxPoints = m_area / ( std::sqrt( 3_ra ) / 2_ra * radius * radius );
+    const size_t nCandidates =
+        std::max( size_t( 1 ), size_t( std::ceil( oversampling * maxPoints ) ) );
+    const SampleArray candidates = sampleUniform( nCandidates, seed );
+    if ( candidates.empty() ) return {};
+
+    // Hashed grid of cell size radius.
+    Aabb aabb;
+    for ( const auto& c : candidates )
+        aabb.extend( c.m_position );
+    const Vector3 origin = aabb.min();
+    const Scalar invCell = 1_ra / radius;
+    CORE_ASSERT( ( aabb.sizes() * invCell ).maxCoeff() < Scalar( 1 << CellBits ),
+                 "Poisson disk radius is too small for the mesh size" );
+
+    std::vector<std::pair<uint64_t, size_t>> sorted( candidates.size() );
+#pragma omp parallel for
+    for ( int i = 0; i < int( candidates.size() ); ++i ) {
+        const Vector3i c =
+            ( ( candidates[i].m_position - origin ) * invCell ).array().floor().cast<int>();
+        sorted[i] = { cellKey( c ), size_t( i ) };
+    }
+    std::sort( sorted.begin(), sorted.end() );
+
+    std::vector<GridCell> cells;
+    std::unordered_map<uint64_t, size_t> cellIndex;
+    for ( size_t i = 0; i < sorted.size(); ++i ) {
+        if ( i == 0 || sorted[i].first != sorted[i - 1].first ) {
+            const Vector3i c =
+                ( ( candidates[sorted[i].second].m_position - origin ) * invCell )
+                    .array()
+                    .floor()
+                    .cast<int>();
+            cellIndex[sorted[i].first] = cells.size();
+            cells.push_back( { c, i, i } );
+        }
+        cells.back().m_end = i + 1;
+    }
+
+    // Neighbor cells of a given phase are never of the same phase, so they are not modified
+    // while the phase is processed.
+    std::array<std::vector<size_t>, 27> phases;
+    for ( size_t i = 0; i < cells.size(); ++i ) {
+        const Vector3i& c = cells[i].m_coords;
+        phases[( c.x() % 3 ) + 3 * ( c.y() % 3 ) + 9 * ( c.z() % 3 )].push_back( i );
+    }
+
+    const Scalar r2 = radius * radius;
+    std::vector<std::vector<size_t>> accepted( cells.size() );
+    for ( const auto& phase : phases ) {
+#pragma omp parallel for schedule( dynamic, 64 )
+        for ( int p = 0; p < int( phase.size() ); ++p ) {
+            const size_t cellId  = phase[p];
+            const GridCell& cell = cells[cellId];
+
+            // gather neighbor cells
+            std::array<const std::vector<size_t>*, 27> neighbors;
+            size_t nNeighbors = 0;
+            for ( int dz = -1; dz <= 1; ++dz )
+                for ( int dy = -1; dy <= 1; ++dy )
+                    for ( int dx = -1; dx <= 1; ++dx ) {
+                        const Vector3i n = cell.m_coords + Vector3i { dx, dy, dz };
+                        if ( ( n.array() < 0 ).any() ) continue;
+                        auto it = cellIndex.find( cellKey( n ) );
+                        if ( it != cellIndex.end() ) {
+                            neighbors[nNeighbors++] = &accepted[it->second];
+                        }
+                    }
+
+            for ( size_t i = cell.m_begin; i < cell.m_end; ++i ) {
+                const size_t cand  = sorted[i].second;
+                const Vector3& pos = candidates[cand].m_position;
+                bool valid         = true;
+                for ( size_t k = 0; k < nNeighbors && valid; ++k ) {
+                    for ( auto a : *neighbors[k] ) {
+                        if ( ( candidates[a].m_position - pos ).squaredNorm() < r2 ) {
+                            valid = false;
+                            break;
+                        }
+                    }
+                }
+                if ( valid ) accepted[cellId].push_back( cand );
+            }
+        }
+    }
+
+    SampleArray samples;
+    for ( const auto& a : accepted )
+        for ( auto i : a )
+            samples.push_back( candidates[i] );
+    return samples;
+}
+
+Geometry::PointCloud SurfaceSampler::toPointCloud( const SampleArray& samples ) const {
+    Geometry::PointCloud cloud;
+    Vector3Array positions( samples.size() );
+    for ( size_t i = 0; i < samples.size(); ++i )
+        positions[i] = samples[i].m_position;
+    cloud.setVertices( std::move( positions ) );
+    if ( samples.empty() ) return cloud;
+
+    const auto& normalName = Geometry::getAttribName( Geometry::MeshAttrib::VERTEX_NORMAL );
+    const auto& posName    = Geometry::getAttribName( Geometry::MeshAttrib::VERTEX_POSITION );
+    const size_t nVertices = m_mesh.vertices().size();
+    m_mesh.vertexAttribs().for_each_attrib( [&]( const auto& attr ) {
+        const auto& name = attr->getName();
+        if ( name == posName || attr->getSize() != nVertices ) return;
+        if ( attr->isFloat() ) {
+            cloud.addAttrib( name, interpolate( samples, attr->template cast<Scalar>().data() ) );
+        }
+        if ( attr->isVector2() ) {
+            cloud.addAttrib( name, interpolate( samples, attr->template cast<Vector2>().data() ) );
+        }
+        if ( attr->isVector3() ) {
+            auto data = interpolate( samples, attr->template cast<Vector3>().data() );
+            if ( name == normalName ) Kernels::normalize( data );
+            cloud.addAttrib( name, data );
+        }
+        if ( attr->isVector4() ) {
+            cloud.addAttrib( name, interpolate( samples, attr->template cast<Vector4>().data() ) );
+        }
+    } );
+    return cloud;
+}
+
+} // namespace Random
+} // namespace Core
+} // namespace Ra
@@ -0,0 +1,116 @@
+#pragma once
+
+#include <Core/Containers/VectorArray.hpp>
+#include <Core/Geometry/IndexedGeometry.hpp>
+#include <Core/RaCore.hpp>
+#include <Core/Types.hpp>
+
+#include <vector>
+
+namespace Ra {
+namespace Core {
+namespace Random {
+
+/** \brief Walker's alias table for O(1) sampling of a discrete distribution.
+ *
+ * Built in O(n) from non-negative weights (Vose's method).
+ */
+class RA_CORE_API AliasTable
+{
+  public:
+    AliasTable() = default;
+    /// Build the table from \p weights, which do not need to be normalized.
+    explicit AliasTable( const std::vector<Scalar>& weights );
+
+    /// Return the index drawn from the two uniform numbers \p u1 and \p u2 in [0, 1).
+    size_t sample( Scalar u1, Scalar u2 ) const;
+
+    /// Return the number of entries of the table.
+    size_t size() const { return m_probability.size(); }
+
+  private:
+    std::vector<Scalar> m_probability;
+    std::vector<size_t> m_alias;
+};
+
+/** \brief Random sampling of points on the surface of a Geometry::TriangleMesh.
+ *
+ * The sampler keeps a reference to the mesh, which must outlive the sampler and not be modified
+ * in between. Samples are stored as (triangle, barycentric coordinates), so that any per-vertex
+ * attribute of the mesh can be interpolated at the sample locations.
+ *
+ * Sampling is multithreaded (OpenMP), and deterministic for a given seed.
+ */
+class RA_CORE_API SurfaceSampler
+{
+  public:
+    /// A point on the mesh surface.
+    struct Sample {
+        /// Index of the triangle containing the sample.
+        uint m_triangle;
+        /// Barycentric coordinates of the sample in the triangle.
+        Vector3 m_barycentric;
+        /// Position of the sample.
+        Vector3 m_position;
+    };
+    using SampleArray = std::vector<Sample>;
+
+    explicit SurfaceSampler( const Geometry::TriangleMesh& mesh );
+
+    /// Return the total area of the mesh.
+    Scalar getArea() const { return m_area; }
+
+    /// Draw \p n samples uniformly distributed on the mesh surface (i.e. triangles are chosen
+    /// proportionally to their area).
+    SampleArray sampleUniform( size_t n, uint seed = 0 ) const;
+
+    /**
+     * \brief Draw blue-noise samples on the mesh surface: no two samples are closer than
+     * \p radius (euclidean distance).
+     *
+     * Candidates are drawn with sampleUniform, bucketed in a hashed grid of cell size \p radius,
+     * and accepted by dart throwing. Cells are processed in 27 independent phases (cell
+     * coordinates modulo 3) so that cells of the same phase are processed in parallel.
+     *
+     * \param radius minimal distance between two samples.
+     * \param seed random seed.
+     * \param oversampling ratio between the number of candidates and the maximal number of
+     * samples that fits on the surface. Higher values give a denser (maximal) distribution.
+     */
+    SampleArray
+    samplePoissonDisk( Scalar radius, uint seed = 0, Scalar oversampling = 8_ra ) const;
+
+    /// Interpolate the per-vertex \p attrib at \p samples.
+    /// \note \p attrib must be of the mesh vertices size.
+    template <typename T>
+    VectorArray<T> interpolate( const SampleArray& samples, const VectorArray<T>& attrib ) const;
+
+    /// Return a point cloud with one vertex per sample. All the Scalar, Vector2, Vector3 and
+    /// Vector4 vertex attributes of the mesh are interpolated, and normals are renormalized.
+    Geometry::PointCloud toPointCloud( const SampleArray& samples ) const;
+
+  private:
+    const Geometry::TriangleMesh& m_mesh;
+    AliasTable m_triangleTable;
+    Scalar m_area { 0_ra };
+};
+
+template <typename T>
+VectorArray<T> SurfaceSampler::interpolate( const SampleArray& samples,
+                                            const VectorArray<T>& attrib ) const {
+    CORE_ASSERT( attrib.size() == m_mesh.vertices().size(), "attrib is not a vertex attrib" );
+    const auto& indices = m_mesh.getIndices();
+    VectorArray<T> res( samples.size() );
+#pragma omp parallel for
+    for ( int i = 0; i < int( samples.size() ); ++i ) {
+        const auto& s = samples[i];
+        const auto& t = indices[s.m_triangle];
+        res[i] = s.m_barycentric[0] * attrib[t[0]] + s.m_barycentric[1] * attrib[t[1]] +
+                 s.m_barycentric[2] * attrib[t[2]];
+    }
+    return res;
+}
+
+} // namespace Random
+} // namespace Core
+} // namespace Ra
@@ -1,6 +1,7 @@
 #include <Core/Resources/Resources.hpp>
 #include <Core/Utils/StdOptional.hpp>
 #include <cpplocate/cpplocate.h>
+#include <cstdlib>
 #include <filesystem>
 #include <stack>
 #include <string>
@@ -82,6 +83,36 @@ void pushDataPath( std::string datapath ) {
     fs::create_directories( DataPath::s_dataPaths.top() );
 }
 
+namespace CachePath {
+static std::string s_cachePath;
+
+/// Return the user cache directory, or the temporary one if none.
+fs::path defaultRoot() {
+#ifdef _WIN32
+    if ( const char* local = std::getenv( "LOCALAPPDATA" ) ) { return local; }
+#else
+    if ( const char* xdg = std::getenv( "XDG_CACHE_HOME" ); xdg && *xdg ) { return xdg; }
+    if ( const char* home = std::getenv( "HOME" ); home && *home ) {
+        return fs::path( home ) / ".cache";
+    }
+#endif
+    return fs::temp_directory_path();
+}
+} // namespace CachePath
+
+std::string getCachePath() {
+    if ( CachePath::s_cachePath.empty() ) {
+        CachePath::s_cachePath = ( CachePath::defaultRoot() / "Radium" ).string();
+    }
+    std::error_code error;
+    fs::create_directories( CachePath::s_cachePath, error );
+    return CachePath::s_cachePath;
+}
+
+void setCachePath( std::string cachePath ) {
+    CachePath::s_cachePath = std::move( cachePath );
+}
+
 } // namespace Resources
 } // namespace Core
 } // namespace Ra
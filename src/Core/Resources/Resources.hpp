@@ -82,6 +82,22 @@ RA_CORE_API void pushDataPath( std::string datapath );
 RA_CORE_API std::string popDataPath();
 ///\}
 
+/** \name Cache path functions
+ * The cache directory stores data which is long to compute and can be recomputed at any time
+ * (e.g. skinning data), outside of the installed or data directories.
+ */
+///\{
+/// \brief Get the cache directory.
+///
+/// If not set with setCachePath(), it is the "Radium" directory of the user cache directory
+/// ($XDG_CACHE_HOME or $HOME/.cache, %LOCALAPPDATA% on Windows), or of the temporary directory
+/// if there is none. The directory is created if needed.
+RA_CORE_API std::string getCachePath();
+
+/// \brief Set the cache directory, an empty path restoring the default one.
+RA_CORE_API void setCachePath( std::string cachePath );
+///\}
+
 } // namespace Resources
 } // namespace Core
 } // namespace Ra
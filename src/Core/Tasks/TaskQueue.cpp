@@ -3,6 +3,7 @@
 #include <Core/Tasks/TaskQueue.hpp>
 #include <Core/Utils/Index.hpp>
 #include <Core/Utils/Log.hpp>
+#include <Core/Utils/Profiler.hpp>
 #include <Core/Utils/Timer.hpp>
 #include <algorithm>
 #include <condition_variable>
@@ -43,6 +44,9 @@ TaskQueue::TaskId TaskQueue::registerTask( std::unique_ptr<Task> task ) {
     // init tdata with task name before moving ownership
     tdata.taskName = task->getName();
     m_timerData.push_back( tdata );
+#ifdef RA_ENABLE_PROFILER
+    m_zoneNames.push_back( nullptr );
+#endif
 
     m_tasks.push_back( std::move( task ) );
     m_dependencies.push_back( std::vector<TaskId>() );
@@ -51,6 +55,9 @@ TaskQueue::TaskId TaskQueue::registerTask( std::unique_ptr<Task> task ) {
     CORE_ASSERT( m_tasks.size() == m_dependencies.size(), "Inconsistent task list" );
     CORE_ASSERT( m_tasks.size() == m_remainingDependencies.size(), "Inconsistent task list" );
     CORE_ASSERT( m_tasks.size() == m_timerData.size(), "Inconsistent task list" );
+#ifdef RA_ENABLE_PROFILER
+    CORE_ASSERT( m_tasks.size() == m_zoneNames.size(), "Inconsistent task list" );
+#endif
     return TaskId { m_tasks.size() - 1 };
 }
 
@@ -249,7 +256,10 @@ void TaskQueue::runTasksInThisThread() {
             // Run task
             m_timerData[task].start    = Utils::Clock::now();
             m_timerData[task].threadId = 0;
-            m_tasks[task]->process();
+            {
+                RA_PROFILE_ZONE( getZoneName( task ) );
+                m_tasks[task]->process();
+            }
             m_timerData[task].end = Utils::Clock::now();
 
             for ( auto t : m_dependencies[task] ) {
@@ -283,9 +293,22 @@ void TaskQueue::flushTaskQueue() {
     m_tasks.clear();
     m_dependencies.clear();
     m_timerData.clear();
+#ifdef RA_ENABLE_PROFILER
+    m_zoneNames.clear();
+#endif
     m_remainingDependencies.clear();
 }
 
+#ifdef RA_ENABLE_PROFILER
+const char* TaskQueue::getZoneName( TaskId task ) {
+    if ( !Utils::Profiler::isEnabled() ) { return nullptr; }
+    // a task is run by a single thread, which is the only one accessing its name
+    auto& name = m_zoneNames[task];
+    if ( !name ) { name = Utils::Profiler::internName( m_timerData[task].taskName ); }
+    return name;
+}
+#endif
+
 void TaskQueue::runThread( uint id ) {
     while ( true ) {
         TaskId task;
@@ -315,7 +338,10 @@ void TaskQueue::runThread( uint id ) {
                 m_timerData[task].start    = Utils::Clock::now();
                 m_timerData[task].threadId = id;
             }
-            m_tasks[task]->process();
+            {
+                RA_PROFILE_ZONE( getZoneName( task ) );
+                m_tasks[task]->process();
+            }
             {
                 rlock lock( m_mutex );
                 m_timerData[task].end = Utils::Clock::now();
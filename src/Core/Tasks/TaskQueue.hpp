@@ -165,6 +165,15 @@ class RA_CORE_API TaskQueue
 
     /// Stores the timings of each frame after execution.
     std::vector<TimerData> m_timerData;
+#ifdef RA_ENABLE_PROFILER
+    /// Profiler zone of each task, named after the task (see Utils::Profiler::internName()),
+    /// nullptr until the task runs with the profiler enabled.
+    std::vector<const char*> m_zoneNames;
+
+    /// Return the profiler zone name of \p task, interned on its first run with the profiler
+    /// enabled, or nullptr if the profiler is disabled.
+    const char* getZoneName( TaskId task );
+#endif
 
     /// Number of tasks each task is waiting on.
     std::vector<uint> m_remainingDependencies;
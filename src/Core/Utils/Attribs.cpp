@@ -26,10 +26,45 @@ void AttribManager::copyAllAttributes( const AttribManager& m ) {
     for ( const auto& attr : m.m_attribs ) {
         m_attribsIndex[attr->getName()] = m_attribs.size();
         m_attribs.push_back( attr->clone() );
+        m_attribs.back()->deferNotifications( isBatchingNotifications() );
+        m_attribs.back()->setMemoryCategory( m_memoryCategory );
         ++m_numAttribs;
     }
 }
 
+void AttribManager::setMemoryCategory( MemoryCategory category ) {
+    m_memoryCategory = category;
+    for_each_attrib( [category]( AttribBase* attr ) { attr->setMemoryCategory( category ); } );
+}
+
+size_t AttribManager::getMemorySize() const {
+    size_t size = 0;
+    for_each_attrib( [&size]( const AttribBase* attr ) { size += attr->getMemorySize(); } );
+    return size;
+}
+
+void AttribManager::addMemoryUsage( MemoryUsage& usage ) const {
+    for_each_attrib(
+        [&usage]( const AttribBase* attr ) { attr->getTrackedMemory().addTo( usage ); } );
+}
+
+void AttribManager::beginNotificationBatch() {
+    if ( m_notificationBatchDepth++ == 0 ) {
+        for_each_attrib( []( AttribBase* attr ) { attr->deferNotifications( true ); } );
+    }
+}
+
+void AttribManager::endNotificationBatch() {
+    CORE_ASSERT( m_notificationBatchDepth > 0, "no notification batch to end" );
+    if ( --m_notificationBatchDepth == 0 ) {
+        for_each_attrib( []( AttribBase* attr ) { attr->deferNotifications( false ); } );
+    }
+}
+
+void AttribManager::flushNotifications() {
+    for_each_attrib( []( AttribBase* attr ) { attr->flushNotification(); } );
+}
+
 bool AttribManager::hasSameAttribs( const AttribManager& other ) {
     // one way
     for ( const auto& attr : m_attribsIndex ) {
@@ -4,11 +4,17 @@
 #include <Core/RaCore.hpp>
 #include <Core/Utils/ContainerIntrospectionInterface.hpp>
 #include <Core/Utils/Index.hpp>
+#include <Core/Utils/MappedFile.hpp>
+#include <Core/Utils/MemoryAccounting.hpp>
 #include <Core/Utils/Observable.hpp>
 #include <Eigen/Core>
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
 #include <iterator>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <stddef.h>
 #include <string>
 #include <type_traits>
@@ -79,28 +85,111 @@ class RA_CORE_API AttribBase : public ObservableVoid, public ContainerIntrospect
     /// Unlock data so another one can gain write access.
     void inline unlock();
 
+    /// Unlock data, only the elements [begin, end) having been modified.
+    void inline unlock( size_t begin, size_t end );
+
+    /// Return the range [begin, end) of the elements modified by the changes the observers are
+    /// notified of. To be called by the observers.
+    /// \see AttribManager::beginNotificationBatch
+    std::pair<size_t, size_t> getDirtyRange() const { return m_notifiedRange; }
+
     virtual std::unique_ptr<AttribBase> clone() = 0;
 
+    /// Return the memory allocated for the content, in bytes. Mapped content is not counted.
+    virtual size_t getMemorySize() const = 0;
+
+    /// Set the category the content memory is accounted in (MemoryCategory::CpuAttributes by
+    /// default).
+    void setMemoryCategory( MemoryCategory category ) { m_memory.setCategory( category ); }
+
+    /// Return the accounted memory of the content.
+    const TrackedMemory& getTrackedMemory() const { return m_memory; }
+
   protected:
     void inline lock( bool isLocked = true );
 
+    /// Notify the observers that the elements [begin, end) changed, or record the change if
+    /// notifications are deferred.
+    void inline notifyChange( size_t begin, size_t end );
+
+    /// Update the accounted memory, to be called when the storage may have been reallocated.
+    void updateMemoryUsage() const { m_memory.set( getMemorySize() ); }
+
   private:
+    /// Defer the notifications until disabled, all the changes being notified at once.
+    void inline deferNotifications( bool defer );
+
+    /// Notify the observers of the recorded changes, if any.
+    void inline flushNotification();
+
     /// The attribute's name.
     std::string m_name;
 
     /// Is data access locked by a user ?
     bool m_isLocked { false };
+
+    /// Notification batching state.
+    bool m_deferNotifications { false };
+    bool m_notificationPending { false };
+    std::pair<size_t, size_t> m_dirtyRange { 0, 0 };
+    std::pair<size_t, size_t> m_notifiedRange { 0, 0 };
+
+    mutable TrackedMemory m_memory { MemoryCategory::CpuAttributes };
+
+    friend class AttribManager;
+};
+
+/**
+ * Read-only view on contiguous elements, made of a pointer and a size.
+ * The view does not own the elements, see Attrib::view() for its validity.
+ */
+template <typename T>
+class ConstArrayView
+{
+  public:
+    using value_type     = T;
+    using const_iterator = const T*;
+
+    ConstArrayView() = default;
+    ConstArrayView( const T* data, size_t size ) : m_data { data }, m_size { size } {}
+
+    const T* data() const { return m_data; }
+    size_t size() const { return m_size; }
+    bool empty() const { return m_size == 0; }
+
+    const T& operator[]( size_t i ) const {
+        CORE_ASSERT( i < m_size, "Index out of the view" );
+        return m_data[i];
+    }
+
+    const_iterator begin() const { return m_data; }
+    const_iterator end() const { return m_data + m_size; }
+    const_iterator cbegin() const { return begin(); }
+    const_iterator cend() const { return end(); }
+
+  private:
+    const T* m_data { nullptr };
+    size_t m_size { 0 };
 };
 
 /**
  * An Attrib stores an element of type \p T for each entry.
+ *
+ * The content is either stored in a VectorArray, or in a memory mapped file region (see
+ * setMappedData()). Mapped content is read without copy through view(), getMap() and the
+ * ContainerIntrospectionInterface (e.g. for GPU upload). It is copied to a VectorArray (and the
+ * mapping released) the first time data() or a write accessor is called, hence read-only code
+ * should prefer view().
  */
 template <typename T>
 class Attrib : public AttribBase
 {
   public:
-    using value_type = T;
-    using Container  = VectorArray<T>;
+    using value_type     = T;
+    using Container      = VectorArray<T>;
+    using ConstMatrixMap = typename Container::ConstMatrixMap;
+    using MatrixMap      = typename Container::MatrixMap;
+    using ConstView      = ConstArrayView<T>;
 
     explicit Attrib( const std::string& name );
     virtual ~Attrib();
@@ -121,6 +210,8 @@ class Attrib : public AttribBase
     const void* dataPtr() const override;
     /// \}
 
+    size_t getMemorySize() const override;
+
     ///\{
     /// setAttribData, attrib mustn't be locked (it's asserted).
     void setData( const Container& data );
@@ -128,7 +219,41 @@ class Attrib : public AttribBase
     ///\}
 
     /// Read-only acccess to the attribute content.
+    /// \note Mapped content is copied, use view() to read it in place.
     inline const Container& data() const;
+
+    /// Return a read-only view on the content, without copying mapped content.
+    /// The view is invalidated when the content is modified or copied from its mapping.
+    inline ConstView view() const;
+
+    /// \name Memory mapped storage
+    /// \{
+
+    /**
+     * \brief Use \p count elements stored at byte \p offset of \p file as attribute content.
+     *
+     * Elements are not copied, pages are loaded on demand by the OS. Clones of a read-only mapped
+     * attrib share the mapping.
+     * \return false (and keep the current content) if the region does not fit in \p file or is not
+     * aligned for \p T.
+     * \note The attrib must not be locked. Observers are notified.
+     */
+    bool setMappedData( std::shared_ptr<MappedFile> file, size_t offset, size_t count );
+
+    /// Return true if the content is stored in a mapped file region.
+    inline bool isMapped() const;
+
+    /// Return an Eigen map on the content, without copying mapped content.
+    template <int N = Container::NumberOfComponents>
+    inline std::enable_if_t<( N > 0 ), ConstMatrixMap> getMap() const;
+
+    /// Return a read-write Eigen map on the content, and lock it (call unlock() when done).
+    /// Content mapped in MappedFile::Mode::CopyOnWrite is modified in place, read-only mapped
+    /// content is copied first.
+    template <int N = Container::NumberOfComponents>
+    inline std::enable_if_t<( N > 0 ), MatrixMap> getMapWithLock();
+    /// \}
+
     bool isFloat() const override;
     bool isVector2() const override;
     bool isVector3() const override;
@@ -139,13 +264,37 @@ class Attrib : public AttribBase
     bool isType();
 
     std::unique_ptr<AttribBase> clone() override {
-        auto ptr    = std::make_unique<Attrib<T>>( getName() );
-        ptr->m_data = m_data;
+        auto ptr = std::make_unique<Attrib<T>>( getName() );
+        std::lock_guard<std::mutex> lock( m_mappedMutex );
+        if ( m_isMapped && m_mappedFile->getMode() == MappedFile::Mode::ReadOnly ) {
+            ptr->m_mappedFile = m_mappedFile;
+            ptr->m_mappedData = m_mappedData;
+            ptr->m_mappedSize = m_mappedSize;
+            ptr->m_isMapped   = true;
+        }
+        else if ( m_isMapped ) {
+            ptr->m_data.assign( m_mappedData, m_mappedData + m_mappedSize );
+        }
+        else { ptr->m_data = m_data; }
+        ptr->setMemoryCategory( getTrackedMemory().getCategory() );
+        ptr->updateMemoryUsage();
         return ptr;
     }
 
   private:
-    Container m_data;
+    /// Copy the mapped content to m_data and release the mapping, if the content is mapped.
+    void materialize() const;
+
+    /// Release the mapping without copying its content.
+    void releaseMapping();
+
+    // Mapped content is lazily copied by const accessors, hence mutable members.
+    mutable Container m_data;
+    mutable std::shared_ptr<MappedFile> m_mappedFile;
+    mutable T* m_mappedData { nullptr };
+    mutable size_t m_mappedSize { 0 };
+    mutable std::atomic<bool> m_isMapped { false };
+    mutable std::mutex m_mappedMutex;
 };
 
 /// An attrib handle basically store an Index and a name.
@@ -241,6 +390,20 @@ class RA_CORE_API AttribManager : public Observable<const std::string&>
     /// \todo allow to copy all attributes, even those with non-standard type
     void copyAllAttributes( const AttribManager& m );
 
+    /// \name Memory accounting
+    /// \{
+
+    /// Set the category the memory of the attributes (current and future ones) is accounted in.
+    void setMemoryCategory( MemoryCategory category );
+    MemoryCategory getMemoryCategory() const { return m_memoryCategory; }
+
+    /// Return the memory allocated for the content of the attributes, in bytes.
+    size_t getMemorySize() const;
+
+    /// Add the memory of the attributes to \p usage.
+    void addMemoryUsage( MemoryUsage& usage ) const;
+    /// \}
+
     /// clear all attribs, invalidate handles.
     void clear();
 
@@ -436,6 +599,36 @@ class RA_CORE_API AttribManager : public Observable<const std::string&>
     /// Returns a scope unlocker for managed attribs
     ScopedLockState getScopedLockState() { return ScopedLockState { this }; }
 
+    /// \name Notification batching
+    /// \{
+
+    /**
+     * \brief Batch the change notifications of the attribs until endNotificationBatch().
+     *
+     * While batching, unlocking or setting the data of an attrib does not notify its observers.
+     * Each changed attrib notifies its observers once when the batch ends (or is flushed),
+     * AttribBase::getDirtyRange() giving the union of the modified ranges.
+     * Batches can be nested, notifications are sent when the outermost batch ends.
+     * \note Attribs added while batching are batched too.
+     * \warning The manager must not be moved while batching.
+     */
+    void beginNotificationBatch();
+
+    /// End the batch started by beginNotificationBatch(), notifying the pending changes.
+    void endNotificationBatch();
+
+    /// Notify the pending changes without ending the batch, e.g. at frame synchronization.
+    void flushNotifications();
+
+    /// Return true if notifications are batched.
+    bool isBatchingNotifications() const { return m_notificationBatchDepth > 0; }
+
+    /// Return a scope batching the notifications (see beginNotificationBatch()).
+    ScopedNotificationBatch<AttribManager> getScopedNotificationBatch() {
+        return ScopedNotificationBatch<AttribManager> { this };
+    }
+    /// \}
+
   private:
     /// Attrib list, better using attribs() to go through.
     Container m_attribs;
@@ -449,6 +642,11 @@ class RA_CORE_API AttribManager : public Observable<const std::string&>
 
     /// Count number of valid attribs
     int m_numAttribs { 0 };
+
+    /// Number of nested notification batches.
+    int m_notificationBatchDepth { 0 };
+
+    MemoryCategory m_memoryCategory { MemoryCategory::CpuAttributes };
 };
 
 AttribBase::AttribBase( const std::string& name ) : m_name { name } {}
@@ -483,10 +681,39 @@ void AttribBase::unlock() {
     lock( false );
 }
 
+void AttribBase::unlock( size_t begin, size_t end ) {
+    CORE_ASSERT( m_isLocked, "double (un)lock" );
+    m_isLocked = false;
+    notifyChange( begin, end );
+}
+
 void AttribBase::lock( bool isLocked ) {
     CORE_ASSERT( isLocked != m_isLocked, "double (un)lock" );
     m_isLocked = isLocked;
-    if ( !m_isLocked ) notify();
+    if ( !m_isLocked ) notifyChange( 0, getSize() );
+}
+
+void AttribBase::notifyChange( size_t begin, size_t end ) {
+    if ( m_notificationPending ) {
+        m_dirtyRange = { std::min( m_dirtyRange.first, begin ),
+                         std::max( m_dirtyRange.second, end ) };
+    }
+    else { m_dirtyRange = { begin, end }; }
+    m_notificationPending = true;
+    updateMemoryUsage();
+    if ( !m_deferNotifications ) flushNotification();
+}
+
+void AttribBase::deferNotifications( bool defer ) {
+    m_deferNotifications = defer;
+    if ( !m_deferNotifications ) flushNotification();
+}
+
+void AttribBase::flushNotification() {
+    if ( !m_notificationPending ) return;
+    m_notificationPending = false;
+    m_notifiedRange       = m_dirtyRange;
+    notify();
 }
 
 /////////////// Attrib ///////////////////
@@ -501,40 +728,140 @@ Attrib<T>::~Attrib() {
 }
 template <typename T>
 void Attrib<T>::resize( size_t s ) {
+    materialize();
     m_data.resize( s );
+    updateMemoryUsage();
 }
 template <typename T>
 typename Attrib<T>::Container& Attrib<T>::getDataWithLock() {
+    materialize();
     lock();
     return m_data;
 }
 
 template <typename T>
 const void* Attrib<T>::dataPtr() const {
+    if ( m_isMapped.load( std::memory_order_acquire ) ) {
+        std::lock_guard<std::mutex> lock( m_mappedMutex );
+        if ( m_isMapped ) return m_mappedData;
+    }
     return m_data.dataPtr();
 }
 
 template <typename T>
 void Attrib<T>::setData( const Container& data ) {
     CORE_ASSERT( !isLocked(), "try to set onto locked data" );
+    releaseMapping();
     m_data = data;
-    notify();
+    notifyChange( 0, m_data.size() );
 }
 
 template <typename T>
 void Attrib<T>::setData( Container&& data ) {
     CORE_ASSERT( !isLocked(), "try to set onto locked data" );
+    releaseMapping();
     m_data = std::move( data );
-    notify();
+    notifyChange( 0, m_data.size() );
 }
 
 template <typename T>
 const typename Attrib<T>::Container& Attrib<T>::data() const {
+    materialize();
     return m_data;
 }
 
+template <typename T>
+typename Attrib<T>::ConstView Attrib<T>::view() const {
+    if ( m_isMapped.load( std::memory_order_acquire ) ) {
+        std::lock_guard<std::mutex> lock( m_mappedMutex );
+        if ( m_isMapped ) return ConstView( m_mappedData, m_mappedSize );
+    }
+    return ConstView( m_data.data(), m_data.size() );
+}
+
+template <typename T>
+bool Attrib<T>::setMappedData( std::shared_ptr<MappedFile> file, size_t offset, size_t count ) {
+    // i.e. arithmetic types and fixed size Eigen matrices, which are plain data.
+    static_assert( Container::NumberOfComponents > 0,
+                   "Only types mappable to Eigen matrices can be mapped from a file" );
+    CORE_ASSERT( !isLocked(), "try to set onto locked data" );
+    if ( !file || !file->isValid() || offset + count * sizeof( T ) > file->size() ) {
+        return false;
+    }
+    auto ptr = static_cast<const char*>( file->data() ) + offset;
+    if ( reinterpret_cast<std::uintptr_t>( ptr ) % alignof( T ) != 0 ) { return false; }
+    {
+        std::lock_guard<std::mutex> lock( m_mappedMutex );
+        Container().swap( m_data );
+        m_mappedData = reinterpret_cast<T*>( const_cast<char*>( ptr ) );
+        m_mappedSize = count;
+        m_mappedFile = std::move( file );
+        m_isMapped.store( true, std::memory_order_release );
+    }
+    notifyChange( 0, count );
+    return true;
+}
+
+template <typename T>
+bool Attrib<T>::isMapped() const {
+    return m_isMapped.load( std::memory_order_acquire );
+}
+
+template <typename T>
+template <int N>
+std::enable_if_t<( N > 0 ), typename Attrib<T>::ConstMatrixMap> Attrib<T>::getMap() const {
+    if ( m_isMapped.load( std::memory_order_acquire ) ) {
+        std::lock_guard<std::mutex> lock( m_mappedMutex );
+        if ( m_isMapped ) {
+            return ConstMatrixMap( reinterpret_cast<const typename Container::component_type*>(
+                                       m_mappedData ),
+                                   Container::NumberOfComponents,
+                                   Eigen::Index( m_mappedSize ) );
+        }
+    }
+    return static_cast<const Container&>( m_data ).getMap();
+}
+
+template <typename T>
+template <int N>
+std::enable_if_t<( N > 0 ), typename Attrib<T>::MatrixMap> Attrib<T>::getMapWithLock() {
+    if ( m_isMapped && m_mappedFile->getMode() == MappedFile::Mode::CopyOnWrite ) {
+        lock();
+        return MatrixMap( reinterpret_cast<typename Container::component_type*>( m_mappedData ),
+                          Container::NumberOfComponents,
+                          Eigen::Index( m_mappedSize ) );
+    }
+    return getDataWithLock().getMap();
+}
+
+template <typename T>
+void Attrib<T>::materialize() const {
+    if ( !m_isMapped.load( std::memory_order_acquire ) ) return;
+    std::lock_guard<std::mutex> lock( m_mappedMutex );
+    if ( !m_isMapped ) return; // materialized by another thread
+    m_data.assign( m_mappedData, m_mappedData + m_mappedSize );
+    m_mappedFile.reset();
+    m_mappedData = nullptr;
+    m_mappedSize = 0;
+    m_isMapped.store( false, std::memory_order_release );
+    updateMemoryUsage();
+}
+
+template <typename T>
+void Attrib<T>::releaseMapping() {
+    std::lock_guard<std::mutex> lock( m_mappedMutex );
+    m_mappedFile.reset();
+    m_mappedData = nullptr;
+    m_mappedSize = 0;
+    m_isMapped.store( false, std::memory_order_release );
+}
+
 template <typename T>
 size_t Attrib<T>::getSize() const {
+    if ( m_isMapped.load( std::memory_order_acquire ) ) {
+        std::lock_guard<std::mutex> lock( m_mappedMutex );
+        if ( m_isMapped ) return m_mappedSize;
+    }
     return m_data.getSize();
 }
 
@@ -545,7 +872,12 @@ int Attrib<T>::getStride() const {
 
 template <typename T>
 size_t Attrib<T>::getBufferSize() const {
-    return m_data.getBufferSize();
+    return getSize() * sizeof( T );
+}
+
+template <typename T>
+size_t Attrib<T>::getMemorySize() const {
+    return m_data.capacity() * sizeof( T );
 }
 
 template <typename T>
@@ -587,12 +919,18 @@ AttribManager::AttribManager() {}
 AttribManager::AttribManager( AttribManager&& m ) :
     m_attribs( std::move( m.m_attribs ) ),
     m_attribsIndex( std::move( m.m_attribsIndex ) ),
-    m_numAttribs( std::move( m.m_numAttribs ) ) {}
+    m_numAttribs( std::move( m.m_numAttribs ) ),
+    m_memoryCategory( m.m_memoryCategory ) {
+    CORE_ASSERT( !m.isBatchingNotifications(), "move while batching notifications" );
+}
 
 AttribManager& AttribManager::operator=( AttribManager&& m ) {
-    m_attribs      = std::move( m.m_attribs );
-    m_attribsIndex = std::move( m.m_attribsIndex );
-    m_numAttribs   = std::move( m.m_numAttribs );
+    CORE_ASSERT( !isBatchingNotifications() && !m.isBatchingNotifications(),
+                 "move while batching notifications" );
+    m_attribs        = std::move( m.m_attribs );
+    m_attribsIndex   = std::move( m.m_attribsIndex );
+    m_numAttribs     = std::move( m.m_numAttribs );
+    m_memoryCategory = m.m_memoryCategory;
     return *this;
 }
 
@@ -609,8 +947,9 @@ void AttribManager::copyAttributes( const AttribManager& m,
         auto& a = m.getAttrib( attr );
         // add new attrib
         auto h = addAttrib<T>( a.getName() );
-        // copy attrib data
-        getAttrib( h ).setData( a.data() );
+        // copy attrib data, reading mapped content in place
+        const auto view = a.view();
+        getAttrib( h ).setData( typename Attrib<T>::Container( view.begin(), view.end() ) );
     }
     // deal with other attribs
     copyAttributes( m, attribs... );
@@ -723,6 +1062,8 @@ AttribHandle<T> AttribManager::addAttrib( const std::string& name ) {
 
     // create the attrib
     smart_pointer_type attrib = std::make_unique<Attrib<T>>( name );
+    attrib->deferNotifications( isBatchingNotifications() );
+    attrib->setMemoryCategory( m_memoryCategory );
 
     // look for a free slot
     auto it = std::find_if(
@@ -5,6 +5,8 @@
 #include <algorithm>
 #include <assert.h>
 #include <deque>
+#include <limits>
+#include <vector>
 
 #include <Core/Utils/Index.hpp>
 
@@ -15,9 +17,15 @@ namespace Utils {
 /*!
  * The class IndexMap define a map where a object is coupled with a index.
  * The index is unique, it is assigned to a object when it's inserted and is kept until the object
- * is removed. After a removal, the index becomes free again. A object will be given the first free
- * index available. If no free indices are available, the object will not be inserted and the
- * IndexMap is considered full.
+ * is removed. If the IndexMap is full, the object will not be inserted.
+ *
+ * The IndexMap is a generational slot map: an index is made of a slot, giving in constant time
+ * the position of the object, and of the generation of the slot, incremented each time the slot
+ * is freed. Insertion, access and removal are in constant time, and the index of a removed
+ * object (stale index) is not valid anymore, even once its slot has been reused (up to the
+ * wrapping of the generations, after s_maxGeneration reuses).
+ * Objects are stored densely, in no specific order: removing an object moves the last object
+ * in its place.
  */
 template <typename T>
 class IndexMap
@@ -37,6 +45,18 @@ class IndexMap
     using ConstIterator = typename Container::const_iterator; /// Const iterator to the list of
                                                               /// objects of the IndexMap.
 
+    // ===============================================================================
+    // CONSTANTS
+    // ===============================================================================
+    /// Number of bits of the slot in an index.
+    static constexpr uint s_slotBits = 22;
+    /// Number of bits of the generation in an index.
+    static constexpr uint s_generationBits = 9;
+    /// Maximal number of objects.
+    static constexpr uint s_maxSlots = 1u << s_slotBits;
+    /// Last generation of a slot, generations wrap after it.
+    static constexpr uint s_maxGeneration = ( 1u << s_generationBits ) - 1;
+
     // ===============================================================================
     // CONSTRUCTOR
     // ===============================================================================
@@ -63,6 +83,8 @@ class IndexMap
     // REMOVE
     // ===============================================================================
     /// Remove the object with the given index. Return false if the operation failed.
+    /// \note Invalidates the iterators and references to the last object, which is moved in
+    ///       place of the removed one.
     inline bool remove( const Index& idx );
 
     // ===============================================================================
@@ -121,41 +143,49 @@ class IndexMap
   protected:
     // Member variables
     Container m_data;       /// Objects in the IndexMap
-    IndexContainer m_index; /// Indices in the IndexMap
+    IndexContainer m_index; /// Indices in the IndexMap, m_index[i] being the index of m_data[i]
 
   private:
+    /// A slot, giving the position of its object in m_data.
+    struct Slot {
+        uint m_position { s_freeSlot }; /// Position of the object, s_freeSlot if none.
+        uint m_generation { 0 };        /// Generation of the current (or next) object.
+    };
+
+    static constexpr uint s_freeSlot = std::numeric_limits<uint>::max();
+    static constexpr uint s_slotMask = s_maxSlots - 1;
+
     // ===============================================================================
     // FREE LIST MANAGEMENT
     // ===============================================================================
-    inline void push_free_index( const Index& idx ); /// Push a new free index in free list
-    inline bool pop_free_index( Index& idx );        /// Pop a free index from the free list
+    /// Allocate a slot for a new object, at the end of m_data, and return its index.
+    /// Return an invalid index if the IndexMap is full.
+    inline Index allocate_index();
 
     // ===============================================================================
     // HELPER FUNCTIONS
     // ===============================================================================
-    // These function return an iterator to an object from an interator in an index.
-    inline ConstIterator citfromIndex( const ConstIndexIterator& it )
-        const; /// Returns a const iterator on an object from its intex iterator
-    inline Iterator
-    itfromIndex( const ConstIndexIterator&
-                     it ); /// Returns a non-const iterator on an object from its intex iterator
-    inline size_t idxfromIndex( const ConstIndexIterator& it )
-        const; /// Return the index of the object in the map from its index iterator
+    /// Return the position in m_data of the object with the given index, s_freeSlot if none.
+    inline uint position( const Index& idx ) const;
 
   private:
     // Member variables
-    IndexContainer m_free; /// List of available free indices.
+    std::vector<Slot> m_slots; /// The slots, indexed by the slot part of the indices.
+    std::deque<uint> m_free;   /// Free slots, reused in the order they are freed.
 };
 
 // ===============================================================================
 // CONSTRUCTOR
 // ===============================================================================
 template <typename T>
-IndexMap<T>::IndexMap() : m_data(), m_index(), m_free( 1, Index( 0 ) ) {}
+IndexMap<T>::IndexMap() : m_data(), m_index(), m_slots(), m_free() {}
 
 template <typename T>
 IndexMap<T>::IndexMap( const IndexMap& id_map ) :
-    m_data( id_map.m_data ), m_index( id_map.m_index ), m_free( id_map.m_free ) {}
+    m_data( id_map.m_data ),
+    m_index( id_map.m_index ),
+    m_slots( id_map.m_slots ),
+    m_free( id_map.m_free ) {}
 
 // ===============================================================================
 // DESTRUCTOR
@@ -168,28 +198,16 @@ IndexMap<T>::~IndexMap() {}
 // ===============================================================================
 template <typename T>
 inline Index IndexMap<T>::insert( const T& obj ) {
-    Index idx;
-    if ( pop_free_index( idx ) ) {
-        typename std::deque<Index>::iterator it =
-            std::lower_bound( m_index.begin(), m_index.end(), idx );
-        if ( it == m_index.end() ) { m_data.insert( m_data.end(), obj ); }
-        else { m_data.insert( citfromIndex( it ), obj ); }
-        m_index.insert( it, idx );
-    }
+    Index idx = allocate_index();
+    if ( idx.isValid() ) { m_data.push_back( obj ); }
     return idx;
 }
 
 template <typename T>
 template <typename... Args>
 Index IndexMap<T>::emplace( const Args&&... args ) {
-    Index idx;
-    if ( pop_free_index( idx ) ) {
-        typename std::deque<Index>::iterator it =
-            std::lower_bound( m_index.begin(), m_index.end(), idx );
-        if ( it == m_index.end() ) { m_data.emplace( m_data.end(), args... ); }
-        else { m_data.emplace( citfromIndex( it ), args... ); }
-        m_index.insert( it, idx );
-    }
+    Index idx = allocate_index();
+    if ( idx.isValid() ) { m_data.emplace_back( args... ); }
     return idx;
 }
 
@@ -198,11 +216,23 @@ Index IndexMap<T>::emplace( const Args&&... args ) {
 // ===============================================================================
 template <typename T>
 inline bool IndexMap<T>::remove( const Index& idx ) {
-    typename std::deque<Index>::iterator it = std::find( m_index.begin(), m_index.end(), idx );
-    if ( it == m_index.end() ) { return false; }
-    m_data.erase( itfromIndex( it ) );
-    m_index.erase( it );
-    push_free_index( idx );
+    const uint pos = position( idx );
+    if ( pos == s_freeSlot ) { return false; }
+    // move the last object in place of the removed one
+    const uint last = uint( m_data.size() - 1 );
+    if ( pos != last ) {
+        m_data[pos]  = std::move( m_data[last] );
+        m_index[pos] = m_index[last];
+        m_slots[uint( m_index[pos].getValue() ) & s_slotMask].m_position = pos;
+    }
+    m_data.pop_back();
+    m_index.pop_back();
+
+    // free the slot, its next object gets a new generation
+    const uint slot           = uint( idx.getValue() ) & s_slotMask;
+    m_slots[slot].m_position   = s_freeSlot;
+    m_slots[slot].m_generation = ( m_slots[slot].m_generation + 1 ) & s_maxGeneration;
+    m_free.push_back( slot );
     return true;
 }
 
@@ -211,17 +241,16 @@ inline bool IndexMap<T>::remove( const Index& idx ) {
 // ===============================================================================
 template <typename T>
 inline const T& IndexMap<T>::at( const Index& idx ) const {
-    typename std::deque<Index>::const_iterator it =
-        std::find( m_index.begin(), m_index.end(), idx );
-    CORE_ASSERT( it != m_index.end(), "Index not found" );
-    return m_data.at( idxfromIndex( it ) );
+    const uint pos = position( idx );
+    CORE_ASSERT( pos != s_freeSlot, "Index not found" );
+    return m_data.at( pos );
 }
 
 template <typename T>
 inline T& IndexMap<T>::access( const Index& idx ) {
-    typename std::deque<Index>::iterator it = std::find( m_index.begin(), m_index.end(), idx );
-    CORE_ASSERT( ( it != m_index.end() ), "Index not found" );
-    return *itfromIndex( it );
+    const uint pos = position( idx );
+    CORE_ASSERT( ( pos != s_freeSlot ), "Index not found" );
+    return m_data[pos];
 }
 
 // ===============================================================================
@@ -234,10 +263,18 @@ inline size_t IndexMap<T>::size() const {
 
 template <typename T>
 inline void IndexMap<T>::clear() {
+    // keep the generations, so that the indices of the removed objects stay invalid
+    for ( const auto& idx : m_index ) {
+        auto& slot        = m_slots[uint( idx.getValue() ) & s_slotMask];
+        slot.m_position   = s_freeSlot;
+        slot.m_generation = ( slot.m_generation + 1 ) & s_maxGeneration;
+    }
     m_index.clear();
     m_data.clear();
     m_free.clear();
-    m_free.push_back( Index( 0 ) );
+    for ( uint slot = 0; slot < m_slots.size(); ++slot ) {
+        m_free.push_back( slot );
+    }
 }
 
 // ===============================================================================
@@ -250,14 +287,12 @@ inline bool IndexMap<T>::empty() const {
 
 template <typename T>
 inline bool IndexMap<T>::full() const {
-    return m_free.empty();
+    return m_free.empty() && m_slots.size() == s_maxSlots;
 }
 
 template <typename T>
 inline bool IndexMap<T>::contains( const Index& idx ) const {
-    typename std::deque<Index>::const_iterator it =
-        std::find( m_index.begin(), m_index.end(), idx );
-    return !( it == m_index.end() );
+    return position( idx ) != s_freeSlot;
 }
 
 template <typename T>
@@ -329,55 +364,36 @@ inline typename IndexMap<T>::ConstIterator IndexMap<T>::cend() const {
 // FREE LIST
 // ===============================================================================
 template <typename T>
-inline void IndexMap<T>::push_free_index( const Index& idx ) {
-    std::deque<Index>::iterator free_it = std::lower_bound( m_free.begin(), m_free.end(), idx );
-    m_free.insert( free_it, idx );
-    if ( m_data.empty() ) {
-        m_free.clear();
-        m_free.push_back( Index( 0 ) );
+inline Index IndexMap<T>::allocate_index() {
+    uint slot;
+    if ( !m_free.empty() ) {
+        slot = m_free.front();
+        m_free.pop_front();
     }
-}
-
-template <typename T>
-inline bool IndexMap<T>::pop_free_index( Index& idx ) {
-    if ( m_free.empty() ) {
-        idx = Index::Invalid();
-        return false;
+    else if ( m_slots.size() < s_maxSlots ) {
+        slot = uint( m_slots.size() );
+        m_slots.emplace_back();
     }
-    idx = m_free.front();
-    m_free.pop_front();
-    if ( m_free.empty() ) {
-        Index next = idx + 1;
-        if ( next.isValid() ) {
-            if ( uint( next.getValue() ) > m_data.size() ) { m_free.push_back( next ); }
-        }
-    }
-    return true;
+    else { return Index::Invalid(); }
+
+    m_slots[slot].m_position = uint( m_data.size() );
+    Index idx( ( m_slots[slot].m_generation << s_slotBits ) | slot );
+    m_index.push_back( idx );
+    return idx;
 }
 
 // ===============================================================================
 // HELPER FUNCTIONS
 // ===============================================================================
-
-template <typename T>
-typename IndexMap<T>::ConstIterator
-IndexMap<T>::citfromIndex( const typename IndexMap<T>::ConstIndexIterator& it ) const {
-    auto dataIt = m_data.begin();
-    std::advance( dataIt, std::distance( m_index.cbegin(), it ) );
-    return dataIt;
-}
-
-template <typename T>
-typename IndexMap<T>::Iterator
-IndexMap<T>::itfromIndex( const typename IndexMap<T>::ConstIndexIterator& it ) {
-    auto dataIt = m_data.begin();
-    std::advance( dataIt, std::distance( m_index.cbegin(), it ) );
-    return dataIt;
-}
-
 template <typename T>
-size_t IndexMap<T>::idxfromIndex( const typename IndexMap<T>::ConstIndexIterator& it ) const {
-    return std::distance( m_index.cbegin(), it );
+inline uint IndexMap<T>::position( const Index& idx ) const {
+    if ( idx.isInvalid() ) { return s_freeSlot; }
+    const uint value = uint( idx.getValue() );
+    const uint slot  = value & s_slotMask;
+    if ( slot >= m_slots.size() || m_slots[slot].m_generation != ( value >> s_slotBits ) ) {
+        return s_freeSlot;
+    }
+    return m_slots[slot].m_position;
 }
 
 } // namespace Utils
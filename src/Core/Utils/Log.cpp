@@ -0,0 +1,358 @@
+#include <Core/Utils/Log.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <csignal>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <thread>
+
+#ifdef OS_WINDOWS
+#    include <io.h>
+#else
+#    include <unistd.h>
+#endif
+
+namespace Ra {
+namespace Core {
+namespace Utils {
+
+namespace {
+
+/// Single producer, single consumer ring buffer of log records.
+/// Each record is stored as a header (size, level, time) followed by the message characters.
+class RingBuffer
+{
+  public:
+    explicit RingBuffer( size_t capacity ) : m_data( capacity ) {}
+
+    size_t getCapacity() const { return m_data.size(); }
+
+    /// Return true if a message of \p size characters fits in the (empty) buffer.
+    bool canHold( size_t size ) const { return sizeof( Header ) + size <= m_data.size(); }
+
+    bool empty() const {
+        return m_head.load( std::memory_order_acquire ) == m_tail.load( std::memory_order_acquire );
+    }
+
+    /// Return true if more than half of the buffer is used.
+    bool isFilling() const {
+        return 2 * ( m_head.load( std::memory_order_relaxed ) -
+                     m_tail.load( std::memory_order_relaxed ) ) >
+               m_data.size();
+    }
+
+    /// Producer side, return false if there is not enough room.
+    bool push( TLogLevel level, std::time_t time, const std::string& msg ) {
+        const Header header { uint32_t( msg.size() ), int32_t( level ), int64_t( time ) };
+        const size_t size = sizeof( Header ) + msg.size();
+        const size_t head = m_head.load( std::memory_order_relaxed );
+        const size_t tail = m_tail.load( std::memory_order_acquire );
+        if ( size > m_data.size() - ( head - tail ) ) { return false; }
+        write( head, &header, sizeof( Header ) );
+        write( head + sizeof( Header ), msg.data(), msg.size() );
+        m_head.store( head + size, std::memory_order_release );
+        return true;
+    }
+
+    /// Write the pending records to the file descriptor \p fd, without consuming them, allocating,
+    /// formatting nor locking, i.e. only with async-signal-safe calls (for crash handlers).
+    void dump( int fd ) const {
+        static const char* const levels[] = {
+            "ERROR", "WARNING", "INFO", "DEBUG", "DEBUG1", "DEBUG2", "DEBUG3", "DEBUG4" };
+        constexpr int levelCount = int( sizeof( levels ) / sizeof( levels[0] ) );
+        const size_t head        = m_head.load( std::memory_order_acquire );
+        size_t tail              = m_tail.load( std::memory_order_acquire );
+        while ( tail != head && head - tail <= m_data.size() ) {
+            Header header;
+            read( tail, &header, sizeof( Header ) );
+            // the consumer may have been interrupted, stop on inconsistent records
+            if ( sizeof( Header ) + header.m_size > head - tail ) { return; }
+            const int level = std::clamp( int( header.m_level ), 0, levelCount - 1 );
+            writeAll( fd, "- ", 2 );
+            writeAll( fd, levels[level], std::strlen( levels[level] ) );
+            writeAll( fd, ": ", 2 );
+            const size_t begin = ( tail + sizeof( Header ) ) % m_data.size();
+            const size_t first = std::min( size_t( header.m_size ), m_data.size() - begin );
+            writeAll( fd, m_data.data() + begin, first );
+            writeAll( fd, m_data.data(), header.m_size - first );
+            tail += sizeof( Header ) + header.m_size;
+        }
+    }
+
+    /// Consumer side, append the formatted records to \p out.
+    void pop( std::string& out, std::string& msg ) {
+        const size_t head = m_head.load( std::memory_order_acquire );
+        size_t tail       = m_tail.load( std::memory_order_relaxed );
+        while ( tail != head ) {
+            Header header;
+            read( tail, &header, sizeof( Header ) );
+            msg.resize( header.m_size );
+            read( tail + sizeof( Header ), &msg[0], header.m_size );
+            Output2FILE::Format(
+                TLogLevel( header.m_level ), std::time_t( header.m_time ), msg, out );
+            tail += sizeof( Header ) + header.m_size;
+        }
+        m_tail.store( tail, std::memory_order_release );
+    }
+
+  private:
+    struct Header {
+        uint32_t m_size;
+        int32_t m_level;
+        int64_t m_time;
+    };
+
+    void write( size_t pos, const void* src, size_t size ) {
+        const size_t begin = pos % m_data.size();
+        const size_t first = std::min( size, m_data.size() - begin );
+        std::memcpy( m_data.data() + begin, src, first );
+        std::memcpy( m_data.data(), static_cast<const char*>( src ) + first, size - first );
+    }
+
+    void read( size_t pos, void* dst, size_t size ) const {
+        const size_t begin = pos % m_data.size();
+        const size_t first = std::min( size, m_data.size() - begin );
+        std::memcpy( dst, m_data.data() + begin, first );
+        std::memcpy( static_cast<char*>( dst ) + first, m_data.data(), size - first );
+    }
+
+    static void writeAll( int fd, const char* data, size_t size ) {
+        while ( size > 0 ) {
+#ifdef OS_WINDOWS
+            const auto written = _write( fd, data, unsigned( size ) );
+#else
+            const auto written = ::write( fd, data, size );
+#endif
+            if ( written <= 0 ) { return; }
+            data += written;
+            size -= size_t( written );
+        }
+    }
+
+    std::vector<char> m_data;
+    /// Monotonic write and read positions, on their own cache lines.
+    alignas( 64 ) std::atomic<size_t> m_head { 0 };
+    alignas( 64 ) std::atomic<size_t> m_tail { 0 };
+};
+
+struct AsyncLogState {
+    std::atomic<bool> m_running { false };
+    size_t m_bufferSize { 0 };
+    /// Protects start and stop.
+    std::mutex m_controlMutex;
+    std::thread m_writer;
+    /// Buffers of the logging threads, a buffer being removed once empty and its thread ended.
+    std::mutex m_buffersMutex;
+    std::vector<std::shared_ptr<RingBuffer>> m_buffers;
+    /// Serializes the writes of the pending messages.
+    std::mutex m_writeMutex;
+    std::string m_out;
+    std::string m_msg;
+    /// Wakes the writer thread before its period when a buffer is filling up.
+    std::mutex m_wakeMutex;
+    std::condition_variable m_wake;
+    std::atomic<bool> m_wakeRequested { false };
+    bool m_handlersInstalled { false };
+};
+
+/// Never destroyed, so that messages can be written at exit.
+AsyncLogState& state() {
+    static AsyncLogState* s = new AsyncLogState;
+    return *s;
+}
+
+constexpr std::chrono::milliseconds writerPeriod { 20 };
+
+/// Buffers and file descriptor read by the crash handler, which can neither lock nor allocate.
+/// Buffers beyond the slot count are not written on crashes.
+constexpr size_t crashBufferCount = 256;
+std::atomic<RingBuffer*> crashBuffers[crashBufferCount];
+std::atomic<int> crashFd { -1 };
+
+void registerCrashBuffer( RingBuffer* buffer ) {
+    for ( auto& slot : crashBuffers ) {
+        RingBuffer* expected = nullptr;
+        if ( slot.compare_exchange_strong( expected, buffer ) ) { return; }
+    }
+}
+
+void unregisterCrashBuffer( RingBuffer* buffer ) {
+    for ( auto& slot : crashBuffers ) {
+        RingBuffer* expected = buffer;
+        if ( slot.compare_exchange_strong( expected, nullptr ) ) { return; }
+    }
+}
+
+void updateCrashFd() {
+    FILE* stream = Output2FILE::Stream();
+#ifdef OS_WINDOWS
+    crashFd = stream ? _fileno( stream ) : -1;
+#else
+    crashFd = stream ? fileno( stream ) : -1;
+#endif
+}
+
+/// Write the pending messages.
+void writePending() {
+    auto& s = state();
+    std::lock_guard<std::mutex> writeLock( s.m_writeMutex );
+    std::unique_lock<std::mutex> buffersLock( s.m_buffersMutex );
+    auto buffers = s.m_buffers;
+    buffersLock.unlock();
+
+    updateCrashFd();
+    s.m_out.clear();
+    for ( const auto& buffer : buffers ) {
+        buffer->pop( s.m_out, s.m_msg );
+    }
+    if ( !s.m_out.empty() ) { Output2FILE::Output( s.m_out ); }
+
+    // release the buffers of the ended threads (only referenced by the registry and the copy)
+    buffers.clear();
+    buffersLock.lock();
+    auto released = std::partition(
+        s.m_buffers.begin(), s.m_buffers.end(), []( const std::shared_ptr<RingBuffer>& buffer ) {
+            return buffer.use_count() > 1 || !buffer->empty();
+        } );
+    for ( auto it = released; it != s.m_buffers.end(); ++it ) {
+        unregisterCrashBuffer( it->get() );
+    }
+    s.m_buffers.erase( released, s.m_buffers.end() );
+}
+
+void writerLoop() {
+    auto& s = state();
+    while ( s.m_running.load( std::memory_order_acquire ) ) {
+        {
+            std::unique_lock<std::mutex> lock( s.m_wakeMutex );
+            s.m_wake.wait_for( lock, writerPeriod, [&s]() {
+                return s.m_wakeRequested.load() || !s.m_running.load();
+            } );
+            s.m_wakeRequested = false;
+        }
+        writePending();
+    }
+}
+
+#ifdef SIGTRAP
+constexpr int crashSignals[] = { SIGSEGV, SIGABRT, SIGFPE, SIGILL, SIGTRAP };
+#else
+constexpr int crashSignals[] = { SIGSEGV, SIGABRT, SIGFPE, SIGILL };
+#endif
+constexpr size_t crashSignalCount = sizeof( crashSignals ) / sizeof( int );
+#ifdef OS_WINDOWS
+using SignalHandler = void ( * )( int );
+SignalHandler previousHandlers[crashSignalCount];
+#else
+struct sigaction previousActions[crashSignalCount];
+#endif
+
+/// Write the raw pending messages, then forward the signal to the previous handler.
+/// \note Only async-signal-safe calls are made, since the crashing thread may hold any lock.
+void crashHandler( int signal ) {
+    state().m_running = false;
+    const int fd      = crashFd.load();
+    if ( fd >= 0 ) {
+        for ( auto& slot : crashBuffers ) {
+            if ( const RingBuffer* buffer = slot.load() ) { buffer->dump( fd ); }
+        }
+    }
+    for ( size_t i = 0; i < crashSignalCount; ++i ) {
+        if ( crashSignals[i] == signal ) {
+#ifdef OS_WINDOWS
+            std::signal( signal, previousHandlers[i] == SIG_ERR ? SIG_DFL : previousHandlers[i] );
+#else
+            // the handler was reset to the default action on entry (SA_RESETHAND)
+            sigaction( signal, &previousActions[i], nullptr );
+#endif
+        }
+    }
+    // delivered once the handler returns, the signal being blocked meanwhile
+    std::raise( signal );
+}
+
+void installHandlers() {
+    for ( size_t i = 0; i < crashSignalCount; ++i ) {
+#ifdef OS_WINDOWS
+        previousHandlers[i] = std::signal( crashSignals[i], crashHandler );
+#else
+        struct sigaction action;
+        std::memset( &action, 0, sizeof( action ) );
+        action.sa_handler = crashHandler;
+        action.sa_flags   = SA_RESETHAND;
+        sigemptyset( &action.sa_mask );
+        sigaction( crashSignals[i], &action, &previousActions[i] );
+#endif
+    }
+    std::atexit( AsyncLog::Stop );
+}
+
+} // namespace
+
+void AsyncLog::Start( size_t bufferSize ) {
+    auto& s = state();
+    std::lock_guard<std::mutex> lock( s.m_controlMutex );
+    if ( s.m_running ) { return; }
+    if ( !s.m_handlersInstalled ) {
+        installHandlers();
+        s.m_handlersInstalled = true;
+    }
+    updateCrashFd();
+    s.m_bufferSize = bufferSize;
+    s.m_running    = true;
+    s.m_writer     = std::thread( writerLoop );
+}
+
+void AsyncLog::Stop() {
+    auto& s = state();
+    std::lock_guard<std::mutex> lock( s.m_controlMutex );
+    if ( !s.m_running.exchange( false ) ) { return; }
+    {
+        std::lock_guard<std::mutex> wakeLock( s.m_wakeMutex );
+        s.m_wake.notify_all();
+    }
+    if ( s.m_writer.joinable() ) { s.m_writer.join(); }
+    writePending();
+}
+
+bool AsyncLog::IsRunning() {
+    return state().m_running.load( std::memory_order_acquire );
+}
+
+void AsyncLog::Flush() {
+    writePending();
+}
+
+bool AsyncLog::Push( TLogLevel level, std::time_t time, const std::string& msg ) {
+    auto& s = state();
+    if ( !s.m_running ) { return false; }
+    thread_local std::shared_ptr<RingBuffer> buffer;
+    if ( !buffer || buffer->getCapacity() != s.m_bufferSize ) {
+        buffer = std::make_shared<RingBuffer>( s.m_bufferSize );
+        std::lock_guard<std::mutex> lock( s.m_buffersMutex );
+        s.m_buffers.push_back( buffer );
+        registerCrashBuffer( buffer.get() );
+    }
+    if ( !buffer->canHold( msg.size() ) ) { return false; }
+
+    while ( !buffer->push( level, time, msg ) ) {
+        // the writer is late, wake it and wait for room
+        if ( !s.m_running ) { return false; }
+        s.m_wakeRequested = true;
+        s.m_wake.notify_one();
+        std::this_thread::yield();
+    }
+    if ( buffer->isFilling() && !s.m_wakeRequested.exchange( true ) ) { s.m_wake.notify_one(); }
+    // the backend was stopped while pushing, write the message now
+    if ( !s.m_running ) { writePending(); }
+    return true;
+}
+
+} // namespace Utils
+} // namespace Core
+} // namespace Ra
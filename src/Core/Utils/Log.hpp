@@ -2,15 +2,18 @@
 
 #include <Core/RaCore.hpp>
 #include <ctime>
+#include <memory>
 #include <sstream>
 #include <stdio.h>
 #include <string>
+#include <vector>
 
 namespace Ra {
 namespace Core {
 namespace Utils {
 
 inline std::string NowTime();
+inline std::string FormatTime( std::time_t time );
 
 enum TLogLevel {
     logERROR,
@@ -37,28 +40,44 @@ class Log
     static TLogLevel FromString( const std::string& level );
 
   protected:
-    std::ostringstream os;
+    /// Message stream, reused by the messages of the thread.
+    std::ostringstream& os;
+    /// Level and time of the message, formatted by the output (possibly in another thread).
+    TLogLevel m_level { logINFO };
+    std::time_t m_time { 0 };
 
   private:
     Log( const Log& );
     Log& operator=( const Log& );
+
+    /// Message streams of a thread, nested messages (e.g. logged while formatting another one)
+    /// using their own stream.
+    struct Streams {
+        std::vector<std::unique_ptr<std::ostringstream>> m_streams;
+        size_t m_depth { 0 };
+    };
+    static Streams& ThreadStreams();
+
+    /// Return a cleared stream of the calling thread.
+    static std::ostringstream& AcquireStream();
+    static void ReleaseStream();
 };
 
 template <typename T>
-Log<T>::Log() {}
+Log<T>::Log() : os( AcquireStream() ) {}
 
 template <typename T>
 std::ostringstream& Log<T>::Get( TLogLevel level ) {
-    os << "- " << NowTime();
-    os << " " << ToString( level ) << ": ";
-    os << std::string( level > logDEBUG ? level - logDEBUG : 0, '\t' );
+    m_level = level;
+    m_time  = std::time( nullptr );
     return os;
 }
 
 template <typename T>
 Log<T>::~Log() {
-    os << std::endl;
-    T::Output( os.str() );
+    os << '\n';
+    T::Output( m_level, m_time, os.str() );
+    ReleaseStream();
 }
 
 template <typename T>
@@ -89,10 +108,80 @@ TLogLevel Log<T>::FromString( const std::string& level ) {
     return logINFO;
 }
 
+template <typename T>
+typename Log<T>::Streams& Log<T>::ThreadStreams() {
+    thread_local Streams streams;
+    return streams;
+}
+
+template <typename T>
+std::ostringstream& Log<T>::AcquireStream() {
+    auto& streams = ThreadStreams();
+    if ( streams.m_depth == streams.m_streams.size() ) {
+        streams.m_streams.push_back( std::make_unique<std::ostringstream>() );
+    }
+    auto& stream = *streams.m_streams[streams.m_depth++];
+    stream.str( std::string() );
+    stream.clear();
+    // reset the formatting state left by the previous message
+    stream.flags( std::ios_base::skipws | std::ios_base::dec );
+    stream.precision( 6 );
+    stream.width( 0 );
+    stream.fill( ' ' );
+    return stream;
+}
+
+template <typename T>
+void Log<T>::ReleaseStream() {
+    --ThreadStreams().m_depth;
+}
+
+/**
+ * \brief Asynchronous backend of Output2FILE.
+ *
+ * When running, messages are not written by the logging threads, but queued with their level and
+ * time in a lock-free ring buffer owned by the thread, and formatted and written by a background
+ * writer thread. Logging from loading or animation threads then does not wait on the stream.
+ *
+ * Pending messages are written when the backend is stopped (at the latest at exit), and when the
+ * program crashes (SIGSEGV, SIGABRT, SIGFPE, SIGILL, SIGTRAP). In the latter case they are written
+ * raw, with their level but without their time, by an async-signal-safe handler.
+ * Messages too large for the ring buffer, or logged while the backend is stopped, are written
+ * synchronously. Messages of different threads may be written out of order, their time being
+ * the one they were logged at.
+ */
+class RA_CORE_API AsyncLog
+{
+  public:
+    /// Start the writer thread, the ring buffer of each logging thread having \p bufferSize bytes.
+    static void Start( size_t bufferSize = size_t( 1 ) << 16 );
+
+    /// Write the pending messages and stop the writer thread.
+    static void Stop();
+
+    static bool IsRunning();
+
+    /// Write the messages queued before the call, from the calling thread.
+    static void Flush();
+
+    /// Queue a message, waiting for room if the ring buffer of the thread is full.
+    /// \returns false if the message is not queued, i.e. the backend is not running or the message
+    /// is larger than the ring buffer.
+    static bool Push( TLogLevel level, std::time_t time, const std::string& msg );
+};
+
 class Output2FILE
 {
   public:
     static FILE*& Stream();
+    /// Output a message logged at \p time, queued to AsyncLog when running.
+    static void Output( TLogLevel level, std::time_t time, const std::string& msg );
+    /// Write a message synchronously.
+    static void Write( TLogLevel level, std::time_t time, const std::string& msg );
+    /// Append the formatted message to \p out.
+    static void
+    Format( TLogLevel level, std::time_t time, const std::string& msg, std::string& out );
+    /// Write an already formatted message.
     static void Output( const std::string& msg );
 };
 
@@ -101,6 +190,28 @@ inline FILE*& Output2FILE::Stream() {
     return pStream;
 }
 
+inline void Output2FILE::Output( TLogLevel level, std::time_t time, const std::string& msg ) {
+    if ( AsyncLog::IsRunning() && AsyncLog::Push( level, time, msg ) ) { return; }
+    Write( level, time, msg );
+}
+
+inline void Output2FILE::Write( TLogLevel level, std::time_t time, const std::string& msg ) {
+    std::string out;
+    Format( level, time, msg, out );
+    Output( out );
+}
+
+inline void
+Output2FILE::Format( TLogLevel level, std::time_t time, const std::string& msg, std::string& out ) {
+    out += "- ";
+    out += FormatTime( time );
+    out += ' ';
+    out += Log<Output2FILE>::ToString( level );
+    out += ": ";
+    out.append( level > logDEBUG ? level - logDEBUG : 0, '\t' );
+    out += msg;
+}
+
 inline void Output2FILE::Output( const std::string& msg ) {
     FILE* pStream = Stream();
     if ( !pStream ) { return; }
@@ -113,8 +224,11 @@ class FILELog : public Log<Output2FILE>
 // using FILELog = Log<Output2FILE>;
 
 inline std::string NowTime() {
+    return FormatTime( std::time( nullptr ) );
+}
+
+inline std::string FormatTime( std::time_t t ) {
     char buffer[100];
-    std::time_t t = std::time( nullptr );
     ON_ASSERT( int ok = ) std::strftime( buffer, 100, "%X", std::localtime( &t ) );
     CORE_ASSERT( ok, "Increase buffer size." );
     std::string result( buffer );
@@ -0,0 +1,121 @@
+#include <Core/Utils/Log.hpp>
+#include <Core/Utils/MappedFile.hpp>
+
+#ifdef OS_WINDOWS
+#    ifndef NOMINMAX
+#        define NOMINMAX
+#    endif
+#    include <windows.h>
+#else
+#    include <fcntl.h>
+#    include <sys/mman.h>
+#    include <sys/stat.h>
+#    include <unistd.h>
+#endif
+
+namespace Ra {
+namespace Core {
+namespace Utils {
+
+MappedFile::MappedFile( const std::string& filename, Mode mode, size_t offset, size_t length ) :
+    m_filename { filename }, m_mode { mode } {
+#ifdef OS_WINDOWS
+    HANDLE file = CreateFileA( filename.c_str(),
+                               GENERIC_READ,
+                               FILE_SHARE_READ,
+                               nullptr,
+                               OPEN_EXISTING,
+                               FILE_ATTRIBUTE_NORMAL,
+                               nullptr );
+    if ( file == INVALID_HANDLE_VALUE ) {
+        LOG( logERROR ) << "MappedFile: cannot open " << filename;
+        return;
+    }
+    LARGE_INTEGER fileSize;
+    GetFileSizeEx( file, &fileSize );
+    const size_t size = size_t( fileSize.QuadPart );
+    SYSTEM_INFO info;
+    GetSystemInfo( &info );
+    const size_t granularity = info.dwAllocationGranularity;
+#else
+    int fd = open( filename.c_str(), O_RDONLY );
+    if ( fd < 0 ) {
+        LOG( logERROR ) << "MappedFile: cannot open " << filename;
+        return;
+    }
+    struct stat st;
+    fstat( fd, &st );
+    const size_t size        = size_t( st.st_size );
+    const size_t granularity = size_t( sysconf( _SC_PAGESIZE ) );
+#endif
+
+    if ( length == 0 && offset < size ) { length = size - offset; }
+    if ( length == 0 || offset + length > size ) {
+        LOG( logERROR ) << "MappedFile: invalid region [" << offset << ", " << offset + length
+                        << ") for " << filename << " of size " << size;
+#ifdef OS_WINDOWS
+        CloseHandle( file );
+#else
+        close( fd );
+#endif
+        return;
+    }
+
+    // mapping offset must be aligned on the allocation granularity
+    const size_t alignedOffset = offset - offset % granularity;
+    m_mappingSize              = length + ( offset - alignedOffset );
+
+#ifdef OS_WINDOWS
+    HANDLE mapping = CreateFileMappingA( file, nullptr, PAGE_WRITECOPY, 0, 0, nullptr );
+    if ( mapping != nullptr ) {
+        m_mapping = MapViewOfFile( mapping,
+                                   mode == Mode::CopyOnWrite ? FILE_MAP_COPY : FILE_MAP_READ,
+                                   DWORD( uint64_t( alignedOffset ) >> 32 ),
+                                   DWORD( alignedOffset & 0xFFFFFFFF ),
+                                   m_mappingSize );
+        // the view keeps a reference on the mapping object
+        CloseHandle( mapping );
+    }
+    CloseHandle( file );
+#else
+    void* ptr = mmap( nullptr,
+                      m_mappingSize,
+                      mode == Mode::CopyOnWrite ? PROT_READ | PROT_WRITE : PROT_READ,
+                      MAP_PRIVATE,
+                      fd,
+                      off_t( alignedOffset ) );
+    m_mapping = ptr == MAP_FAILED ? nullptr : ptr;
+    // the mapping keeps a reference on the file
+    close( fd );
+#endif
+
+    if ( m_mapping == nullptr ) {
+        LOG( logERROR ) << "MappedFile: cannot map " << filename;
+        m_mappingSize = 0;
+        return;
+    }
+    m_data = static_cast<char*>( m_mapping ) + ( offset - alignedOffset );
+    m_size = length;
+}
+
+MappedFile::~MappedFile() {
+    unmap();
+}
+
+void MappedFile::unmap() {
+    if ( m_mapping != nullptr ) {
+#ifdef OS_WINDOWS
+        UnmapViewOfFile( m_mapping );
+#else
+        munmap( m_mapping, m_mappingSize );
+#endif
+    }
+    m_mapping     = nullptr;
+    m_mappingSize = 0;
+    m_data        = nullptr;
+    m_size        = 0;
+}
+
+} // namespace Utils
+} // namespace Core
+} // namespace Ra
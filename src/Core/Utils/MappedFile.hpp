@@ -0,0 +1,76 @@
+#pragma once
+
+#include <Core/RaCore.hpp>
+
+#include <cstddef>
+#include <string>
+
+namespace Ra {
+namespace Core {
+namespace Utils {
+
+/**
+ * \brief RAII memory mapping of a file region.
+ *
+ * Pages are loaded by the OS on demand, so that mapping a huge file is instantaneous and only
+ * the accessed parts consume memory.
+ *
+ * In ReadOnly mode the mapped memory must not be written. In CopyOnWrite mode the mapped memory
+ * can be written, modified pages are private to the process and never written back to the file.
+ *
+ * \see Attrib::setMappedData to use a mapped region as attribute storage.
+ */
+class RA_CORE_API MappedFile
+{
+  public:
+    enum class Mode { ReadOnly, CopyOnWrite };
+
+    /**
+     * Map \p length bytes of \p filename, starting at byte \p offset.
+     * \param length number of bytes to map, 0 to map up to the end of the file.
+     * \note On failure, an error is logged and isValid() returns false.
+     */
+    explicit MappedFile( const std::string& filename,
+                         Mode mode     = Mode::ReadOnly,
+                         size_t offset = 0,
+                         size_t length = 0 );
+    ~MappedFile();
+
+    MappedFile( const MappedFile& )            = delete;
+    MappedFile& operator=( const MappedFile& ) = delete;
+
+    /// Return true if the file is mapped.
+    bool isValid() const { return m_data != nullptr; }
+
+    /// Return the mapping mode.
+    Mode getMode() const { return m_mode; }
+
+    /// Return the mapped file name.
+    const std::string& getFilename() const { return m_filename; }
+
+    /// Return the number of mapped bytes.
+    size_t size() const { return m_size; }
+
+    /// Read-only access to the mapped bytes.
+    const void* data() const { return m_data; }
+
+    /// Read-write access to the mapped bytes, nullptr if the mapping is read only.
+    void* writableData() { return m_mode == Mode::CopyOnWrite ? m_data : nullptr; }
+
+  private:
+    void unmap();
+
+    std::string m_filename;
+    Mode m_mode;
+    /// Start of the requested region.
+    void* m_data { nullptr };
+    /// Size of the requested region.
+    size_t m_size { 0 };
+    /// Start and size of the mapping, which is aligned on the system allocation granularity.
+    void* m_mapping { nullptr };
+    size_t m_mappingSize { 0 };
+};
+
+} // namespace Utils
+} // namespace Core
+} // namespace Ra
@@ -0,0 +1,118 @@
+#include <Core/Utils/MemoryAccounting.hpp>
+
+#include <atomic>
+#include <numeric>
+
+namespace Ra {
+namespace Core {
+namespace Utils {
+
+namespace {
+
+constexpr size_t categoryCount = size_t( MemoryCategory::Count );
+
+struct Counter {
+    std::atomic<int64_t> m_current { 0 };
+    std::atomic<int64_t> m_peak { 0 };
+
+    void add( int64_t bytes ) {
+        const int64_t current = m_current.fetch_add( bytes, std::memory_order_relaxed ) + bytes;
+        int64_t peak          = m_peak.load( std::memory_order_relaxed );
+        while ( current > peak &&
+                !m_peak.compare_exchange_weak( peak, current, std::memory_order_relaxed ) ) {}
+    }
+};
+
+struct Counters {
+    std::array<Counter, categoryCount> m_categories;
+    Counter m_total;
+};
+
+/// Never destroyed, so that static containers can be released after the static destructors.
+Counters& counters() {
+    static Counters* c = new Counters;
+    return *c;
+}
+
+size_t toSize( int64_t bytes ) {
+    return bytes > 0 ? size_t( bytes ) : 0;
+}
+
+} // namespace
+
+size_t MemoryUsage::getTotal() const {
+    return std::accumulate( m_bytes.begin(), m_bytes.end(), size_t( 0 ) );
+}
+
+MemoryUsage& MemoryUsage::operator+=( const MemoryUsage& other ) {
+    for ( size_t i = 0; i < m_bytes.size(); ++i ) {
+        m_bytes[i] += other.m_bytes[i];
+    }
+    return *this;
+}
+
+void MemoryAccounting::add( MemoryCategory category, int64_t bytes ) {
+    if ( bytes == 0 ) { return; }
+    auto& c = counters();
+    c.m_categories[size_t( category )].add( bytes );
+    c.m_total.add( bytes );
+}
+
+MemoryUsage MemoryAccounting::getUsage() {
+    MemoryUsage usage;
+    for ( size_t i = 0; i < categoryCount; ++i ) {
+        usage.m_bytes[i] =
+            toSize( counters().m_categories[i].m_current.load( std::memory_order_relaxed ) );
+    }
+    return usage;
+}
+
+MemoryUsage MemoryAccounting::getPeak() {
+    MemoryUsage usage;
+    for ( size_t i = 0; i < categoryCount; ++i ) {
+        usage.m_bytes[i] =
+            toSize( counters().m_categories[i].m_peak.load( std::memory_order_relaxed ) );
+    }
+    return usage;
+}
+
+size_t MemoryAccounting::getTotalUsage() {
+    return toSize( counters().m_total.m_current.load( std::memory_order_relaxed ) );
+}
+
+size_t MemoryAccounting::getTotalPeak() {
+    return toSize( counters().m_total.m_peak.load( std::memory_order_relaxed ) );
+}
+
+void MemoryAccounting::resetPeaks() {
+    auto& c = counters();
+    for ( auto& counter : c.m_categories ) {
+        counter.m_peak.store( counter.m_current.load( std::memory_order_relaxed ),
+                              std::memory_order_relaxed );
+    }
+    c.m_total.m_peak.store( c.m_total.m_current.load( std::memory_order_relaxed ),
+                            std::memory_order_relaxed );
+}
+
+std::string MemoryAccounting::getCategoryName( MemoryCategory category ) {
+    switch ( category ) {
+    case MemoryCategory::CpuAttributes:
+        return "CPU attributes";
+    case MemoryCategory::MeshCopies:
+        return "Mesh copies";
+    case MemoryCategory::GpuBuffers:
+        return "GPU buffers";
+    case MemoryCategory::Textures:
+        return "Textures";
+    case MemoryCategory::Skinning:
+        return "Skinning";
+    case MemoryCategory::Animation:
+        return "Animation";
+    default:
+        return "Unknown";
+    }
+}
+
+} // namespace Utils
+} // namespace Core
+} // namespace Ra
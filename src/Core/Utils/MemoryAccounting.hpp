@@ -0,0 +1,127 @@
+#pragma once
+
+#include <Core/RaCore.hpp>
+
+#include <array>
+#include <cstdint>
+#include <string>
+
+namespace Ra {
+namespace Core {
+namespace Utils {
+
+/// Subsystems the memory is accounted for.
+enum class MemoryCategory : int {
+    CpuAttributes = 0, ///< Attributes and index layers of the core geometries.
+    MeshCopies,        ///< Core geometries owned by the engine displayables.
+    GpuBuffers,        ///< Vertex and index buffers.
+    Textures,          ///< Texture images on the GPU.
+    Skinning,          ///< Skinning reference and per-frame data.
+    Animation,         ///< Animation clips and baked poses.
+    Count
+};
+
+/// Memory used by each category, in bytes.
+struct RA_CORE_API MemoryUsage {
+    std::array<size_t, size_t( MemoryCategory::Count )> m_bytes {};
+
+    size_t& operator[]( MemoryCategory c ) { return m_bytes[size_t( c )]; }
+    size_t operator[]( MemoryCategory c ) const { return m_bytes[size_t( c )]; }
+
+    /// Return the memory used by all the categories.
+    size_t getTotal() const;
+
+    MemoryUsage& operator+=( const MemoryUsage& other );
+};
+
+/**
+ * \brief Process-wide byte counters of the memory used by the subsystems.
+ *
+ * The counters are updated with atomic operations, each one keeping its high-water mark. They are
+ * usually updated through TrackedMemory objects owned by the containers.
+ * Engine::RadiumEngine::getMemoryReport() adds the usage per entity and component.
+ */
+class RA_CORE_API MemoryAccounting
+{
+  public:
+    /// Add \p bytes (may be negative) to the counter of \p category.
+    static void add( MemoryCategory category, int64_t bytes );
+
+    /// Return the memory currently used.
+    static MemoryUsage getUsage();
+
+    /// Return the high-water marks of the categories.
+    static MemoryUsage getPeak();
+
+    /// Return the current and maximal memory used by all the categories together.
+    static size_t getTotalUsage();
+    static size_t getTotalPeak();
+
+    /// Set the high-water marks to the current usage.
+    static void resetPeaks();
+
+    static std::string getCategoryName( MemoryCategory category );
+};
+
+/**
+ * \brief Account \p bytes of memory in a category, for the lifetime of the object.
+ *
+ * Meant as a member of the containers, set when their storage changes. Copies account the same
+ * memory again, moves transfer it.
+ */
+class TrackedMemory
+{
+  public:
+    explicit TrackedMemory( MemoryCategory category ) : m_category( category ) {}
+    TrackedMemory( const TrackedMemory& other ) : m_category( other.m_category ) {
+        set( other.m_bytes );
+    }
+    TrackedMemory( TrackedMemory&& other ) noexcept :
+        m_category( other.m_category ), m_bytes( other.m_bytes ) {
+        other.m_bytes = 0;
+    }
+    TrackedMemory& operator=( const TrackedMemory& other ) {
+        if ( this != &other ) { set( other.m_bytes ); }
+        return *this;
+    }
+    TrackedMemory& operator=( TrackedMemory&& other ) noexcept {
+        if ( this != &other ) {
+            set( 0 );
+            m_bytes       = other.m_bytes;
+            other.m_bytes = 0;
+            MemoryAccounting::add( other.m_category, -int64_t( m_bytes ) );
+            MemoryAccounting::add( m_category, int64_t( m_bytes ) );
+        }
+        return *this;
+    }
+    ~TrackedMemory() { set( 0 ); }
+
+    /// Set the accounted memory to \p bytes.
+    void set( size_t bytes ) {
+        if ( bytes != m_bytes ) {
+            MemoryAccounting::add( m_category, int64_t( bytes ) - int64_t( m_bytes ) );
+            m_bytes = bytes;
+        }
+    }
+    size_t get() const { return m_bytes; }
+
+    /// Move the accounted memory to \p category.
+    void setCategory( MemoryCategory category ) {
+        if ( category == m_category ) { return; }
+        MemoryAccounting::add( m_category, -int64_t( m_bytes ) );
+        MemoryAccounting::add( category, int64_t( m_bytes ) );
+        m_category = category;
+    }
+    MemoryCategory getCategory() const { return m_category; }
+
+    /// Add the accounted memory to \p usage.
+    void addTo( MemoryUsage& usage ) const { usage[m_category] += m_bytes; }
+
+  private:
+    MemoryCategory m_category;
+    size_t m_bytes { 0 };
+};
+
+} // namespace Utils
+} // namespace Core
+} // namespace Ra
@@ -90,6 +90,29 @@ class Observable
 class RA_CORE_API ObservableVoid : public Observable<>
 {};
 
+/// Scope batching the notifications of an object of type \p T, which must provide
+/// beginNotificationBatch() and endNotificationBatch().
+/// \code{.cpp}
+/// {
+///   auto batch = mesh.getScopedNotificationBatch();
+///   // modifications, observers are not notified
+/// } // observers are notified once for all the modifications
+/// \endcode
+template <typename T>
+class ScopedNotificationBatch
+{
+  public:
+    explicit ScopedNotificationBatch( T* object ) : m_object( object ) {
+        m_object->beginNotificationBatch();
+    }
+    ScopedNotificationBatch( const ScopedNotificationBatch& )            = delete;
+    ScopedNotificationBatch& operator=( const ScopedNotificationBatch& ) = delete;
+    ~ScopedNotificationBatch() { m_object->endNotificationBatch(); }
+
+  private:
+    T* m_object;
+};
+
 } // namespace Utils
 } // namespace Core
 } // namespace Ra
@@ -0,0 +1,277 @@
+#include <Core/Utils/Profiler.hpp>
+#include <Core/Utils/Timer.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <iomanip>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace Ra {
+namespace Core {
+namespace Utils {
+
+namespace {
+
+constexpr int maxZoneCount = 1024;
+constexpr int rootZone     = -1;
+/// Zones beyond maxZoneCount, and their children, are not recorded.
+constexpr int untrackedZone = -2;
+
+struct Zone {
+    /// Set once, before the zone is published by ProfilerState::m_zoneCount.
+    std::string m_name;
+    int m_parent { rootZone };
+
+    /// Totals of the current frame, updated by the profiled threads.
+    std::atomic<int64_t> m_frameTime { 0 };
+    std::atomic<uint32_t> m_frameCalls { 0 };
+
+    /// Window of the last frames (ring buffer), updated under ProfilerState::m_historyMutex.
+    struct Sample {
+        double m_time;
+        uint32_t m_calls;
+    };
+    std::vector<Sample> m_samples;
+    size_t m_next { 0 };
+};
+
+struct ProfilerState {
+    std::atomic<bool> m_enabled { false };
+    std::unique_ptr<Zone[]> m_zones { new Zone[maxZoneCount] };
+    std::atomic<int> m_zoneCount { 0 };
+    /// Protects the zone creation.
+    std::mutex m_registryMutex;
+    std::map<std::pair<int, std::string>, int> m_registry;
+    /// Names returned by internName(), the nodes of the set being stable.
+    std::mutex m_namesMutex;
+    std::unordered_set<std::string> m_names;
+    /// Protects the windows.
+    std::mutex m_historyMutex;
+    size_t m_windowSize { 120 };
+};
+
+/// Never destroyed, so that zones can be closed by threads ending after the static destructors.
+ProfilerState& state() {
+    static ProfilerState* s = new ProfilerState;
+    return *s;
+}
+
+struct ThreadZones {
+    struct OpenZone {
+        int m_zone;
+        TimePoint m_start;
+    };
+    struct KeyHash {
+        size_t operator()( const std::pair<int, const char*>& key ) const {
+            return std::hash<const char*>()( key.second ) ^ ( std::hash<int>()( key.first ) << 1 );
+        }
+    };
+    std::vector<OpenZone> m_stack;
+    /// Cache of the zone ids, by parent zone and name address.
+    std::unordered_map<std::pair<int, const char*>, int, KeyHash> m_ids;
+};
+
+ThreadZones& threadZones() {
+    thread_local ThreadZones zones;
+    return zones;
+}
+
+/// Return the zone \p name child of \p parent, creating it if needed.
+int findZone( int parent, const char* name ) {
+    auto& s = state();
+    std::lock_guard<std::mutex> lock( s.m_registryMutex );
+    auto it = s.m_registry.find( { parent, name } );
+    if ( it != s.m_registry.end() ) { return it->second; }
+    const int zone = s.m_zoneCount.load( std::memory_order_relaxed );
+    if ( zone == maxZoneCount ) { return untrackedZone; }
+    s.m_zones[zone].m_name   = name;
+    s.m_zones[zone].m_parent = parent;
+    s.m_registry.emplace( std::make_pair( parent, std::string( name ) ), zone );
+    s.m_zoneCount.store( zone + 1, std::memory_order_release );
+    return zone;
+}
+
+/// Return the \p p percentile (nearest rank) of the sorted \p values.
+double percentile( const std::vector<double>& values, double p ) {
+    const size_t rank = size_t( std::ceil( p * double( values.size() ) ) );
+    return values[std::min( std::max( rank, size_t( 1 ) ), values.size() ) - 1];
+}
+
+} // namespace
+
+void Profiler::setEnabled( bool enabled ) {
+    state().m_enabled.store( enabled, std::memory_order_relaxed );
+}
+
+bool Profiler::isEnabled() {
+    return state().m_enabled.load( std::memory_order_relaxed );
+}
+
+void Profiler::setWindowSize( size_t frameCount ) {
+    CORE_ASSERT( frameCount > 0, "Empty profiler window." );
+    {
+        std::lock_guard<std::mutex> lock( state().m_historyMutex );
+        state().m_windowSize = frameCount;
+    }
+    reset();
+}
+
+size_t Profiler::getWindowSize() {
+    std::lock_guard<std::mutex> lock( state().m_historyMutex );
+    return state().m_windowSize;
+}
+
+bool Profiler::beginZone( const char* name ) {
+    if ( !name || !isEnabled() ) { return false; }
+    auto& thread     = threadZones();
+    const int parent = thread.m_stack.empty() ? rootZone : thread.m_stack.back().m_zone;
+    int zone         = untrackedZone;
+    if ( parent != untrackedZone ) {
+        auto it = thread.m_ids.find( { parent, name } );
+        if ( it == thread.m_ids.end() ) {
+            it = thread.m_ids.emplace( std::make_pair( parent, name ), findZone( parent, name ) )
+                     .first;
+        }
+        zone = it->second;
+    }
+    thread.m_stack.push_back( { zone, Clock::now() } );
+    return true;
+}
+
+void Profiler::endZone() {
+    const auto end = Clock::now();
+    auto& thread   = threadZones();
+    CORE_ASSERT( !thread.m_stack.empty(), "No open profiler zone." );
+    const auto open = thread.m_stack.back();
+    thread.m_stack.pop_back();
+    if ( open.m_zone < 0 ) { return; }
+    auto& zone = state().m_zones[open.m_zone];
+    zone.m_frameTime.fetch_add(
+        std::chrono::duration_cast<std::chrono::nanoseconds>( end - open.m_start ).count(),
+        std::memory_order_relaxed );
+    zone.m_frameCalls.fetch_add( 1, std::memory_order_relaxed );
+}
+
+const char* Profiler::internName( const std::string& name ) {
+    auto& s = state();
+    std::lock_guard<std::mutex> lock( s.m_namesMutex );
+    return s.m_names.insert( name ).first->c_str();
+}
+
+void Profiler::nextFrame() {
+    auto& s = state();
+    std::lock_guard<std::mutex> lock( s.m_historyMutex );
+    const int zoneCount = s.m_zoneCount.load( std::memory_order_acquire );
+    for ( int i = 0; i < zoneCount; ++i ) {
+        auto& zone           = s.m_zones[i];
+        const int64_t time   = zone.m_frameTime.exchange( 0, std::memory_order_relaxed );
+        const uint32_t calls = zone.m_frameCalls.exchange( 0, std::memory_order_relaxed );
+        if ( calls == 0 ) { continue; }
+        // nanoseconds to milliseconds
+        const Zone::Sample sample { double( time ) * 1e-6, calls };
+        if ( zone.m_samples.size() < s.m_windowSize ) { zone.m_samples.push_back( sample ); }
+        else { zone.m_samples[zone.m_next] = sample; }
+        zone.m_next = ( zone.m_next + 1 ) % s.m_windowSize;
+    }
+}
+
+std::vector<Profiler::ZoneStats> Profiler::getStats() {
+    auto& s = state();
+    std::lock_guard<std::mutex> lock( s.m_historyMutex );
+    const int zoneCount = s.m_zoneCount.load( std::memory_order_acquire );
+    std::vector<std::vector<int>> children( zoneCount );
+    std::vector<int> roots;
+    for ( int i = 0; i < zoneCount; ++i ) {
+        const int parent = s.m_zones[i].m_parent;
+        ( parent == rootZone ? roots : children[parent] ).push_back( i );
+    }
+
+    std::vector<ZoneStats> stats;
+    std::vector<double> times;
+    // depth-first traversal, zones without samples being kept if one of their children has some
+    std::function<bool( int, int, int )> visit = [&]( int zone, int parent, int depth ) {
+        const auto& samples = s.m_zones[zone].m_samples;
+        const size_t index  = stats.size();
+        ZoneStats zoneStats {};
+        zoneStats.m_name       = s.m_zones[zone].m_name;
+        zoneStats.m_parent     = parent;
+        zoneStats.m_depth      = depth;
+        zoneStats.m_frameCount = samples.size();
+        if ( !samples.empty() ) {
+            times.clear();
+            double calls = 0;
+            for ( const auto& sample : samples ) {
+                times.push_back( sample.m_time );
+                calls += sample.m_calls;
+                zoneStats.m_mean += sample.m_time;
+            }
+            std::sort( times.begin(), times.end() );
+            zoneStats.m_callsPerFrame = calls / double( samples.size() );
+            zoneStats.m_mean /= double( samples.size() );
+            zoneStats.m_p50 = percentile( times, 0.5 );
+            zoneStats.m_p95 = percentile( times, 0.95 );
+            zoneStats.m_p99 = percentile( times, 0.99 );
+            zoneStats.m_max = times.back();
+        }
+        stats.push_back( zoneStats );
+        bool used = !samples.empty();
+        for ( int child : children[zone] ) {
+            used |= visit( child, int( index ), depth + 1 );
+        }
+        if ( !used ) { stats.resize( index ); }
+        return used;
+    };
+    for ( int root : roots ) {
+        visit( root, -1, 0 );
+    }
+    return stats;
+}
+
+void Profiler::printStats( std::ostream& out ) {
+    const auto stats = getStats();
+    size_t width     = 4;
+    for ( const auto& zone : stats ) {
+        width = std::max( width, 2 * size_t( zone.m_depth ) + zone.m_name.size() );
+    }
+    const auto flags     = out.flags();
+    const auto precision = out.precision();
+    out << std::left << std::setw( int( width ) ) << "Zone" << std::right;
+    for ( const char* column : { "frames", "calls", "mean", "p50", "p95", "p99", "max" } ) {
+        out << std::setw( 10 ) << column;
+    }
+    out << "  (ms)\n" << std::fixed << std::setprecision( 3 );
+    for ( const auto& zone : stats ) {
+        out << std::left << std::setw( int( width ) )
+            << std::string( 2 * size_t( zone.m_depth ), ' ' ) + zone.m_name << std::right
+            << std::setw( 10 ) << zone.m_frameCount << std::setw( 10 ) << zone.m_callsPerFrame
+            << std::setw( 10 ) << zone.m_mean << std::setw( 10 ) << zone.m_p50 << std::setw( 10 )
+            << zone.m_p95 << std::setw( 10 ) << zone.m_p99 << std::setw( 10 ) << zone.m_max
+            << "\n";
+    }
+    out.flags( flags );
+    out.precision( precision );
+}
+
+void Profiler::reset() {
+    auto& s = state();
+    std::lock_guard<std::mutex> lock( s.m_historyMutex );
+    const int zoneCount = s.m_zoneCount.load( std::memory_order_acquire );
+    for ( int i = 0; i < zoneCount; ++i ) {
+        auto& zone = s.m_zones[i];
+        zone.m_frameTime.store( 0, std::memory_order_relaxed );
+        zone.m_frameCalls.store( 0, std::memory_order_relaxed );
+        zone.m_samples.clear();
+        zone.m_next = 0;
+    }
+}
+
+} // namespace Utils
+} // namespace Core
+} // namespace Ra
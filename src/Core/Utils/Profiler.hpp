@@ -0,0 +1,109 @@
+#pragma once
+
+#include <Core/RaCore.hpp>
+
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace Ra {
+namespace Core {
+namespace Utils {
+
+/**
+ * \brief In-process hierarchical profiler, with rolling statistics over the last frames.
+ *
+ * Zones are opened and closed by ScopedProfileZone, usually through the RA_PROFILE_ZONE and
+ * RA_PROFILE_FUNCTION macros, which compile out unless RA_ENABLE_PROFILER is defined (CMake
+ * option RADIUM_ENABLE_PROFILER). Each thread has its own stack of open zones, and a zone is
+ * identified by its name and its parent zone, so that a function profiled from different callers
+ * gives different zones.
+ *
+ * The times spent in a zone are summed over a frame with atomic counters, without locking.
+ * nextFrame() (called by Engine::RadiumEngine::endFrameSync()) pushes the frame totals into a
+ * window of the last frames, on which getStats() computes the percentiles.
+ *
+ * \note Zone names must have static storage duration (e.g. string literals, __func__ or
+ * internName()), since they are identified by address on the hot path.
+ */
+class RA_CORE_API Profiler
+{
+  public:
+    /// Statistics of a zone over the window, times are in milliseconds per frame.
+    struct ZoneStats {
+        std::string m_name;
+        /// Index of the parent zone in the result of getStats(), -1 for root zones.
+        int m_parent;
+        int m_depth;
+        /// Number of frames of the window in which the zone was closed.
+        size_t m_frameCount;
+        /// Mean number of calls in these frames.
+        double m_callsPerFrame;
+        double m_mean;
+        double m_p50;
+        double m_p95;
+        double m_p99;
+        double m_max;
+    };
+
+    /// Enable or disable the profiler at runtime, zones opened while disabled are ignored.
+    static void setEnabled( bool enabled );
+    static bool isEnabled();
+
+    /// Set the number of frames the statistics are computed on (120 by default), clears the
+    /// statistics.
+    static void setWindowSize( size_t frameCount );
+    static size_t getWindowSize();
+
+    /// Open the zone \p name in the calling thread, as a child of its current zone.
+    /// \returns false if the profiler is disabled or \p name is nullptr, the zone not being
+    /// opened.
+    static bool beginZone( const char* name );
+
+    /// Close the current zone of the calling thread.
+    static void endZone();
+
+    /// Return a copy of \p name with static storage duration, to name zones at runtime (e.g.
+    /// after tasks). Equal names give the same pointer, and are kept until the process ends.
+    static const char* internName( const std::string& name );
+
+    /// End the current frame, pushing the times of the frame into the window.
+    static void nextFrame();
+
+    /// Return the statistics of the zones having samples in the window, in depth-first order.
+    static std::vector<ZoneStats> getStats();
+
+    /// Print the statistics as an indented table.
+    static void printStats( std::ostream& out );
+
+    /// Clear the statistics of all the zones.
+    static void reset();
+};
+
+/// Open a profiler zone for the lifetime of the object.
+class ScopedProfileZone
+{
+  public:
+    explicit ScopedProfileZone( const char* name ) : m_open( Profiler::beginZone( name ) ) {}
+    ~ScopedProfileZone() {
+        if ( m_open ) { Profiler::endZone(); }
+    }
+    ScopedProfileZone( const ScopedProfileZone& )            = delete;
+    ScopedProfileZone& operator=( const ScopedProfileZone& ) = delete;
+
+  private:
+    bool m_open;
+};
+
+} // namespace Utils
+} // namespace Core
+} // namespace Ra
+
+#ifdef RA_ENABLE_PROFILER
+#    define RA_PROFILE_ZONE( name ) \
+        Ra::Core::Utils::ScopedProfileZone CONCATENATE( raProfileZone, __LINE__ )( name )
+#    define RA_PROFILE_FUNCTION() RA_PROFILE_ZONE( __func__ )
+#else
+#    define RA_PROFILE_ZONE( name )
+#    define RA_PROFILE_FUNCTION()
+#endif
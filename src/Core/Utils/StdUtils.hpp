@@ -2,6 +2,8 @@
 
 #include <Core/RaCore.hpp>
 
+#include <cstddef>
+#include <cstdint>
 #include <functional>
 
 /// This file contains utilities and wrapper to the standard library
@@ -26,6 +28,21 @@ inline std::size_t hash( const std::pair<T1, T2>& p ) {
     hash_combine( result, p.second );
     return result;
 }
+
+/// Offset basis of the 64 bits FNV-1a hash, the initial value of fnv1a()'s \p seed.
+constexpr uint64_t fnvOffsetBasis = 0xcbf29ce484222325ull;
+
+/// Accumulate the \p size bytes at \p data in the 64 bits FNV-1a hash \p seed.
+/// Unlike std::hash, the result does not depend on the standard library implementation, and
+/// can be saved, e.g. as the key of a disk cache.
+inline uint64_t fnv1a( const void* data, std::size_t size, uint64_t seed = fnvOffsetBasis ) {
+    const auto* bytes = static_cast<const unsigned char*>( data );
+    for ( std::size_t i = 0; i < size; ++i ) {
+        seed ^= bytes[i];
+        seed *= 0x100000001b3ull;
+    }
+    return seed;
+}
 } // namespace Utils
 } // namespace Core
 } // namespace Ra
@@ -5,11 +5,17 @@
 # ----------------------------------------------------
 
 set(core_sources
+    Animation/AnimationBlendTree.cpp
+    Animation/BlendShapes.cpp
     Animation/Cage.cpp
+    Animation/CageDeformation.cpp
+    Animation/CompressedAnimation.cpp
+    Animation/CrowdSkinning.cpp
     Animation/DualQuaternionSkinning.cpp
     Animation/HandleArray.cpp
     Animation/HandleWeightOperation.cpp
     Animation/LinearBlendSkinning.cpp
+    Animation/PackedSkinningWeights.cpp
     Animation/PoseOperation.cpp
     Animation/RotationCenterSkinning.cpp
     Animation/Sequence.cpp
@@ -25,31 +31,45 @@ set(core_sources
     Asset/MaterialData.cpp
     Containers/AdjacencyList.cpp
     Containers/DynamicVisitor.cpp
+    Containers/FrameArena.cpp
     Containers/VariableSet.cpp
     Containers/VariableSetEnumManagement.cpp
     Geometry/CatmullClarkSubdivider.cpp
     Geometry/IndexedGeometry.cpp
     Geometry/LoopSubdivider.cpp
+    Geometry/MeshBvh.cpp
     Geometry/MeshPrimitives.cpp
+    Geometry/NormalStencil.cpp
     Geometry/PolyLine.cpp
     Geometry/RayCast.cpp
+    Geometry/SignedDistanceField.cpp
     Geometry/TopologicalMesh.cpp
     Geometry/TriangleMesh.cpp
     Geometry/Volume.cpp
     Geometry/deprecated/TopologicalMesh.cpp
     Random/RandomPointSet.cpp
+    Random/SurfaceSampler.cpp
     Resources/Resources.cpp
     Tasks/TaskQueue.cpp
     Utils/Attribs.cpp
     Utils/CircularIndex.cpp
     Utils/Color.cpp
+    Utils/Log.cpp
+    Utils/MappedFile.cpp
+    Utils/MemoryAccounting.cpp
+    Utils/Profiler.cpp
     Utils/StackTrace.cpp
     Utils/StringUtils.cpp
     Utils/TypesUtils.cpp
 )
 
 set(core_headers
+    Animation/AnimationBlendTree.hpp
+    Animation/BlendShapes.hpp
     Animation/Cage.hpp
+    Animation/CageDeformation.hpp
+    Animation/CompressedAnimation.hpp
+    Animation/CrowdSkinning.hpp
     Animation/DualQuaternionSkinning.hpp
     Animation/HandleArray.hpp
     Animation/HandleWeight.hpp
@@ -58,6 +78,7 @@ set(core_headers
     Animation/KeyFramedValueController.hpp
     Animation/KeyFramedValueInterpolators.hpp
     Animation/LinearBlendSkinning.hpp
+    Animation/PackedSkinningWeights.hpp
     Animation/Pose.hpp
     Animation/PoseOperation.hpp
     Animation/RotationCenterSkinning.hpp
@@ -83,13 +104,17 @@ set(core_headers
     Containers/AlignedStdVector.hpp
     Containers/DynamicVisitor.hpp
     Containers/DynamicVisitorBase.hpp
+    Containers/FrameArena.hpp
     Containers/Grid.hpp
     Containers/Iterators.hpp
+    Containers/LruCache.hpp
     Containers/MakeShared.hpp
+    Containers/SmallVector.hpp
     Containers/Tex.hpp
     Containers/VariableSet.hpp
     Containers/VariableSetEnumManagement.hpp
     Containers/VectorArray.hpp
+    Containers/VectorArrayKernels.hpp
     CoreMacros.hpp
     Geometry/AbstractGeometry.hpp
     Geometry/CatmullClarkSubdivider.hpp
@@ -97,11 +122,14 @@ set(core_headers
     Geometry/DistanceQueries.hpp
     Geometry/IndexedGeometry.hpp
     Geometry/LoopSubdivider.hpp
+    Geometry/MeshBvh.hpp
     Geometry/MeshPrimitives.hpp
+    Geometry/NormalStencil.hpp
     Geometry/Obb.hpp
     Geometry/OpenMesh.hpp
     Geometry/PolyLine.hpp
     Geometry/RayCast.hpp
+    Geometry/SignedDistanceField.hpp
     Geometry/Spline.hpp
     Geometry/StandardAttribNames.hpp
     Geometry/TopologicalMesh.hpp
@@ -115,6 +143,7 @@ set(core_headers
     Math/Quadric.hpp
     RaCore.hpp
     Random/RandomPointSet.hpp
+    Random/SurfaceSampler.hpp
     Resources/Resources.hpp
     Tasks/Task.hpp
     Tasks/TaskQueue.hpp
@@ -130,8 +159,11 @@ set(core_headers
     Utils/IndexMap.hpp
     Utils/IndexedObject.hpp
     Utils/Log.hpp
+    Utils/MappedFile.hpp
+    Utils/MemoryAccounting.hpp
     Utils/ObjectWithSemantic.hpp
     Utils/Observable.hpp
+    Utils/Profiler.hpp
     Utils/Singleton.hpp
     Utils/StackTrace.hpp
     Utils/StdExperimentalTypeTraits.hpp
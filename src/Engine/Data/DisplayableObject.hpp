@@ -8,6 +8,7 @@
 #include <Core/Containers/VectorArray.hpp>
 #include <Core/Geometry/TriangleMesh.hpp>
 #include <Core/Utils/Color.hpp>
+#include <Core/Utils/MemoryAccounting.hpp>
 
 namespace Ra {
 namespace Engine {
@@ -61,6 +62,9 @@ class RA_ENGINE_API Displayable
     virtual size_t getNumFaces() const { return 0; }
     virtual size_t getNumVertices() const { return 0; }
 
+    /// Add the memory used by the displayable (core geometry, GPU buffers) to \p usage.
+    virtual void addMemoryUsage( Core::Utils::MemoryUsage& /*usage*/ ) const {}
+
   protected:
     PickingRenderMode m_pickingRenderMode { NO_PICKING };
 
@@ -1,5 +1,6 @@
 #include <Engine/Data/DrawPrimitives.hpp>
 
+#include <Core/Containers/VectorArrayKernels.hpp>
 #include <Core/Geometry/MeshPrimitives.hpp>
 #include <Core/Geometry/StandardAttribNames.hpp>
 #include <Core/Utils/Color.hpp>
@@ -290,23 +291,14 @@ MeshPtr Capsule( const Core::Vector3& p1,
     Core::Transform t = Core::Transform::Identity();
     t.rotate( rot );
     t.pretranslate( trans );
-    Matrix3 normalMatrix = t.linear().inverse().transpose();
 
     auto vertHandle = geom.getAttribHandle<TriangleMesh::Point>(
         Ra::Core::Geometry::getAttribName( Ra::Core::Geometry::VERTEX_POSITION ) );
-    auto& vertAttrib = geom.getAttrib<TriangleMesh::Point>( vertHandle );
-    auto& vertData   = vertAttrib.getDataWithLock();
-    std::for_each( vertData.begin(), vertData.end(), [t]( Core::Vector3& v ) { v = t * v; } );
-    vertAttrib.unlock();
+    Core::Kernels::applyTransform( geom.getAttrib<TriangleMesh::Point>( vertHandle ), t );
 
     auto normalHandle = geom.getAttribHandle<TriangleMesh::Point>(
         Ra::Core::Geometry::getAttribName( Ra::Core::Geometry::VERTEX_NORMAL ) );
-    auto& normalAttrib = geom.getAttrib<TriangleMesh::Point>( normalHandle );
-    auto& normalData   = normalAttrib.getDataWithLock();
-    std::for_each( normalData.begin(), normalData.end(), [normalMatrix]( Core::Vector3& n ) {
-        n = normalMatrix * n;
-    } );
-    normalAttrib.unlock();
+    Core::Kernels::applyNormalTransform( geom.getAttrib<TriangleMesh::Point>( normalHandle ), t );
 
     return make_shared<Mesh>( "Capsule Primitive", std::move( geom ) );
 }
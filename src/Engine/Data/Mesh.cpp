@@ -1,5 +1,7 @@
 #include <Engine/Data/Mesh.hpp>
 
+#include <algorithm>
+#include <limits>
 #include <numeric>
 
 #include <Core/Utils/Attribs.hpp>
@@ -75,6 +77,7 @@ void Mesh::loadGeometry( const Core::Vector3Array& vertices, const std::vector<u
 
     mesh.setIndices( std::move( mindices ) );
     m_dataDirty.clear();
+    m_dirtyRanges.clear();
     m_vbos.clear();
 
     ///\todo check line vs triangle here is a bug
@@ -124,13 +127,17 @@ void AttribArrayDisplayable::setDirty( const std::string& name ) {
         m_vbos.emplace_back( nullptr );
     }
     else
-        m_dataDirty[itr->second] = true;
+        setDirty( itr->second );
 
     m_isDirty = true;
 }
 
 void AttribArrayDisplayable::setDirty( unsigned int index ) {
     if ( index < m_dataDirty.size() ) {
+        // the whole buffer is uploaded, even if a range was flagged before
+        if ( index < m_dirtyRanges.size() ) {
+            m_dirtyRanges[index] = { 0, std::numeric_limits<size_t>::max() };
+        }
         m_dataDirty[index] = true;
         m_isDirty          = true;
     }
@@ -145,7 +152,7 @@ void AttribArrayDisplayable::setDirty( const Ra::Core::Geometry::MeshAttrib& typ
         m_vbos.emplace_back( nullptr );
     }
     else
-        m_dataDirty[itr->second] = true;
+        setDirty( itr->second );
 
     m_isDirty = true;
 }
@@ -161,6 +168,90 @@ AttribArrayDisplayable::getVboHandle( const std::string& name ) {
     return {};
 }
 
+void AttribArrayDisplayable::addMemoryUsage( Core::Utils::MemoryUsage& usage ) const {
+    m_vboMemory.addTo( usage );
+}
+
+void AttribArrayDisplayable::setDirty( unsigned int index, size_t begin, size_t end ) {
+    if ( index >= m_dataDirty.size() ) { return; }
+    if ( m_dirtyRanges.size() < m_dataDirty.size() ) {
+        m_dirtyRanges.resize( m_dataDirty.size(), { 0, std::numeric_limits<size_t>::max() } );
+    }
+    auto& range = m_dirtyRanges[index];
+    if ( m_dataDirty[index] ) {
+        range = { std::min( range.first, begin ), std::max( range.second, end ) };
+    }
+    else { range = { begin, end }; }
+    m_dataDirty[index] = true;
+    m_isDirty          = true;
+}
+
+std::pair<size_t, size_t> AttribArrayDisplayable::takeDirtyRange( unsigned int index,
+                                                                  size_t size ) {
+    if ( index >= m_dirtyRanges.size() ) { return { 0, size }; }
+    auto& range                 = m_dirtyRanges[index];
+    const size_t end            = std::min( range.second, size );
+    std::pair<size_t, size_t> r = { std::min( range.first, end ), end };
+    range                       = { 0, std::numeric_limits<size_t>::max() };
+    return r;
+}
+
+void AttribArrayDisplayable::uploadAttrib( unsigned int index,
+                                           const AttribBase* attrib,
+                                           bool scalarAsFloat ) {
+    const size_t size       = attrib->getSize();
+    const auto [begin, end] = takeDirtyRange( index, size );
+
+    // a partial range is only valid if the attrib was not resized since the last upload
+    if ( m_uploadedSizes.size() < m_vbos.size() ) { m_uploadedSizes.resize( m_vbos.size(), 0 ); }
+    const size_t uploaded  = m_uploadedSizes[index];
+    const bool wholeBuffer = !m_vbos[index] || size != uploaded || end > uploaded ||
+                             ( begin == 0 && end == size );
+    const size_t first     = wholeBuffer ? 0 : begin;
+    const size_t count     = wholeBuffer ? size : end - first;
+    const size_t stride    = attrib->getStride();
+    const char* data       = reinterpret_cast<const char*>( attrib->dataPtr() );
+    if ( !m_vbos[index] ) { m_vbos[index] = globjects::Buffer::create(); }
+
+    if ( scalarAsFloat ) {
+        const size_t eltSize = attrib->getNumberOfComponents();
+        auto converted       = std::make_unique<float[]>( count * eltSize );
+        for ( size_t i = 0; i < count; ++i ) {
+            auto tptr = reinterpret_cast<const Scalar*>( data + ( first + i ) * stride );
+            for ( size_t j = 0; j < eltSize; ++j ) {
+                converted[i * eltSize + j] = float( tptr[j] );
+            }
+        }
+        const size_t eltBytes = eltSize * sizeof( float );
+        if ( wholeBuffer ) {
+            m_vbos[index]->setData( count * eltBytes, converted.get(), GL_DYNAMIC_DRAW );
+        }
+        else if ( count > 0 ) {
+            m_vbos[index]->setSubData( first * eltBytes, count * eltBytes, converted.get() );
+        }
+    }
+    else if ( wholeBuffer ) {
+        m_vbos[index]->setData( attrib->getBufferSize(), data, GL_DYNAMIC_DRAW );
+    }
+    else if ( count > 0 ) {
+        m_vbos[index]->setSubData( first * stride, count * stride, data + first * stride );
+    }
+    m_uploadedSizes[index] = size;
+    m_dataDirty[index]     = false;
+}
+
+void AttribArrayDisplayable::updateVboMemory( const Core::Utils::AttribManager& attribs,
+                                              bool scalarAsFloat ) {
+    size_t size = 0;
+    attribs.for_each_attrib( [this, &size, scalarAsFloat]( const AttribBase* b ) {
+        auto idx = m_handleToBuffer.find( b->getName() );
+        if ( idx == m_handleToBuffer.end() || !m_vbos[idx->second] ) return;
+        size += scalarAsFloat ? b->getSize() * b->getNumberOfComponents() * sizeof( float )
+                              : b->getBufferSize();
+    } );
+    m_vboMemory.set( size );
+}
+
 void PointCloud::render( const ShaderProgram* prog ) {
     if ( m_vao ) {
         autoVertexAttribPointer( prog );
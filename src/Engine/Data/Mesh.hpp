@@ -101,6 +101,11 @@ class RA_ENGINE_API AttribArrayDisplayable : public Displayable
     /// If index is greater than then number of buffer, this function as no effect.
     /// \param index: the data buffer index to set to dirty.
     void setDirty( unsigned int index );
+
+    /// Mark the elements [begin, end) of the data buffer \p index dirty, only this range being
+    /// uploaded (together with the other dirty ranges of the buffer) by updateGL().
+    /// If index is greater than then number of buffer, this function as no effect.
+    void setDirty( unsigned int index, size_t begin, size_t end );
     ///\}
 
     /// This function is called at the start of the rendering.
@@ -125,19 +130,37 @@ class RA_ENGINE_API AttribArrayDisplayable : public Displayable
     /// If vao is not initialized, the returned optional is empty
     Ra::Core::Utils::optional<gl::GLuint> getVaoHandle();
 
+    void addMemoryUsage( Core::Utils::MemoryUsage& usage ) const override;
+
   protected:
     /// Update the picking render mode according to the object render mode
     void updatePickingRenderMode();
 
+    /// Account the memory of the vertex buffers of \p attribs, once uploaded.
+    /// \param scalarAsFloat true if the Scalar components are converted to float on upload.
+    void updateVboMemory( const Core::Utils::AttribManager& attribs, bool scalarAsFloat );
+
+    /// Return the range [begin, end) of the elements of the dirty buffer \p index to upload, for
+    /// an attrib of \p size elements, and reset it to the whole buffer.
+    std::pair<size_t, size_t> takeDirtyRange( unsigned int index, size_t size );
+
+    /// Upload the dirty elements of \p attrib to the buffer \p index (created if needed), the
+    /// Scalar components being converted to float if \p scalarAsFloat.
+    void
+    uploadAttrib( unsigned int index, const Core::Utils::AttribBase* attrib, bool scalarAsFloat );
+
     class AttribObserver
     {
       public:
-        explicit AttribObserver( AttribArrayDisplayable* displayable, int idx ) :
-            m_displayable( displayable ), m_idx( idx ) {}
+        AttribObserver( AttribArrayDisplayable* displayable,
+                        int idx,
+                        const Core::Utils::AttribBase* attrib ) :
+            m_displayable( displayable ), m_idx( idx ), m_attrib( attrib ) {}
         void operator()() {
             if ( m_idx < int( m_displayable->m_dataDirty.size() ) ) {
-                m_displayable->m_dataDirty[m_idx] = true;
-                m_displayable->m_isDirty          = true;
+                // only upload the elements the attrib reports as modified
+                const auto [begin, end] = m_attrib->getDirtyRange();
+                m_displayable->setDirty( unsigned( m_idx ), begin, end );
             }
             else {
                 /// \todo Should never be here
@@ -148,6 +171,7 @@ class RA_ENGINE_API AttribArrayDisplayable : public Displayable
       private:
         AttribArrayDisplayable* m_displayable;
         int m_idx;
+        const Core::Utils::AttribBase* m_attrib;
     };
 
   protected:
@@ -159,6 +183,13 @@ class RA_ENGINE_API AttribArrayDisplayable : public Displayable
     std::vector<std::unique_ptr<globjects::Buffer>> m_vbos;
     std::vector<bool> m_dataDirty;
 
+    // Ranges of elements to upload, indexed as m_dataDirty (the whole buffer if missing). A clean
+    // buffer has a whole range, so that only setDirty( index, begin, end ) restricts uploads.
+    std::vector<std::pair<size_t, size_t>> m_dirtyRanges;
+
+    // Number of elements of the last upload of each buffer, indexed as m_vbos (0 if missing).
+    std::vector<size_t> m_uploadedSizes;
+
     // Geometry attrib name (std::string) to buffer id (int)
     // buffer id are indices in m_vbos and m_dataDirty
     std::map<std::string, unsigned int> m_handleToBuffer;
@@ -167,6 +198,8 @@ class RA_ENGINE_API AttribArrayDisplayable : public Displayable
     ///
     /// Must be equivalent of the "or" of the other dirty flags. An empty mesh is not dirty
     bool m_isDirty { false };
+
+    Core::Utils::TrackedMemory m_vboMemory { Core::Utils::MemoryCategory::GpuBuffers };
 };
 
 /// Concept class to ensure consistent naming of VaoIndices accross derived classes.
@@ -195,6 +228,8 @@ class RA_ENGINE_API VaoIndices
     /// number of elements to draw (i.e number of indices to use)
     /// automatically set by updateGL(), not meaningfull if m_indicesDirty.
     size_t m_numElements { 0 };
+    /// Size of the index buffer, set when uploaded.
+    Core::Utils::TrackedMemory m_indicesMemory { Core::Utils::MemoryCategory::GpuBuffers };
 };
 
 /// This class handles an attrib array displayable on gpu only, without core
@@ -216,6 +251,8 @@ class IndexedAttribArrayDisplayable : public AttribArrayDisplayable, public VaoI
 
     inline void render( const ShaderProgram* prog ) override;
 
+    inline void addMemoryUsage( Core::Utils::MemoryUsage& usage ) const override;
+
   protected:
     /// assume m_vao is bound.
     inline void autoVertexAttribPointer( const ShaderProgram* prog );
@@ -283,6 +320,10 @@ class CoreGeometryDisplayable : public AttribArrayDisplayable
     void setAttribNameCorrespondance( const std::string& meshAttribName,
                                       const std::string& shaderAttribName );
 
+    /// Add the memory of the vertex buffers and of the attributes of the core geometry, accounted
+    /// as MemoryCategory::MeshCopies.
+    void addMemoryUsage( Core::Utils::MemoryUsage& usage ) const override;
+
   protected:
     virtual void updateGL_specific_impl() {}
 
@@ -345,6 +386,8 @@ class IndexedGeometry : public CoreGeometryDisplayable<T>, public VaoIndices
 
     void loadGeometry( T&& mesh ) override;
 
+    void addMemoryUsage( Core::Utils::MemoryUsage& usage ) const override;
+
   protected:
     void updateGL_specific_impl() override;
 };
@@ -600,6 +643,7 @@ void IndexedAttribArrayDisplayable<I>::updateGL() {
                 static_cast<gl::GLsizeiptr>( m_cpu_indices.size() * sizeof( IndexType ) ),
                 m_cpu_indices.data(),
                 GL_STATIC_DRAW );
+            m_indicesMemory.set( m_cpu_indices.size() * sizeof( IndexType ) );
             m_indicesDirty = false;
         }
 
@@ -620,11 +664,19 @@ void IndexedAttribArrayDisplayable<I>::updateGL() {
             }
         };
         m_attribManager.for_each_attrib( func );
+        updateVboMemory( m_attribManager, false );
         GL_CHECK_ERROR;
         m_isDirty = false;
     }
 }
 
+template <typename I>
+void IndexedAttribArrayDisplayable<I>::addMemoryUsage( Core::Utils::MemoryUsage& usage ) const {
+    AttribArrayDisplayable::addMemoryUsage( usage );
+    m_indicesMemory.addTo( usage );
+    m_attribManager.addMemoryUsage( usage );
+}
+
 template <typename I>
 void IndexedAttribArrayDisplayable<I>::autoVertexAttribPointer( const ShaderProgram* prog ) {
 
@@ -740,7 +792,7 @@ void CoreGeometryDisplayable<CoreGeometry>::addAttribObserver( const std::string
             m_vbos.emplace_back( nullptr );
         }
         auto idx = m_handleToBuffer[name];
-        attrib->attach( AttribObserver( this, idx ) );
+        attrib->attach( AttribObserver( this, idx, attrib ) );
     }
     // else it's an attrib remove, do nothing, cleanup will be done in updateGL()
     else {}
@@ -790,6 +842,7 @@ void CoreGeometryDisplayable<CoreGeometry>::autoVertexAttribPointer( const Shade
 template <typename T>
 void CoreGeometryDisplayable<T>::loadGeometry_common( T&& mesh ) {
     m_mesh = std::move( mesh );
+    m_mesh.setMemoryCategory( Core::Utils::MemoryCategory::MeshCopies );
     setupCoreMeshObservers();
 }
 
@@ -798,6 +851,7 @@ template <typename T>
 void CoreGeometryDisplayable<T>::setupCoreMeshObservers() {
     int idx = 0;
     m_dataDirty.resize( m_mesh.vertexAttribs().getNumAttribs() );
+    m_dirtyRanges.clear();
     m_vbos.resize( m_mesh.vertexAttribs().getNumAttribs() );
     // here capture ref to idx to propagate idx incrementation
     m_mesh.vertexAttribs().for_each_attrib( [&idx, this]( Ra::Core::Utils::AttribBase* b ) {
@@ -808,7 +862,7 @@ void CoreGeometryDisplayable<T>::setupCoreMeshObservers() {
         // create a identity translation if name is not already translated.
         addToTranslationTable( name );
 
-        b->attach( AttribObserver( this, idx ) );
+        b->attach( AttribObserver( this, idx, b ) );
         ++idx;
     } );
 
@@ -849,44 +903,14 @@ void CoreGeometryDisplayable<CoreGeometry>::updateGL() {
         updateGL_specific_impl();
 #ifdef CORE_USE_DOUBLE
         // need convserion
-        auto func = [this]( Ra::Core::Utils::AttribBase* b ) {
-            auto idx = m_handleToBuffer[b->getName()];
-
-            if ( m_dataDirty[idx] ) {
-                if ( !m_vbos[idx] ) { m_vbos[idx] = globjects::Buffer::create(); }
-
-                auto stride      = b->getStride();
-                auto eltSize     = b->getNumberOfComponents();
-                auto size        = b->getSize();
-                auto data        = std::make_unique<float[]>( size * eltSize );
-                const void* ptr  = b->dataPtr();
-                const char* cptr = reinterpret_cast<const char*>( ptr );
-
-                for ( size_t i = 0; i < size; i++ ) {
-                    auto tptr = reinterpret_cast<const Scalar*>( cptr + i * stride );
-                    for ( size_t j = 0; j < eltSize; ++j ) {
-                        data[i * eltSize + j] = tptr[j];
-                    }
-                }
-
-                m_vbos[idx]->setData(
-                    size * eltSize * sizeof( float ), data.get(), GL_DYNAMIC_DRAW );
-
-                m_dataDirty[idx] = false;
-            }
-        };
-
+        constexpr bool scalarAsFloat = true;
 #else
-        auto func = [this]( Ra::Core::Utils::AttribBase* b ) {
+        constexpr bool scalarAsFloat = false;
+#endif
+        auto func = [this, scalarAsFloat]( Ra::Core::Utils::AttribBase* b ) {
             auto idx = m_handleToBuffer[b->getName()];
-
-            if ( m_dataDirty[idx] ) {
-                if ( !m_vbos[idx] ) { m_vbos[idx] = globjects::Buffer::create(); }
-                m_vbos[idx]->setData( b->getBufferSize(), b->dataPtr(), GL_DYNAMIC_DRAW );
-                m_dataDirty[idx] = false;
-            }
+            if ( m_dataDirty[idx] ) { uploadAttrib( idx, b, scalarAsFloat ); }
         };
-#endif
         m_mesh.vertexAttribs().for_each_attrib( func );
 
         // cleanup removed attrib
@@ -898,12 +922,20 @@ void CoreGeometryDisplayable<CoreGeometry>::updateGL() {
                 m_dataDirty[buffer.second] = false;
             }
         }
+        updateVboMemory( m_mesh.vertexAttribs(), scalarAsFloat );
 
         GL_CHECK_ERROR;
         m_isDirty = false;
     }
 }
 
+template <typename CoreGeometry>
+void CoreGeometryDisplayable<CoreGeometry>::addMemoryUsage(
+    Core::Utils::MemoryUsage& usage ) const {
+    base::addMemoryUsage( usage );
+    m_mesh.addMemoryUsage( usage );
+}
+
 template <typename CoreGeometry>
 void CoreGeometryDisplayable<CoreGeometry>::setAttribNameCorrespondance(
     const std::string& meshAttribName,
@@ -931,6 +963,12 @@ void IndexedGeometry<T>::loadGeometry( T&& mesh ) {
     base::m_mesh.attach( IndicesObserver( this ) );
 }
 
+template <typename T>
+void IndexedGeometry<T>::addMemoryUsage( Core::Utils::MemoryUsage& usage ) const {
+    base::addMemoryUsage( usage );
+    m_indicesMemory.addTo( usage );
+}
+
 template <typename T>
 void IndexedGeometry<T>::updateGL_specific_impl() {
     if ( !m_indices ) {
@@ -943,11 +981,11 @@ void IndexedGeometry<T>::updateGL_specific_impl() {
         m_numElements =
             base::m_mesh.getIndices().size() * base::CoreGeometry::IndexType::RowsAtCompileTime;
 
+        const size_t size =
+            base::m_mesh.getIndices().size() * sizeof( typename base::CoreGeometry::IndexType );
         m_indices->setData(
-            static_cast<gl::GLsizeiptr>( base::m_mesh.getIndices().size() *
-                                         sizeof( typename base::CoreGeometry::IndexType ) ),
-            base::m_mesh.getIndices().data(),
-            GL_STATIC_DRAW );
+            static_cast<gl::GLsizeiptr>( size ), base::m_mesh.getIndices().data(), GL_STATIC_DRAW );
+        m_indicesMemory.set( size );
         m_indicesDirty = false;
     }
     if ( !base::m_vao ) { base::m_vao = globjects::VertexArray::create(); }
@@ -1090,6 +1128,7 @@ void GeneralMesh<T>::updateGL_specific_impl() {
                                                                sizeof( GeneralMesh::IndexType ) ),
                                   m_triangleIndices.data(),
                                   GL_STATIC_DRAW );
+        this->m_indicesMemory.set( m_triangleIndices.size() * sizeof( GeneralMesh::IndexType ) );
         this->m_indicesDirty = false;
     }
     if ( !base::m_vao ) { base::m_vao = globjects::VertexArray::create(); }
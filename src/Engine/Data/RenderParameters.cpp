@@ -2,13 +2,177 @@
 #include <Core/Utils/Log.hpp>
 
 #include <Engine/Data/RenderParameters.hpp>
+#include <Engine/Data/Texture.hpp>
+#include <Engine/OpenGL.hpp>
 #include <Engine/RadiumEngine.hpp>
 
+#include <algorithm>
 #include <fstream>
 namespace Ra {
 namespace Engine {
 namespace Data {
 
+namespace {
+// Uniform upload, using the program given as parameter, so that it does not need to be bound.
+void uploadValue( GLuint program, GLint location, bool value ) {
+    glProgramUniform1i( program, location, value ? 1 : 0 );
+}
+
+void uploadValue( GLuint program, GLint location, int value ) {
+    glProgramUniform1i( program, location, value );
+}
+
+void uploadValue( GLuint program, GLint location, uint value ) {
+    glProgramUniform1ui( program, location, value );
+}
+
+void uploadValue( GLuint program, GLint location, Scalar value ) {
+    glProgramUniform1f( program, location, GLfloat( value ) );
+}
+
+void uploadValue( GLuint program, GLint location, const std::vector<int>& value ) {
+    glProgramUniform1iv( program, location, GLsizei( value.size() ), value.data() );
+}
+
+void uploadValue( GLuint program, GLint location, const std::vector<uint>& value ) {
+    glProgramUniform1uiv( program, location, GLsizei( value.size() ), value.data() );
+}
+
+void uploadValue( GLuint program, GLint location, const std::vector<Scalar>& value ) {
+#ifdef CORE_USE_DOUBLE
+    std::vector<GLfloat> converted( value.begin(), value.end() );
+    glProgramUniform1fv( program, location, GLsizei( converted.size() ), converted.data() );
+#else
+    glProgramUniform1fv( program, location, GLsizei( value.size() ), value.data() );
+#endif
+}
+
+void uploadValue( GLuint program, GLint location, const Core::Vector2& value ) {
+    const Eigen::Matrix<GLfloat, 2, 1> v = value.cast<GLfloat>();
+    glProgramUniform2fv( program, location, 1, v.data() );
+}
+
+void uploadValue( GLuint program, GLint location, const Core::Vector3& value ) {
+    const Eigen::Matrix<GLfloat, 3, 1> v = value.cast<GLfloat>();
+    glProgramUniform3fv( program, location, 1, v.data() );
+}
+
+void uploadValue( GLuint program, GLint location, const Core::Vector4& value ) {
+    const Eigen::Matrix<GLfloat, 4, 1> v = value.cast<GLfloat>();
+    glProgramUniform4fv( program, location, 1, v.data() );
+}
+
+void uploadValue( GLuint program, GLint location, const Core::Utils::Color& value ) {
+    uploadValue( program, location, Core::Utils::Color::VectorType( value ) );
+}
+
+void uploadValue( GLuint program, GLint location, const Core::Matrix2& value ) {
+    const Eigen::Matrix<GLfloat, 2, 2> m = value.cast<GLfloat>();
+    glProgramUniformMatrix2fv( program, location, 1, GL_FALSE, m.data() );
+}
+
+void uploadValue( GLuint program, GLint location, const Core::Matrix3& value ) {
+    const Eigen::Matrix<GLfloat, 3, 3> m = value.cast<GLfloat>();
+    glProgramUniformMatrix3fv( program, location, 1, GL_FALSE, m.data() );
+}
+
+void uploadValue( GLuint program, GLint location, const Core::Matrix4& value ) {
+    const Eigen::Matrix<GLfloat, 4, 4> m = value.cast<GLfloat>();
+    glProgramUniformMatrix4fv( program, location, 1, GL_FALSE, m.data() );
+}
+
+template <typename T>
+void uploadUniform( const ShaderProgram* /*shader*/,
+                    GLuint program,
+                    GLint location,
+                    int /*texUnit*/,
+                    const void* value ) {
+    uploadValue( program, location, *static_cast<const T*>( value ) );
+}
+
+void uploadTexture( const ShaderProgram* /*shader*/,
+                    GLuint program,
+                    GLint location,
+                    int texUnit,
+                    const void* value ) {
+    auto [tex, unit] = *static_cast<const RenderParameters::TextureInfo*>( value );
+    // automatic texture unit, only available for active samplers
+    if ( unit == -1 ) {
+        if ( texUnit == -1 ) { return; }
+        unit = texUnit;
+    }
+    tex->bind( unit );
+    if ( location != -1 ) { glProgramUniform1i( program, location, unit ); }
+}
+
+void uploadParameters( const ShaderProgram* shader,
+                       GLuint /*program*/,
+                       GLint /*location*/,
+                       int /*texUnit*/,
+                       const void* value ) {
+    static_cast<const RenderParameters*>( value )->bind( shader );
+}
+} // namespace
+
+class RenderParameters::BindingCompiler
+{
+  public:
+    using types = BindableTypes;
+
+    /// Texture parameters are bound to the unit given with the texture, or to the one associated
+    /// with the sampler at link time.
+    void operator()( const std::string& name, const TextureInfo& p, ProgramBinding* binding ) {
+        binding->m_uniforms.push_back( { uploadTexture,
+                                         binding->m_shader->getUniformLocation( name.c_str() ),
+                                         binding->m_shader->getTextureBinding( name.c_str() ).first,
+                                         &p } );
+    }
+
+    /// Embedded parameters have their own bindings.
+    void operator()( const std::string& /*name*/,
+                     const RenderParameters& p,
+                     ProgramBinding* binding ) {
+        binding->m_uniforms.push_back( { uploadParameters, -1, -1, &p } );
+    }
+
+    /// Parameters without active uniform are skipped.
+    template <typename T>
+    void operator()( const std::string& name, const T& p, ProgramBinding* binding ) {
+        auto location = binding->m_shader->getUniformLocation( name.c_str() );
+        if ( location != -1 ) {
+            binding->m_uniforms.push_back( { uploadUniform<T>, location, -1, &p } );
+        }
+    }
+};
+
+void RenderParameters::compileBinding( ProgramBinding& binding ) const {
+    binding.m_linkId        = binding.m_shader->getLinkId();
+    binding.m_layoutVersion = getLayoutVersion();
+    binding.m_uniforms.clear();
+    visit( BindingCompiler {}, &binding );
+}
+
+void RenderParameters::bind( const Data::ShaderProgram* shader ) const {
+    auto& bindings = m_bindingCache.m_bindings;
+    auto it        = std::find_if( bindings.begin(), bindings.end(), [shader]( const auto& b ) {
+        return b.m_shader == shader;
+    } );
+    if ( it == bindings.end() ) {
+        bindings.emplace_back();
+        it           = bindings.end() - 1;
+        it->m_shader = shader;
+        compileBinding( *it );
+    }
+    else if ( it->m_linkId != shader->getLinkId() || it->m_layoutVersion != getLayoutVersion() ) {
+        compileBinding( *it );
+    }
+
+    const GLuint program = shader->getProgramObject()->id();
+    for ( const auto& uniform : it->m_uniforms ) {
+        uniform.m_upload( shader, program, uniform.m_location, uniform.m_texUnit, uniform.m_value );
+    }
+}
+
 void ParameterSetEditingInterface::loadMetaData( const std::string& basename,
                                                  nlohmann::json& destination ) {
     auto resourcesRootDir { RadiumEngine::getInstance()->getResourcesDir() };
@@ -84,60 +84,71 @@ class RA_ENGINE_API RenderParameters final : public Core::VariableSet
     }
 
     /** \brief Bind the parameter uniform on the shader program.
+     *
+     * The uniform locations of the parameters are resolved the first time the parameters are
+     * bound to the program, and then reused as long as the program is not linked again and no
+     * parameter is added or removed. Values are read directly from the parameter storage, so that
+     * modified values are uploaded without any lookup.
      *
      * \note, this will only bind the supported parameter types.
      * \param shader The shader to bind to.
      */
-    void bind( const Data::ShaderProgram* shader ) const {
-        visit( StaticParameterBinder {}, shader );
-    }
+    void bind( const Data::ShaderProgram* shader ) const;
 
   private:
-    /** \brief Static visitor to bind the stored parameters.
-     * \note Binds only statically supported types. To bind unsupported types, use a custom
-     * dynamic visitor and the RenderParameter::visit method.
-     */
-    class StaticParameterBinder
+    /// Upload a parameter value (given as type erased pointer) to the given uniform location.
+    using UniformUploader = void ( * )( const Data::ShaderProgram* shader,
+                                        gl::GLuint program,
+                                        gl::GLint location,
+                                        int texUnit,
+                                        const void* value );
+
+    /// A parameter associated with its uniform.
+    struct UniformBinding {
+        UniformUploader m_upload;
+        gl::GLint m_location;
+        /// Texture unit associated at link time, for texture parameters.
+        int m_texUnit;
+        /// The parameter value, in the parameter storage.
+        const void* m_value;
+    };
+
+    /// The uniforms of the parameters for a program, valid for a link of the program and a layout
+    /// of the parameters.
+    struct ProgramBinding {
+        const Data::ShaderProgram* m_shader { nullptr };
+        size_t m_linkId { 0 };
+        size_t m_layoutVersion { 0 };
+        std::vector<UniformBinding> m_uniforms;
+    };
+
+    /// Per program bindings. As they refer to the parameter storage, bindings are not copied nor
+    /// moved with the parameters.
+    class BindingCache
     {
       public:
-        /// Type supported by the binder, as expected by VariableSet
-        using types = BindableTypes;
-
-        /** \brief Binds a color parameter as this requires special access to the parameter value.
-         */
-        void operator()( const std::string& name,
-                         const Ra::Core::Utils::Color& p,
-                         const Data::ShaderProgram* shader ) {
-            shader->setUniform( name.c_str(), Ra::Core::Utils::Color::VectorType( p ) );
+        BindingCache() = default;
+        BindingCache( const BindingCache& /*other*/ ) {}
+        BindingCache( BindingCache&& /*other*/ ) noexcept {}
+        BindingCache& operator=( const BindingCache& /*other*/ ) {
+            m_bindings.clear();
+            return *this;
         }
-
-        /** \brief Binds a Texture parameter as this requires special access to the parameter value.
-         */
-        void operator()( const std::string& name,
-                         const RenderParameters::TextureInfo& p,
-                         const Data::ShaderProgram* shader ) {
-            auto [tex, texUnit] = p;
-            if ( texUnit == -1 ) { shader->setUniformTexture( name.c_str(), tex ); }
-            else { shader->setUniform( name.c_str(), tex, texUnit ); }
-        }
-
-        /** \brief Binds a embedded const RenderParameter.
-         *
-         * This allows to build hierarchies of RenderParameters.
-         */
-        void operator()( const std::string& /*name*/,
-                         const RenderParameters& p,
-                         const Data::ShaderProgram* shader ) {
-            p.bind( shader );
+        BindingCache& operator=( BindingCache&& /*other*/ ) noexcept {
+            m_bindings.clear();
+            return *this;
         }
 
-        /** \brief Bind any type of parameter that do not requires special access
-         */
-        template <typename T>
-        void operator()( const std::string& name, const T& p, const Data::ShaderProgram* shader ) {
-            shader->setUniform( name.c_str(), p );
-        }
+        std::vector<ProgramBinding> m_bindings;
     };
+
+    /// Static visitor resolving the uniforms of the parameters.
+    class BindingCompiler;
+
+    /// Resolve the uniforms of the parameters for the program of \p binding.
+    void compileBinding( ProgramBinding& binding ) const;
+
+    mutable BindingCache m_bindingCache;
 };
 
 /** \brief Interface to define metadata (constraints, description, ...) for the editing of parameter
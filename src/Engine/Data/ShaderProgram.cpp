@@ -13,6 +13,7 @@
 #include <Engine/Data/Texture.hpp>
 
 #include <algorithm>
+#include <atomic>
 #include <numeric> // for std::accumulate
 #include <regex>
 
@@ -208,7 +209,9 @@ void ShaderProgram::load( const ShaderConfiguration& shaderConfig ) {
 }
 
 void ShaderProgram::link() {
+    static std::atomic<size_t> linkCount { 0 };
     m_program = globjects::Program::create();
+    m_linkId  = ++linkCount;
 
     for ( unsigned int i = 0; i < ShaderType_COUNT; ++i ) {
         if ( m_shaderObjects[i].second ) { m_program->attach( m_shaderObjects[i].second.get() ); }
@@ -374,6 +377,16 @@ globjects::Program* ShaderProgram::getProgramObject() const {
     return m_program.get();
 }
 
+GLint ShaderProgram::getUniformLocation( const char* name ) const {
+    return m_program->getUniformLocation( name );
+}
+
+std::pair<int, int> ShaderProgram::getTextureBinding( const char* name ) const {
+    auto itr = textureUnits.find( std::string( name ) );
+    if ( itr == textureUnits.end() ) { return { -1, -1 }; }
+    return { itr->second.m_texUnit, itr->second.m_location };
+}
+
 /****************************************************
  * Include workaround due to globject bugs
  ****************************************************/
@@ -13,6 +13,7 @@
 #include <memory>
 #include <string>
 #include <type_traits>
+#include <utility>
 
 namespace globjects {
 class Shader;
@@ -65,6 +66,17 @@ class RA_ENGINE_API ShaderProgram final
 
     globjects::Program* getProgramObject() const;
 
+    /// Return the location of the uniform \p name, -1 if it is not an active uniform.
+    gl::GLint getUniformLocation( const char* name ) const;
+
+    /// Return the texture unit and the location associated at link time to the sampler \p name
+    /// (see setUniformTexture), or {-1, -1} if it is not an active sampler.
+    std::pair<int, int> getTextureBinding( const char* name ) const;
+
+    /// Return an identifier of the last link of the program, unique among all the programs.
+    /// Uniform locations are valid as long as the identifier is unchanged.
+    size_t getLinkId() const { return m_linkId; }
+
     ///\todo go private, and update ShaderConfiguration to add from source !
     void addShaderFromSource( Data::ShaderType type,
                               std::unique_ptr<globjects::StaticStringSource>&& source,
@@ -105,6 +117,7 @@ class RA_ENGINE_API ShaderProgram final
         m_shaderSources;
 
     std::unique_ptr<globjects::Program> m_program;
+    size_t m_linkId { 0 };
 };
 
 // declare specialization, definied in .cpp
@@ -21,6 +21,46 @@ namespace Engine {
 namespace Data {
 using namespace Core::Utils; // log
 
+namespace {
+/// Return the size of a texel of the external data, used to estimate the GPU memory.
+size_t getTexelSize( GLenum format, GLenum type ) {
+    size_t components = 4;
+    switch ( format ) {
+    case GL_RED:
+    case GL_RED_INTEGER:
+    case GL_DEPTH_COMPONENT:
+    case GL_STENCIL_INDEX:
+        components = 1;
+        break;
+    case GL_RG:
+    case GL_RG_INTEGER:
+    case GL_DEPTH_STENCIL:
+        components = 2;
+        break;
+    case GL_RGB:
+    case GL_BGR:
+    case GL_RGB_INTEGER:
+        components = 3;
+        break;
+    default:
+        break;
+    }
+    switch ( type ) {
+    case GL_UNSIGNED_BYTE:
+    case GL_BYTE:
+        return components;
+    case GL_UNSIGNED_SHORT:
+    case GL_SHORT:
+    case GL_HALF_FLOAT:
+        return 2 * components;
+    case GL_UNSIGNED_INT_24_8:
+        return 4;
+    default:
+        return 4 * components;
+    }
+}
+} // namespace
+
 Texture::Texture( const TextureParameters& texParameters ) :
     m_textureParameters { texParameters }, m_texture { nullptr }, m_isMipMapped { false } {}
 
@@ -88,11 +128,13 @@ void Texture::destroy() {
         // else gpu representation will not be cleaned by the application.
         m_texture.reset();
     }
+    m_gpuMemory.set( 0 );
 }
 
 void Texture::destroyNow() {
     m_texture->detach();
     m_texture.reset();
+    m_gpuMemory.set( 0 );
 }
 
 void Texture::updateData( std::shared_ptr<void> newData ) {
@@ -302,6 +344,14 @@ void Texture::sendImageDataToGpu() {
     // Generate mip-map if needed.
     if ( m_isMipMapped ) { m_texture->generateMipmap(); }
 
+    const auto& image = m_textureParameters.image;
+    size_t size =
+        image.width * image.height * image.depth * getTexelSize( image.format, image.type );
+    if ( image.target == GL_TEXTURE_CUBE_MAP ) { size *= 6; }
+    // the mip-map levels add up to a third of the base level
+    if ( m_isMipMapped ) { size += size / 3; }
+    m_gpuMemory.set( size );
+
     GL_CHECK_ERROR;
 }
 
@@ -2,6 +2,7 @@
 
 #include <Core/Tasks/TaskQueue.hpp>
 #include <Core/Utils/Color.hpp>
+#include <Core/Utils/MemoryAccounting.hpp>
 
 #include <Engine/RaEngine.hpp>
 
@@ -196,6 +197,12 @@ class RA_ENGINE_API Texture final
      */
     globjects::Texture* getGpuTexture() const { return m_texture.get(); }
 
+    /** \brief Estimated GPU memory used by the texture, in bytes (0 if not uploaded).
+     *
+     * Computed from the size and the external format of the image, mip-maps included.
+     */
+    size_t getGpuMemorySize() const { return m_gpuMemory.get(); }
+
     /** \brief get read access to texture parameters */
     const TextureParameters& getParameters() const { return m_textureParameters; }
     /** \brief read/write access to texture parameters */
@@ -335,6 +342,9 @@ class RA_ENGINE_API Texture final
 
     /** mutex to protect non gpu setters, in a thread safe way. */
     std::mutex m_updateMutex;
+
+    /** GPU memory accounting, set when the image is sent to the GPU. */
+    Core::Utils::TrackedMemory m_gpuMemory { Core::Utils::MemoryCategory::Textures };
 };
 } // namespace Data
 } // namespace Engine
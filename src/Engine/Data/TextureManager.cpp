@@ -105,6 +105,14 @@ void TextureManager::deleteTexture( const TextureHandle& handle ) {
     if ( handle.isValid() ) m_textures[handle.getValue()].reset( nullptr );
 }
 
+size_t TextureManager::getGpuMemorySize() const {
+    size_t size = 0;
+    for ( const auto& texture : m_textures ) {
+        if ( texture ) { size += texture->getGpuMemorySize(); }
+    }
+    return size;
+}
+
 } // namespace Data
 } // namespace Engine
 } // namespace Ra
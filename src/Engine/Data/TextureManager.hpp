@@ -53,6 +53,12 @@ class RA_ENGINE_API TextureManager final
      */
     void deleteTexture( const TextureHandle& handle );
 
+    /** \brief Estimated GPU memory used by the managed textures, in bytes.
+     *
+     * \see Texture::getGpuMemorySize
+     */
+    size_t getGpuMemorySize() const;
+
     /** \brief Load \a filename and fill ImageParameters according to \a filename content.
      *
      * \note only loads 2D image file for now.
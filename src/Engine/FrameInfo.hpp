@@ -16,6 +16,10 @@ struct RA_ENGINE_API FrameInfo {
     // (NB : at 60 FPS on a 32 bits machine this will cycle every two years... ;) )
     uint m_numFrame { 0 };
 
+    /// Whether the time jumped since the last frame (e.g. set from the timeline), instead of
+    /// flowing.
+    bool m_timeJumped { false };
+
     // Other stuff (e.g. which systems are present, etc).
 };
 } // namespace Engine
@@ -2,12 +2,16 @@
 
 #include <Core/Asset/FileData.hpp>
 #include <Core/Asset/FileLoaderInterface.hpp>
+#include <Core/Containers/FrameArena.hpp>
+#include <Core/Geometry/IndexedGeometry.hpp>
 #include <Core/Resources/Resources.hpp>
 #include <Core/Tasks/Task.hpp>
 #include <Core/Tasks/TaskQueue.hpp>
+#include <Core/Utils/Profiler.hpp>
 #include <Core/Utils/StringUtils.hpp>
 #include <Engine/Data/BlinnPhongMaterial.hpp>
 #include <Engine/Data/LambertianMaterial.hpp>
+#include <Engine/Data/Mesh.hpp>
 #include <Engine/Data/MaterialConverters.hpp>
 #include <Engine/Data/PlainMaterial.hpp>
 #include <Engine/Data/ShaderConfigFactory.hpp>
@@ -25,6 +29,8 @@
 #include <Engine/Scene/System.hpp>
 #include <Engine/Scene/SystemDisplay.hpp>
 
+#include <algorithm>
+#include <iomanip>
 #include <iostream>
 #include <string>
 
@@ -56,6 +62,12 @@ void RadiumEngine::initialize() {
     m_textureManager       = std::make_unique<Data::TextureManager>();
     m_shaderProgramManager = std::make_unique<Data::ShaderProgramManager>();
 
+    // forget the high-water marks of the destroyed objects, whose address may be reused
+    m_signalManager->getEntityDestroyedNotifier().attach(
+        [this]( const Scene::ItemEntry& entry ) { m_memoryPeaks.erase( entry.m_entity ); } );
+    m_signalManager->getComponentDestroyedNotifier().attach(
+        [this]( const Scene::ItemEntry& entry ) { m_memoryPeaks.erase( entry.m_component ); } );
+
     m_loadedFile.reset();
     Scene::ComponentMessenger::createInstance();
 
@@ -157,15 +169,30 @@ void RadiumEngine::cleanup() {
 
     Scene::ComponentMessenger::destroyInstance();
 
+    m_memoryPeaks.clear();
     m_loadingState = false;
 }
 
 void RadiumEngine::endFrameSync() {
+    // changes made in notification batches spanning frames are uploaded at the next frame
+    for ( const auto& ro : m_renderObjectManager->getRenderObjects() ) {
+        auto mesh = dynamic_cast<Data::AttribArrayDisplayable*>( ro->getMesh().get() );
+        if ( !mesh ) { continue; }
+        auto& geometry = mesh->getAttribArrayGeometry();
+        if ( auto indexed = dynamic_cast<Core::Geometry::MultiIndexedGeometry*>( &geometry ) ) {
+            indexed->flushNotifications();
+        }
+        else { geometry.vertexAttribs().flushNotifications(); }
+    }
     m_entityManager->swapBuffers();
     m_signalManager->fireFrameEnded();
+    // per-frame temporaries of the frame are released
+    Core::FrameArena::nextFrame();
+    Core::Utils::Profiler::nextFrame();
 }
 
 void RadiumEngine::getTasks( Core::TaskQueue* taskQueue, Scalar dt ) {
+    RA_PROFILE_ZONE( "RadiumEngine::getTasks" );
     static uint frameCounter = 0;
 
     if ( m_timeData.m_play || m_timeData.m_singleStep ) {
@@ -173,8 +200,11 @@ void RadiumEngine::getTasks( Core::TaskQueue* taskQueue, Scalar dt ) {
         m_timeData.m_singleStep = false;
     }
 
-    FrameInfo frameInfo {
-        m_timeData.m_time, m_timeData.m_realTime ? dt : m_timeData.m_dt, frameCounter++ };
+    FrameInfo frameInfo { m_timeData.m_time,
+                          m_timeData.m_realTime ? dt : m_timeData.m_dt,
+                          frameCounter++,
+                          m_timeData.m_jumped };
+    m_timeData.m_jumped = false;
     for ( auto& syst : m_systems ) {
         syst.second->generateTasks( taskQueue, frameInfo );
     }
@@ -380,6 +410,10 @@ bool RadiumEngine::setConstantTimeStep( Scalar dt, bool forceConstantTime ) {
     return !m_timeData.m_realTime;
 }
 
+Scalar RadiumEngine::getConstantTimeStep() const {
+    return m_timeData.m_dt;
+}
+
 void RadiumEngine::play( bool isPlaying ) {
     m_timeData.m_play = isPlaying;
 }
@@ -392,10 +426,12 @@ void RadiumEngine::resetTime() {
     m_timeData.m_play       = false;
     m_timeData.m_singleStep = false;
     m_timeData.m_time       = m_timeData.m_startTime;
+    m_timeData.m_jumped     = true;
 }
 
 void RadiumEngine::setTime( Scalar t ) {
-    m_timeData.m_time = t;
+    m_timeData.m_jumped = m_timeData.m_jumped || t != m_timeData.m_time;
+    m_timeData.m_time   = t;
 }
 
 void RadiumEngine::setStartTime( Scalar t ) {
@@ -471,6 +507,7 @@ void RadiumEngine::TimeData::updateTime( Scalar dt ) {
 }
 
 void RadiumEngine::runGpuTasks() {
+    RA_PROFILE_ZONE( "RadiumEngine::runGpuTasks" );
     m_gpuTaskQueue->runTasksInThisThread();
 }
 
@@ -482,5 +519,79 @@ void RadiumEngine::removeGpuTask( Core::TaskQueue::TaskId taskId ) {
     m_gpuTaskQueue->removeTask( taskId );
 }
 
+namespace {
+void updatePeak( Core::Utils::MemoryUsage& peak, const Core::Utils::MemoryUsage& usage ) {
+    for ( size_t i = 0; i < peak.m_bytes.size(); ++i ) {
+        peak.m_bytes[i] = std::max( peak.m_bytes[i], usage.m_bytes[i] );
+    }
+}
+} // namespace
+
+RadiumEngine::MemoryUsageReport RadiumEngine::getMemoryReport() {
+    using Core::Utils::MemoryAccounting;
+    MemoryUsageReport report {
+        "Process", MemoryAccounting::getUsage(), MemoryAccounting::getPeak(), {} };
+    for ( const auto entity : m_entityManager->getEntities() ) {
+        MemoryUsageReport entityReport { entity->getName(), {}, {}, {} };
+        for ( const auto& component : entity->getComponents() ) {
+            MemoryUsageReport componentReport { component->getName(), {}, {}, {} };
+            component->addMemoryUsage( componentReport.m_usage );
+            auto& peak = m_memoryPeaks[component.get()];
+            updatePeak( peak, componentReport.m_usage );
+            componentReport.m_peak = peak;
+            entityReport.m_usage += componentReport.m_usage;
+            entityReport.m_children.push_back( std::move( componentReport ) );
+        }
+        auto& peak = m_memoryPeaks[entity];
+        updatePeak( peak, entityReport.m_usage );
+        entityReport.m_peak = peak;
+        report.m_children.push_back( std::move( entityReport ) );
+    }
+    return report;
+}
+
+void RadiumEngine::printMemoryReport( std::ostream& out ) {
+    using Core::Utils::MemoryAccounting;
+    using Core::Utils::MemoryCategory;
+    using Core::Utils::MemoryUsage;
+    const auto report   = getMemoryReport();
+    const auto flags    = out.flags();
+    constexpr int width = 16;
+    size_t nameWidth    = 12;
+    for ( const auto& entity : report.m_children ) {
+        nameWidth = std::max( nameWidth, entity.m_name.size() );
+        for ( const auto& component : entity.m_children ) {
+            nameWidth = std::max( nameWidth, 2 + component.m_name.size() );
+        }
+    }
+
+    const auto printLine = [&out, nameWidth]( const std::string& name, const MemoryUsage& usage ) {
+        out << std::left << std::setw( int( nameWidth ) ) << name << std::right;
+        for ( size_t bytes : usage.m_bytes ) {
+            out << std::setw( width ) << bytes / 1024;
+        }
+        out << std::setw( width ) << usage.getTotal() / 1024 << '\n';
+    };
+    out << std::left << std::setw( int( nameWidth ) ) << "Memory (KiB)" << std::right;
+    for ( int c = 0; c < int( MemoryCategory::Count ); ++c ) {
+        out << std::setw( width ) << MemoryAccounting::getCategoryName( MemoryCategory( c ) );
+    }
+    out << std::setw( width ) << "Total" << '\n';
+    printLine( report.m_name, report.m_usage );
+    printLine( report.m_name + " peak", report.m_peak );
+    for ( const auto& entity : report.m_children ) {
+        printLine( entity.m_name, entity.m_usage );
+        for ( const auto& component : entity.m_children ) {
+            printLine( "  " + component.m_name, component.m_usage );
+        }
+    }
+    out.flags( flags );
+}
+
+void RadiumEngine::resetMemoryPeaks() {
+    Core::Utils::MemoryAccounting::resetPeaks();
+    m_memoryPeaks.clear();
+}
+
 } // namespace Engine
 } // namespace Ra
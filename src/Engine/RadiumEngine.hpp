@@ -3,6 +3,7 @@
 
 #include <Core/Tasks/TaskQueue.hpp>
 #include <Core/Types.hpp>
+#include <Core/Utils/MemoryAccounting.hpp>
 #include <Core/Utils/Singleton.hpp>
 
 #include <glbinding/Version.h>
@@ -10,6 +11,7 @@
 
 #include <map>
 #include <memory>
+#include <ostream>
 #include <stack>
 #include <string>
 #include <vector>
@@ -255,6 +257,11 @@ class RA_ENGINE_API RadiumEngine
      */
     bool setConstantTimeStep( Scalar dt, bool forceConstantTime = false );
 
+    /**
+     * \brief Returns the time delta between two frames for Constant-time time flow.
+     */
+    Scalar getConstantTimeStep() const;
+
     /**
      * \brief Activates or disables ForwardBackward time flow.
      *
@@ -280,6 +287,7 @@ class RA_ENGINE_API RadiumEngine
     /**
      * Resets time to the `start` time of the time window.
      * \note Also stops time flow.
+     * \note The next frame is flagged as a time jump (see FrameInfo::m_timeJumped).
      */
     void resetTime();
 
@@ -287,6 +295,7 @@ class RA_ENGINE_API RadiumEngine
      * Sets time to \p t.
      * \note \p t can be any time value, regardless of the time window or time
      *       flow modes. However as soon as time flows, \p t will be adapted.
+     * \note The next frame is flagged as a time jump (see FrameInfo::m_timeJumped).
      */
     void setTime( Scalar t );
 
@@ -346,6 +355,36 @@ class RA_ENGINE_API RadiumEngine
      */
     void removeGpuTask( Core::TaskQueue::TaskId taskId );
 
+    /// \name Memory accounting
+    /// \{
+
+    /// Memory used per category by the process, an entity or a component.
+    struct MemoryUsageReport {
+        std::string m_name;
+        Core::Utils::MemoryUsage m_usage;
+        /// High-water mark, see getMemoryReport().
+        Core::Utils::MemoryUsage m_peak;
+        /// Entities of the process, components of an entity.
+        std::vector<MemoryUsageReport> m_children;
+    };
+
+    /**
+     * Return the memory used by the process, and by each entity and component.
+     * The usage and high-water marks of the process are maintained by
+     * Core::Utils::MemoryAccounting. The usage of the components (see
+     * Scene::Component::addMemoryUsage) is gathered at each call, their high-water marks being
+     * the maxima over the calls. Textures are shared, and thus only accounted for the process.
+     * \note To be called from the main thread, between two frames.
+     */
+    MemoryUsageReport getMemoryReport();
+
+    /// Print the memory report as a table (in KiB), with a line per entity and component.
+    void printMemoryReport( std::ostream& out );
+
+    /// Reset the high-water marks to the current usage.
+    void resetMemoryPeaks();
+    /// \}
+
   private:
     RadiumEngine();
     ~RadiumEngine();
@@ -381,6 +420,10 @@ class RA_ENGINE_API RadiumEngine
     std::unique_ptr<Data::ShaderProgramManager> m_shaderProgramManager;
     std::unique_ptr<Core::Asset::FileData> m_loadedFile;
 
+    /// High-water marks of the entities and components, by object. Entries are erased when the
+    /// object is destroyed.
+    std::map<const void*, Core::Utils::MemoryUsage> m_memoryPeaks;
+
     bool m_loadingState { false };
 
     /// For internal resources management in a filesystem
@@ -417,6 +460,7 @@ class RA_ENGINE_API RadiumEngine
         bool m_realTime { false }; ///< Whether we use the effective time flow or the constant one.
         bool m_forwardBackward { false }; ///< Is PingPong mode enabled.
         bool m_isBackward { false };      ///< Whether time is going backwards.
+        bool m_jumped { false };          ///< Whether time was set since the last frame.
     };
 
     TimeData m_timeData;
@@ -1,8 +1,10 @@
 #include <Engine/Rendering/Renderer.hpp>
 
 #include <Core/Asset/FileData.hpp>
+#include <Core/Containers/FrameArena.hpp>
 #include <Core/Geometry/MeshPrimitives.hpp>
 #include <Core/Utils/Log.hpp>
+#include <Core/Utils/Profiler.hpp>
 #include <Engine/Data/Material.hpp>
 #include <Engine/Data/Mesh.hpp>
 #include <Engine/Data/ShaderConfigFactory.hpp>
@@ -25,6 +27,7 @@
 #include <globjects/Texture.h>
 
 #include <algorithm>
+#include <array>
 #include <iostream>
 
 namespace Ra {
@@ -319,6 +322,7 @@ void Renderer::render( const Data::ViewingParameters& data ) {
 
     std::lock_guard<std::mutex> renderLock( m_renderMutex );
     CORE_UNUSED( renderLock );
+    RA_PROFILE_ZONE( "Renderer::render" );
 
     m_timerData.renderStart = Core::Utils::Clock::now();
 
@@ -381,6 +385,7 @@ void Renderer::saveExternalFBOInternal() {
 }
 
 void Renderer::updateRenderObjectsInternal( const Data::ViewingParameters& /*renderData*/ ) {
+    RA_PROFILE_ZONE( "Renderer::updateRenderObjects" );
     /// \todo move the update to engine runGpuTasks
     for ( auto& ro : m_fancyRenderObjects ) {
         ro->updateGL();
@@ -397,6 +402,7 @@ void Renderer::updateRenderObjectsInternal( const Data::ViewingParameters& /*ren
 }
 
 void Renderer::feedRenderQueuesInternal( const Data::ViewingParameters& /*renderData*/ ) {
+    RA_PROFILE_ZONE( "Renderer::feedRenderQueues" );
     m_fancyRenderObjects.clear();
     m_debugRenderObjects.clear();
     m_uiRenderObjects.clear();
@@ -485,6 +491,7 @@ void Renderer::renderForPicking(
 }
 
 void Renderer::doPicking( const Data::ViewingParameters& renderData ) {
+    RA_PROFILE_ZONE( "Renderer::doPicking" );
     m_pickingResults.reserve( m_pickingQueries.size() );
 
     m_pickingFbo->bind();
@@ -517,8 +524,9 @@ void Renderer::doPicking( const Data::ViewingParameters& renderData ) {
         }
         else {
             // select the results for the RO with the most representatives
-            // (or first to come if same amount)
-            std::map<int, PickingResult> resultPerRO;
+            // (or the lowest RO index if same amount)
+            // the picked pixels and their count per RO are temporaries of the frame
+            Core::FrameVector<std::array<int, 4>> picks;
             for ( auto i = -m_brushRadius; i <= m_brushRadius; i += 3 ) {
                 auto h = std::round( std::sqrt( m_brushRadius * m_brushRadius - i * i ) );
                 for ( auto j = -h; j <= +h; j += 3 ) {
@@ -529,19 +537,29 @@ void Renderer::doPicking( const Data::ViewingParameters& renderData ) {
                         continue;
                     }
                     GL_ASSERT( glReadPixels( x, y, 1, 1, GL_RGBA_INTEGER, GL_INT, pick ) );
-                    resultPerRO[pick[0]].setRoIdx( pick[0] );
-                    resultPerRO[pick[0]].addIndex( { pick[2], pick[1], pick[3] } );
+                    picks.push_back( { pick[0], pick[1], pick[2], pick[3] } );
                 }
             }
 
+            Core::FrameVector<std::pair<int, size_t>> pickCounts;
+            for ( const auto& p : picks ) {
+                auto it = std::find_if( pickCounts.begin(),
+                                        pickCounts.end(),
+                                        [&p]( const auto& count ) { return count.first == p[0]; } );
+                if ( it == pickCounts.end() ) { pickCounts.emplace_back( p[0], 1 ); }
+                else { ++it->second; }
+            }
             auto itr = std::max_element(
-                resultPerRO.begin(),
-                resultPerRO.end(),
-                []( const std::map<int, PickingResult>::value_type& a,
-                    const std::map<int, PickingResult>::value_type& b ) -> bool {
-                    return a.second.getIndices().size() < b.second.getIndices().size();
+                pickCounts.begin(), pickCounts.end(), []( const auto& a, const auto& b ) {
+                    return a.second < b.second || ( a.second == b.second && a.first > b.first );
                 } );
-            result = itr->second;
+            if ( itr != pickCounts.end() ) {
+                result.setRoIdx( itr->first );
+                result.reserve( itr->second );
+                for ( const auto& p : picks ) {
+                    if ( p[0] == itr->first ) { result.addIndex( { p[2], p[1], p[3] } ); }
+                }
+            }
         }
         result.setMode( query.m_mode );
         m_pickingResults.push_back( result );
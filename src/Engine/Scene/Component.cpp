@@ -77,6 +77,15 @@ Core::Aabb Component::computeAabb() {
     return m_aabb;
 }
 
+void Component::addMemoryUsage( MemoryUsage& usage ) const {
+    auto roMgr = RadiumEngine::getInstance()->getRenderObjectManager();
+    for ( const auto& roIndex : m_renderObjects ) {
+        if ( !roMgr->exists( roIndex ) ) { continue; }
+        auto ro = roMgr->getRenderObject( roIndex );
+        if ( ro->getMesh() ) { ro->getMesh()->addMemoryUsage( usage ); }
+    }
+}
+
 void Component::invalidateAabb() {
     m_isAabbValid = false;
     m_entity->invalidateAabb();
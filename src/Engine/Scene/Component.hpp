@@ -1,6 +1,7 @@
 #pragma once
 
 #include <Core/Utils/Index.hpp>
+#include <Core/Utils/MemoryAccounting.hpp>
 #include <Eigen/Core>
 #include <Eigen/Geometry>
 #include <Engine/RaEngine.hpp>
@@ -93,6 +94,10 @@ class RA_ENGINE_API Component
 
     const std::vector<Core::Utils::Index>& getRenderObjects() { return m_renderObjects; }
 
+    /// Add the memory used by the component to \p usage. By default, the memory of the
+    /// displayables of its render objects.
+    virtual void addMemoryUsage( Core::Utils::MemoryUsage& usage ) const;
+
   protected:
     /// Shortcut to access the render object manager.
     static Rendering::RenderObjectManager* getRoMgr();
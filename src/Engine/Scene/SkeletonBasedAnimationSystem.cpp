@@ -35,6 +35,11 @@ class Entity;
 
 using namespace Ra::Core::Animation;
 
+namespace {
+/// Number of poses baked per frame by each SkeletonComponent.
+constexpr int bakedPoseCount = 16;
+} // namespace
+
 namespace Ra {
 namespace Engine {
 namespace Scene {
@@ -65,25 +70,41 @@ void SkeletonBasedAnimationSystem::generateTasks( Core::TaskQueue* taskQueue,
     for ( auto compEntry : m_components ) {
         // deal with AnimationComponents
         if ( auto animComp = dynamic_cast<SkeletonComponent*>( compEntry.second ) ) {
+            Core::TaskQueue::TaskId animTaskId;
             if ( !Core::Math::areApproxEqual( m_time, frameInfo.m_animationTime ) ) {
-                // here we update the skeleton w.r.t. the animation
-                auto animFunc =
-                    std::bind( &SkeletonComponent::update, animComp, frameInfo.m_animationTime );
+                // here we update the skeleton w.r.t. the animation, using the baked poses if
+                // the time jumped
+                auto animFunc = std::bind( frameInfo.m_timeJumped
+                                               ? &SkeletonComponent::updateFromCache
+                                               : &SkeletonComponent::update,
+                                           animComp,
+                                           frameInfo.m_animationTime );
                 auto animTask = std::make_unique<Core::FunctionTask>(
                     animFunc, "AnimatorTask_" + animComp->getSkeleton()->getName() );
-                taskQueue->registerTask( std::move( animTask ) );
+                animTaskId = taskQueue->registerTask( std::move( animTask ) );
             }
             else {
                 // here we update the skeleton w.r.t. the manipulation
                 auto animFunc = std::bind( &SkeletonComponent::updateDisplay, animComp );
                 auto animTask = std::make_unique<Core::FunctionTask>(
                     animFunc, "AnimatorTask_" + animComp->getSkeleton()->getName() );
-                taskQueue->registerTask( std::move( animTask ) );
+                animTaskId = taskQueue->registerTask( std::move( animTask ) );
+            }
+            // bake a few more poses, after the update since both use the pose cache
+            if ( animComp->needsBaking() ) {
+                auto bakeFunc =
+                    std::bind( &SkeletonComponent::bakePoses, animComp, bakedPoseCount );
+                auto bakeTask = std::make_unique<Core::FunctionTask>(
+                    bakeFunc, "PoseBakerTask_" + animComp->getSkeleton()->getName() );
+                auto bakeTaskId = taskQueue->registerTask( std::move( bakeTask ) );
+                taskQueue->addDependency( animTaskId, bakeTaskId );
             }
         }
         // deal with SkinningComponents
         else if ( auto skinComp = dynamic_cast<SkinningComponent*>( compEntry.second ) ) {
-            auto skinFunc = std::bind( &SkinningComponent::skin, skinComp );
+            auto skinFunc = std::bind( frameInfo.m_timeJumped ? &SkinningComponent::skinFromCache
+                                                              : &SkinningComponent::skin,
+                                       skinComp );
             auto skinTask = std::make_unique<Core::FunctionTask>(
                 skinFunc, "SkinnerTask_" + skinComp->getMeshName() );
             auto endFunc = std::bind( &SkinningComponent::endSkinning, skinComp );
@@ -107,6 +128,7 @@ void SkeletonBasedAnimationSystem::handleAssetLoading( Entity* entity,
     auto animData = fileData->getAnimationData();
 
     // deal with AnimationComponents
+    auto engine      = RadiumEngine::getInstance();
     Scalar startTime = std::numeric_limits<Scalar>::max();
     Scalar endTime   = 0;
     for ( const auto& skel : skelData ) {
@@ -117,10 +139,10 @@ void SkeletonBasedAnimationSystem::handleAssetLoading( Entity* entity,
         startTime   = std::min( startTime, s );
         endTime     = std::max( endTime, e );
         component->setXray( m_xrayOn );
+        component->setPoseCache( m_poseCacheBudget, engine->getConstantTimeStep() );
         registerComponent( entity, component );
     }
     // configure the time on the Engine
-    auto engine = RadiumEngine::getInstance();
     engine->setStartTime( startTime );
     engine->setEndTime( endTime );
 
@@ -142,6 +164,8 @@ void SkeletonBasedAnimationSystem::handleAssetLoading( Entity* entity,
                 SkinningComponent* component = new SkinningComponent(
                     "SkC_" + geom->getName(), SkinningComponent::LBS, entity );
                 component->handleSkinDataLoading( skel, geom->getName() );
+                component->handleBlendShapeLoading( geom, animData );
+                component->setSkinCache( m_skinCacheBudget, engine->getConstantTimeStep() );
                 registerComponent( entity, component );
             }
         }
@@ -171,6 +195,22 @@ void SkeletonBasedAnimationSystem::toggleSkeleton( const bool status ) {
     }
 }
 
+// Baked animation cache
+
+void SkeletonBasedAnimationSystem::setBakeCache( size_t poseBudget, size_t skinBudget ) {
+    m_poseCacheBudget     = poseBudget;
+    m_skinCacheBudget     = skinBudget;
+    const Scalar timeStep = RadiumEngine::getInstance()->getConstantTimeStep();
+    for ( const auto& comp : m_components ) {
+        if ( auto animComp = dynamic_cast<SkeletonComponent*>( comp.second ) ) {
+            animComp->setPoseCache( poseBudget, timeStep );
+        }
+        else if ( auto skinComp = dynamic_cast<SkinningComponent*>( comp.second ) ) {
+            skinComp->setSkinCache( skinBudget, timeStep );
+        }
+    }
+}
+
 } // namespace Scene
 } // namespace Engine
 } // namespace Ra
@@ -46,6 +46,26 @@ class RA_ENGINE_API SkeletonBasedAnimationSystem : public System
     void toggleSkeleton( const bool status );
     /// \}
 
+    /// \name Baked animation cache
+    /// The poses sampled from the animations, and the skinned meshes, can be cached per frame
+    /// of the Engine's time window, to be used when the time jumps (e.g. when scrubbing the
+    /// timeline) instead of sampling the animations and skinning the meshes.
+    /// \{
+
+    /// Sets the memory budgets (in bytes) of the pose cache of each SkeletonComponent and of the
+    /// skin cache of each SkinningComponent, 0 disabling the cache.
+    /// Poses are baked a few frames per Engine frame, in tasks run after the animation update,
+    /// skinned meshes the first time they are displayed.
+    /// \note Frames are spaced by the Engine's constant time step.
+    void setBakeCache( size_t poseBudget, size_t skinBudget );
+
+    /// Returns the memory budget of the pose cache of each SkeletonComponent.
+    inline size_t getPoseCacheBudget() const { return m_poseCacheBudget; }
+
+    /// Returns the memory budget of the skin cache of each SkinningComponent.
+    inline size_t getSkinCacheBudget() const { return m_skinCacheBudget; }
+    /// \}
+
     /// Enforce Skeleton update at the next frame.
     inline void enforceUpdate() { m_time = -1; }
 
@@ -56,6 +76,12 @@ class RA_ENGINE_API SkeletonBasedAnimationSystem : public System
     /// The current animation time.
     Scalar m_time { 0_ra };
 
+    /// The memory budget of the pose caches (0 if disabled).
+    size_t m_poseCacheBudget { 0 };
+
+    /// The memory budget of the skin caches (0 if disabled).
+    size_t m_skinCacheBudget { 0 };
+
     Data::TextureManager::TextureHandle m_heatMapTextureHandle;
 };
 
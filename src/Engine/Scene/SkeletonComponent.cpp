@@ -1,7 +1,10 @@
 #include <Engine/Scene/SkeletonComponent.hpp>
 
+#include <algorithm>
+#include <cmath>
 #include <fstream>
 #include <iostream>
+#include <limits>
 #include <queue>
 
 #include <Core/Animation/KeyFramedValueInterpolators.hpp>
@@ -94,10 +97,27 @@ void SkeletonComponent::handleAnimationLoading(
     CORE_ASSERT( ( m_skel.size() != 0 ), "A Skeleton should be loaded first." );
     m_animations.clear();
     m_animations.reserve( data.size() );
+    m_clips.clear();
+    m_clips.reserve( data.size() );
 
     auto pose = m_skel.getPose( SpaceType::LOCAL );
     for ( uint n = 0; n < data.size(); ++n ) {
         m_animations.emplace_back();
+        m_clips.emplace_back();
+        // compressed clips are played as is, and only converted to keyframes if requested
+        if ( const auto& clip = data[n]->getClip() ) {
+            m_clips.back().m_clip = clip;
+            m_clips.back().m_bones.resize( clip->getChannelCount(), -1 );
+            for ( uint i = 0; i < m_skel.size(); ++i ) {
+                for ( size_t c = 0; c < clip->getChannelCount(); ++c ) {
+                    if ( m_skel.getLabel( i ) == clip->getChannelName( c ) ) {
+                        m_clips.back().m_bones[c] = int( i );
+                        break;
+                    }
+                }
+            }
+            continue;
+        }
         m_animations.back().reserve( m_skel.size() );
         auto handleAnim = data[n]->getHandleData();
         for ( uint i = 0; i < m_skel.size(); ++i ) {
@@ -113,12 +133,15 @@ void SkeletonComponent::handleAnimationLoading(
     }
     if ( m_animations.empty() ) {
         m_animations.emplace_back();
+        m_clips.emplace_back();
         for ( uint i = 0; i < m_skel.size(); ++i ) {
             m_animations[0].push_back( KeyFramedValue( 0_ra, pose[i] ) );
         }
     }
-    m_animationID   = 0;
-    m_animationTime = 0_ra;
+    m_animationID        = 0;
+    m_animationTime      = 0_ra;
+    m_sampledPoseVersion = 0;
+    invalidateBakedPoses();
 }
 
 // Skeleton-based animation data
@@ -126,35 +149,82 @@ void SkeletonComponent::handleAnimationLoading(
 void SkeletonComponent::setSkeleton( const Skeleton& skel ) {
     m_skel    = skel;
     m_refPose = skel.getPose( SpaceType::LOCAL );
+    invalidateBakedPoses();
     setupSkeletonDisplay();
 }
 
+const SkeletonComponent::Animation& SkeletonComponent::getAnimation( const size_t i ) const {
+    return m_animations[i];
+}
+
+SkeletonComponent::Animation& SkeletonComponent::getAnimation( const size_t i ) {
+    materializeAnimation( i );
+    return m_animations[i];
+}
+
 SkeletonComponent::Animation& SkeletonComponent::addNewAnimation() {
     m_animations.emplace_back();
+    m_clips.emplace_back();
     for ( uint i = 0; i < m_skel.size(); ++i ) {
         m_animations.back().push_back( KeyFramedValue( 0_ra, m_refPose[i] ) );
     }
+    m_sampledPoseVersion = 0;
+    if ( m_animations.size() == m_animationID + 1 ) { invalidateBakedPoses(); }
+    else { updateMemoryUsage(); }
     return m_animations.back();
 }
 
 void SkeletonComponent::removeAnimation( const size_t i ) {
     CORE_ASSERT( i < m_animations.size(), "Out of bound index." );
     m_animations.erase( m_animations.begin() + i );
-    m_animationID = i > 1 ? i - 1 : 0;
+    m_clips.erase( m_clips.begin() + i );
+    m_animationID        = i > 1 ? i - 1 : 0;
+    m_useBlendTree       = false;
+    m_sampledPoseVersion = 0;
+    invalidateBakedPoses();
 }
 
 void SkeletonComponent::useAnimation( const size_t i ) {
-    if ( i < m_animations.size() ) { m_animationID = i; }
+    if ( i < m_animations.size() ) {
+        m_animationID        = i;
+        m_useBlendTree       = false;
+        m_sampledPoseVersion = 0;
+        invalidateBakedPoses();
+    }
+}
+
+void SkeletonComponent::notifyAnimationChanged( const size_t i ) {
+    CORE_ASSERT( i < m_animations.size(), "Out of bound index." );
+    // the keyframes may have been edited, they replace the clip
+    materializeAnimation( i );
+    m_clips[i] = CompressedClip();
+    if ( i == m_animationID ) {
+        m_sampledPoseVersion = 0;
+        invalidateBakedPoses();
+    }
+    else { updateMemoryUsage(); }
 }
 
 size_t SkeletonComponent::getAnimationId() const {
     return m_animationID;
 }
 
+bool SkeletonComponent::useBlendTree( const Core::Animation::AnimationBlendTree& tree ) {
+    Core::Animation::AnimationBlendTree blendTree = tree;
+    if ( !blendTree.isCompiled() && !blendTree.compile() ) { return false; }
+    for ( size_t i = 0; i < m_animations.size(); ++i ) {
+        materializeAnimation( i );
+    }
+    m_blendTree    = std::move( blendTree );
+    m_useBlendTree = true;
+    return true;
+}
+
 // Animation Process
 
 void SkeletonComponent::update( Scalar t ) {
     m_wasReset = Core::Math::areApproxEqual( t, 0_ra );
+    m_playback = { m_wasReset ? t : m_speed * t, m_autoRepeat, m_pingPong };
     if ( m_wasReset ) {
         m_animationTime = t;
         m_skel.setPose( m_refPose, SpaceType::LOCAL );
@@ -164,46 +234,80 @@ void SkeletonComponent::update( Scalar t ) {
     }
 
     m_animationTime = m_speed * t;
-    Scalar lastTime = 0;
-    if ( !m_animations.empty() ) {
-        // m_animationID is always < m_animation.size() unless m_animations.empty()
-        for ( const auto& boneAnim : m_animations[m_animationID] ) {
-            lastTime = std::max( lastTime, *boneAnim.getTimes().rbegin() );
-        }
-    }
-    if ( m_autoRepeat ) {
-        if ( !m_pingPong ) { m_animationTime = std::fmod( m_animationTime, lastTime ); }
-        else {
-            m_animationTime = std::fmod( m_animationTime, 2 * lastTime );
-            if ( m_animationTime > lastTime ) { m_animationTime = 2 * lastTime - m_animationTime; }
-        }
+    if ( m_useBlendTree ) {
+        // clip nodes loop on their own
+        Core::Animation::Pose pose = m_skel.getPose( SpaceType::LOCAL );
+        m_blendTree.evaluate( m_animations, m_animationTime, pose );
+        m_skel.setPose( pose, SpaceType::LOCAL );
+
+        updateDisplay();
+        return;
     }
-    else if ( m_pingPong ) {
-        if ( m_animationTime > 2 * lastTime ) { m_animationTime = 0_ra; }
-        else if ( m_animationTime > lastTime ) { m_animationTime = 2 * lastTime - m_animationTime; }
+
+    // the pose does not change outside of the keyframes (e.g. for static animations), skip
+    // sampling if the skeleton still holds the pose sampled at the same time
+    const Scalar sampledTime = wrapAnimationTime();
+    if ( m_sampledPoseVersion == m_skel.getPoseVersion() && sampledTime == m_sampledTime ) {
+        return;
     }
 
     // get the current pose from the animation
     Core::Animation::Pose pose = m_skel.getPose( SpaceType::LOCAL );
     if ( !m_animations.empty() ) {
-#pragma omp parallel for
-        for ( int i = 0; i < int( m_animations[m_animationID].size() ); ++i ) {
-            pose[uint( i )] = m_animations[m_animationID][uint( i )].at(
-                m_animationTime, Core::Animation::linearInterpolate<Core::Transform> );
-        }
+        sampleAnimation( m_animationID, m_animationTime, m_animationCursors, pose );
     }
     else { pose = m_refPose; }
     m_skel.setPose( pose, SpaceType::LOCAL );
+    m_sampledTime        = sampledTime;
+    m_sampledPoseVersion = m_skel.getPoseVersion();
 
     updateDisplay();
 }
 
+namespace {
+/// Wraps \p time into an animation ending at \p lastTime, according to the auto repeat and
+/// ping-pong modes.
+Scalar wrapTime( Scalar time, Scalar lastTime, bool autoRepeat, bool pingPong ) {
+    if ( autoRepeat ) {
+        if ( !pingPong ) { time = std::fmod( time, lastTime ); }
+        else {
+            time = std::fmod( time, 2 * lastTime );
+            if ( time > lastTime ) { time = 2 * lastTime - time; }
+        }
+    }
+    else if ( pingPong ) {
+        if ( time > 2 * lastTime ) { time = 0_ra; }
+        else if ( time > lastTime ) { time = 2 * lastTime - time; }
+    }
+    return time;
+}
+} // namespace
+
+Scalar SkeletonComponent::Playback::wrap( Scalar firstTime, Scalar lastTime ) const {
+    const Scalar time = wrapTime( m_time, lastTime, m_autoRepeat, m_pingPong );
+    return std::clamp( time, std::min( firstTime, lastTime ), lastTime );
+}
+
+Scalar SkeletonComponent::wrapAnimationTime() {
+    const auto [firstTime, lastTime] = getAnimationTimeInterval();
+    m_animationTime = wrapTime( m_animationTime, lastTime, m_autoRepeat, m_pingPong );
+    return std::clamp( m_animationTime, std::min( firstTime, lastTime ), lastTime );
+}
+
 Scalar SkeletonComponent::getAnimationTime() const {
     return m_animationTime;
 }
 
 std::pair<Scalar, Scalar> SkeletonComponent::getAnimationTimeInterval() const {
     if ( m_animations.empty() ) { return { 0_ra, 0_ra }; }
+    if ( const auto& clip = m_clips[m_animationID]; clip.m_clip ) {
+        // as keyframes, bones without channel have a single keyframe at 0
+        const auto isBone     = []( int b ) { return b >= 0; };
+        const size_t animated = std::count_if( clip.m_bones.begin(), clip.m_bones.end(), isBone );
+        Scalar startTime      = clip.m_clip->getStartTime();
+        if ( animated < m_skel.size() ) { startTime = std::min( startTime, 0_ra ); }
+        return { startTime, std::max( clip.m_clip->getEndTime(), 0_ra ) };
+    }
     Scalar startTime = std::numeric_limits<Scalar>::max();
     Scalar endTime   = 0;
     for ( const auto& boneAnim : m_animations[m_animationID] ) {
@@ -238,6 +342,157 @@ bool SkeletonComponent::isPingPong() const {
     return m_pingPong;
 }
 
+// Baked pose cache
+
+namespace {
+/// Return the time at which \p frame is baked, within the animation time interval.
+inline Scalar bakedFrameTime( int frame, Scalar frameStep, Scalar firstTime, Scalar lastTime ) {
+    return std::clamp( frame * frameStep, std::min( firstTime, lastTime ), lastTime );
+}
+} // namespace
+
+void SkeletonComponent::setPoseCache( size_t budget, Scalar frameStep ) {
+    if ( budget == 0 || frameStep <= 0_ra ) {
+        m_poseCache.reset();
+        updateMemoryUsage();
+        return;
+    }
+    if ( m_poseCache && frameStep == m_bakeStep ) { m_poseCache->setBudget( budget ); }
+    else {
+        m_poseCache = std::make_unique<Core::LruCache<int, Core::Animation::Pose>>(
+            budget, []( const Core::Animation::Pose& pose ) {
+                return pose.size() * sizeof( Core::Transform );
+            } );
+    }
+    m_bakeStep = frameStep;
+    invalidateBakedPoses();
+}
+
+void SkeletonComponent::updateFromCache( Scalar t ) {
+    if ( !m_poseCache || m_useBlendTree || m_animations.empty() ||
+         Core::Math::areApproxEqual( t, 0_ra ) ) {
+        update( t );
+        return;
+    }
+
+    // snap to the nearest frame
+    m_wasReset                       = false;
+    m_animationTime                  = m_speed * t;
+    m_playback                       = { m_animationTime, m_autoRepeat, m_pingPong };
+    const int frame                  = int( std::lround( wrapAnimationTime() / m_bakeStep ) );
+    const auto [firstTime, lastTime] = getAnimationTimeInterval();
+    m_animationTime                  = bakedFrameTime( frame, m_bakeStep, firstTime, lastTime );
+    if ( m_sampledPoseVersion == m_skel.getPoseVersion() && m_animationTime == m_sampledTime ) {
+        return;
+    }
+
+    if ( auto pose = m_poseCache->get( frame ) ) { m_skel.setPose( *pose, SpaceType::LOCAL ); }
+    else {
+        // not baked yet, or evicted
+        Core::Animation::Pose pose = m_skel.getPose( SpaceType::LOCAL );
+        sampleAnimation( m_animationID, m_animationTime, m_animationCursors, pose );
+        m_skel.setPose( pose, SpaceType::LOCAL );
+        m_poseCache->insert( frame, std::move( pose ) );
+        updateMemoryUsage();
+    }
+    m_sampledTime        = m_animationTime;
+    m_sampledPoseVersion = m_skel.getPoseVersion();
+
+    updateDisplay();
+}
+
+bool SkeletonComponent::needsBaking() const {
+    return m_poseCache && m_nextBakedFrame <= m_lastBakedFrame;
+}
+
+void SkeletonComponent::bakePoses( int frameCount ) {
+    if ( !needsBaking() ) { return; }
+
+    const auto [firstTime, lastTime] = getAnimationTimeInterval();
+    const size_t poseSize            = m_refPose.size() * sizeof( Core::Transform );
+    Core::Animation::Pose pose       = m_refPose;
+    for ( ; frameCount > 0 && m_nextBakedFrame <= m_lastBakedFrame; ++m_nextBakedFrame ) {
+        if ( m_poseCache->contains( m_nextBakedFrame ) ) { continue; }
+        // keep the already baked frames instead of evicting them
+        if ( m_poseCache->getMemorySize() + poseSize > m_poseCache->getBudget() ) {
+            m_nextBakedFrame = m_lastBakedFrame + 1;
+            break;
+        }
+        sampleAnimation( m_animationID,
+                         bakedFrameTime( m_nextBakedFrame, m_bakeStep, firstTime, lastTime ),
+                         m_bakeCursors,
+                         pose );
+        m_poseCache->insert( m_nextBakedFrame, pose );
+        --frameCount;
+    }
+    updateMemoryUsage();
+}
+
+void SkeletonComponent::invalidateBakedPoses() {
+    if ( m_poseCache ) {
+        m_poseCache->clear();
+        m_bakeCursors.clear();
+        if ( m_animations.empty() ) {
+            m_nextBakedFrame = 0;
+            m_lastBakedFrame = -1;
+        }
+        else {
+            const auto [firstTime, lastTime] = getAnimationTimeInterval();
+            const Scalar startTime           = std::min( firstTime, lastTime );
+            m_nextBakedFrame                 = int( std::lround( startTime / m_bakeStep ) );
+            m_lastBakedFrame                 = int( std::lround( lastTime / m_bakeStep ) );
+        }
+    }
+    updateMemoryUsage();
+}
+
+void SkeletonComponent::updateMemoryUsage() {
+    size_t size = 0;
+    for ( const auto& animation : m_animations ) {
+        for ( const auto& channel : animation ) {
+            size += channel.getKeyFrames().capacity() *
+                    sizeof( Core::Animation::KeyFramedValue<Core::Transform>::KeyFrame );
+        }
+    }
+    for ( const auto& clip : m_clips ) {
+        if ( clip.m_clip ) { size += clip.m_clip->getMemorySize(); }
+    }
+    if ( m_poseCache ) { size += m_poseCache->getMemorySize(); }
+    m_animationMemory.set( size );
+}
+
+void SkeletonComponent::materializeAnimation( size_t i ) {
+    const auto& clip = m_clips[i];
+    if ( !clip.m_clip || !m_animations[i].empty() ) { return; }
+    auto& animation = m_animations[i];
+    animation.reserve( m_skel.size() );
+    for ( uint b = 0; b < m_skel.size(); ++b ) {
+        animation.push_back( KeyFramedValue( 0_ra, m_refPose[b] ) );
+    }
+    for ( size_t c = 0; c < clip.m_bones.size(); ++c ) {
+        if ( clip.m_bones[c] >= 0 ) { animation[clip.m_bones[c]] = clip.m_clip->getChannel( c ); }
+    }
+    updateMemoryUsage();
+}
+
+void SkeletonComponent::sampleAnimation( size_t i,
+                                         Scalar t,
+                                         std::vector<size_t>& cursors,
+                                         Core::Animation::Pose& pose ) const {
+    const auto& clip = m_clips[i];
+    if ( clip.m_clip ) {
+        // bones without channel keep their reference transformation
+        pose = m_refPose;
+        clip.m_clip->sample( t, pose, cursors, clip.m_bones );
+    }
+    else { Core::Animation::sampleKeyFramedValues( m_animations[i], t, cursors, pose ); }
+}
+
+void SkeletonComponent::addMemoryUsage( Core::Utils::MemoryUsage& usage ) const {
+    Component::addMemoryUsage( usage );
+    m_animationMemory.addTo( usage );
+}
+
 // Skeleton display
 
 void SkeletonComponent::setXray( bool on ) const {
@@ -295,6 +550,7 @@ Core::Geometry::TriangleMesh makeBoneShape() {
 void SkeletonComponent::setupSkeletonDisplay() {
     m_renderObjects.clear();
     m_boneDrawables.clear();
+    m_displayedPoseVersion = 0;
     if ( !s_boneMesh ) {
         s_boneMesh = std::make_shared<Data::Mesh>( "Bone Mesh" );
         s_boneMesh->loadGeometry( makeBoneShape() );
@@ -347,6 +603,8 @@ void SkeletonComponent::printSkeleton( const Skeleton& skeleton ) {
 }
 
 void SkeletonComponent::updateDisplay() {
+    if ( m_skel.getPoseVersion() == m_displayedPoseVersion ) return;
+    m_displayedPoseVersion = m_skel.getPoseVersion();
     for ( auto& bone : m_boneDrawables ) {
         uint boneIdx = m_boneMap.at( bone->getIndex() );
         Core::Vector3 start;
@@ -407,6 +665,11 @@ void SkeletonComponent::setupIO() {
     ComponentMessenger::getInstance()->registerOutput<Scalar>(
         getEntity(), this, m_skelName, timeOut );
 
+    ComponentMessenger::CallbackTypes<Playback>::Getter playbackOut =
+        std::bind( &SkeletonComponent::getPlaybackOutput, this );
+    ComponentMessenger::getInstance()->registerOutput<Playback>(
+        getEntity(), this, m_skelName, playbackOut );
+
     ComponentMessenger::CallbackTypes<bool>::Getter resetOut =
         std::bind( &SkeletonComponent::getWasReset, this );
     ComponentMessenger::getInstance()->registerOutput<bool>(
@@ -421,8 +684,9 @@ const Core::Animation::RefPose* SkeletonComponent::getRefPoseOutput() const {
     return &m_refPose;
 }
 
-const SkeletonComponent::Animation* SkeletonComponent::getAnimationOutput() const {
+const SkeletonComponent::Animation* SkeletonComponent::getAnimationOutput() {
     if ( m_animations.empty() ) { return nullptr; }
+    materializeAnimation( m_animationID );
     return &m_animations[m_animationID];
 }
 
@@ -430,6 +694,10 @@ const Scalar* SkeletonComponent::getTimeOutput() const {
     return &m_animationTime;
 }
 
+const SkeletonComponent::Playback* SkeletonComponent::getPlaybackOutput() const {
+    return &m_playback;
+}
+
 const bool* SkeletonComponent::getWasReset() const {
     return &m_wasReset;
 }
@@ -1,10 +1,12 @@
 #pragma once
 
+#include <Core/Animation/AnimationBlendTree.hpp>
 #include <Core/Animation/HandleWeight.hpp>
 #include <Core/Animation/KeyFramedValue.hpp>
 #include <Core/Animation/Skeleton.hpp>
 #include <Core/Asset/AnimationData.hpp>
 #include <Core/Asset/HandleData.hpp>
+#include <Core/Containers/LruCache.hpp>
 
 #include <Engine/Scene/Component.hpp>
 
@@ -36,6 +38,7 @@ class SkeletonBasedAnimationSystem;
  *    - the reference Pose;
  *    - the current Animation;
  *    - the current animation time;
+ *    - the playback time and modes, for the animations sampled along with the skeleton;
  *    - whether the animation time has been reset.
  */
 class RA_ENGINE_API SkeletonComponent : public Component
@@ -46,6 +49,19 @@ class RA_ENGINE_API SkeletonComponent : public Component
     /// Animations are lists of keyframed transforms (one per bone).
     using Animation = std::vector<Core::Animation::KeyFramedValue<Core::Transform>>;
 
+    /// Playback state of the animation, for the components playing their own animation along
+    /// with the skeleton (e.g. blendshape weights), on their own time interval.
+    struct Playback {
+        /// The animation time, before wrapping.
+        Scalar m_time { 0_ra };
+        bool m_autoRepeat { false };
+        bool m_pingPong { false };
+
+        /// Returns the time at which an animation over [firstTime, lastTime] is to be sampled,
+        /// according to the auto repeat and ping-pong modes.
+        Scalar wrap( Scalar firstTime, Scalar lastTime ) const;
+    };
+
     SkeletonComponent( const std::string& name, Entity* entity );
     ~SkeletonComponent() override;
     SkeletonComponent( const SkeletonComponent& )            = delete;
@@ -94,22 +110,49 @@ class RA_ENGINE_API SkeletonComponent : public Component
     inline size_t getAnimationCount() const { return m_animations.size(); }
 
     /// Return the \p i -th animation.
-    inline const Animation& getAnimation( const size_t i ) const { return m_animations[i]; }
+    /// \note Animations loaded as compressed clips are played from the clip, and have no
+    /// keyframes until converted by materializeAnimation().
+    const Animation& getAnimation( const size_t i ) const;
 
-    /// Return the \p i -th animation.
-    inline Animation& getAnimation( const size_t i ) { return m_animations[i]; }
+    /// Return the \p i -th animation, converted to keyframes if needed.
+    /// \note notifyAnimationChanged() must be called after editing the animation.
+    Animation& getAnimation( const size_t i );
+
+    /// Converts the compressed clip of the \p i -th animation, if any, to keyframes, which are
+    /// accounted in the animation memory. The clip is still played until the keyframes are edited.
+    void materializeAnimation( size_t i );
+
+    /// Notifies that the keyframes of the \p i -th animation have been edited: if it is the
+    /// current animation, the pose is sampled again at the next update and the baked poses are
+    /// discarded. An animation loaded as a compressed clip is played from its keyframes from
+    /// now on.
+    void notifyAnimationChanged( const size_t i );
 
     /// Creates a new empty animation from the current pose.
     Animation& addNewAnimation();
 
     /// Deletes the \p i-th animation.
+    /// \note Stops playing the blend tree, since its clip indices may be invalid.
     void removeAnimation( const size_t i );
 
-    /// Set the animation to play.
+    /// Set the animation to play, instead of the blend tree.
     void useAnimation( const size_t i );
 
     /// Return the index of the animation to play.
     size_t getAnimationId() const;
+
+    /// Set the blend tree to play, instead of a single animation. Clip nodes of the tree sample
+    /// the keyframes of the animations of the component, compressed clips are converted. The
+    /// tree is compiled if needed.
+    /// \returns false, and keeps playing the current animation, if the tree is invalid.
+    bool useBlendTree( const Core::Animation::AnimationBlendTree& tree );
+
+    /// Return the blend tree, e.g. to update its weights.
+    /// \note Structural changes require to call useBlendTree again.
+    inline Core::Animation::AnimationBlendTree& getBlendTree() { return m_blendTree; }
+
+    /// Return true if the blend tree is played.
+    inline bool isUsingBlendTree() const { return m_useBlendTree; }
     /// \}
 
     /// \name Animation Process
@@ -143,6 +186,34 @@ class RA_ENGINE_API SkeletonComponent : public Component
     bool isPingPong() const;
     /// \}
 
+    /// \name Baked pose cache
+    /// The poses of the current animation can be baked per frame, to be used instead of sampling
+    /// the animation when the time jumps (e.g. when scrubbing the timeline). The
+    /// SkeletonBasedAnimationSystem bakes a few frames per engine frame, in a task run after the
+    /// animation update task of the component.
+    /// \{
+
+    /// Enables the pose cache, with frames spaced by \p frameStep and the given memory budget
+    /// (in bytes). The least recently used poses are evicted when the budget is exceeded.
+    /// \note A budget of 0 disables the cache.
+    void setPoseCache( size_t budget, Scalar frameStep );
+
+    /// Returns true if the pose cache is enabled.
+    inline bool hasPoseCache() const { return m_poseCache != nullptr; }
+
+    /// Returns true if some frames of the current animation remain to be baked.
+    bool needsBaking() const;
+
+    /// Bakes the next \p frameCount frames of the current animation which are not in the cache
+    /// yet. Stops when the cache budget is reached.
+    void bakePoses( int frameCount );
+
+    /// Updates the skeleton pose after a time jump to time \p time: the pose and the animation
+    /// time are the ones of the nearest frame, taken from the pose cache if already baked.
+    /// \note Falls back to update() if the cache is disabled or the blend tree is played.
+    void updateFromCache( Scalar time );
+    /// \}
+
     /// \name Skeleton display and manipulation
     /// \{
 
@@ -162,7 +233,7 @@ class RA_ENGINE_API SkeletonComponent : public Component
     /// Returns the map from RO index to bone index.
     const std::map<Core::Utils::Index, uint>* getBoneRO2idx() const;
 
-    /// Updates the skeleton display.
+    /// Updates the skeleton display, if the skeleton pose has changed since the last update.
     void updateDisplay();
 
     /// Sets the given manipulation scheme for the Skeleton.
@@ -172,6 +243,10 @@ class RA_ENGINE_API SkeletonComponent : public Component
     Core::Animation::Skeleton::Manipulation getManipulationScheme();
     /// \}
 
+    /// Add the memory of the animations and of the baked poses, accounted as
+    /// MemoryCategory::Animation.
+    void addMemoryUsage( Core::Utils::MemoryUsage& usage ) const override;
+
   private:
     /// Internal function to create the bone display objects.
     void setupSkeletonDisplay();
@@ -179,6 +254,24 @@ class RA_ENGINE_API SkeletonComponent : public Component
     /// Internal Debug function to display the skeleton hierarchy.
     void printSkeleton( const Core::Animation::Skeleton& skeleton );
 
+    /// Wraps m_animationTime into the current animation according to the auto repeat and
+    /// ping-pong modes.
+    /// \returns the time at which the current animation is to be sampled.
+    Scalar wrapAnimationTime();
+
+    /// Updates the accounted memory of the animations and of the baked poses.
+    void updateMemoryUsage();
+
+    /// Samples the \p i -th animation at time \p t into \p pose, from its compressed clip if any.
+    void sampleAnimation( size_t i,
+                          Scalar t,
+                          std::vector<size_t>& cursors,
+                          Core::Animation::Pose& pose ) const;
+
+    /// Clears the pose cache, e.g. when the current animation changes. Baking restarts from the
+    /// first frame.
+    void invalidateBakedPoses();
+
     /// \name Component Communication (CC)
     /// \{
 
@@ -188,12 +281,15 @@ class RA_ENGINE_API SkeletonComponent : public Component
     /// Reference Pose getter for CC.
     const Core::Animation::RefPose* getRefPoseOutput() const;
 
-    /// Current Animation getter for CC.
-    const Animation* getAnimationOutput() const;
+    /// Current Animation getter for CC, converted to keyframes if needed.
+    const Animation* getAnimationOutput();
 
     /// Current Animation Time for CC.
     const Scalar* getTimeOutput() const;
 
+    /// Current Playback for CC.
+    const Playback* getPlaybackOutput() const;
+
     /// Reset status getter for CC.
     const bool* getWasReset() const;
     /// \}
@@ -208,15 +304,59 @@ class RA_ENGINE_API SkeletonComponent : public Component
     /// The Reference Pose in model space.
     Core::Animation::RefPose m_refPose;
 
-    /// The animations.
+    /// Compressed clip of an animation, with the bone of each clip channel (-1 if none).
+    struct CompressedClip {
+        std::shared_ptr<const Core::Animation::CompressedAnimation> m_clip;
+        std::vector<int> m_bones;
+    };
+
+    /// The animations. Animations played from a compressed clip have no keyframes until
+    /// requested, see materializeAnimation().
     std::vector<Animation> m_animations;
 
+    /// The compressed clips of the animations, null for keyframed animations.
+    std::vector<CompressedClip> m_clips;
+
     /// Current animation ID.
     size_t m_animationID { 0 };
 
     /// Current animation time (might be different from the app time -- see below).
     Scalar m_animationTime { 0_ra };
 
+    /// Per-bone keyframe cursors for the current animation playback.
+    std::vector<size_t> m_animationCursors;
+
+    /// The blend tree, played instead of the current animation if m_useBlendTree.
+    Core::Animation::AnimationBlendTree m_blendTree;
+
+    /// Whether the blend tree is played.
+    bool m_useBlendTree { false };
+
+    /// Time at which the current animation was last sampled.
+    Scalar m_sampledTime { 0_ra };
+
+    /// Version of the skeleton pose resulting from the last animation sampling (0 if none).
+    uint64_t m_sampledPoseVersion { 0 };
+
+    /// Version of the skeleton pose last displayed (0 if none).
+    uint64_t m_displayedPoseVersion { 0 };
+
+    /// Baked poses of the current animation, in local space, per frame index.
+    std::unique_ptr<Core::LruCache<int, Core::Animation::Pose>> m_poseCache;
+
+    /// Time between two baked frames.
+    Scalar m_bakeStep { 1_ra / 60_ra };
+
+    /// Next frame to bake, and last frame of the current animation.
+    int m_nextBakedFrame { 0 };
+    int m_lastBakedFrame { -1 };
+
+    /// Keyframe cursors of the baking, which samples the frames in increasing time order.
+    std::vector<size_t> m_bakeCursors;
+
+    /// Memory of the animations and of the baked poses, updated when they change.
+    Core::Utils::TrackedMemory m_animationMemory { Core::Utils::MemoryCategory::Animation };
+
     /// Animation Play speed.
     Scalar m_speed { 1_ra };
 
@@ -229,6 +369,9 @@ class RA_ENGINE_API SkeletonComponent : public Component
     /// Was the animation reset?
     bool m_wasReset { false };
 
+    /// The playback state, for CC.
+    Playback m_playback;
+
     /// Bones ROs.
     std::vector<Rendering::RenderObject*> m_boneDrawables;
 
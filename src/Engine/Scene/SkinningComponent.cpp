@@ -2,13 +2,17 @@
 
 #include <Core/Animation/PoseOperation.hpp>
 
+#include <Core/Animation/CageDeformation.hpp>
 #include <Core/Animation/DualQuaternionSkinning.hpp>
 #include <Core/Animation/HandleWeightOperation.hpp>
+#include <Core/Animation/KeyFramedValueInterpolators.hpp>
 #include <Core/Animation/LinearBlendSkinning.hpp>
 #include <Core/Animation/RotationCenterSkinning.hpp>
 #include <Core/Geometry/DistanceQueries.hpp>
+#include <Core/Resources/Resources.hpp>
 #include <Core/Utils/Color.hpp>
 #include <Core/Utils/Log.hpp>
+#include <Core/Utils/StdUtils.hpp>
 
 #include <Engine/Data/BlinnPhongMaterial.hpp>
 #include <Engine/Data/Mesh.hpp>
@@ -19,6 +23,12 @@
 #include <Engine/Rendering/RenderObjectManager.hpp>
 #include <Engine/Rendering/RenderTechnique.hpp>
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <mutex>
+#include <unordered_map>
+
 using namespace Ra::Core;
 
 using Geometry::AttribArrayGeometry;
@@ -83,6 +93,59 @@ TriangleMesh triangulate( const QuadMesh& quadMesh ) {
     return res;
 }
 
+namespace {
+template <typename Array>
+bool sameArrays( const Array& a, const Array& b ) {
+    return a.size() == b.size() && std::equal( a.begin(), a.end(), b.begin() );
+}
+
+bool sameAttrib( const TriangleMesh& a, const TriangleMesh& b, const std::string& name ) {
+    const auto aH = a.getAttribHandle<Vector3>( name );
+    const auto bH = b.getAttribHandle<Vector3>( name );
+    return a.isValid( aH ) == b.isValid( bH ) &&
+           ( !a.isValid( aH ) || sameArrays( a.getAttrib( aH ).view(), b.getAttrib( bH ).view() ) );
+}
+
+template <typename Matrix>
+bool sameWeights( const Matrix& a, const Matrix& b ) {
+    return a.rows() == b.rows() && a.cols() == b.cols() && a.nonZeros() == b.nonZeros() &&
+           ( a.nonZeros() == 0 || Matrix( a - b ).norm() == 0_ra );
+}
+
+/// Whether the skinning of \p a and \p b gives the same result for any pose.
+bool isSameRefData( const SkinningRefData& a, const SkinningRefData& b ) {
+    const auto& meshA = a.m_referenceMesh;
+    const auto& meshB = b.m_referenceMesh;
+    if ( !sameArrays( meshA.vertices(), meshB.vertices() ) ||
+         !sameArrays( meshA.normals(), meshB.normals() ) ||
+         !sameArrays( meshA.getIndices(), meshB.getIndices() ) ||
+         !sameAttrib( meshA, meshB, tangentName ) || !sameAttrib( meshA, meshB, bitangentName ) ) {
+        return false;
+    }
+    if ( !sameWeights( a.m_weights, b.m_weights ) ||
+         !sameWeights( a.m_cageWeights, b.m_cageWeights ) || !sameArrays( a.m_CoR, b.m_CoR ) ) {
+        return false;
+    }
+    if ( a.m_meshTransformInverse.matrix() != b.m_meshTransformInverse.matrix() ||
+         a.m_skeleton.size() != b.m_skeleton.size() ||
+         a.m_bindMatrices.size() != b.m_bindMatrices.size() ) {
+        return false;
+    }
+    for ( size_t i = 0; i < a.m_bindMatrices.size(); ++i ) {
+        if ( a.m_bindMatrices[i].matrix() != b.m_bindMatrices[i].matrix() ) { return false; }
+    }
+    for ( uint i = 0; i < a.m_skeleton.size(); ++i ) {
+        if ( a.m_skeleton.getLabel( i ) != b.m_skeleton.getLabel( i ) ) { return false; }
+    }
+    return true;
+}
+} // namespace
+
+SkinningComponent::~SkinningComponent() {
+    // hand the report of the shared reference data to the next sharer
+    releaseRefData();
+}
+
 void SkinningComponent::initialize() {
     auto compMsg = ComponentMessenger::getInstance();
     // get the current animation data.
@@ -95,6 +158,13 @@ void SkinningComponent::initialize() {
     if ( hasSkel && hasRefPose && ( hasTriMesh || m_meshIsPoly || m_meshIsQuad ) ) {
         m_renderObjectReader = compMsg->getterCallback<Index>( getEntity(), m_meshName );
         m_skeletonGetter     = compMsg->getterCallback<Skeleton>( getEntity(), m_skelName );
+        if ( compMsg->canGet<Scalar>( getEntity(), m_skelName ) ) {
+            m_timeGetter = compMsg->getterCallback<Scalar>( getEntity(), m_skelName );
+        }
+        if ( compMsg->canGet<SkeletonComponent::Playback>( getEntity(), m_skelName ) ) {
+            m_playbackGetter =
+                compMsg->getterCallback<SkeletonComponent::Playback>( getEntity(), m_skelName );
+        }
         if ( hasTriMesh ) {
             m_triMeshWriter = compMsg->rwCallback<TriangleMesh>( getEntity(), m_meshName );
         }
@@ -104,65 +174,93 @@ void SkinningComponent::initialize() {
         else { m_polyMeshWriter = compMsg->rwCallback<PolyMesh>( getEntity(), m_meshName ); }
 
         // copy mesh triangles and find duplicates for normal computation.
-        if ( hasTriMesh ) { m_refData.m_referenceMesh = *m_triMeshWriter(); }
-        else if ( m_meshIsQuad ) { m_refData.m_referenceMesh = triangulate( *m_quadMeshWriter() ); }
-        else { m_refData.m_referenceMesh = triangulate( *m_polyMeshWriter() ); }
+        m_refData     = std::make_shared<SharedRefData>();
+        auto& refMesh = m_refData->m_referenceMesh;
+        if ( hasTriMesh ) { refMesh = *m_triMeshWriter(); }
+        else if ( m_meshIsQuad ) { refMesh = triangulate( *m_quadMeshWriter() ); }
+        else { refMesh = triangulate( *m_polyMeshWriter() ); }
+        refMesh.setMemoryCategory( MemoryCategory::Skinning );
         /// TODO : use the tangent computation algorithms from Core as soon as it is available.
-        if ( !m_refData.m_referenceMesh.hasAttrib( tangentName ) &&
-             !m_refData.m_referenceMesh.hasAttrib( bitangentName ) ) {
-            const auto& normals = m_refData.m_referenceMesh.normals();
+        if ( !refMesh.hasAttrib( tangentName ) && !refMesh.hasAttrib( bitangentName ) ) {
+            const auto& normals = refMesh.normals();
             Vector3Array tangents( normals.size() );
             Vector3Array bitangents( normals.size() );
 #pragma omp parallel for
             for ( int i = 0; i < int( normals.size() ); ++i ) {
                 Core::Math::getOrthogonalVectors( normals[i], tangents[i], bitangents[i] );
             }
-            m_refData.m_referenceMesh.addAttrib( tangentName, std::move( tangents ) );
-            m_refData.m_referenceMesh.addAttrib( bitangentName, std::move( bitangents ) );
+            refMesh.addAttrib( tangentName, std::move( tangents ) );
+            refMesh.addAttrib( bitangentName, std::move( bitangents ) );
         }
-        else if ( !m_refData.m_referenceMesh.hasAttrib( tangentName ) ) {
-            const auto& normals = m_refData.m_referenceMesh.normals();
-            const auto& bH = m_refData.m_referenceMesh.getAttribHandle<Vector3>( bitangentName );
-            const auto& bitangents = m_refData.m_referenceMesh.getAttrib( bH ).data();
+        else if ( !refMesh.hasAttrib( tangentName ) ) {
+            const auto& normals    = refMesh.normals();
+            const auto& bH         = refMesh.getAttribHandle<Vector3>( bitangentName );
+            const auto bitangents  = refMesh.getAttrib( bH ).view();
             Vector3Array tangents( normals.size() );
 #pragma omp parallel for
             for ( int i = 0; i < int( normals.size() ); ++i ) {
                 tangents[i] = bitangents[i].cross( normals[i] );
             }
-            m_refData.m_referenceMesh.addAttrib( tangentName, std::move( tangents ) );
+            refMesh.addAttrib( tangentName, std::move( tangents ) );
         }
-        else if ( !m_refData.m_referenceMesh.hasAttrib( bitangentName ) ) {
-            const auto& normals = m_refData.m_referenceMesh.normals();
-            const auto& tH      = m_refData.m_referenceMesh.getAttribHandle<Vector3>( tangentName );
-            const auto& tangents = m_refData.m_referenceMesh.getAttrib( tH ).data();
+        else if ( !refMesh.hasAttrib( bitangentName ) ) {
+            const auto& normals  = refMesh.normals();
+            const auto& tH       = refMesh.getAttribHandle<Vector3>( tangentName );
+            const auto tangents  = refMesh.getAttrib( tH ).view();
             Vector3Array bitangents( normals.size() );
 #pragma omp parallel for
             for ( int i = 0; i < int( normals.size() ); ++i ) {
                 bitangents[i] = normals[i].cross( tangents[i] );
             }
-            m_refData.m_referenceMesh.addAttrib( bitangentName, std::move( bitangents ) );
+            refMesh.addAttrib( bitangentName, std::move( bitangents ) );
+        }
+
+        // prepare the blendshapes, the reference mesh being the base mesh
+        if ( !m_loadedBlendShapes.empty() ) {
+            const auto& mesh = refMesh;
+            if ( mesh.vertices().size() == m_blendShapeVertexCount ) {
+                const auto& tH       = mesh.getAttribHandle<Vector3>( tangentName );
+                m_blendShapeDeformer = BlendShapeDeformer( std::move( m_loadedBlendShapes ),
+                                                           mesh.vertices(),
+                                                           mesh.normals(),
+                                                           mesh.getAttrib( tH ).data() );
+                m_appliedBlendShapeWeights.assign( m_blendShapeWeights.size(), 0_ra );
+            }
+            else {
+                LOG( logWARNING ) << "Blendshapes of mesh " << m_meshName
+                                  << " are incompatible with the skinned mesh, ignored.";
+                m_blendShapeWeights.clear();
+                m_blendShapeAnimation.clear();
+            }
+            m_loadedBlendShapes.clear();
         }
 
-        m_topoMesh = Ra::Core::Geometry::TopologicalMesh { m_refData.m_referenceMesh };
+        m_normalStencil = Geometry::NormalStencil( refMesh.vertices(),
+                                                   refMesh.getIndices(),
+                                                   refMesh.normals() );
 
         auto ro = getRoMgr()->getRenderObject( *m_renderObjectReader() );
         // get other data
-        m_refData.m_meshTransformInverse = ro->getLocalTransform().inverse();
-        m_refData.m_skeleton             = *m_skeletonGetter();
+        m_refData->m_meshTransformInverse = ro->getLocalTransform().inverse();
+        m_refData->m_skeleton             = *m_skeletonGetter();
         createWeightMatrix();
+        if ( !m_cage.m_triangle.empty() ) { m_refData->m_cageWeights = computeCageWeights(); }
+        shareRefData();
 
         // initialize frame data
-        m_frameData.m_skeleton        = m_refData.m_skeleton;
-        m_frameData.m_currentPosition = m_refData.m_referenceMesh.vertices();
-        m_frameData.m_currentNormal   = m_refData.m_referenceMesh.normals();
-        const auto& tH = m_refData.m_referenceMesh.getAttribHandle<Vector3>( tangentName );
-        m_frameData.m_currentTangent = m_refData.m_referenceMesh.getAttrib( tH ).data();
-        const auto& bH = m_refData.m_referenceMesh.getAttribHandle<Vector3>( bitangentName );
-        m_frameData.m_currentBitangent = m_refData.m_referenceMesh.getAttrib( bH ).data();
+        m_frameData.m_skeleton        = m_refData->m_skeleton;
+        m_frameData.m_currentPosition = m_refData->m_referenceMesh.vertices();
+        m_frameData.m_currentNormal   = m_refData->m_referenceMesh.normals();
+        const auto& tH = m_refData->m_referenceMesh.getAttribHandle<Vector3>( tangentName );
+        m_frameData.m_currentTangent = m_refData->m_referenceMesh.getAttrib( tH ).data();
+        const auto& bH = m_refData->m_referenceMesh.getAttribHandle<Vector3>( bitangentName );
+        m_frameData.m_currentBitangent = m_refData->m_referenceMesh.getAttrib( bH ).data();
         m_frameData.m_frameCounter     = 0;
         m_frameData.m_doSkinning       = true;
         m_frameData.m_doReset          = false;
 
+        updateMemoryUsage();
+
         // setup comp data
         m_isReady     = true;
         m_forceUpdate = true;
@@ -212,47 +310,328 @@ void SkinningComponent::skin() {
         m_frameData.m_frameCounter = 0;
         m_forceUpdate              = true;
     }
-    const auto prevPose    = m_frameData.m_skeleton.getPose( SpaceType::MODEL );
-    m_frameData.m_skeleton = *skel;
-    auto currentPose       = m_frameData.m_skeleton.getPose( SpaceType::MODEL );
-    if ( !areEqual( currentPose, prevPose ) || m_forceUpdate ) {
+    // apply the blendshapes onto the reference mesh, which is then skinned
+    if ( !m_blendShapeDeformer.empty() && applyBlendShapes() ) { m_forceUpdate = true; }
+
+    // the skeleton copy keeps the pose version of the skeleton it was copied from
+    if ( skel->getPoseVersion() != m_frameData.m_skeleton.getPoseVersion() || m_forceUpdate ) {
+        // cage deformation moves all the vertices
+        const bool fullUpdate = m_forceUpdate || m_skinningType == CAGE;
+        if ( m_normalSkinning == GEOMETRIC && !fullUpdate ) {
+            // flag the vertices influenced by the bones which moved since the last skinning
+            m_movedVertices.assign( m_refData->m_referenceMesh.vertices().size(), false );
+            const auto& pose     = skel->getPose( SpaceType::MODEL );
+            const auto& prevPose = m_frameData.m_skeleton.getPose( SpaceType::MODEL );
+            for ( uint b = 0; b < pose.size(); ++b ) {
+                if ( pose[b].matrix() == prevPose[b].matrix() ) { continue; }
+                for ( Sparse::InnerIterator it( m_refData->m_weights, b ); it; ++it ) {
+                    m_movedVertices[it.row()] = true;
+                }
+            }
+        }
+        m_frameData.m_skeleton   = *skel;
         m_forceUpdate            = false;
         m_frameData.m_doSkinning = true;
         m_frameData.m_frameCounter++;
 
-        const auto tH = m_refData.m_referenceMesh.getAttribHandle<Vector3>( tangentName );
-        const Vector3Array& tangents = m_refData.m_referenceMesh.getAttrib( tH ).data();
-        const auto bH = m_refData.m_referenceMesh.getAttribHandle<Vector3>( bitangentName );
-        const Vector3Array& bitangents = m_refData.m_referenceMesh.getAttrib( bH ).data();
+        const auto tH = m_refData->m_referenceMesh.getAttribHandle<Vector3>( tangentName );
+        const Vector3Array& tangents = m_refData->m_referenceMesh.getAttrib( tH ).data();
+        const auto bH = m_refData->m_referenceMesh.getAttribHandle<Vector3>( bitangentName );
+        const Vector3Array& bitangents = m_refData->m_referenceMesh.getAttrib( bH ).data();
 
         switch ( m_skinningType ) {
         case DQS: {
-            dualQuaternionSkinning( m_refData, tangents, bitangents, m_frameData );
+            dualQuaternionSkinning( *m_refData, tangents, bitangents, m_frameData );
             break;
         }
         case COR: {
-            centerOfRotationSkinning( m_refData, tangents, bitangents, m_frameData );
+            centerOfRotationSkinning( *m_refData, tangents, bitangents, m_frameData );
+            break;
+        }
+        case CAGE: {
+            cageDeformation( m_refData->m_cageWeights, m_cage, m_frameData.m_currentPosition );
+            // the cage weights are computed on the base positions, without the blendshapes
+            // applied onto the reference mesh: add their deltas to the deformed positions
+            if ( !m_blendShapeDeformer.empty() ) {
+                m_blendShapeDeformer.addPositionDeltas( m_appliedBlendShapeWeights,
+                                                        m_frameData.m_currentPosition );
+            }
             break;
         }
         case LBS:
         default: {
-            linearBlendSkinning( m_refData, tangents, bitangents, m_frameData );
+            linearBlendSkinning( *m_refData, tangents, bitangents, m_frameData );
             break;
         }
         }
 
-        if ( m_normalSkinning == GEOMETRIC ) {
-            m_topoMesh.updatePositions( m_frameData.m_currentPosition );
-            m_topoMesh.updateWedgeNormals();
-            m_topoMesh.updateTriangleMeshNormals( m_frameData.m_currentNormal );
+        // cage deformation does not deform the normals, they are always recomputed
+        if ( m_normalSkinning == GEOMETRIC || m_skinningType == CAGE ) {
+            computeGeometricNormals( fullUpdate );
+        }
+    }
+}
+
+void SkinningComponent::skinFromCache() {
+    CORE_ASSERT( m_isReady, "Skinning is not setup" );
+    bool reset = ComponentMessenger::getInstance()->get<bool>( getEntity(), m_skelName );
+    if ( !m_skinCache || !m_timeGetter || m_forceUpdate || reset ) {
+        skin();
+        return;
+    }
+
+    const int frame      = int( std::lround( *m_timeGetter() / m_bakeStep ) );
+    const Skeleton* skel = m_skeletonGetter();
+    const auto& pose     = skel->getPose( SpaceType::LOCAL );
+    auto baked           = m_skinCache->get( frame );
+    // the frame may have been baked from another animation
+    const auto samePose = []( const Transform& a, const Transform& b ) {
+        return a.matrix() == b.matrix();
+    };
+    // or with other blendshape weights, which are animated on their own time interval
+    const auto weights = sampleBlendShapeWeights();
+    const bool valid   = baked && baked->m_pose.size() == pose.size() &&
+                         std::equal( pose.begin(), pose.end(), baked->m_pose.begin(), samePose ) &&
+                         baked->m_blendShapeWeights == weights;
+    if ( !valid ) {
+        skin();
+        m_skinCache->insert( frame, bakeSkin( pose ) );
+        updateMemoryUsage();
+        return;
+    }
+    // the baked frame accounts for the blendshapes, which are applied onto the reference mesh
+    // at the next skinning
+    if ( skel->getPoseVersion() != m_frameData.m_skeleton.getPoseVersion() ||
+         weights != m_frameBlendShapeWeights ) {
+        unbakeSkin( *baked );
+        m_frameData.m_skeleton   = *skel;
+        m_frameData.m_doSkinning = true;
+        m_frameData.m_frameCounter++;
+    }
+}
+
+SkinningComponent::BakedSkin SkinningComponent::bakeSkin( const Pose& pose ) const {
+    const auto& positions = m_frameData.m_currentPosition;
+    BakedSkin skin;
+    skin.m_pose              = pose;
+    skin.m_blendShapeWeights = m_frameBlendShapeWeights;
+    Aabb aabb;
+    for ( const auto& p : positions ) {
+        aabb.extend( p );
+    }
+    skin.m_origin = aabb.isEmpty() ? Vector3::Zero() : aabb.min();
+    skin.m_extent = aabb.isEmpty() ? Vector3::Zero() : Vector3( aabb.sizes() );
+
+    const auto quantizePosition = [&skin]( const Vector3& p ) {
+        std::array<uint16_t, 3> q;
+        for ( int k = 0; k < 3; ++k ) {
+            const Scalar x = skin.m_extent[k] > 0_ra
+                                 ? ( p[k] - skin.m_origin[k] ) / skin.m_extent[k]
+                                 : 0_ra;
+            q[k] = uint16_t( std::lround( std::clamp( x, 0_ra, 1_ra ) * 65535_ra ) );
+        }
+        return q;
+    };
+    const auto quantizeUnit = []( const Vector3& v ) {
+        std::array<int16_t, 3> q;
+        for ( int k = 0; k < 3; ++k ) {
+            q[k] = int16_t( std::lround( std::clamp( v[k], -1_ra, 1_ra ) * 32767_ra ) );
+        }
+        return q;
+    };
+    const auto quantizeUnits = [&quantizeUnit]( const Vector3Array& in,
+                                                std::vector<std::array<int16_t, 3>>& out ) {
+        out.resize( in.size() );
+        std::transform( in.begin(), in.end(), out.begin(), quantizeUnit );
+    };
+
+    skin.m_positions.resize( positions.size() );
+    std::transform(
+        positions.begin(), positions.end(), skin.m_positions.begin(), quantizePosition );
+    quantizeUnits( m_frameData.m_currentNormal, skin.m_normals );
+    quantizeUnits( m_frameData.m_currentTangent, skin.m_tangents );
+    quantizeUnits( m_frameData.m_currentBitangent, skin.m_bitangents );
+    return skin;
+}
+
+void SkinningComponent::unbakeSkin( const BakedSkin& skin ) {
+    const auto dequantizeUnits = []( const std::vector<std::array<int16_t, 3>>& in,
+                                     Vector3Array& out ) {
+        out.resize( in.size() );
+        for ( size_t i = 0; i < in.size(); ++i ) {
+            out[i] = Vector3( in[i][0], in[i][1], in[i][2] ).normalized();
+        }
+    };
+
+    auto& positions = m_frameData.m_currentPosition;
+    positions.resize( skin.m_positions.size() );
+    for ( size_t i = 0; i < positions.size(); ++i ) {
+        const auto& q = skin.m_positions[i];
+        positions[i] =
+            skin.m_origin +
+            skin.m_extent.cwiseProduct( Vector3( q[0], q[1], q[2] ) / 65535_ra );
+    }
+    dequantizeUnits( skin.m_normals, m_frameData.m_currentNormal );
+    dequantizeUnits( skin.m_tangents, m_frameData.m_currentTangent );
+    dequantizeUnits( skin.m_bitangents, m_frameData.m_currentBitangent );
+    m_frameBlendShapeWeights = skin.m_blendShapeWeights;
+    // the geometric normals are recomputed from scratch at the next skinning
+    m_geometricNormals.clear();
+}
+
+void SkinningComponent::setSkinCache( size_t budget, Scalar frameStep ) {
+    if ( budget == 0 || frameStep <= 0_ra ) {
+        m_skinCache.reset();
+        updateMemoryUsage();
+        return;
+    }
+    if ( m_skinCache && frameStep == m_bakeStep ) { m_skinCache->setBudget( budget ); }
+    else {
+        m_skinCache = std::make_unique<LruCache<int, BakedSkin>>(
+            budget, []( const BakedSkin& skin ) {
+                return skin.m_pose.size() * sizeof( Transform ) +
+                       skin.m_blendShapeWeights.size() * sizeof( Scalar ) +
+                       skin.m_positions.size() * sizeof( std::array<uint16_t, 3> ) +
+                       ( skin.m_normals.size() + skin.m_tangents.size() +
+                         skin.m_bitangents.size() ) *
+                           sizeof( std::array<int16_t, 3> );
+            } );
+    }
+    m_bakeStep = frameStep;
+    updateMemoryUsage();
+}
+
+void SkinningComponent::clearSkinCache() {
+    if ( m_skinCache ) { m_skinCache->clear(); }
+    updateMemoryUsage();
+}
+
+void SkinningComponent::updateRefDataMemoryUsage() {
+    const auto sparseSize = []( const auto& m ) {
+        using StorageIndex = typename std::decay_t<decltype( m )>::StorageIndex;
+        return size_t( m.nonZeros() ) * ( sizeof( Scalar ) + sizeof( StorageIndex ) ) +
+               size_t( m.outerSize() + 1 ) * sizeof( StorageIndex );
+    };
+    size_t refSize = sparseSize( m_refData->m_weights ) + sparseSize( m_refData->m_weightSTBS ) +
+                     sparseSize( m_refData->m_cageWeights );
+    const auto& packed = m_refData->m_packedWeights;
+    refSize += ( packed.getBones().capacity() + packed.getQuantizedWeights().capacity() ) *
+               sizeof( uint16_t );
+    refSize += m_refData->m_bindMatrices.capacity() * sizeof( Transform );
+    refSize += m_refData->m_CoR.capacity() * sizeof( Vector3 );
+    m_refData->m_memory.set( refSize );
+}
+
+void SkinningComponent::updateMemoryUsage() {
+    size_t size = 0;
+    for ( const Vector3Array* array : { &m_frameData.m_currentPosition,
+                                        &m_frameData.m_currentNormal,
+                                        &m_frameData.m_currentTangent,
+                                        &m_frameData.m_currentBitangent,
+                                        &m_geometricNormals,
+                                        &m_geometricTangents,
+                                        &m_geometricBitangents } ) {
+        size += array->capacity() * sizeof( Vector3 );
+    }
+    if ( m_skinCache ) { size += m_skinCache->getMemorySize(); }
+    m_skinningMemory.set( size );
+}
+
+void SkinningComponent::addMemoryUsage( MemoryUsage& usage ) const {
+    Component::addMemoryUsage( usage );
+    m_skinningMemory.addTo( usage );
+    // the shared reference data is reported by the first component using it
+    const auto& sharers = m_refData->m_sharers;
+    if ( !sharers.empty() && sharers.front() == this ) {
+        m_refData->m_memory.addTo( usage );
+        m_refData->m_referenceMesh.addMemoryUsage( usage );
+    }
+}
+
+void SkinningComponent::shareRefData() {
+    auto& sharers = m_refData->m_sharers;
+    if ( std::find( sharers.begin(), sharers.end(), this ) == sharers.end() ) {
+        sharers.push_back( this );
+    }
+    updateRefDataMemoryUsage();
+
+    // the blendshapes are applied onto the reference mesh, which is then specific to the component
+    if ( !m_blendShapeDeformer.empty() ) { return; }
+
+    // hash of the reference mesh and weights, collisions being sorted out by comparing the data
+    const auto& vertices = m_refData->m_referenceMesh.vertices();
+    const auto& indices  = m_refData->m_referenceMesh.getIndices();
+    const auto& W        = m_refData->m_weights;
+
+    uint64_t key = fnv1a( vertices.data(), sizeof( Vector3 ) * vertices.size() );
+    key          = fnv1a( indices.data(), sizeof( Vector3ui ) * indices.size(), key );
+    for ( int k = 0; k < W.outerSize(); ++k ) {
+        for ( Sparse::InnerIterator it( W, k ); it; ++it ) {
+            const auto row     = it.row();
+            const Scalar value = it.value();
+            key                = fnv1a( &row, sizeof( row ), key );
+            key                = fnv1a( &value, sizeof( value ), key );
+        }
+    }
+
+    static std::mutex registryMutex;
+    static std::unordered_multimap<uint64_t, std::weak_ptr<SharedRefData>> registry;
+    std::lock_guard<std::mutex> lock( registryMutex );
+    auto range = registry.equal_range( key );
+    for ( auto it = range.first; it != range.second; ) {
+        auto refData = it->second.lock();
+        if ( !refData ) {
+            it = registry.erase( it );
+            continue;
+        }
+        if ( refData == m_refData ) { return; }
+        if ( isSameRefData( *refData, *m_refData ) ) {
+            releaseRefData();
+            m_refData = std::move( refData );
+            m_refData->m_sharers.push_back( this );
+            return;
+        }
+        ++it;
+    }
+    registry.emplace( key, m_refData );
+}
+
+SkinningComponent::SharedRefData& SkinningComponent::editRefData() {
+    if ( m_refData.use_count() > 1 ) {
+        releaseRefData();
+        m_refData            = std::make_shared<SharedRefData>( *m_refData );
+        m_refData->m_sharers = { this };
+        updateRefDataMemoryUsage();
+    }
+    return *m_refData;
+}
+
+void SkinningComponent::releaseRefData() {
+    auto& sharers = m_refData->m_sharers;
+    sharers.erase( std::remove( sharers.begin(), sharers.end(), this ), sharers.end() );
+}
+
+void SkinningComponent::computeGeometricNormals( bool fullUpdate ) {
+    const auto& positions = m_frameData.m_currentPosition;
+    const int size        = int( positions.size() );
+    if ( fullUpdate || m_geometricNormals.size() != positions.size() ) {
+        m_geometricNormals.resize( size );
+        m_geometricTangents.resize( size );
+        m_geometricBitangents.resize( size );
+        m_normalStencil.computeNormals( positions, m_geometricNormals );
+    }
+    else { m_normalStencil.computeNormals( positions, m_movedVertices, m_geometricNormals ); }
 #pragma omp parallel for
-            for ( int i = 0; i < int( m_frameData.m_currentNormal.size() ); ++i ) {
-                Core::Math::getOrthogonalVectors( m_frameData.m_currentNormal[i],
-                                                  m_frameData.m_currentTangent[i],
-                                                  m_frameData.m_currentBitangent[i] );
-            }
+    for ( int i = 0; i < size; ++i ) {
+        if ( m_normalStencil.wasUpdated( uint( i ) ) ) {
+            Core::Math::getOrthogonalVectors(
+                m_geometricNormals[i], m_geometricTangents[i], m_geometricBitangents[i] );
         }
     }
+    // the skinning overwrote the vectors of all the vertices, including the non updated ones
+    m_frameData.m_currentNormal    = m_geometricNormals;
+    m_frameData.m_currentTangent   = m_geometricTangents;
+    m_frameData.m_currentBitangent = m_geometricBitangents;
 }
 
 void SkinningComponent::endSkinning() {
@@ -264,6 +643,8 @@ void SkinningComponent::endSkinning() {
         }
         else { geom = const_cast<PolyMesh*>( m_polyMeshWriter() ); }
 
+        // the displayable is notified once per attrib, when the batch ends
+        auto batch = geom->vertexAttribs().getScopedNotificationBatch();
         geom->setVertices( m_frameData.m_currentPosition );
         geom->setNormals( m_frameData.m_currentNormal );
         auto handle = geom->getAttribHandle<Vector3>( tangentName );
@@ -302,33 +683,120 @@ void SkinningComponent::handleSkinDataLoading( const Asset::HandleData* data,
     }
 }
 
+void SkinningComponent::handleBlendShapeLoading(
+    const Asset::GeometryData* geom,
+    const std::vector<Asset::AnimationData*>& animData ) {
+    m_loadedBlendShapes = geom->getBlendShapes();
+    if ( m_loadedBlendShapes.empty() ) { return; }
+    m_blendShapeVertexCount = geom->getGeometry().vertices().size();
+    m_blendShapeWeights.resize( m_loadedBlendShapes.size() );
+    std::transform( m_loadedBlendShapes.begin(),
+                    m_loadedBlendShapes.end(),
+                    m_blendShapeWeights.begin(),
+                    []( const auto& shape ) { return shape.m_defaultWeight; } );
+
+    for ( const auto& anim : animData ) {
+        const auto& morphData = anim->getMorphData();
+        auto it = std::find_if( morphData.begin(), morphData.end(), [&geom]( const auto& morph ) {
+            return morph.m_meshName == geom->getName();
+        } );
+        if ( it != morphData.end() ) {
+            m_blendShapeAnimation = it->m_weights;
+            if ( m_blendShapeAnimation.size() > m_loadedBlendShapes.size() ) {
+                LOG( logWARNING ) << "Mesh " << geom->getName()
+                                  << " has more animated weights than blendshapes.";
+                m_blendShapeAnimation.resize( m_loadedBlendShapes.size() );
+            }
+            // the weights are played on their own time interval
+            Scalar startTime = std::numeric_limits<Scalar>::max();
+            Scalar endTime   = std::numeric_limits<Scalar>::lowest();
+            for ( const auto& track : m_blendShapeAnimation ) {
+                const auto& keyFrames = track.getKeyFrames();
+                startTime             = std::min( startTime, keyFrames.front().first );
+                endTime               = std::max( endTime, keyFrames.back().first );
+            }
+            if ( startTime <= endTime ) { m_blendShapeTimeInterval = { startTime, endTime }; }
+            break;
+        }
+    }
+}
+
+void SkinningComponent::setBlendShapeWeight( uint i, Scalar weight ) {
+    CORE_ASSERT( i < m_blendShapeWeights.size(), "Invalid blendshape index." );
+    m_blendShapeWeights[i] = weight;
+    clearSkinCache();
+}
+
+std::vector<Scalar> SkinningComponent::sampleBlendShapeWeights() {
+    // animated weights override the static ones
+    std::vector<Scalar> weights = m_blendShapeWeights;
+    if ( !m_blendShapeAnimation.empty() && m_playbackGetter ) {
+        const Scalar t = m_playbackGetter()->wrap( m_blendShapeTimeInterval.first,
+                                                   m_blendShapeTimeInterval.second );
+        sampleKeyFramedValues( m_blendShapeAnimation, t, m_blendShapeCursors, weights );
+    }
+    return weights;
+}
+
+bool SkinningComponent::applyBlendShapes() {
+    std::vector<Scalar> weights = sampleBlendShapeWeights();
+    // the current frame may have been taken from the skin cache, with other weights
+    const bool frameChanged  = weights != m_frameBlendShapeWeights;
+    m_frameBlendShapeWeights = weights;
+    if ( weights == m_appliedBlendShapeWeights ) { return frameChanged; }
+
+    auto& mesh       = editRefData().m_referenceMesh;
+    const auto tH    = mesh.getAttribHandle<Vector3>( tangentName );
+    const auto bH    = mesh.getAttribHandle<Vector3>( bitangentName );
+    auto& positions  = mesh.verticesWithLock();
+    auto& normals    = mesh.normalsWithLock();
+    auto& tangents   = mesh.getAttrib( tH ).getDataWithLock();
+    auto& bitangents = mesh.getAttrib( bH ).getDataWithLock();
+    m_blendShapeDeformer.apply( weights, positions, normals, tangents );
+    const auto& affected = m_blendShapeDeformer.getAffectedVertices();
+#pragma omp parallel for
+    for ( int k = 0; k < int( affected.size() ); ++k ) {
+        const uint v  = affected[k];
+        bitangents[v] = normals[v].cross( tangents[v] );
+    }
+    mesh.getAttrib( bH ).unlock();
+    mesh.getAttrib( tH ).unlock();
+    mesh.normalsUnlock();
+    mesh.verticesUnlock();
+
+    m_appliedBlendShapeWeights = std::move( weights );
+    return true;
+}
+
 void SkinningComponent::createWeightMatrix() {
-    m_refData.m_bindMatrices.resize( m_refData.m_skeleton.size(), Transform::Identity() );
-    m_refData.m_weights.resize( int( m_refData.m_referenceMesh.vertices().size() ),
-                                m_refData.m_skeleton.size() );
+    m_refData->m_bindMatrices.resize( m_refData->m_skeleton.size(), Transform::Identity() );
+    m_refData->m_weights.resize( int( m_refData->m_referenceMesh.vertices().size() ),
+                                 m_refData->m_skeleton.size() );
     std::vector<Eigen::Triplet<Scalar>> triplets;
-    for ( uint col = 0; col < m_refData.m_skeleton.size(); ++col ) {
-        std::string boneName = m_refData.m_skeleton.getLabel( col );
+    for ( uint col = 0; col < m_refData->m_skeleton.size(); ++col ) {
+        std::string boneName = m_refData->m_skeleton.getLabel( col );
         auto it              = m_loadedWeights.find( boneName );
         if ( it != m_loadedWeights.end() ) {
             const auto& W = it->second;
             for ( uint i = 0; i < W.size(); ++i ) {
                 const auto& w = W[i];
                 int row { int( w.first ) };
-                CORE_ASSERT( row < m_refData.m_weights.rows(),
+                CORE_ASSERT( row < m_refData->m_weights.rows(),
                              "Weights are incompatible with mesh." );
                 triplets.push_back( { row, int( col ), w.second } );
             }
-            m_refData.m_bindMatrices[col] = m_loadedBindMatrices[boneName];
+            m_refData->m_bindMatrices[col] = m_loadedBindMatrices[boneName];
         }
     }
-    m_refData.m_weights.setFromTriplets( triplets.begin(), triplets.end() );
+    m_refData->m_weights.setFromTriplets( triplets.begin(), triplets.end() );
 
-    checkWeightMatrix( m_refData.m_weights, false, true );
+    checkWeightMatrix( m_refData->m_weights, false, true );
 
-    if ( normalizeWeights( m_refData.m_weights, true ) ) {
+    if ( normalizeWeights( m_refData->m_weights, true ) ) {
         LOG( logINFO ) << "Skinning weights have been normalized";
     }
+
+    m_refData->m_packedWeights = PackedSkinningWeights( m_refData->m_weights );
 }
 
 void SkinningComponent::setupIO( const std::string& id ) {
@@ -342,18 +810,51 @@ void SkinningComponent::setupIO( const std::string& id ) {
 }
 
 void SkinningComponent::setSkinningType( SkinningType type ) {
+    if ( type == CAGE && m_cage.m_triangle.empty() ) {
+        LOG( logWARNING ) << "No cage set for " << m_meshName << ", cannot use cage deformation.";
+        return;
+    }
     m_skinningType = type;
     if ( m_isReady ) {
         // compute the per-vertex center of rotation only if required.
-        // FIXME: takes time, would be nice to store them in a file and reload.
-        if ( m_skinningType == COR && m_refData.m_CoR.empty() ) { computeCoR( m_refData ); }
+        // They are cached in the cache directory, since their computation takes time.
+        if ( m_skinningType == COR && m_refData->m_CoR.empty() ) {
+            computeCoR( editRefData(), 0.1_ra, 0.1_ra, Resources::getCachePath() );
+            shareRefData();
+        }
+        m_forceUpdate = true;
+    }
+    clearSkinCache();
+}
+
+void SkinningComponent::setCage( const Cage& cage, Scalar threshold ) {
+    m_cage          = cage;
+    m_cageThreshold = threshold;
+    if ( m_isReady ) {
+        editRefData().m_cageWeights = computeCageWeights();
+        shareRefData();
         m_forceUpdate = true;
     }
+    clearSkinCache();
+}
+
+CageWeights SkinningComponent::computeCageWeights() const {
+    // the reference mesh holds the applied blendshapes, which are added after the deformation
+    Vector3Array positions = m_refData->m_referenceMesh.vertices();
+    if ( !m_blendShapeDeformer.empty() ) { m_blendShapeDeformer.resetPositions( positions ); }
+    return computeMeanValueCoordinates( m_cage, positions, m_cageThreshold );
+}
+
+void SkinningComponent::setCagePose( const Pose& pose ) {
+    m_cage.setPose( pose, SpaceType::MODEL );
+    if ( m_isReady ) { m_forceUpdate = true; }
+    clearSkinCache();
 }
 
 void SkinningComponent::setNormalSkinning( NormalSkinning normalSkinning ) {
     m_normalSkinning = normalSkinning;
     if ( m_isReady ) { m_forceUpdate = true; }
+    clearSkinCache();
 }
 
 const std::string& SkinningComponent::getMeshName() const {
@@ -386,7 +887,7 @@ void SkinningComponent::showWeights( bool on ) {
         default: {
 #pragma omp parallel for
             for ( int i = 0; i < int( size ); ++i ) {
-                m_weightsUV[i][0] = m_refData.m_weights.coeff( i, m_weightBone );
+                m_weightsUV[i][0] = m_refData->m_weights.coeff( i, m_weightBone );
             }
         } break;
         } // end of switch.
@@ -1,10 +1,16 @@
 #pragma once
 
+#include <Core/Animation/BlendShapes.hpp>
+#include <Core/Animation/Cage.hpp>
 #include <Core/Animation/HandleWeight.hpp>
+#include <Core/Animation/KeyFramedValue.hpp>
 #include <Core/Animation/Pose.hpp>
 #include <Core/Animation/SkinningData.hpp>
+#include <Core/Asset/AnimationData.hpp>
+#include <Core/Asset/GeometryData.hpp>
 #include <Core/Asset/HandleData.hpp>
-#include <Core/Geometry/TopologicalMesh.hpp>
+#include <Core/Containers/LruCache.hpp>
+#include <Core/Geometry/NormalStencil.hpp>
 #include <Core/Geometry/TriangleMesh.hpp>
 #include <Core/Math/DualQuaternion.hpp>
 #include <Core/Utils/Index.hpp>
@@ -12,6 +18,10 @@
 #include <Engine/Data/Material.hpp>
 #include <Engine/Scene/Component.hpp>
 #include <Engine/Scene/ComponentMessenger.hpp>
+#include <Engine/Scene/SkeletonComponent.hpp>
+
+#include <array>
+#include <memory>
 
 namespace Ra {
 namespace Engine {
@@ -28,6 +38,9 @@ namespace Scene {
  *    - the Ra::Core::Animation::SkinningFrameData containing all the
  *      data needed for the skinning at the current frame.
  *
+ * The components skinning identical meshes with identical weights (e.g. instances of the same
+ * character) share their reference data, so that its memory scales with the number of assets.
+ *
  * \warning The Ra::Core::Animation::SkinningFrameData better be accessed after
  *          the skinning task.
  */
@@ -39,12 +52,13 @@ class RA_ENGINE_API SkinningComponent : public Component
         LBS = 0, ///< Linear Blend Skinning
         DQS,     ///< Dual Quaternion Skinning
         COR,     ///< Center of Rotation skinning
+        CAGE,    ///< Mean value coordinates cage deformation (see setCage())
     };
 
     /// How to skin the normal, tangent and binormal vectors.
     enum NormalSkinning {
         APPROX = 0, ///< Use the standard approximation method.
-        GEOMETRIC   ///< Recompute from scratch from the skinned positions.
+        GEOMETRIC   ///< Recompute from the skinned positions, around the bones which moved.
     };
 
     /// The skinning weight type.
@@ -62,7 +76,7 @@ class RA_ENGINE_API SkinningComponent : public Component
         m_weightType( STANDARD ),
         m_showingWeights( false ) {}
 
-    ~SkinningComponent() override {}
+    ~SkinningComponent() override;
 
     /// \name Component Communication (CC)
     /// \{
@@ -76,6 +90,12 @@ class RA_ENGINE_API SkinningComponent : public Component
     /// Loads the skinning data from the given Handledata.
     /// \note Call initialize() afterwards to finalize data registration.
     void handleSkinDataLoading( const Core::Asset::HandleData* data, const std::string& meshName );
+
+    /// Loads the blendshapes of the skinned mesh from \p geom, and their animated weights from
+    /// the first of \p animData animating them.
+    /// \note Call after handleSkinDataLoading() and before initialize().
+    void handleBlendShapeLoading( const Core::Asset::GeometryData* geom,
+                                  const std::vector<Core::Asset::AnimationData*>& animData );
     /// \}
 
     /// \name Skinning Process
@@ -100,6 +120,58 @@ class RA_ENGINE_API SkinningComponent : public Component
     inline NormalSkinning getNormalSkinning() const { return m_normalSkinning; }
     /// \}
 
+    /// \name Baked skin cache
+    /// The skinned meshes can be baked per frame, quantized on 16 bits, to be used instead of
+    /// skinning the mesh when the time jumps (e.g. when scrubbing the timeline).
+    /// \{
+
+    /// Enables the skin cache, with frames spaced by \p frameStep and the given memory budget
+    /// (in bytes). Frames are baked the first time they are skinned after a time jump, the
+    /// least recently used ones being evicted when the budget is exceeded.
+    /// \note A budget of 0 disables the cache.
+    void setSkinCache( size_t budget, Scalar frameStep );
+
+    /// Returns true if the skin cache is enabled.
+    inline bool hasSkinCache() const { return m_skinCache != nullptr; }
+
+    /// Same as skin(), using the skinned mesh baked for the current frame if any.
+    /// \note The animation time is expected to be snapped to the frames, as done by
+    ///       SkeletonComponent::updateFromCache.
+    void skinFromCache();
+    /// \}
+
+    /// \name Cage Deformation
+    /// \{
+
+    /// Sets the cage used by the CAGE skinning method, in its rest pose and in the mesh's
+    /// local frame. The mean value coordinates of the mesh vertices are computed once, here or
+    /// at initialization if the component is not initialized yet.
+    /// \param threshold coordinates smaller than threshold are ignored.
+    void setCage( const Core::Animation::Cage& cage, Scalar threshold = 1e-3_ra );
+
+    /// Returns the cage in its current pose.
+    const Core::Animation::Cage& getCage() const { return m_cage; }
+
+    /// Sets the current pose of the cage, in the mesh's local frame.
+    void setCagePose( const Core::Animation::Pose& pose );
+    /// \}
+
+    /// \name Blendshapes
+    /// Blendshapes are applied onto the reference mesh before skinning it.
+    /// \{
+
+    /// Returns the blendshapes of the skinned mesh.
+    const std::vector<Core::Animation::BlendShape>& getBlendShapes() const {
+        return m_blendShapeDeformer.getBlendShapes();
+    }
+
+    /// Returns the weights of the blendshapes which are not animated.
+    const std::vector<Scalar>& getBlendShapeWeights() const { return m_blendShapeWeights; }
+
+    /// Sets the weight of the blendshape \p i, used if the blendshape is not animated.
+    void setBlendShapeWeight( uint i, Scalar weight );
+    /// \}
+
     /// \name Skinning Data
     /// \{
 
@@ -114,10 +186,15 @@ class RA_ENGINE_API SkinningComponent : public Component
     const std::string& getSkeletonName() const;
 
     /// Returns the reference skinning data.
-    const Core::Animation::SkinningRefData* getSkinningRefData() const { return &m_refData; }
+    /// \note The reference data may be shared with the components skinning the same asset.
+    const Core::Animation::SkinningRefData* getSkinningRefData() const { return m_refData.get(); }
 
     /// Returns the current Pose data.
     const Core::Animation::SkinningFrameData* getSkinningFrameData() const { return &m_frameData; }
+
+    /// Add the memory of the skinning data (reference mesh, weights, frame data, skin cache),
+    /// accounted as MemoryCategory::Skinning.
+    void addMemoryUsage( Core::Utils::MemoryUsage& usage ) const override;
     /// \}
 
     /// \name Skinning Weights Display
@@ -160,6 +237,74 @@ class RA_ENGINE_API SkinningComponent : public Component
     /// Internal function to create the skinning weights.
     void createWeightMatrix();
 
+    /// Internal function to recompute the normal, tangent and bitangent vectors from the
+    /// skinned positions. Unless \p fullUpdate, only the vectors around the vertices flagged in
+    /// m_movedVertices are recomputed.
+    void computeGeometricNormals( bool fullUpdate );
+
+    /// Internal function to compute the cage weights of the reference mesh, on the positions
+    /// without blendshapes.
+    Core::Animation::CageWeights computeCageWeights() const;
+
+    /// Internal function to get the blendshape weights of the current time.
+    std::vector<Scalar> sampleBlendShapeWeights();
+
+    /// Internal function to apply the blendshapes onto the reference mesh.
+    /// \returns true if the reference mesh has been modified, or if the current frame data was
+    /// skinned with other weights.
+    bool applyBlendShapes();
+
+    /// A skinned mesh, quantized on 16 bits per component.
+    struct BakedSkin {
+        /// The local pose the mesh has been skinned from.
+        Core::Animation::Pose m_pose;
+        /// The blendshape weights the mesh has been skinned with.
+        std::vector<Scalar> m_blendShapeWeights;
+        /// The bounding box of the positions, used to quantize them.
+        Core::Vector3 m_origin;
+        Core::Vector3 m_extent;
+        std::vector<std::array<uint16_t, 3>> m_positions;
+        std::vector<std::array<int16_t, 3>> m_normals;
+        std::vector<std::array<int16_t, 3>> m_tangents;
+        std::vector<std::array<int16_t, 3>> m_bitangents;
+    };
+
+    /// Internal function to quantize the current frame data, skinned from \p pose.
+    BakedSkin bakeSkin( const Core::Animation::Pose& pose ) const;
+
+    /// Internal function to set the current frame data from \p skin.
+    void unbakeSkin( const BakedSkin& skin );
+
+    /// Internal function to clear the skin cache, when the skinning changes.
+    void clearSkinCache();
+
+    /// Internal function to update the accounted memory of the per-component skinning data.
+    /// \note Called by the frame tasks, it does not touch the shared reference data.
+    void updateMemoryUsage();
+
+    /// Internal function to update the accounted memory of the shared reference data.
+    /// \note Only called on the main thread, where the reference data is built or edited.
+    void updateRefDataMemoryUsage();
+
+    /// Reference data, shared by the components skinning the same asset.
+    struct SharedRefData : public Core::Animation::SkinningRefData {
+        /// Memory of the weights, bind matrices and centers of rotation.
+        Core::Utils::TrackedMemory m_memory { Core::Utils::MemoryCategory::Skinning };
+        /// The components using the data, the first one reporting it in its memory usage.
+        std::vector<const SkinningComponent*> m_sharers;
+    };
+
+    /// Internal function to remove the component from the sharers of m_refData.
+    void releaseRefData();
+
+    /// Internal function to replace m_refData by the reference data of another component
+    /// skinning the same asset, if any, or to register it for the next components.
+    /// \note Reference data modified by the blendshapes are not shared.
+    void shareRefData();
+
+    /// Internal function to get m_refData for modification, making a copy of it if it is shared.
+    SharedRefData& editRefData();
+
   private:
     template <typename T>
     using Getter = typename ComponentMessenger::CallbackTypes<T>::Getter;
@@ -173,8 +318,8 @@ class RA_ENGINE_API SkinningComponent : public Component
     /// The Skeleton name for Component communication.
     std::string m_skelName;
 
-    /// The refrence Skinning data.
-    Core::Animation::SkinningRefData m_refData;
+    /// The refrence Skinning data, see shareRefData().
+    std::shared_ptr<SharedRefData> m_refData { std::make_shared<SharedRefData>() };
 
     /// The current Pose data.
     Core::Animation::SkinningFrameData m_frameData;
@@ -212,8 +357,17 @@ class RA_ENGINE_API SkinningComponent : public Component
     /// Getter/Setter to the skinned mesh, in case it is a QuadMesh.
     ReadWrite<Core::Geometry::QuadMesh> m_quadMeshWriter;
 
-    /// The Topological mesh used to geometrically recompute the normals.
-    Core::Geometry::TopologicalMesh m_topoMesh;
+    /// The per-vertex stencils used to geometrically recompute the normals.
+    Core::Geometry::NormalStencil m_normalStencil;
+
+    /// The vertices influenced by the bones which moved since the last skinning.
+    std::vector<bool> m_movedVertices;
+
+    /// The geometrically recomputed normal, tangent and bitangent vectors, which are kept from
+    /// one frame to the other since only the ones around moving bones are recomputed.
+    Core::Vector3Array m_geometricNormals;
+    Core::Vector3Array m_geometricTangents;
+    Core::Vector3Array m_geometricBitangents;
 
     /// The per-bone skinning weights.
     /// \note These are stored this way because we cannot build the weight matrix
@@ -225,6 +379,57 @@ class RA_ENGINE_API SkinningComponent : public Component
     ///       without data from other components (skeleton).
     std::map<std::string, Core::Transform> m_loadedBindMatrices;
 
+    /// The deformation cage, in its current pose.
+    Core::Animation::Cage m_cage;
+
+    /// The cage coordinates threshold.
+    Scalar m_cageThreshold { 1e-3_ra };
+
+    /// The loaded blendshapes.
+    /// \note These are stored this way because the deformer needs the reference mesh.
+    std::vector<Core::Animation::BlendShape> m_loadedBlendShapes;
+
+    /// The number of vertices of the mesh the blendshapes are defined on.
+    size_t m_blendShapeVertexCount { 0 };
+
+    /// Applies the blendshapes onto the reference mesh.
+    Core::Animation::BlendShapeDeformer m_blendShapeDeformer;
+
+    /// The animated blendshape weights.
+    std::vector<Core::Animation::KeyFramedValue<Scalar>> m_blendShapeAnimation;
+
+    /// The time interval of the animated blendshape weights.
+    std::pair<Scalar, Scalar> m_blendShapeTimeInterval { 0_ra, 0_ra };
+
+    /// The keyframe cursors of the animated blendshape weights.
+    std::vector<size_t> m_blendShapeCursors;
+
+    /// The weights of the blendshapes which are not animated.
+    std::vector<Scalar> m_blendShapeWeights;
+
+    /// The weights applied onto the reference mesh, the reference mesh being the base mesh when
+    /// they are all 0.
+    std::vector<Scalar> m_appliedBlendShapeWeights;
+
+    /// The weights of the current frame data, which may differ from the applied ones when the
+    /// frame comes from the skin cache.
+    std::vector<Scalar> m_frameBlendShapeWeights;
+
+    /// Getter for the animation time.
+    Getter<Scalar> m_timeGetter;
+
+    /// Getter for the animation playback, to sample the blendshape weights.
+    Getter<SkeletonComponent::Playback> m_playbackGetter;
+
+    /// Baked skinned meshes, per frame index.
+    std::unique_ptr<Core::LruCache<int, BakedSkin>> m_skinCache;
+
+    /// Memory of the per component skinning data.
+    Core::Utils::TrackedMemory m_skinningMemory { Core::Utils::MemoryCategory::Skinning };
+
+    /// Time between two baked frames.
+    Scalar m_bakeStep { 1_ra / 60_ra };
+
     /// Initial RO Material when not showing skinning weights.
     std::shared_ptr<Data::Material> m_baseMaterial;
 
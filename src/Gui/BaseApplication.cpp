@@ -183,6 +183,9 @@ BaseApplication::BaseApplication( int& argc,
 
     QDir().mkdir( m_exportFoldername.c_str() );
 
+    // Logs are written by a background thread, so that logging does not cost frame time.
+    Ra::Core::Utils::AsyncLog::Start();
+
     // Boilerplate print.
     LOG( logINFO ) << "*** Radium Engine Base Application  ***";
     std::stringstream config;
@@ -583,6 +586,7 @@ BaseApplication::~BaseApplication() {
 
     // This will remove the directory if empty.
     QDir().rmdir( m_exportFoldername.c_str() );
+    Ra::Core::Utils::AsyncLog::Stop();
 }
 
 bool BaseApplication::loadPlugins( const std::string& pluginsPath,
@@ -52,6 +52,7 @@ void SkeletonBasedAnimationUI::selectionChanged( const Engine::Scene::ItemEntry&
     ui->actionLBS->setEnabled( false );
     ui->actionDQS->setEnabled( false );
     ui->actionCoR->setEnabled( false );
+    ui->actionCage->setEnabled( false );
     ui->tabWidget->setEnabled( false );
     ui->m_skinning->setEnabled( false );
     if ( m_selection.m_entity == nullptr ) { return; }
@@ -85,6 +86,8 @@ void SkeletonBasedAnimationUI::selectionChanged( const Engine::Scene::ItemEntry&
             ui->actionLBS->setEnabled( true );
             ui->actionDQS->setEnabled( true );
             ui->actionCoR->setEnabled( true );
+            // cage deformation is only available once a cage is set
+            ui->actionCage->setEnabled( !skinComp->getCage().m_triangle.empty() );
             ui->m_skinningMethod->setEnabled( true );
             ui->m_skinningMethod->setCurrentIndex( int( skinComp->getSkinningType() ) );
             on_m_skinningMethod_currentIndexChanged( int( skinComp->getSkinningType() ) );
@@ -125,6 +128,8 @@ QAction* SkeletonBasedAnimationUI::getAction( int i ) {
         return ui->actionDQS;
     case 3:
         return ui->actionCoR;
+    case 4:
+        return ui->actionCage;
     default:
         return nullptr;
     }
@@ -145,7 +150,8 @@ void SkeletonBasedAnimationUI::postLoadFile( Engine::Scene::Entity* entity ) {
         } );
     if ( c != entity->getComponents().end() ) {
         auto skel           = static_cast<Ra::Engine::Scene::SkeletonComponent*>( ( *c ).get() );
-        auto& anim          = skel->getAnimation( skel->getAnimationId() );
+        const size_t animId = skel->getAnimationId();
+        auto& anim          = skel->getAnimation( animId );
         const auto& boneMap = skel->getBoneRO2idx();
         for ( size_t j = 0; j < anim.size(); ++j ) {
             auto it = std::find_if(
@@ -157,10 +163,13 @@ void SkeletonBasedAnimationUI::postLoadFile( Engine::Scene::Entity* entity ) {
                 KeyFramedValueController(
                     &anim[j],
                     "Animation_" + skel->getSkeleton()->getLabel( uint( j ) ),
-                    [&anim, j, skel]( const Scalar& t ) {
+                    [&anim, j, skel, animId]( const Scalar& t ) {
                         anim[j].insertKeyFrame(
                             t, skel->getSkeleton()->getPose( HandleArray::SpaceType::LOCAL )[j] );
-                    } ) ); // no update callback here
+                        skel->notifyAnimationChanged( animId );
+                    },
+                    []( const Scalar& ) {}, // no update callback here
+                    [skel, animId]() { skel->notifyAnimationChanged( animId ); } ) );
         }
     }
     // update the timeline display interval to the bounding interval of all anims
@@ -207,6 +216,8 @@ void SkeletonBasedAnimationUI::on_m_currentAnimation_currentIndexChanged( int in
     auto& anim          = m_currentSkeleton->getAnimation( uint( index ) );
     const auto& boneMap = m_currentSkeleton->getBoneRO2idx();
     auto skel           = m_currentSkeleton->getSkeleton();
+    auto skelComp       = m_currentSkeleton;
+    const size_t animId = size_t( index );
     for ( size_t j = 0; j < anim.size(); ++j ) {
         auto it = std::find_if(
             boneMap->begin(), boneMap->end(), [j]( const auto& b ) { return b.second == j; } );
@@ -218,9 +229,12 @@ void SkeletonBasedAnimationUI::on_m_currentAnimation_currentIndexChanged( int in
             KeyFramedValueController(
                 &anim[j],
                 "Animation_" + skel->getLabel( uint( j ) ),
-                [&anim, j, skel]( const Scalar& t ) {
+                [&anim, j, skel, skelComp, animId]( const Scalar& t ) {
                     anim[j].insertKeyFrame( t, skel->getPose( HandleArray::SpaceType::LOCAL )[j] );
-                } ) ); // no update callback here
+                    skelComp->notifyAnimationChanged( animId );
+                },
+                []( const Scalar& ) {}, // no update callback here
+                [skelComp, animId]() { skelComp->notifyAnimationChanged( animId ); } ) );
     }
     // ask the animation system to update w.r.t. the animation
     m_system->enforceUpdate();
@@ -272,6 +286,7 @@ void SkeletonBasedAnimationUI::on_m_loadAnim_clicked() {
             bAnim.insertKeyFrame( t, T );
         }
     }
+    m_currentSkeleton->notifyAnimationChanged( m_currentSkeleton->getAnimationCount() - 1 );
 
     // update the ui and set the loaded animation as the one used
     const int num = ui->m_currentAnimation->count();
@@ -327,6 +342,12 @@ void SkeletonBasedAnimationUI::on_m_skinningMethod_currentIndexChanged( int newT
     for ( auto skin : m_currentSkinnings ) {
         skin->setSkinningType( type );
     }
+    // the skinning type is kept when the method is unavailable (e.g. no cage for CAGE)
+    if ( !m_currentSkinnings.empty() && m_currentSkinnings.front()->getSkinningType() != type ) {
+        const auto current = m_currentSkinnings.front()->getSkinningType();
+        ui->m_skinningMethod->setCurrentIndex( int( current ) );
+        return;
+    }
     switch ( type ) {
     case SkinningType::LBS: {
         on_actionLBS_triggered();
@@ -340,6 +361,10 @@ void SkeletonBasedAnimationUI::on_m_skinningMethod_currentIndexChanged( int newT
         on_actionCoR_triggered();
         break;
     }
+    case SkinningType::CAGE: {
+        on_actionCage_triggered();
+        break;
+    }
     default: {
         break;
     }
@@ -373,6 +398,7 @@ void SkeletonBasedAnimationUI::on_actionLBS_triggered() {
     ui->actionLBS->setChecked( true );
     ui->actionDQS->setChecked( false );
     ui->actionCoR->setChecked( false );
+    ui->actionCage->setChecked( false );
     askForUpdate();
 }
 
@@ -382,6 +408,7 @@ void SkeletonBasedAnimationUI::on_actionDQS_triggered() {
     ui->actionLBS->setChecked( false );
     ui->actionDQS->setChecked( true );
     ui->actionCoR->setChecked( false );
+    ui->actionCage->setChecked( false );
     askForUpdate();
 }
 
@@ -391,6 +418,17 @@ void SkeletonBasedAnimationUI::on_actionCoR_triggered() {
     ui->actionLBS->setChecked( false );
     ui->actionDQS->setChecked( false );
     ui->actionCoR->setChecked( true );
+    ui->actionCage->setChecked( false );
+    askForUpdate();
+}
+
+void SkeletonBasedAnimationUI::on_actionCage_triggered() {
+    using SkinningType = Ra::Engine::Scene::SkinningComponent::SkinningType;
+    ui->m_skinningMethod->setCurrentIndex( int( SkinningType::CAGE ) );
+    ui->actionLBS->setChecked( false );
+    ui->actionDQS->setChecked( false );
+    ui->actionCoR->setChecked( false );
+    ui->actionCage->setChecked( true );
     askForUpdate();
 }
 
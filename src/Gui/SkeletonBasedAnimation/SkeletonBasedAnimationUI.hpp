@@ -129,6 +129,9 @@ class RA_GUI_API SkeletonBasedAnimationUI : public QFrame
     /// Slot for the user requesting to use CoR skinning.
     void on_actionCoR_triggered();
 
+    /// Slot for the user requesting to use cage deformation.
+    void on_actionCage_triggered();
+
   private:
     /// The actual ui.
     Ui::SkeletonBasedAnimationUI* ui;
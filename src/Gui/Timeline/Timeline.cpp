@@ -346,6 +346,7 @@ void Timeline::onRemovingKeyFrame( size_t i ) {
     if ( m_current.m_value ) {
         const Scalar time = m_current.m_value->getTimes()[i];
         if ( m_current.m_value->removeKeyFrame( i ) ) {
+            m_current.notifyChange();
             m_current.updateKeyFrame( time );
             emit keyFrameDeleted( i );
         }
@@ -368,6 +369,7 @@ void Timeline::onMovingKeyFrame( size_t i, Scalar time1 ) {
     if ( m_current.m_value ) {
         if ( !Ra::Core::Math::areApproxEqual( m_current.m_value->getTimes()[i], time1 ) ) {
             m_current.m_value->moveKeyFrame( i, time1 );
+            m_current.notifyChange();
             m_current.updateKeyFrame( time1 );
             emit keyFrameMoved( i, time1 );
         }
@@ -391,6 +393,7 @@ void Timeline::onMovingKeyFrames( size_t first, Scalar offset ) {
                 if ( t >= time ) { m_current.m_value->moveKeyFrame( i, t + offset ); }
             }
         }
+        m_current.notifyChange();
         m_current.updateKeyFrame( time );
         emit keyFramesMoved( first, offset );
     }
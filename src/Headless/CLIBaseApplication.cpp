@@ -2,9 +2,19 @@
 #include <Headless/CLI/Error.hpp>
 #include <Headless/CLIBaseApplication.hpp>
 
+#include <Core/Utils/Profiler.hpp>
+
 namespace Ra {
 
 namespace Headless {
+CLIBaseApplication::CLIBaseApplication() {
+    addFlag( "--profile", m_profile, "Enable the profiler and print its statistics at exit." );
+}
+
+CLIBaseApplication::~CLIBaseApplication() {
+    if ( m_profile ) { printProfile(); }
+}
+
 int CLIBaseApplication::init( int argc, const char** argv ) {
     try {
         m_cmdLineParser.parse( argc, argv );
@@ -12,8 +22,13 @@ int CLIBaseApplication::init( int argc, const char** argv ) {
     catch ( const CLI::ParseError& e ) {
         return m_cmdLineParser.exit( e ) + 1;
     }
+    if ( m_profile ) { Core::Utils::Profiler::setEnabled( true ); }
     return 0;
 }
 
+void CLIBaseApplication::printProfile( std::ostream& out ) const {
+    Core::Utils::Profiler::printStats( out );
+}
+
 } // namespace Headless
 } // namespace Ra
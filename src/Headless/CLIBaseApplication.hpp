@@ -2,6 +2,8 @@
 #include <Headless/CLI/CLI.hpp>
 #include <Headless/RaHeadless.hpp>
 
+#include <iostream>
+
 namespace Ra {
 namespace Headless {
 /**
@@ -13,6 +15,9 @@ namespace Headless {
  * Once the parser is populated, derived application should call the inherited init() method
  * which only parse the command line and return the result of this parsing.
  *
+ * The "--profile" flag enables the Core::Utils::Profiler, whose statistics are printed when the
+ * application is destroyed (the zones are only compiled with the RADIUM_ENABLE_PROFILER option).
+ *
  * \see https://cliutils.github.io/CLI11/book/ for a description of the wrapped commandline parser.
  */
 class HEADLESS_API CLIBaseApplication
@@ -24,11 +29,14 @@ class HEADLESS_API CLIBaseApplication
      */
     CLI::App m_cmdLineParser;
 
+    /// Enable the profiler (--profile flag).
+    bool m_profile { false };
+
   public:
     /// Base constructor.
-    CLIBaseApplication() = default;
-    /// Base destructor
-    virtual ~CLIBaseApplication() = default;
+    CLIBaseApplication();
+    /// Base destructor, printing the profiler statistics if enabled.
+    virtual ~CLIBaseApplication();
 
     /// adapter allowing to add a command line option on an application the same way than using
     /// CLI11 directly.
@@ -56,6 +64,9 @@ class HEADLESS_API CLIBaseApplication
      * https://cliutils.github.io/CLI11/class_c_l_i_1_1_app.html#aac000657ef11647125ba91af38fd7d9c).
      */
     virtual int init( int argc, const char* argv[] );
+
+    /// Print the profiler statistics over the last frames.
+    void printProfile( std::ostream& out = std::cout ) const;
 };
 
 template <typename... Args>
@@ -4,6 +4,7 @@
 #include <Core/Asset/FileLoaderInterface.hpp>
 #include <Core/Tasks/TaskQueue.hpp>
 #include <Core/Utils/Log.hpp>
+#include <Core/Utils/Profiler.hpp>
 
 #include <Engine/Data/ViewingParameters.hpp>
 #include <Engine/RadiumEngine.hpp>
@@ -144,6 +145,8 @@ int CLIViewer::oneFrame( float timeStep ) {
     Ra::Engine::Data::ViewingParameters data {
         m_camera->getViewMatrix(), m_camera->getProjMatrix(), timeStep };
     if ( m_renderer ) m_renderer->render( data );
+    // headless frames are not ended by the engine
+    Core::Utils::Profiler::nextFrame();
     return 0;
 }
 
@@ -116,6 +116,16 @@ void AssimpAnimationDataLoader::fetchAnimation( const aiAnimation* anim,
         time.extends( keyFrame[i].m_animationTime );
     }
     data->setHandleData( keyFrame );
+    // skeleton animations are played from the compressed clip, only converted to keyframes for
+    // edition (see Engine::Scene::SkeletonComponent)
+    if ( !keyFrame.empty() ) { data->setHandleData( data->compress() ); }
+
+    std::vector<MorphAnimation> morph( anim->mNumMorphMeshChannels );
+    for ( uint i = 0; i < anim->mNumMorphMeshChannels; ++i ) {
+        fetchMorphAnimation( anim->mMorphMeshChannels[i], morph[i], data->getTimeStep() );
+        time.extends( morph[i].m_animationTime );
+    }
+    data->setMorphData( std::move( morph ) );
     data->setTime( time );
 }
 
@@ -179,5 +189,51 @@ void AssimpAnimationDataLoader::fetchHandleAnimation( aiNodeAnim* node,
     data.m_anim.removeKeyFrame( 0 );
 }
 
+void AssimpAnimationDataLoader::fetchMorphAnimation( aiMeshMorphAnim* morph,
+                                                     MorphAnimation& data,
+                                                     const AnimationTime::Time dt ) const {
+    data.m_meshName = assimpToCore( morph->mName );
+
+    // check if there are keyframes
+    if ( morph->mNumKeys == 0 ) { return; }
+
+    // keys only list the weights of some blendshapes, the missing ones being 0
+    uint shapeCount = 0;
+    for ( uint i = 0; i < morph->mNumKeys; ++i ) {
+        const aiMeshMorphKey& key = morph->mKeys[i];
+        for ( uint j = 0; j < key.mNumValuesAndWeights; ++j ) {
+            shapeCount = std::max( shapeCount, key.mValues[j] + 1 );
+        }
+    }
+
+    // According to Assimp's doc, time can be negative so deal with it
+    const AnimationTime::Time firstTime( morph->mKeys[0].mTime );
+    const AnimationTime::Time timeOffset = firstTime < 0_ra ? -firstTime : 0_ra;
+    std::vector<Scalar> weights( shapeCount );
+    for ( uint i = 0; i < morph->mNumKeys; ++i ) {
+        const aiMeshMorphKey& key = morph->mKeys[i];
+        std::fill( weights.begin(), weights.end(), 0_ra );
+        for ( uint j = 0; j < key.mNumValuesAndWeights; ++j ) {
+            weights[key.mValues[j]] = Scalar( key.mWeights[j] );
+        }
+        const AnimationTime::Time t = Scalar( key.mTime ) + timeOffset;
+        const AnimationTime::Time keyTime =
+            Ra::Core::Math::areApproxEqual( dt, 0_ra ) ? t : ( dt * t );
+        if ( i == 0 ) {
+            data.m_animationTime = AnimationTime( t, t );
+            data.m_weights.reserve( shapeCount );
+            for ( uint k = 0; k < shapeCount; ++k ) {
+                data.m_weights.emplace_back( keyTime, weights[k] );
+            }
+        }
+        else {
+            data.m_animationTime.extends( AnimationTime( t, t ) );
+            for ( uint k = 0; k < shapeCount; ++k ) {
+                data.m_weights[k].insertKeyFrame( keyTime, weights[k] );
+            }
+        }
+    }
+}
+
 } // namespace IO
 } // namespace Ra
@@ -10,12 +10,14 @@
 struct aiScene;
 struct aiAnimation;
 struct aiNodeAnim;
+struct aiMeshMorphAnim;
 
 namespace Ra {
 namespace Core {
 namespace Asset {
 class AnimationData;
 struct HandleAnimation;
+struct MorphAnimation;
 } // namespace Asset
 } // namespace Core
 
@@ -75,6 +77,14 @@ class RA_IO_API AssimpAnimationDataLoader
     void fetchHandleAnimation( aiNodeAnim* node,
                                Core::Asset::HandleAnimation& data,
                                const Core::Asset::AnimationTime::Time dt ) const;
+
+    /**
+     * Fills \p data with the MorphAnimation from \p morph, according to the
+     * animation timestep \p dt.
+     */
+    void fetchMorphAnimation( aiMeshMorphAnim* morph,
+                              Core::Asset::MorphAnimation& data,
+                              const Core::Asset::AnimationTime::Time dt ) const;
 };
 
 } // namespace IO
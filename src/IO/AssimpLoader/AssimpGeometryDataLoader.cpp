@@ -137,6 +137,52 @@ void AssimpGeometryDataLoader::loadMeshAttrib( const aiMesh& mesh,
     }
     // TODO : Polyhedrons are not supported yet in Radium core geometry
     if ( data.isTetraMesh() || data.isHexMesh() ) { fetchPolyhedron( mesh, data ); }
+
+    if ( mesh.mNumAnimMeshes > 0 ) { fetchBlendShapes( mesh, data ); }
+}
+
+void AssimpGeometryDataLoader::fetchBlendShapes( const aiMesh& mesh, GeometryData& data ) const {
+    const auto toCore = [&mesh]( const aiVector3D* v ) {
+        Core::Vector3Array res;
+        if ( v == nullptr ) return res;
+        res.resize( mesh.mNumVertices );
+#pragma omp parallel for
+        for ( int i = 0; i < int( mesh.mNumVertices ); ++i ) {
+            res[i] = assimpToCore( v[i] );
+        }
+        return res;
+    };
+    const auto positions = toCore( mesh.mVertices );
+    const auto normals   = toCore( mesh.mNormals );
+    const auto tangents  = toCore( mesh.mTangents );
+
+    std::vector<Core::Animation::BlendShape> shapes;
+    shapes.reserve( mesh.mNumAnimMeshes );
+    for ( uint k = 0; k < mesh.mNumAnimMeshes; ++k ) {
+        const aiAnimMesh* anim = mesh.mAnimMeshes[k];
+        std::string name       = assimpToCore( anim->mName );
+        if ( name.empty() ) { name = data.getName() + "_blendshape_" + std::to_string( k ); }
+        // keep invalid blendshapes as empty ones so that morph animations indices stay valid.
+        if ( anim->mNumVertices != mesh.mNumVertices || !anim->HasPositions() ) {
+            LOG( logWARNING ) << "Blendshape " << name << " of mesh " << data.getName()
+                              << " does not match the mesh vertices, ignored.";
+            Core::Animation::BlendShape shape;
+            shape.m_name = name;
+            shapes.push_back( std::move( shape ) );
+            continue;
+        }
+        auto shape = Core::Animation::makeBlendShape(
+            name,
+            positions,
+            toCore( anim->mVertices ),
+            normals,
+            anim->HasNormals() ? toCore( anim->mNormals ) : Core::Vector3Array {},
+            tangents,
+            anim->HasTangentsAndBitangents() ? toCore( anim->mTangents ) : Core::Vector3Array {} );
+        shape.m_defaultWeight = Scalar( anim->mWeight );
+        shapes.push_back( std::move( shape ) );
+    }
+    data.setBlendShapes( std::move( shapes ) );
 }
 
 void AssimpGeometryDataLoader::loadMeshFrame(
@@ -77,6 +77,10 @@ class RA_IO_API AssimpGeometryDataLoader : public Core::Asset::DataLoader<Core::
     /// Fill \p data with the polyhedra from \p mesh.
     void fetchPolyhedron( const aiMesh& mesh, Core::Asset::GeometryData& data ) const;
 
+    /// Fill \p data with the blendshapes (assimp animation meshes) from \p mesh.
+    /// \note Blendshape i corresponds to mesh.mAnimMeshes[i], even if the latter is invalid.
+    void fetchBlendShapes( const aiMesh& mesh, Core::Asset::GeometryData& data ) const;
+
     /// Fill the Radium geometry attribute \p a of \p data from assimp data \p aiData
     template <typename T>
     void fetchAttribute( T* aiData,
@@ -9,6 +9,7 @@
 #include <Core/Animation/Pose.hpp>
 #include <Core/Containers/AdjacencyList.hpp>
 #include <Core/Containers/AlignedStdVector.hpp>
+#include <Core/Containers/FrameArena.hpp>
 #include <Core/Containers/VectorArray.hpp>
 #include <Core/CoreMacros.hpp>
 #include <Core/Math/Math.hpp>
@@ -19,15 +20,29 @@
 #include <Core/Animation/DualQuaternionSkinning.hpp>
 //! [include DualQuaternionSkinning ]
 
+#include <Core/Animation/AnimationBlendTree.hpp>
+#include <Core/Animation/BlendShapes.hpp>
+#include <Core/Animation/CageDeformation.hpp>
+#include <Core/Animation/CompressedAnimation.hpp>
+#include <Core/Animation/CrowdSkinning.hpp>
+#include <Core/Animation/LinearBlendSkinning.hpp>
+#include <Core/Animation/PackedSkinningWeights.hpp>
 #include <Core/Animation/PoseOperation.hpp>
+#include <Core/Animation/RotationCenterSkinning.hpp>
 #include <Core/Animation/Skeleton.hpp>
+#include <Core/Animation/SkinningData.hpp>
+#include <Core/Asset/AnimationData.hpp>
+#include <Core/Geometry/MeshPrimitives.hpp>
 #include <Eigen/Core>
 #include <Eigen/Geometry>
 #include <Eigen/SparseCore>
 #include <algorithm>
 #include <catch2/catch_test_macros.hpp>
 #include <cmath>
+#include <filesystem>
+#include <fstream>
 #include <iostream>
+#include <sstream>
 #include <vector>
 
 using namespace Ra::Core;
@@ -308,6 +323,42 @@ TEST_CASE( "Core/Animation/KeyFramedValue", "[unittests][Core][Core/Animation][K
         // The seventh one should be (5,2)
         checkValues( kf[6], 5_ra, 2_ra );
     }
+
+    SECTION( "Test playback cursor" ) {
+        for ( int i = 0; i < 10; ++i )
+            kf.insertKeyFrame( Scalar( i ) * 0.5_ra, Scalar( i * i ) );
+
+        auto checkCursor = [&kf]( Scalar t, size_t& cursor ) {
+            const auto ref = kf.findRange( t );
+            REQUIRE( kf.findRange( t, cursor ) == ref );
+            REQUIRE( Math::areApproxEqual( kf.at( t, cursor, LinearInterpolator {} ),
+                                           kf.at( t, linearInterpolate<Scalar> ) ) );
+        };
+        // forward playback, including times before the first and after the last keyframes.
+        size_t cursor = 0;
+        for ( Scalar t = -1_ra; t < 6_ra; t += 0.1_ra )
+            checkCursor( t, cursor );
+        REQUIRE( cursor == kf.size() - 1 );
+        // backward playback and random accesses, with an out of range cursor.
+        cursor = 1000;
+        for ( Scalar t = 6_ra; t > -1_ra; t -= 0.3_ra )
+            checkCursor( t, cursor );
+        for ( Scalar t : { 3_ra, 0.25_ra, 4.5_ra, 4.5_ra, 1_ra, 2.1_ra, 2.2_ra } )
+            checkCursor( t, cursor );
+
+        // batched sampling of several channels
+        std::vector<KeyFramedValue<Scalar>> channels { kf, KeyFramedValue<Scalar> { 0_ra, 1_ra } };
+        channels[1].insertKeyFrame( 1_ra, 3_ra );
+        std::vector<size_t> cursors;
+        std::vector<Scalar> values( 2 );
+        for ( Scalar t : { 0.3_ra, 0.6_ra, 0.9_ra, 2_ra } ) {
+            sampleKeyFramedValues( channels, t, cursors, values );
+            REQUIRE( cursors.size() == 2 );
+            REQUIRE( Math::areApproxEqual( values[0], kf.at( t, linearInterpolate<Scalar> ) ) );
+            REQUIRE( Math::areApproxEqual( values[1],
+                                           channels[1].at( t, linearInterpolate<Scalar> ) ) );
+        }
+    }
 }
 
 TEST_CASE( "Core/Animation/KeyFramedStruct", "[unittests]" ) {
@@ -976,6 +1027,75 @@ TEST_CASE( "Core/Animation/Skeleton", "[unittests][Core][Core/Animation][Skeleto
             REQUIRE( areEqual( skel.getPose( Space::MODEL ), { T, T1, T2, T3 } ) );
         }
     }
+
+    SECTION( "Test pose version" ) {
+        uint64_t version = skel.getPoseVersion();
+        Skeleton copy    = skel;
+        REQUIRE( copy.getPoseVersion() == version );
+        REQUIRE( Skeleton().getPoseVersion() != version );
+
+        skel.setPose( skel.getPose( Space::LOCAL ), Space::LOCAL );
+        REQUIRE( skel.getPoseVersion() != version );
+        version = skel.getPoseVersion();
+        skel.setTransform( bone2, localT, Space::MODEL );
+        REQUIRE( skel.getPoseVersion() != version );
+        version = skel.getPoseVersion();
+        skel.addBone( bone3 );
+        REQUIRE( skel.getPoseVersion() != version );
+        // reading the pose does not change the version
+        version = skel.getPoseVersion();
+        skel.getPose( Space::MODEL );
+        skel.getTransform( bone1, Space::LOCAL );
+        REQUIRE( skel.getPoseVersion() == version );
+        REQUIRE( copy.getPoseVersion() != version );
+    }
+
+    SECTION( "Test branching hierarchy" ) {
+        // bones are not created in depth-first order
+        int bone4 = skel.addBone( bone1, localT, Space::LOCAL, "bone4" );
+        int bone5 = skel.addRoot( localT, "root2" );
+        int bone6 = skel.addBone( bone4, localT, Space::LOCAL, "bone6" );
+        int bone7 = skel.addBone( bone5, localT, Space::LOCAL, "bone7" );
+        REQUIRE( skel.size() == 8 );
+
+        // model pose computed by walking up the hierarchy
+        auto modelPose = [&skel]() {
+            Pose pose( skel.size() );
+            for ( uint i = 0; i < skel.size(); ++i ) {
+                pose[i] = skel.getTransform( i, Space::LOCAL );
+                for ( int p = skel.m_graph.parents()[i]; p != -1; p = skel.m_graph.parents()[p] )
+                    pose[i] = skel.getTransform( p, Space::LOCAL ) * pose[i];
+            }
+            return pose;
+        };
+        REQUIRE( areEqual( skel.getPose( Space::MODEL ), modelPose() ) );
+
+        // editing a bone updates its subtree only
+        const Pose before = skel.getPose( Space::MODEL );
+        Transform R       = Transform::Identity();
+        R.rotate( AngleAxis( Math::Pi / 3, Vector3::UnitZ() ) );
+        skel.setTransform( bone4, R, Space::LOCAL );
+        const Pose& after = skel.getPose( Space::MODEL );
+        REQUIRE( areEqual( after, modelPose() ) );
+        for ( int b : { root, bone1, bone2, bone3, bone5, bone7 } )
+            REQUIRE( after[b].isApprox( before[b] ) );
+        REQUIRE( !after[bone6].isApprox( before[bone6] ) );
+
+        // full local and model poses
+        Pose local = skel.getPose( Space::LOCAL );
+        for ( auto& t : local )
+            t.rotate( AngleAxis( 0.1_ra, Vector3::UnitY() ) );
+        skel.setPose( local, Space::LOCAL );
+        REQUIRE( areEqual( skel.getPose( Space::MODEL ), modelPose() ) );
+        const Pose model = skel.getPose( Space::MODEL );
+        skel.setPose( model, Space::MODEL );
+        REQUIRE( areEqual( skel.getPose( Space::LOCAL ), local ) );
+
+        // editing in model space keeps the model transforms of the descendants
+        skel.setTransform( bone1, R, Space::MODEL );
+        REQUIRE( skel.getTransform( bone6, Space::MODEL ).isApprox( model[bone6] ) );
+        REQUIRE( areEqual( skel.getPose( Space::MODEL ), modelPose() ) );
+    }
 }
 
 TEST_CASE( "Core/Animation/DualQuaternionSkinning",
@@ -1030,3 +1150,745 @@ TEST_CASE( "Core/Animation/DualQuaternionSkinning",
     auto dq_n = Ra::Core::Animation::computeDQ( pose, weights );
     REQUIRE( q3.toRotationMatrix().isApprox( dq_n[2].getTransform().linear() ) );
 }
+
+TEST_CASE( "Core/Animation/PackedSkinning", "[unittests][Core][Core/Animation][PackedSkinning]" ) {
+    using Space = HandleArray::SpaceType;
+    // chain of 6 bones along X
+    Skeleton skel;
+    int bone             = skel.addRoot( Transform::Identity(), "root" );
+    Transform localT     = Transform::Identity();
+    localT.translation() = Vector3::UnitX();
+    for ( int b = 1; b < 6; ++b )
+        bone = skel.addBone( bone, localT, Space::LOCAL, "bone" + std::to_string( b ) );
+
+    // a strip of vertices along the bones, with up to 3 influences per vertex
+    const int nVertices = 50;
+    Vector3Array vertices;
+    Vector3Array normals;
+    Vector3Array tangents;
+    Vector3Array bitangents;
+    WeightMatrix weights( nVertices, int( skel.size() ) );
+    for ( int i = 0; i < nVertices; ++i ) {
+        const Scalar x = 5_ra * Scalar( i ) / Scalar( nVertices - 1 );
+        vertices.push_back( { x, Scalar( i % 2 ), 0_ra } );
+        normals.push_back( Vector3::UnitZ() );
+        tangents.push_back( Vector3::UnitX() );
+        bitangents.push_back( Vector3::UnitY() );
+        const int b                = std::min( int( x ), 4 );
+        const Scalar t             = x - Scalar( b );
+        weights.insert( i, b )     = 1_ra - t;
+        weights.insert( i, b + 1 ) = b > 0 ? t * 0.75_ra : t;
+        if ( b > 0 ) weights.insert( i, b - 1 ) = t * 0.25_ra;
+    }
+    weights.makeCompressed();
+
+    SECTION( "Packing" ) {
+        PackedSkinningWeights packed( weights );
+        REQUIRE( packed.getVertexCount() == size_t( nVertices ) );
+        REQUIRE( packed.getBoneCount() == skel.size() );
+        REQUIRE( packed.getInfluenceCount() == 4 );
+        for ( int i = 0; i < nVertices; ++i ) {
+            Scalar sum = 0_ra;
+            for ( int k = 0; k < packed.getInfluenceCount(); ++k ) {
+                const Scalar w = packed.getWeight( size_t( i ), k );
+                sum += w;
+                if ( w > 0_ra ) {
+                    REQUIRE( std::abs( w - weights.coeff( i, int( packed.getBone( i, k ) ) ) ) <
+                             1e-4_ra );
+                }
+                // sorted by decreasing weight
+                if ( k > 0 ) REQUIRE( w <= packed.getWeight( size_t( i ), k - 1 ) );
+            }
+            REQUIRE( Math::areApproxEqual( sum, 1_ra ) );
+        }
+
+        // only the largest influences are kept, and renormalized
+        WeightMatrix many( 1, 10 );
+        for ( int j = 0; j < 10; ++j )
+            many.insert( 0, j ) = Scalar( j + 1 );
+        PackedSkinningWeights truncated( many, 4 );
+        REQUIRE( truncated.getInfluenceCount() == 4 );
+        REQUIRE( truncated.getBone( 0, 0 ) == 9 );
+        REQUIRE( truncated.getBone( 0, 3 ) == 6 );
+        REQUIRE( std::abs( truncated.getWeight( 0, 0 ) - 10_ra / 34_ra ) < 1e-4_ra );
+        PackedSkinningWeights eight( many, 8 );
+        REQUIRE( eight.getInfluenceCount() == 8 );
+        REQUIRE( eight.getBone( 0, 7 ) == 2 );
+    }
+
+    SECTION( "Skinning" ) {
+        SkinningRefData refData;
+        refData.m_referenceMesh.setVertices( vertices );
+        refData.m_referenceMesh.setNormals( normals );
+        refData.m_meshTransformInverse = Transform::Identity();
+        refData.m_skeleton             = skel;
+        refData.m_bindMatrices.resize( skel.size() );
+        for ( uint b = 0; b < skel.size(); ++b )
+            refData.m_bindMatrices[b] = skel.getTransform( b, Space::MODEL ).inverse();
+        refData.m_weights = weights;
+
+        // bend the chain
+        SkinningFrameData frameData;
+        frameData.m_skeleton = skel;
+        for ( uint b = 1; b < skel.size(); ++b ) {
+            Transform T = skel.getTransform( b, Space::LOCAL );
+            T.rotate( AngleAxis( 0.3_ra, Vector3::UnitZ() ) );
+            frameData.m_skeleton.setTransform( b, T, Space::LOCAL );
+        }
+        auto resize = [nVertices]( SkinningFrameData& f ) {
+            f.m_currentPosition.resize( nVertices );
+            f.m_currentNormal.resize( nVertices );
+            f.m_currentTangent.resize( nVertices );
+            f.m_currentBitangent.resize( nVertices );
+        };
+        resize( frameData );
+        SkinningFrameData packedFrameData = frameData;
+
+        auto check = [&]() {
+            for ( int i = 0; i < nVertices; ++i ) {
+                REQUIRE( frameData.m_currentPosition[i].isApprox(
+                    packedFrameData.m_currentPosition[i], 1e-3_ra ) );
+                REQUIRE( frameData.m_currentNormal[i].isApprox( packedFrameData.m_currentNormal[i],
+                                                                1e-3_ra ) );
+                REQUIRE( frameData.m_currentTangent[i].isApprox(
+                    packedFrameData.m_currentTangent[i], 1e-3_ra ) );
+                REQUIRE( frameData.m_currentBitangent[i].isApprox(
+                    packedFrameData.m_currentBitangent[i], 1e-3_ra ) );
+            }
+        };
+
+        refData.m_packedWeights = PackedSkinningWeights( weights );
+
+        SkinningRefData sparseData = refData;
+        sparseData.m_packedWeights = PackedSkinningWeights();
+
+        // the temporaries allocated in the frame arena are given back
+        const size_t arenaSize = FrameArena::getThreadArena().getUsedSize();
+
+        linearBlendSkinning( sparseData, tangents, bitangents, frameData );
+        linearBlendSkinning( refData, tangents, bitangents, packedFrameData );
+        check();
+        REQUIRE( !frameData.m_currentPosition[nVertices - 1].isApprox( vertices[nVertices - 1] ) );
+
+        dualQuaternionSkinning( sparseData, tangents, bitangents, frameData );
+        dualQuaternionSkinning( refData, tangents, bitangents, packedFrameData );
+        check();
+        REQUIRE( FrameArena::getThreadArena().getUsedSize() == arenaSize );
+    }
+
+    SECTION( "Crowd" ) {
+        SkinningRefData refData;
+        refData.m_referenceMesh.setVertices( vertices );
+        refData.m_referenceMesh.setNormals( normals );
+        refData.m_meshTransformInverse = Transform::Identity();
+        refData.m_skeleton             = skel;
+        refData.m_bindMatrices.resize( skel.size() );
+        for ( uint b = 0; b < skel.size(); ++b )
+            refData.m_bindMatrices[b] = skel.getTransform( b, Space::MODEL ).inverse();
+        refData.m_weights = weights;
+        const auto shared = makeSharedSkinningRefData( std::move( refData ) );
+        REQUIRE( shared->m_packedWeights.getVertexCount() == size_t( nVertices ) );
+
+        CrowdSkinning crowd;
+        const int nInstances = 20;
+        for ( int i = 0; i < nInstances; ++i )
+            crowd.addInstance( shared );
+        REQUIRE( crowd.getInstanceCount() == size_t( nInstances ) );
+        REQUIRE( crowd.getRefDataCount() == 1 );
+        REQUIRE( shared.use_count() == nInstances + 1 );
+        REQUIRE( crowd.getPositions().size() == size_t( nInstances * nVertices ) );
+
+        // each instance bends the chain by a different angle
+        for ( int i = 0; i < nInstances; ++i ) {
+            Skeleton posed = skel;
+            for ( uint b = 1; b < skel.size(); ++b ) {
+                Transform T = skel.getTransform( b, Space::LOCAL );
+                T.rotate( AngleAxis( 0.05_ra * Scalar( i ), Vector3::UnitZ() ) );
+                posed.setTransform( b, T, Space::LOCAL );
+            }
+            crowd.setPose( uint( i ), posed.getPose( Space::MODEL ) );
+        }
+        crowd.skin();
+
+        // compare with individual skinning
+        for ( int i = 0; i < nInstances; i += 7 ) {
+            SkinningFrameData frameData;
+            frameData.m_skeleton = skel;
+            frameData.m_skeleton.setPose( crowd.getPose( uint( i ) ), Space::MODEL );
+            frameData.m_currentPosition.resize( nVertices );
+            frameData.m_currentNormal.resize( nVertices );
+            frameData.m_currentTangent.resize( nVertices );
+            frameData.m_currentBitangent.resize( nVertices );
+            linearBlendSkinning( *shared, tangents, bitangents, frameData );
+            const size_t offset = crowd.getOffset( uint( i ) );
+            REQUIRE( crowd.getVertexCount( uint( i ) ) == size_t( nVertices ) );
+            for ( int v = 0; v < nVertices; ++v ) {
+                REQUIRE( crowd.getPositions()[offset + v].isApprox(
+                    frameData.m_currentPosition[v] ) );
+                REQUIRE( crowd.getNormals()[offset + v].isApprox( frameData.m_currentNormal[v] ) );
+            }
+        }
+
+        crowd.clear();
+        REQUIRE( shared.use_count() == 1 );
+    }
+}
+
+TEST_CASE( "Core/Animation/CompressedAnimation",
+           "[unittests][Core][Core/Animation][CompressedAnimation]" ) {
+    // dense clip, sampled at 30 fps
+    const int nFrames = 241;
+    const Scalar dt   = 1_ra / 30_ra;
+    std::vector<KeyFramedValue<Transform>> channels;
+    auto frame = []( int bone, Scalar t ) -> Transform {
+        Transform T = Transform::Identity();
+        switch ( bone ) {
+        case 0: // constant
+            T.translate( Vector3( 0_ra, 1_ra, 0_ra ) );
+            break;
+        case 1: // constant angular velocity
+            T.rotate( AngleAxis( 0.5_ra * t, Vector3::UnitZ() ) );
+            T.translate( Vector3( 1_ra, 0_ra, 0_ra ) );
+            break;
+        case 2: // smooth motion
+            T.translate( Vector3( std::sin( t ), 0.5_ra * std::cos( 2_ra * t ), 0_ra ) );
+            T.rotate( AngleAxis( std::sin( 3_ra * t ), Vector3( 1_ra, 1_ra, 0_ra ).normalized() ) );
+            break;
+        default: // scaling
+            T.rotate( AngleAxis( 0.3_ra * t, Vector3::UnitX() ) );
+            T.scale( Vector3( 1_ra + 0.5_ra * std::sin( t ), 1_ra, 2_ra ) );
+            break;
+        }
+        return T;
+    };
+    for ( int b = 0; b < 4; ++b ) {
+        KeyFramedValue<Transform> channel( 0_ra, frame( b, 0_ra ) );
+        for ( int f = 1; f < nFrames; ++f )
+            channel.insertKeyFrame( f * dt, frame( b, f * dt ) );
+        channels.push_back( channel );
+    }
+
+    CompressedAnimation::Tolerances tolerances;
+    tolerances.m_rotation    = 1e-3_ra;
+    tolerances.m_translation = 1e-3_ra;
+    tolerances.m_scale       = 1e-3_ra;
+    CompressedAnimation clip( channels, { "root", "arm", "forearm", "hand" }, tolerances );
+
+    // the rotation, translation and scale of the error between two transformations
+    auto checkError = [&tolerances]( const Transform& a, const Transform& b, Scalar factor ) {
+        Matrix3 Ra, Sa, Rb, Sb;
+        a.computeRotationScaling( &Ra, &Sa );
+        b.computeRotationScaling( &Rb, &Sb );
+        REQUIRE( Quaternion( Ra ).angularDistance( Quaternion( Rb ) ) <=
+                 factor * tolerances.m_rotation );
+        REQUIRE( ( a.translation() - b.translation() ).norm() <=
+                 factor * tolerances.m_translation );
+        REQUIRE( ( Sa.diagonal() - Sb.diagonal() ).norm() <= factor * tolerances.m_scale );
+    };
+
+    SECTION( "Compression" ) {
+        REQUIRE( clip.getChannelCount() == 4 );
+        REQUIRE( clip.getChannelName( 2 ) == "forearm" );
+        REQUIRE( clip.getStartTime() == 0_ra );
+        REQUIRE( Math::areApproxEqual( clip.getEndTime(), ( nFrames - 1 ) * dt ) );
+        // constant tracks have a single key, linear ones have few keys
+        REQUIRE( clip.getKeyFrameCount() < size_t( 3 * 4 * nFrames / 4 ) );
+        REQUIRE( clip.getMemorySize() < 4 * nFrames * sizeof( Transform ) / 8 );
+
+        // error bound at the input keyframes, and between them
+        Pose pose( 4 );
+        std::vector<size_t> cursors;
+        for ( int f = 0; f < nFrames; ++f ) {
+            clip.sample( f * dt, pose, cursors );
+            for ( int b = 0; b < 4; ++b )
+                checkError( pose[b], frame( b, f * dt ), 1.01_ra );
+        }
+        for ( Scalar t = 0_ra; t < clip.getEndTime(); t += 0.37_ra * dt ) {
+            clip.sample( t, pose, cursors );
+            for ( int b = 0; b < 4; ++b )
+                checkError( pose[b], frame( b, t ), 2_ra );
+        }
+        // out of range times are clamped
+        clip.sample( -1_ra, pose, cursors );
+        checkError( pose[2], frame( 2, 0_ra ), 1.01_ra );
+        clip.sample( 100_ra, pose, cursors );
+        checkError( pose[2], frame( 2, ( nFrames - 1 ) * dt ), 1.01_ra );
+
+        // channels sampled into a pose ordered differently
+        Pose reordered( 5, Transform::Identity() );
+        std::vector<size_t> reorderedCursors;
+        clip.sample( 1_ra, pose, cursors );
+        clip.sample( 1_ra, reordered, reorderedCursors, { 4, -1, 0, 2 } );
+        REQUIRE( reordered[4].isApprox( pose[0] ) );
+        REQUIRE( reordered[0].isApprox( pose[2] ) );
+        REQUIRE( reordered[2].isApprox( pose[3] ) );
+        REQUIRE( reordered[1].isApprox( Transform::Identity() ) );
+        REQUIRE( reordered[3].isApprox( Transform::Identity() ) );
+    }
+
+    SECTION( "Serialization" ) {
+        std::stringstream stream;
+        clip.write( stream );
+        CompressedAnimation loaded;
+        REQUIRE( loaded.read( stream ) );
+        REQUIRE( loaded.getChannelCount() == clip.getChannelCount() );
+        REQUIRE( loaded.getKeyFrameCount() == clip.getKeyFrameCount() );
+        REQUIRE( loaded.getChannelName( 3 ) == "hand" );
+        Pose a( 4 ), b( 4 );
+        std::vector<size_t> ca, cb;
+        for ( Scalar t = 0_ra; t < clip.getEndTime(); t += 0.5_ra ) {
+            clip.sample( t, a, ca );
+            loaded.sample( t, b, cb );
+            for ( int k = 0; k < 4; ++k )
+                REQUIRE( a[k].isApprox( b[k] ) );
+        }
+
+        const std::string data = stream.str();
+        std::stringstream truncated( data.substr( 0, data.size() / 2 ) );
+        REQUIRE_FALSE( loaded.read( truncated ) );
+        REQUIRE( loaded.getChannelCount() == 0 );
+
+        // the channel count is checked against the stream size before allocating the channels
+        std::string corrupted = data;
+        const uint64_t count  = uint64_t( 1 ) << 40;
+        std::copy_n( reinterpret_cast<const char*>( &count ), sizeof( count ), &corrupted[8] );
+        std::stringstream corruptedStream( corrupted );
+        REQUIRE_FALSE( loaded.read( corruptedStream ) );
+        REQUIRE( loaded.getChannelCount() == 0 );
+    }
+
+    SECTION( "AnimationData round-trip" ) {
+        std::vector<Asset::HandleAnimation> handles;
+        for ( int b = 0; b < 4; ++b ) {
+            Asset::HandleAnimation handle( "bone" + std::to_string( b ) );
+            handle.m_anim          = channels[b];
+            handle.m_animationTime = Asset::AnimationTime( 0_ra, ( nFrames - 1 ) * dt );
+            handles.push_back( handle );
+        }
+        Asset::AnimationData data;
+        data.setHandleData( handles );
+
+        Asset::AnimationData decompressed;
+        decompressed.setHandleData( data.compress( tolerances ) );
+        REQUIRE( decompressed.getClip() != nullptr );
+        REQUIRE( decompressed.getFramesSize() == 4 );
+        const auto result = decompressed.getHandleData();
+        REQUIRE( result.size() == 4 );
+        for ( int b = 0; b < 4; ++b ) {
+            REQUIRE( result[b].m_name == handles[b].m_name );
+            REQUIRE( result[b].m_animationTime.getStart() == 0_ra );
+            REQUIRE( Math::areApproxEqual( result[b].m_animationTime.getEnd(),
+                                           ( nFrames - 1 ) * dt ) );
+            REQUIRE( result[b].m_anim.size() <= channels[b].size() );
+            for ( int f = 0; f < nFrames; ++f )
+                checkError( result[b].m_anim.at( f * dt, linearInterpolate<Transform> ),
+                            frame( b, f * dt ),
+                            1.01_ra );
+        }
+    }
+}
+
+TEST_CASE( "Core/Animation/AnimationBlendTree",
+           "[unittests][Core][Core/Animation][AnimationBlendTree]" ) {
+    const uint nBones = 3;
+    // clip 0: rotating bones, clip 1: translating bones, clip 2: rest pose
+    std::vector<AnimationBlendTree::Clip> clips( 3 );
+    for ( uint b = 0; b < nBones; ++b ) {
+        KeyFramedValue<Transform> rotation( 0_ra, Transform::Identity() );
+        Transform T = Transform::Identity();
+        T.rotate( AngleAxis( 1_ra, Vector3::UnitZ() ) );
+        rotation.insertKeyFrame( 2_ra, T );
+        clips[0].push_back( rotation );
+
+        KeyFramedValue<Transform> translation( 0_ra, Transform::Identity() );
+        T = Transform::Identity();
+        T.translate( Vector3( 0_ra, 2_ra, 0_ra ) );
+        translation.insertKeyFrame( 2_ra, T );
+        clips[1].push_back( translation );
+
+        clips[2].push_back( KeyFramedValue<Transform>( 0_ra, Transform::Identity() ) );
+    }
+    auto sample = [&clips]( size_t clip, Scalar t ) {
+        Pose pose( nBones );
+        std::vector<size_t> cursors;
+        sampleKeyFramedValues( clips[clip], t, cursors, pose );
+        return pose;
+    };
+    auto requireEqual = []( const Pose& a, const Pose& b ) {
+        REQUIRE( a.size() == b.size() );
+        for ( size_t i = 0; i < a.size(); ++i )
+            REQUIRE( a[i].isApprox( b[i] ) );
+    };
+    Pose pose( nBones );
+
+    SECTION( "Compilation" ) {
+        AnimationBlendTree tree;
+        REQUIRE( tree.empty() );
+        REQUIRE_FALSE( tree.compile() );
+        // chain of crossfades: buffers are reused
+        auto node = tree.addClip( 0 );
+        for ( int i = 0; i < 10; ++i )
+            node = tree.addCrossfade( node, tree.addClip( i % 2 ), 0.5_ra );
+        tree.addClip( 1 ); // unused
+        tree.setRoot( node );
+        REQUIRE( tree.compile() );
+        REQUIRE( tree.isCompiled() );
+        REQUIRE( tree.getInstructionCount() == 21 );
+        REQUIRE( tree.getBufferCount() <= 3 );
+        tree.evaluate( clips, 1_ra, pose );
+        tree.clear();
+        REQUIRE( tree.empty() );
+        REQUIRE_FALSE( tree.isCompiled() );
+    }
+
+    SECTION( "Clip" ) {
+        AnimationBlendTree tree;
+        auto looping = tree.addClip( 0 );
+        auto clamped = tree.addClip( 0, 2_ra, 0.5_ra, false );
+        tree.setRoot( looping );
+        REQUIRE( tree.compile() );
+        tree.evaluate( clips, 0.5_ra, pose );
+        requireEqual( pose, sample( 0, 0.5_ra ) );
+        tree.evaluate( clips, 2.5_ra, pose );
+        requireEqual( pose, sample( 0, 0.5_ra ) );
+
+        tree.setRoot( clamped );
+        REQUIRE( tree.compile() );
+        tree.evaluate( clips, 0.5_ra, pose );
+        requireEqual( pose, sample( 0, 1.5_ra ) );
+        tree.evaluate( clips, 5_ra, pose );
+        requireEqual( pose, sample( 0, 2_ra ) );
+        tree.setClipTime( clamped, 1_ra, 0_ra );
+        tree.evaluate( clips, 1_ra, pose );
+        requireEqual( pose, sample( 0, 1_ra ) );
+    }
+
+    SECTION( "Crossfade" ) {
+        AnimationBlendTree tree;
+        auto fade = tree.addCrossfade( tree.addClip( 0 ), tree.addClip( 1 ) );
+        tree.setRoot( fade );
+        REQUIRE( tree.compile() );
+        tree.evaluate( clips, 1_ra, pose );
+        requireEqual( pose, sample( 0, 1_ra ) );
+        tree.setWeight( fade, 1_ra );
+        tree.evaluate( clips, 1_ra, pose );
+        requireEqual( pose, sample( 1, 1_ra ) );
+        tree.setWeight( fade, 0.25_ra );
+        REQUIRE( tree.getWeight( fade ) == 0.25_ra );
+        tree.evaluate( clips, 1_ra, pose );
+        requireEqual( pose, interpolatePoses( sample( 0, 1_ra ), sample( 1, 1_ra ), 0.25_ra ) );
+    }
+
+    SECTION( "Additive" ) {
+        AnimationBlendTree tree;
+        auto base     = tree.addClip( 0 );
+        auto additive = tree.addAdditive( base, tree.addClip( 1 ), tree.addClip( 2 ) );
+        tree.setRoot( additive );
+        REQUIRE( tree.compile() );
+        tree.evaluate( clips, 1_ra, pose );
+        const Pose a = sample( 0, 1_ra );
+        const Pose b = sample( 1, 1_ra );
+        for ( uint i = 0; i < nBones; ++i )
+            REQUIRE( pose[i].isApprox( a[i] * b[i] ) );
+        tree.setWeight( additive, 0_ra );
+        tree.evaluate( clips, 1_ra, pose );
+        requireEqual( pose, a );
+    }
+
+    SECTION( "Masked" ) {
+        AnimationBlendTree tree;
+        auto masked =
+            tree.addMasked( tree.addClip( 0 ), tree.addClip( 1 ), { 0_ra, 1_ra, 0.5_ra } );
+        tree.setRoot( masked );
+        REQUIRE( tree.compile() );
+        tree.evaluate( clips, 1_ra, pose );
+        const Pose a = sample( 0, 1_ra );
+        const Pose b = sample( 1, 1_ra );
+        REQUIRE( pose[0].isApprox( a[0] ) );
+        REQUIRE( pose[1].isApprox( b[1] ) );
+        REQUIRE( pose[2].isApprox( Math::linearInterpolate( a[2], b[2], 0.5_ra ) ) );
+    }
+}
+
+TEST_CASE( "Core/Animation/BlendShapes", "[unittests][Core][Core/Animation][BlendShapes]" ) {
+    const uint nVerts = 6;
+    Vector3Array positions( nVerts );
+    Vector3Array normals( nVerts, Vector3::UnitZ() );
+    Vector3Array tangents( nVerts, Vector3::UnitX() );
+    for ( uint i = 0; i < nVerts; ++i )
+        positions[i] = Vector3( Scalar( i ), 0_ra, 0_ra );
+
+    // shape 0 lifts vertices 1 and 2, shape 1 moves vertex 2 and tilts its normal
+    Vector3Array target0 = positions;
+    target0[1] += Vector3::UnitZ();
+    target0[2] += Vector3::UnitZ();
+    Vector3Array target1 = positions;
+    target1[2] += Vector3::UnitY();
+    Vector3Array targetNormals1 = normals;
+    targetNormals1[2]           = Vector3::UnitY();
+
+    auto shape0 = makeBlendShape( "lift", positions, target0 );
+    auto shape1 = makeBlendShape( "tilt", positions, target1, normals, targetNormals1 );
+
+    SECTION( "Sparse deltas" ) {
+        REQUIRE( shape0.m_indices == std::vector<uint> { 1, 2 } );
+        REQUIRE( shape0.m_positionDeltas.size() == 2 );
+        REQUIRE( shape0.m_normalDeltas.empty() );
+        REQUIRE( shape1.m_indices == std::vector<uint> { 2 } );
+        REQUIRE( shape1.m_normalDeltas.size() == 1 );
+        REQUIRE( shape1.m_normalDeltas[0].isApprox( Vector3( 0_ra, 1_ra, -1_ra ) ) );
+    }
+
+    BlendShapeDeformer deformer( { shape0, shape1 }, positions, normals, tangents );
+    REQUIRE( deformer.getAffectedVertices() == std::vector<uint> { 1, 2 } );
+
+    Vector3Array p = positions;
+    Vector3Array n = normals;
+    Vector3Array t = tangents;
+
+    SECTION( "Apply" ) {
+        deformer.apply( { 0.5_ra, 0_ra }, p, n, t );
+        REQUIRE( p[1].isApprox( positions[1] + 0.5_ra * Vector3::UnitZ() ) );
+        REQUIRE( p[2].isApprox( positions[2] + 0.5_ra * Vector3::UnitZ() ) );
+        REQUIRE( n[2].isApprox( Vector3::UnitZ() ) );
+
+        deformer.apply( { 1_ra, 1_ra }, p, n, t );
+        REQUIRE( p[2].isApprox( positions[2] + Vector3( 0_ra, 1_ra, 1_ra ) ) );
+        REQUIRE( n[2].isApprox( Vector3::UnitY() ) );
+        REQUIRE( t[2].isApprox( Vector3::UnitX() ) );
+
+        deformer.apply( { 0_ra, 0.5_ra }, p, n, t );
+        REQUIRE( p[1].isApprox( positions[1] ) );
+        REQUIRE( Math::areApproxEqual( n[2].norm(), 1_ra ) );
+        REQUIRE( n[2].isApprox( Vector3( 0_ra, 1_ra, 1_ra ).normalized() ) );
+
+        // unaffected vertices are never written
+        for ( uint i : { 0u, 3u, 4u, 5u } ) {
+            REQUIRE( p[i] == positions[i] );
+            REQUIRE( n[i] == normals[i] );
+        }
+
+        deformer.apply( deformer.getDefaultWeights(), p, n, t );
+        for ( uint i = 0; i < nVerts; ++i ) {
+            REQUIRE( p[i].isApprox( positions[i] ) );
+            REQUIRE( n[i].isApprox( normals[i] ) );
+        }
+    }
+
+    SECTION( "Position deltas" ) {
+        // on top of another deformation (here a translation), affected vertices only
+        for ( auto& q : p )
+            q += Vector3::UnitX();
+        deformer.addPositionDeltas( { 1_ra, 0.5_ra }, p );
+        REQUIRE( p[1].isApprox( positions[1] + Vector3( 1_ra, 0_ra, 1_ra ) ) );
+        REQUIRE( p[2].isApprox( positions[2] + Vector3( 1_ra, 0.5_ra, 1_ra ) ) );
+        REQUIRE( p[0] == positions[0] + Vector3::UnitX() );
+    }
+
+    SECTION( "Cage with blendshapes" ) {
+        // the reference positions hold the applied blendshapes, the cage weights are computed
+        // on the base positions and the deltas added after the deformation, only once
+        const std::vector<Scalar> weights { 1_ra, 0.5_ra };
+        deformer.apply( weights, p, n, t );
+        Vector3Array base = p;
+        deformer.resetPositions( base );
+        for ( uint i = 0; i < nVerts; ++i )
+            REQUIRE( base[i] == positions[i] );
+
+        const auto box = Geometry::makeBox(
+            Aabb( Vector3( -1_ra, -1_ra, -1_ra ), Vector3( 6_ra, 2_ra, 2_ra ) ) );
+        Cage cage( uint( box.vertices().size() ) );
+        Pose restPose( cage.size() );
+        for ( uint i = 0; i < cage.size(); ++i )
+            restPose[i] = Translation( box.vertices()[i] );
+        cage.setPose( restPose, HandleArray::SpaceType::MODEL );
+        cage.m_triangle = box.getIndices();
+
+        Vector3Array deformed;
+        cageDeformation( computeMeanValueCoordinates( cage, base ), cage, deformed );
+        deformer.addPositionDeltas( weights, deformed );
+        for ( uint i = 0; i < nVerts; ++i )
+            REQUIRE( ( deformed[i] - p[i] ).norm() < 1e-4_ra );
+    }
+
+    SECTION( "Missing attributes" ) {
+        Vector3Array noNormals;
+        Vector3Array noTangents;
+        deformer.apply( { 1_ra, 1_ra }, p, noNormals, noTangents );
+        REQUIRE( p[2].isApprox( positions[2] + Vector3( 0_ra, 1_ra, 1_ra ) ) );
+        REQUIRE( noNormals.empty() );
+    }
+}
+
+TEST_CASE( "Core/Animation/CageDeformation",
+           "[unittests][Core][Core/Animation][CageDeformation]" ) {
+    // unit cube cage
+    const auto box = Geometry::makeBox();
+    Cage cage( uint( box.vertices().size() ) );
+    Pose restPose( cage.size() );
+    for ( uint i = 0; i < cage.size(); ++i )
+        restPose[i] = Translation( box.vertices()[i] );
+    cage.setPose( restPose, HandleArray::SpaceType::MODEL );
+    cage.m_triangle = box.getIndices();
+    const Vector3Array cageVertices = getCageVertices( cage );
+
+    // points inside the cage, on a face and on a vertex
+    Vector3Array points;
+    for ( int i = -2; i <= 2; ++i )
+        for ( int j = -2; j <= 2; ++j )
+            for ( int k = -2; k <= 2; ++k )
+                points.emplace_back(
+                    0.2_ra * Scalar( i ), 0.15_ra * Scalar( j ), 0.1_ra * Scalar( k ) );
+    points.emplace_back( 0.1_ra, 0.2_ra, 0.5_ra );
+    points.push_back( cageVertices[3] );
+
+    const CageWeights weights = computeMeanValueCoordinates( cage, points );
+    REQUIRE( weights.rows() == int( points.size() ) );
+    REQUIRE( weights.cols() == int( cage.size() ) );
+
+    SECTION( "Reproduction" ) {
+        for ( int i = 0; i < weights.rows(); ++i ) {
+            REQUIRE( Math::areApproxEqual( weights.row( i ).sum(), 1_ra ) );
+        }
+        // the point on a cage vertex only depends on it
+        REQUIRE( weights.row( weights.rows() - 1 ).nonZeros() == 1 );
+        Vector3Array deformed;
+        cageDeformation( weights, cage, deformed );
+        REQUIRE( deformed.size() == points.size() );
+        for ( size_t i = 0; i < points.size(); ++i ) {
+            REQUIRE( ( deformed[i] - points[i] ).norm() < 1e-4_ra );
+        }
+    }
+
+    SECTION( "Affine invariance" ) {
+        Transform T = Transform::Identity();
+        T.translate( Vector3( 1_ra, -2_ra, 0.5_ra ) );
+        T.rotate( AngleAxis( 0.7_ra, Vector3( 1_ra, 1_ra, 0_ra ).normalized() ) );
+        T.scale( Vector3( 2_ra, 1_ra, 0.5_ra ) );
+        Pose pose( restPose );
+        for ( auto& t : pose )
+            t = T * t;
+        cage.setPose( pose, HandleArray::SpaceType::MODEL );
+        Vector3Array deformed;
+        cageDeformation( weights, cage, deformed );
+        for ( size_t i = 0; i < points.size(); ++i ) {
+            REQUIRE( ( deformed[i] - T * points[i] ).norm() < 1e-4_ra );
+        }
+    }
+
+    SECTION( "Local deformation" ) {
+        // moving a cage vertex moves the points close to it the most
+        Vector3Array moved = cageVertices;
+        moved[7] += Vector3( 0_ra, 0_ra, 1_ra );
+        Vector3Array deformed;
+        cageDeformation( weights, moved, deformed );
+        Scalar nearShift = 0_ra;
+        Scalar farShift  = 0_ra;
+        for ( size_t i = 0; i < points.size(); ++i ) {
+            const Scalar shift = ( deformed[i] - points[i] ).norm();
+            if ( ( points[i] - cageVertices[7] ).norm() < 0.5_ra )
+                nearShift = std::max( nearShift, shift );
+            if ( ( points[i] - cageVertices[0] ).norm() < 0.5_ra )
+                farShift = std::max( farShift, shift );
+        }
+        REQUIRE( nearShift > farShift );
+        REQUIRE( ( deformed.back() - points.back() ).norm() < 1e-4_ra );
+    }
+
+    SECTION( "Pruning" ) {
+        const CageWeights pruned = computeMeanValueCoordinates( cage, points, 0.05_ra );
+        REQUIRE( pruned.nonZeros() < weights.nonZeros() );
+        for ( int i = 0; i < pruned.rows(); ++i ) {
+            REQUIRE( Math::areApproxEqual( pruned.row( i ).sum(), 1_ra ) );
+            for ( CageWeights::InnerIterator it( pruned, i ); it; ++it )
+                REQUIRE( std::abs( it.value() ) > 0.05_ra / 2_ra );
+        }
+    }
+}
+
+TEST_CASE( "Core/Animation/CenterOfRotation",
+           "[unittests][Core][Core/Animation][CenterOfRotation]" ) {
+    namespace fs = ::std::filesystem;
+
+    // a strip of triangles along X, blended between two bones around x = 1
+    const int nVertices = 40;
+    SkinningRefData refData;
+    Vector3Array vertices;
+    Vector3Array normals;
+    VectorArray<Vector3ui> indices;
+    WeightMatrix weights( nVertices, 2 );
+    for ( int i = 0; i < nVertices; ++i ) {
+        const Scalar x = 2_ra * Scalar( i ) / Scalar( nVertices - 1 );
+        vertices.push_back( { x, Scalar( i % 2 ), 0_ra } );
+        normals.push_back( Vector3::UnitZ() );
+        const Scalar t = std::clamp( x - 0.5_ra, 0_ra, 1_ra );
+        if ( t < 1_ra ) weights.insert( i, 0 ) = 1_ra - t;
+        if ( t > 0_ra ) weights.insert( i, 1 ) = t;
+        if ( i + 2 < nVertices ) indices.emplace_back( uint( i ), uint( i + 1 ), uint( i + 2 ) );
+    }
+    weights.makeCompressed();
+    refData.m_referenceMesh.setVertices( vertices );
+    refData.m_referenceMesh.setNormals( normals );
+    refData.m_referenceMesh.setIndices( std::move( indices ) );
+    refData.m_weights = weights;
+
+    SkinningRefData uncached = refData;
+    computeCoR( uncached );
+    REQUIRE( uncached.m_CoR.size() == size_t( nVertices ) );
+
+    const auto cacheDirectory = fs::temp_directory_path() / "radium_cor_cache";
+    fs::remove_all( cacheDirectory );
+    fs::create_directories( cacheDirectory );
+
+    SECTION( "Cache" ) {
+        const uint64_t key = hashCoRInputs( refData, 0.1_ra, 0.1_ra );
+        REQUIRE( hashCoRInputs( uncached, 0.1_ra, 0.1_ra ) == key );
+        REQUIRE( hashCoRInputs( refData, 0.2_ra, 0.1_ra ) != key );
+
+        // computed and saved, then loaded
+        for ( int pass = 0; pass < 2; ++pass ) {
+            SkinningRefData cached = refData;
+            computeCoR( cached, 0.1_ra, 0.1_ra, cacheDirectory.string() );
+            REQUIRE( std::distance( fs::directory_iterator( cacheDirectory ),
+                                    fs::directory_iterator() ) == 1 );
+            REQUIRE( cached.m_CoR.size() == uncached.m_CoR.size() );
+            for ( int i = 0; i < nVertices; ++i ) {
+                REQUIRE( cached.m_CoR[i] == uncached.m_CoR[i] );
+            }
+        }
+
+        // other weights, other key
+        SkinningRefData moved = refData;
+        moved.m_weights.coeffRef( nVertices / 2, 0 ) += 0.1_ra;
+        REQUIRE( hashCoRInputs( moved, 0.1_ra, 0.1_ra ) != key );
+        computeCoR( moved, 0.1_ra, 0.1_ra, cacheDirectory.string() );
+        REQUIRE( std::distance( fs::directory_iterator( cacheDirectory ),
+                                fs::directory_iterator() ) == 2 );
+    }
+
+    SECTION( "Invalid cache" ) {
+        SkinningRefData cached = refData;
+        computeCoR( cached, 0.1_ra, 0.1_ra, cacheDirectory.string() );
+        const auto file = fs::directory_iterator( cacheDirectory )->path();
+        const auto size = fs::file_size( file );
+
+        // corrupted, then truncated: recomputed and saved again
+        {
+            std::fstream f( file, std::ios::in | std::ios::out | std::ios::binary );
+            f.seekp( 20 );
+            f.put( char( 0x5a ) );
+        }
+        for ( int pass = 0; pass < 2; ++pass ) {
+            SkinningRefData reloaded = refData;
+            computeCoR( reloaded, 0.1_ra, 0.1_ra, cacheDirectory.string() );
+            REQUIRE( reloaded.m_CoR.size() == uncached.m_CoR.size() );
+            for ( int i = 0; i < nVertices; ++i ) {
+                REQUIRE( reloaded.m_CoR[i] == uncached.m_CoR[i] );
+            }
+            REQUIRE( fs::file_size( file ) == size );
+            fs::resize_file( file, size / 2 );
+        }
+    }
+
+    fs::remove_all( cacheDirectory );
+}
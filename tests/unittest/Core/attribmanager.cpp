@@ -1,11 +1,16 @@
+#include <Core/Containers/VectorArrayKernels.hpp>
 #include <Core/Types.hpp>
 #include <Core/Utils/Attribs.hpp>
 #include <Core/Utils/ContainerIntrospectionInterface.hpp>
 #include <Core/Utils/Index.hpp>
+#include <Core/Utils/MappedFile.hpp>
+#include <Core/Utils/MemoryAccounting.hpp>
+#include <Core/Utils/StdFilesystem.hpp>
 #include <Eigen/Core>
 
 #include <catch2/catch_test_macros.hpp>
 
+#include <fstream>
 #include <string>
 
 using namespace Ra::Core;
@@ -198,3 +203,224 @@ TEST_CASE( "Core/Utils/AttibManager", "[unittests][Core][Utils][Attribs][AttribM
         REQUIRE( invalidConstPtrFromIdx == nullptr );
     }
 }
+
+TEST_CASE( "Core/Utils/Attribs/MappedFile", "[unittests][Core][Utils][Attribs]" ) {
+    namespace fs = ::std::filesystem;
+
+    // file layout: a 16 bytes header followed by 100 Vector3
+    const auto filename = ( fs::temp_directory_path() / "radium_mapped_attrib.bin" ).string();
+    const size_t header = 16;
+    Vector3Array ref;
+    for ( int i = 0; i < 100; ++i )
+        ref.emplace_back( Scalar( i ), Scalar( 2 * i ), Scalar( 3 * i ) );
+    {
+        std::ofstream out( filename, std::ios::binary );
+        const std::string h( header, 'h' );
+        out.write( h.data(), std::streamsize( header ) );
+        out.write( reinterpret_cast<const char*>( ref.data() ),
+                   std::streamsize( ref.size() * sizeof( Vector3 ) ) );
+    }
+
+    SECTION( "MappedFile" ) {
+        MappedFile file( filename, MappedFile::Mode::ReadOnly, header );
+        REQUIRE( file.isValid() );
+        REQUIRE( file.size() == ref.size() * sizeof( Vector3 ) );
+        REQUIRE( file.writableData() == nullptr );
+        REQUIRE( *static_cast<const Scalar*>( file.data() ) == 0_ra );
+
+        MappedFile invalid( filename, MappedFile::Mode::ReadOnly, header, 1 << 20 );
+        REQUIRE( !invalid.isValid() );
+        MappedFile missing( filename + ".missing" );
+        REQUIRE( !missing.isValid() );
+    }
+
+    SECTION( "Read only attrib" ) {
+        auto file = std::make_shared<MappedFile>( filename );
+        Attrib<Vector3> attr { "mapped" };
+        int notified = 0;
+        attr.attach( [&notified]() { ++notified; } );
+
+        REQUIRE( !attr.setMappedData( file, header, ref.size() + 1 ) ); // too large
+        REQUIRE( !attr.setMappedData( file, 1, 10 ) );                  // misaligned
+        REQUIRE( attr.setMappedData( file, header, ref.size() ) );
+        REQUIRE( notified == 1 );
+        REQUIRE( attr.isMapped() );
+
+        // no copy through introspection and Eigen maps
+        REQUIRE( attr.getSize() == ref.size() );
+        REQUIRE( attr.getBufferSize() == ref.size() * sizeof( Vector3 ) );
+        REQUIRE( attr.dataPtr() == static_cast<const char*>( file->data() ) + header );
+        REQUIRE( attr.getMap() == ref.getMap() );
+
+        // clones share the mapping
+        auto clone = attr.clone();
+        REQUIRE( clone->dataPtr() == attr.dataPtr() );
+
+        // read-only views and kernels read in place
+        const auto view = attr.view();
+        REQUIRE( view.data() == attr.dataPtr() );
+        REQUIRE( view.size() == ref.size() );
+        REQUIRE( std::equal( view.begin(), view.end(), ref.begin() ) );
+        const auto aabb = Kernels::computeAabb( attr );
+        REQUIRE( aabb.min() == ref.front() );
+        REQUIRE( aabb.max() == ref.back() );
+        REQUIRE( attr.isMapped() );
+
+        // copies of attributes read in place
+        AttribManager mng;
+        auto h = mng.addAttrib<Vector3>( "mapped" );
+        REQUIRE( mng.getAttrib( h ).setMappedData( file, header, ref.size() ) );
+        AttribManager copy;
+        copy.copyAttributes( mng, h );
+        REQUIRE( mng.getAttrib( h ).isMapped() );
+        REQUIRE( copy.getAttrib( copy.findAttrib<Vector3>( "mapped" ) ).data() == ref );
+
+        // data access copies
+        REQUIRE( attr.data() == ref );
+        REQUIRE( !attr.isMapped() );
+        REQUIRE( attr.dataPtr() != clone->dataPtr() );
+        attr.getDataWithLock()[0] = Vector3::Ones();
+        attr.unlock();
+        REQUIRE( clone->cast<Vector3>().data()[0] == Vector3::Zero() );
+    }
+
+    SECTION( "Copy on write attrib" ) {
+        auto file = std::make_shared<MappedFile>( filename, MappedFile::Mode::CopyOnWrite );
+        Attrib<Vector3> attr { "mapped" };
+        REQUIRE( attr.setMappedData( file, header, ref.size() ) );
+
+        auto map = attr.getMapWithLock();
+        map.col( 0 ) = Vector3::Ones();
+        attr.unlock();
+        REQUIRE( attr.isMapped() );
+        REQUIRE( attr.getMap().col( 0 ) == Vector3::Ones() );
+
+        // the file is not modified
+        MappedFile check( filename, MappedFile::Mode::ReadOnly, header );
+        REQUIRE( *static_cast<const Scalar*>( check.data() ) == 0_ra );
+
+        attr.setData( ref );
+        REQUIRE( !attr.isMapped() );
+        REQUIRE( attr.data() == ref );
+    }
+
+    fs::remove( filename );
+}
+
+TEST_CASE( "Core/Utils/Attribs/NotificationBatch", "[unittests][Core][Utils][Attribs]" ) {
+    AttribManager mng;
+    auto h      = mng.addAttrib<Scalar>( "attrib" );
+    auto& attr  = mng.getAttrib( h );
+    int count   = 0;
+    auto range  = std::make_pair( size_t { 0 }, size_t { 0 } );
+    auto record = [&count, &range, &attr]() {
+        ++count;
+        range = attr.getDirtyRange();
+    };
+    attr.attach( record );
+    attr.setData( Attrib<Scalar>::Container( 10, 0_ra ) );
+    REQUIRE( count == 1 );
+    REQUIRE( range == std::make_pair( size_t { 0 }, size_t { 10 } ) );
+
+    SECTION( "Immediate notifications" ) {
+        attr.getDataWithLock()[2] = 1_ra;
+        attr.unlock( 2, 3 );
+        REQUIRE( count == 2 );
+        REQUIRE( range == std::make_pair( size_t { 2 }, size_t { 3 } ) );
+    }
+
+    SECTION( "Batched notifications" ) {
+        {
+            auto batch = mng.getScopedNotificationBatch();
+            REQUIRE( mng.isBatchingNotifications() );
+            attr.getDataWithLock()[2] = 1_ra;
+            attr.unlock( 2, 3 );
+            attr.getDataWithLock()[6] = 1_ra;
+            attr.unlock( 5, 7 );
+            {
+                // nested batch
+                auto nested = mng.getScopedNotificationBatch();
+                attr.getDataWithLock()[4] = 1_ra;
+                attr.unlock( 4, 5 );
+            }
+            REQUIRE( count == 1 );
+
+            // attribs added while batching are batched
+            int otherCount = 0;
+            auto o         = mng.addAttrib<Scalar>( "other" );
+            mng.getAttrib( o ).attach( [&otherCount]() { ++otherCount; } );
+            mng.getAttrib( o ).setData( Attrib<Scalar>::Container( 4, 0_ra ) );
+            REQUIRE( otherCount == 0 );
+            mng.flushNotifications();
+            REQUIRE( otherCount == 1 );
+            REQUIRE( count == 2 );
+            REQUIRE( range == std::make_pair( size_t { 2 }, size_t { 7 } ) );
+
+            attr.getDataWithLock()[0] = 1_ra;
+            attr.unlock();
+        }
+        REQUIRE( !mng.isBatchingNotifications() );
+        REQUIRE( count == 3 );
+        REQUIRE( range == std::make_pair( size_t { 0 }, size_t { 10 } ) );
+    }
+}
+
+TEST_CASE( "Core/Utils/Attribs/MemoryAccounting", "[unittests][Core][Utils][Attribs]" ) {
+    const auto cpu    = MemoryCategory::CpuAttributes;
+    const auto copies = MemoryCategory::MeshCopies;
+
+    SECTION( "Counters and peaks" ) {
+        const auto usage = MemoryAccounting::getUsage();
+        {
+            TrackedMemory memory( cpu );
+            memory.set( 1000 );
+            memory.set( 400 );
+            REQUIRE( MemoryAccounting::getUsage()[cpu] == usage[cpu] + 400 );
+            REQUIRE( MemoryAccounting::getPeak()[cpu] >= usage[cpu] + 1000 );
+
+            TrackedMemory copy( memory );
+            REQUIRE( MemoryAccounting::getUsage()[cpu] == usage[cpu] + 800 );
+            TrackedMemory moved( std::move( copy ) );
+            REQUIRE( MemoryAccounting::getUsage()[cpu] == usage[cpu] + 800 );
+            moved.setCategory( copies );
+            REQUIRE( MemoryAccounting::getUsage()[cpu] == usage[cpu] + 400 );
+            REQUIRE( MemoryAccounting::getUsage()[copies] == usage[copies] + 400 );
+        }
+        REQUIRE( MemoryAccounting::getUsage()[cpu] == usage[cpu] );
+        REQUIRE( MemoryAccounting::getUsage()[copies] == usage[copies] );
+        REQUIRE( MemoryAccounting::getTotalUsage() == usage.getTotal() );
+
+        MemoryAccounting::resetPeaks();
+        REQUIRE( MemoryAccounting::getPeak()[cpu] == usage[cpu] );
+        REQUIRE( MemoryAccounting::getTotalPeak() == usage.getTotal() );
+    }
+
+    SECTION( "Attributes" ) {
+        const size_t before = MemoryAccounting::getUsage()[cpu];
+        {
+            AttribManager mng;
+            auto h = mng.addAttrib<Vector3>( "v" );
+            mng.setAttrib( h, Vector3Array( 100, Vector3::Zero() ) );
+            const size_t size = mng.getMemorySize();
+            REQUIRE( size >= 100 * sizeof( Vector3 ) );
+            REQUIRE( MemoryAccounting::getUsage()[cpu] == before + size );
+
+            // a copy accounts its own storage
+            AttribManager copy;
+            copy.copyAllAttributes( mng );
+            REQUIRE( MemoryAccounting::getUsage()[cpu] == before + size + copy.getMemorySize() );
+
+            copy.setMemoryCategory( copies );
+            MemoryUsage usage;
+            copy.addMemoryUsage( usage );
+            REQUIRE( usage[copies] == copy.getMemorySize() );
+            REQUIRE( usage[cpu] == 0 );
+            REQUIRE( MemoryAccounting::getUsage()[cpu] == before + size );
+
+            mng.getAttrib( h ).resize( 1000 );
+            REQUIRE( MemoryAccounting::getUsage()[cpu] == before + mng.getMemorySize() );
+            REQUIRE( mng.getMemorySize() >= 1000 * sizeof( Vector3 ) );
+        }
+        REQUIRE( MemoryAccounting::getUsage()[cpu] == before );
+    }
+}
@@ -1,5 +1,10 @@
+#include <Core/Containers/FrameArena.hpp>
 #include <Core/Containers/Iterators.hpp>
+#include <Core/Containers/LruCache.hpp>
+#include <Core/Containers/SmallVector.hpp>
+#include <Core/Types.hpp>
 #include <algorithm>
+#include <cstdint>
 #include <catch2/catch_test_macros.hpp>
 #include <functional>
 #include <iterator>
@@ -70,3 +75,182 @@ TEST_CASE( "Core/Containers/Iterators", "[unittests][Core][Core/Containers][Iter
         REQUIRE( reverted1 != reverted3 );
     }
 }
+
+TEST_CASE( "Core/Containers/SmallVector", "[unittests][Core][Core/Containers][SmallVector]" ) {
+    using namespace Ra::Core;
+    using Container = SmallVector<int, 4>;
+
+    SECTION( "Inline storage" ) {
+        Container v { 3, 1, 2 };
+        REQUIRE( v.size() == 3 );
+        REQUIRE( v.isInline() );
+        REQUIRE( v[0] == 3 );
+        REQUIRE( v[2] == 2 );
+
+        v.insert( v.begin(), 0 );
+        REQUIRE( v.size() == 4 );
+        REQUIRE( v.isInline() );
+        REQUIRE( std::equal( v.begin(), v.end(), std::vector<int> { 0, 3, 1, 2 }.begin() ) );
+    }
+
+    SECTION( "Heap storage" ) {
+        Container v;
+        for ( int i = 0; i < 10; ++i ) {
+            v.push_back( i );
+        }
+        REQUIRE( v.size() == 10 );
+        REQUIRE( !v.isInline() );
+        for ( int i = 0; i < 10; ++i ) {
+            REQUIRE( v[i] == i );
+        }
+        // insert at the inline/heap limit
+        v.insert( v.begin() + 4, 42 );
+        REQUIRE( v[4] == 42 );
+        REQUIRE( v[10] == 9 );
+
+        Container copy = v;
+        REQUIRE( std::equal( v.begin(), v.end(), copy.begin() ) );
+        Container moved = std::move( copy );
+        REQUIRE( moved.size() == 11 );
+        REQUIRE( copy.empty() );
+
+        v.clear();
+        REQUIRE( v.empty() );
+        v.push_back( 1 );
+        REQUIRE( v.isInline() );
+        REQUIRE( v[0] == 1 );
+    }
+
+    SECTION( "Insertion at the inline limit" ) {
+        Container v { 0, 1, 2, 4 };
+        v.insert( v.begin() + 3, 3 );
+        REQUIRE( !v.isInline() );
+        for ( int i = 0; i < 5; ++i ) {
+            REQUIRE( v[i] == i );
+        }
+    }
+}
+
+TEST_CASE( "Core/Containers/LruCache", "[unittests][Core][Core/Containers][LruCache]" ) {
+    using namespace Ra::Core;
+    using Cache = LruCache<int, std::vector<int>>;
+    // values weight their number of elements
+    Cache cache( 10, []( const std::vector<int>& v ) { return v.size(); } );
+
+    SECTION( "Insertion and lookup" ) {
+        REQUIRE( cache.insert( 0, { 0, 0, 0 } ) );
+        REQUIRE( cache.insert( 1, { 1, 1, 1 } ) );
+        REQUIRE( cache.size() == 2 );
+        REQUIRE( cache.getMemorySize() == 6 );
+        REQUIRE( cache.contains( 0 ) );
+        REQUIRE( !cache.contains( 2 ) );
+        REQUIRE( cache.get( 2 ) == nullptr );
+        auto v = cache.get( 1 );
+        REQUIRE( v != nullptr );
+        REQUIRE( ( *v )[0] == 1 );
+
+        // replacing a value updates the memory size
+        REQUIRE( cache.insert( 1, { 1 } ) );
+        REQUIRE( cache.size() == 2 );
+        REQUIRE( cache.getMemorySize() == 4 );
+        // the previous value is still valid for its users
+        REQUIRE( v->size() == 3 );
+
+        cache.erase( 0 );
+        REQUIRE( !cache.contains( 0 ) );
+        REQUIRE( cache.getMemorySize() == 1 );
+        cache.clear();
+        REQUIRE( cache.size() == 0 );
+        REQUIRE( cache.getMemorySize() == 0 );
+    }
+
+    SECTION( "Least recently used eviction" ) {
+        cache.insert( 0, { 0, 0, 0 } );
+        cache.insert( 1, { 1, 1, 1 } );
+        cache.insert( 2, { 2, 2, 2 } );
+        // 0 becomes the most recently used one
+        REQUIRE( cache.get( 0 ) != nullptr );
+        cache.insert( 3, { 3, 3, 3 } );
+        REQUIRE( cache.contains( 0 ) );
+        REQUIRE( !cache.contains( 1 ) );
+        REQUIRE( cache.contains( 2 ) );
+        REQUIRE( cache.contains( 3 ) );
+        REQUIRE( cache.getMemorySize() == 9 );
+
+        // too large values are not stored
+        REQUIRE( !cache.insert( 4, std::vector<int>( 11 ) ) );
+        REQUIRE( !cache.contains( 4 ) );
+        REQUIRE( cache.size() == 3 );
+
+        // reducing the budget evicts the least recently used values
+        cache.setBudget( 6 );
+        REQUIRE( cache.getBudget() == 6 );
+        REQUIRE( !cache.contains( 2 ) );
+        REQUIRE( cache.contains( 0 ) );
+        REQUIRE( cache.contains( 3 ) );
+    }
+}
+
+TEST_CASE( "Core/Containers/FrameArena", "[unittests][Core][Core/Containers][FrameArena]" ) {
+    using namespace Ra::Core;
+
+    SECTION( "Allocation and reset" ) {
+        FrameArena arena( 256 );
+        auto p             = arena.allocate( 10, 1 );
+        const size_t usedP = arena.getUsedSize();
+        auto q             = arena.allocate( 8, 16 );
+        REQUIRE( reinterpret_cast<std::uintptr_t>( q ) % 16 == 0 );
+        REQUIRE( static_cast<char*>( q ) >= static_cast<char*>( p ) + 10 );
+        REQUIRE( arena.getCapacity() == 256 );
+
+        // only the last allocation is given back, with its alignment
+        const size_t used = arena.getUsedSize();
+        arena.deallocate( p, 10 );
+        REQUIRE( arena.getUsedSize() == used );
+        arena.deallocate( q, 8 );
+        REQUIRE( arena.getUsedSize() == usedP );
+        arena.deallocate( p, 10 );
+        REQUIRE( arena.getUsedSize() == 0 );
+        REQUIRE( arena.allocate( 10, 1 ) == p );
+
+        // larger allocations add chunks, merged at reset
+        arena.allocate( 1000, 8 );
+        REQUIRE( arena.getCapacity() > 1000 );
+        const size_t capacity = arena.getCapacity();
+        arena.reset();
+        REQUIRE( arena.getUsedSize() == 0 );
+        REQUIRE( arena.getCapacity() == capacity );
+        REQUIRE( arena.allocate( 1000, 8 ) != nullptr );
+        REQUIRE( arena.getCapacity() == capacity );
+    }
+
+    SECTION( "Containers" ) {
+        FrameArena arena( 64 );
+        AlignedStdVector<int, FrameAllocator<int>> v { FrameAllocator<int>( arena ) };
+        for ( int i = 0; i < 100; ++i ) {
+            v.push_back( i );
+        }
+        REQUIRE( v.size() == 100 );
+        REQUIRE( v[99] == 99 );
+        REQUIRE( arena.getUsedSize() >= 100 * sizeof( int ) );
+
+        VectorArray<Vector3, FrameAllocator<Vector3>> points( 4, Vector3::Ones(),
+                                                              FrameAllocator<Vector3>( arena ) );
+        REQUIRE( reinterpret_cast<std::uintptr_t>( points.data() ) % EIGEN_MAX_ALIGN_BYTES == 0 );
+        REQUIRE( points.getMap().sum() == 12_ra );
+    }
+
+    SECTION( "Thread arena" ) {
+        auto& arena = FrameArena::getThreadArena();
+        {
+            FrameVector<Scalar> v( 1000, 1_ra );
+            REQUIRE( arena.getUsedSize() >= 1000 * sizeof( Scalar ) );
+        }
+        // memory is released at the first access of the next frame
+        const auto frame = FrameArena::getFrame();
+        FrameArena::nextFrame();
+        REQUIRE( FrameArena::getFrame() == frame + 1 );
+        REQUIRE( FrameArena::getThreadArena().getUsedSize() == 0 );
+        REQUIRE( &FrameArena::getThreadArena() == &arena );
+    }
+}
@@ -1,9 +1,13 @@
 #include <Core/Geometry/DistanceQueries.hpp>
+#include <Core/Geometry/MeshBvh.hpp>
+#include <Core/Geometry/MeshPrimitives.hpp>
+#include <Core/Geometry/SignedDistanceField.hpp>
 #include <Core/Math/LinearAlgebra.hpp> // Math::getOrthogonalVectors
 #include <Core/Math/Math.hpp>          //  Math::areApproxEqual
 #include <Core/Types.hpp>
 #include <Eigen/Core>
 #include <catch2/catch_test_macros.hpp>
+#include <algorithm>
 #include <cmath>
 
 TEST_CASE( "Core/Geometry/DistanceQueries", "[unittests][Core][Core/Geometry][DistanceQueries]" ) {
@@ -146,3 +150,176 @@ TEST_CASE( "Core/Geometry/DistanceQueries", "[unittests][Core][Core/Geometry][Di
         REQUIRE( dg.flags == Geometry::FlagsInternal::HIT_FACE );
     }
 }
+
+TEST_CASE( "Core/Geometry/MeshBvh", "[unittests][Core][Core/Geometry][DistanceQueries]" ) {
+    using namespace Ra::Core;
+    using namespace Ra::Core::Geometry;
+
+    auto sphere = makeGeodesicSphere( 1_ra, 2 );
+    auto box    = makeBox();
+    const MeshBvh sphereBvh( sphere );
+    const MeshBvh boxBvh( box, 1 );
+
+    // brute force reference
+    auto bruteForce = []( const TriangleMesh& m1,
+                          const Transform& t1,
+                          const TriangleMesh& m2,
+                          const Transform& t2,
+                          Scalar epsilon,
+                          std::vector<TrianglePair>& pairs ) {
+        Scalar best = std::numeric_limits<Scalar>::max();
+        for ( uint i = 0; i < m1.getIndices().size(); ++i ) {
+            const auto& ti = m1.getIndices()[i];
+            const Vector3 a[3] = {
+                t1 * m1.vertices()[ti[0]], t1 * m1.vertices()[ti[1]], t1 * m1.vertices()[ti[2]] };
+            for ( uint j = 0; j < m2.getIndices().size(); ++j ) {
+                const auto& tj = m2.getIndices()[j];
+                const Vector3 b[3] = { t2 * m2.vertices()[tj[0]],
+                                       t2 * m2.vertices()[tj[1]],
+                                       t2 * m2.vertices()[tj[2]] };
+                const Scalar d     = triangleToTriSq( a, b ).sqrDistance;
+                best               = std::min( best, d );
+                if ( d <= epsilon * epsilon ) pairs.emplace_back( i, j );
+            }
+        }
+        return best;
+    };
+
+    SECTION( "Hierarchy" ) {
+        const auto& nodes = sphereBvh.getNodes();
+        REQUIRE( !nodes.empty() );
+        REQUIRE( nodes[0].m_count == int( sphere.getIndices().size() ) );
+        REQUIRE( nodes[0].m_aabb.isApprox( sphere.computeAabb() ) );
+        for ( const auto& n : nodes ) {
+            if ( n.isLeaf() ) { REQUIRE( n.m_count <= 4 ); }
+            else {
+                REQUIRE( nodes[n.m_left].m_count + nodes[n.m_right].m_count == n.m_count );
+                REQUIRE( n.m_aabb.contains( nodes[n.m_left].m_aabb ) );
+                REQUIRE( n.m_aabb.contains( nodes[n.m_right].m_aabb ) );
+            }
+        }
+    }
+
+    SECTION( "Inclusion" ) {
+        REQUIRE( sphereBvh.contains( Vector3::Zero() ) );
+        REQUIRE( sphereBvh.contains( Vector3 { 0.3_ra, -0.5_ra, 0.6_ra } ) );
+        REQUIRE( !sphereBvh.contains( Vector3 { 0.8_ra, 0.8_ra, 0_ra } ) );
+        REQUIRE( !sphereBvh.contains( Vector3 { -2_ra, 0_ra, 0_ra } ) );
+        REQUIRE( boxBvh.contains( Vector3 { 0.4_ra, 0.4_ra, -0.4_ra } ) );
+        REQUIRE( !boxBvh.contains( Vector3 { 0.6_ra, 0_ra, 0_ra } ) );
+    }
+
+    SECTION( "Distance" ) {
+        Transform t1 = Transform::Identity();
+        Transform t2 = Transform::Identity();
+        t2.translate( Vector3 { 3_ra, 0.2_ra, 0.1_ra } );
+        t2.rotate( AngleAxis( 0.3_ra, Vector3::UnitZ() ) );
+
+        std::vector<TrianglePair> pairs;
+        const Scalar ref = bruteForce( sphere, t1, box, t2, 0_ra, pairs );
+        const auto res   = meshToMeshSq( sphereBvh, t1, boxBvh, t2 );
+        REQUIRE( Math::areApproxEqual( res.sqrDistance, ref ) );
+        REQUIRE( Math::areApproxEqual( ( res.closestPoint[0] - res.closestPoint[1] ).squaredNorm(),
+                                       ref ) );
+        REQUIRE( !meshesIntersect( sphereBvh, t1, boxBvh, t2 ) );
+
+        // nothing closer than the bound
+        const auto far = meshToMeshSq( sphereBvh, t1, boxBvh, t2, 0.5_ra * ref );
+        REQUIRE( far.sqrDistance == std::numeric_limits<Scalar>::max() );
+    }
+
+    SECTION( "Contacts and intersection" ) {
+        Transform t1 = Transform::Identity();
+        Transform t2 = Transform::Identity();
+        t2.translate( Vector3 { 1.2_ra, 0_ra, 0_ra } );
+
+        const Scalar epsilon = 0.1_ra;
+        std::vector<TrianglePair> ref;
+        bruteForce( sphere, t1, box, t2, epsilon, ref );
+        std::sort( ref.begin(), ref.end() );
+        const auto pairs = meshPairsWithin( sphereBvh, t1, boxBvh, t2, epsilon );
+        REQUIRE( !pairs.empty() );
+        REQUIRE( pairs == ref );
+        REQUIRE( meshesIntersect( sphereBvh, t1, boxBvh, t2 ) );
+        REQUIRE( meshToMeshSq( sphereBvh, t1, boxBvh, t2 ).sqrDistance == 0_ra );
+
+        // box inside the sphere, without surface contact
+        t2 = Transform::Identity();
+        t2.scale( 0.5_ra );
+        REQUIRE( meshToMeshSq( sphereBvh, t1, boxBvh, t2 ).sqrDistance > 0_ra );
+        REQUIRE( meshesIntersect( sphereBvh, t1, boxBvh, t2 ) );
+        REQUIRE( meshesIntersect( boxBvh, t2, sphereBvh, t1 ) );
+    }
+
+    SECTION( "Refit" ) {
+        auto deformed = makeGeodesicSphere( 1_ra, 2 );
+        MeshBvh bvh( deformed );
+        auto& vertices = deformed.verticesWithLock();
+        for ( auto& v : vertices )
+            v.x() *= 3_ra;
+        deformed.verticesUnlock();
+        bvh.refit();
+        REQUIRE( bvh.getNodes()[0].m_aabb.isApprox( deformed.computeAabb() ) );
+
+        // box centered on the extremal vertex of the deformed sphere
+        Transform t2 = Transform::Identity();
+        t2.translate( *std::max_element(
+            deformed.vertices().begin(),
+            deformed.vertices().end(),
+            []( const Vector3& a, const Vector3& b ) { return a.x() < b.x(); } ) );
+        REQUIRE( bvh.getNodes()[0].m_aabb.max().x() > 2_ra );
+        REQUIRE( meshesIntersect( bvh, Transform::Identity(), boxBvh, t2 ) );
+        REQUIRE( !meshesIntersect( sphereBvh, Transform::Identity(), boxBvh, t2 ) );
+    }
+}
+
+TEST_CASE( "Core/Geometry/SignedDistanceField",
+           "[unittests][Core][Core/Geometry][SignedDistanceField]" ) {
+    using namespace Ra::Core;
+    using namespace Ra::Core::Geometry;
+
+    SECTION( "Box" ) {
+        // analytic distance to the box
+        auto boxDistance = []( const Vector3& p ) {
+            const Vector3 q = p.cwiseAbs() - Vector3::Constant( 0.5_ra );
+            return q.cwiseMax( 0_ra ).norm() + std::min( q.maxCoeff(), 0_ra );
+        };
+        const auto box = makeBox();
+        SignedDistanceField sdf( box, 0.05_ra, 4, 2 );
+        const auto& grid = sdf.getGrid();
+        REQUIRE( ( grid.size().array() > 0 ).all() );
+
+        // samples, at bin centers, are exact
+        const Vector3 half = 0.5_ra * grid.binSize();
+        for ( int k = 0; k < grid.size().z(); k += 2 )
+            for ( int j = 0; j < grid.size().y(); j += 2 )
+                for ( int i = 0; i < grid.size().x(); i += 2 ) {
+                    const Vector3 index { Scalar( i ), Scalar( j ), Scalar( k ) };
+                    const Vector3 v  = grid.binSize().cwiseProduct( index ) + half;
+                    const auto value = grid.getValue( v );
+                    REQUIRE( value );
+                    const Scalar expected = boxDistance( sdf.getGridToModel() * v );
+                    REQUIRE( std::abs( *value - expected ) < 1e-4_ra );
+                }
+
+        REQUIRE( *sdf.getDistance( Vector3::Zero() ) < -0.45_ra );
+        REQUIRE( std::abs( *sdf.getDistance( Vector3 { 0.6_ra, 0.1_ra, 0_ra } ) - 0.1_ra ) <
+                 0.01_ra );
+        REQUIRE( !sdf.getDistance( Vector3 { 10_ra, 0_ra, 0_ra } ) );
+    }
+
+    SECTION( "Sphere" ) {
+        const auto sphere = makeGeodesicSphere( 1_ra, 4 );
+        SignedDistanceField sdf( sphere, 0.1_ra, 3, 1 );
+        for ( Scalar r : { 0_ra, 0.3_ra, 0.8_ra, 1.2_ra } ) {
+            for ( const auto& dir : { Vector3 { 1_ra, 0_ra, 0_ra },
+                                      Vector3 { 0_ra, -1_ra, 0_ra },
+                                      Vector3 { 1_ra, 1_ra, 1_ra }.normalized() } ) {
+                const auto d = sdf.getDistance( r * dir );
+                REQUIRE( d );
+                // interpolation and mesh approximation error
+                REQUIRE( std::abs( *d - ( r - 1_ra ) ) < 0.06_ra );
+            }
+        }
+    }
+}
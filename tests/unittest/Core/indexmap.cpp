@@ -1,7 +1,14 @@
 #include <Core/Utils/IndexMap.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
 #include <catch2/catch_test_macros.hpp>
 #include <unittestUtils.hpp>
 
+#include <algorithm>
+#include <deque>
+#include <numeric>
+#include <random>
+#include <vector>
+
 using Ra::Core::Utils::Index;
 using Ra::Core::Utils::IndexMap;
 
@@ -121,6 +128,61 @@ TEST_CASE( "Core/Utils/IndexMap", "[unittests][Core][Core/Utils][IndexMap]" ) {
         map2.clear();
         REQUIRE( map2.size() == 0 );
         REQUIRE( map2.empty() );
+        REQUIRE( !map2.contains( i1 ) );
+        REQUIRE( !map2.contains( i2 ) );
+    }
+
+    SECTION( "Test stale indices" ) {
+        IndexMap<Foo> map1;
+        Index i0 = map1.insert( Foo( 0 ) );
+        Index i1 = map1.insert( Foo( 1 ) );
+        Index i2 = map1.insert( Foo( 2 ) );
+        // indices of a new map are consecutive
+        REQUIRE( i0 == Index( 0 ) );
+        REQUIRE( i1 == Index( 1 ) );
+        REQUIRE( i2 == Index( 2 ) );
+
+        // removal moves the last object, which keeps its index
+        REQUIRE( map1.remove( i0 ) );
+        REQUIRE( map1.size() == 2 );
+        REQUIRE( map1[i1].value == 1 );
+        REQUIRE( map1[i2].value == 2 );
+        REQUIRE( map1.index( 0 ) == i2 );
+        REQUIRE( map1.index( 1 ) == i1 );
+        REQUIRE( map1.index( 2 ).isInvalid() );
+
+        // the slot of i0 is reused, with another index
+        Index i3 = map1.insert( Foo( 3 ) );
+        REQUIRE( i3.isValid() );
+        REQUIRE( i3 != i0 );
+        REQUIRE( !map1.contains( i0 ) );
+        REQUIRE( !map1.remove( i0 ) );
+        REQUIRE( map1[i3].value == 3 );
+        REQUIRE( map1.size() == 3 );
+
+        // objects and indices stay consistent under many insertions and removals
+        std::vector<Index> indices { i1, i2, i3 };
+        std::vector<Index> removed { i0 };
+        for ( int i = 4; i < 1000; ++i ) {
+            indices.push_back( map1.insert( Foo( i ) ) );
+            if ( i % 3 == 0 ) {
+                const size_t k = size_t( i * 7 ) % indices.size();
+                REQUIRE( map1.remove( indices[k] ) );
+                removed.push_back( indices[k] );
+                indices.erase( indices.begin() + k );
+            }
+        }
+        REQUIRE( map1.size() == indices.size() );
+        for ( const auto& idx : removed ) {
+            REQUIRE( !map1.contains( idx ) );
+        }
+        for ( const auto& idx : indices ) {
+            REQUIRE( map1.contains( idx ) );
+        }
+        for ( uint i = 0; i < map1.size(); ++i ) {
+            REQUIRE( map1.contains( map1.index( i ) ) );
+            REQUIRE( &map1[map1.index( i )] == &*( map1.begin() + i ) );
+        }
     }
 }
 
@@ -162,3 +224,98 @@ TEST_CASE( "Core/Utils/Index/Ctor", "[unittests][Core][Core/Utils][Index]" ) {
     testType<unsigned int>();
     testType<size_t>();
 }
+
+namespace {
+// The IndexMap before it was a slot map, kept as reference for the benchmark: the objects and
+// their sorted indices are stored in deques, and indices are searched linearly.
+template <typename T>
+class DequeIndexMap
+{
+  public:
+    Index insert( const T& obj ) {
+        Index idx = m_free.front();
+        m_free.pop_front();
+        if ( m_free.empty() ) { m_free.push_back( idx + 1 ); }
+        auto it = std::lower_bound( m_index.begin(), m_index.end(), idx );
+        m_data.insert( m_data.begin() + ( it - m_index.begin() ), obj );
+        m_index.insert( it, idx );
+        return idx;
+    }
+
+    bool remove( const Index& idx ) {
+        auto it = std::find( m_index.begin(), m_index.end(), idx );
+        if ( it == m_index.end() ) { return false; }
+        m_data.erase( m_data.begin() + ( it - m_index.begin() ) );
+        m_index.erase( it );
+        m_free.insert( std::lower_bound( m_free.begin(), m_free.end(), idx ), idx );
+        return true;
+    }
+
+    T& operator[]( const Index& idx ) {
+        auto it = std::find( m_index.begin(), m_index.end(), idx );
+        return m_data[size_t( it - m_index.begin() )];
+    }
+
+    typename std::deque<T>::const_iterator begin() const { return m_data.begin(); }
+    typename std::deque<T>::const_iterator end() const { return m_data.end(); }
+
+  private:
+    std::deque<T> m_data;
+    std::deque<Index> m_index;
+    std::deque<Index> m_free { Index( 0 ) };
+};
+
+// Runs the benchmarks of the insertion, removal, lookup and iteration of n objects in a Map,
+// removed and looked up in random order.
+template <typename Map>
+void benchmarkIndexMap( const std::string& name, int n ) {
+    std::vector<Index> indices;
+    Map filled;
+    for ( int i = 0; i < n; ++i ) {
+        indices.push_back( filled.insert( Foo( i ) ) );
+    }
+    std::shuffle( indices.begin(), indices.end(), std::mt19937( 42 ) );
+
+    BENCHMARK( name + " insert" ) {
+        Map map;
+        for ( int i = 0; i < n; ++i ) {
+            map.insert( Foo( i ) );
+        }
+        return map;
+    };
+
+    BENCHMARK_ADVANCED( name + " remove" )( Catch::Benchmark::Chronometer meter ) {
+        std::vector<Map> maps( size_t( meter.runs() ), filled );
+        meter.measure( [&maps, &indices]( int run ) {
+            for ( const auto& idx : indices ) {
+                maps[size_t( run )].remove( idx );
+            }
+        } );
+    };
+
+    BENCHMARK( name + " lookup" ) {
+        int sum = 0;
+        for ( const auto& idx : indices ) {
+            sum += filled[idx].value;
+        }
+        return sum;
+    };
+
+    // removing half of the objects fragments the slot map
+    for ( size_t i = 0; i < indices.size(); i += 2 ) {
+        filled.remove( indices[i] );
+    }
+    BENCHMARK( name + " iterate" ) {
+        return std::accumulate( filled.begin(), filled.end(), 0, []( int sum, const Foo& f ) {
+            return sum + f.value;
+        } );
+    };
+}
+} // namespace
+
+TEST_CASE( "Core/Utils/IndexMap/Benchmark", "[.][benchmark][Core][Core/Utils][IndexMap]" ) {
+    for ( int n : { 100, 10000 } ) {
+        benchmarkIndexMap<IndexMap<Foo>>( "IndexMap " + std::to_string( n ), n );
+        benchmarkIndexMap<DequeIndexMap<Foo>>( "deque IndexMap " + std::to_string( n ), n );
+    }
+}
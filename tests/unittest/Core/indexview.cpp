@@ -1,6 +1,7 @@
 #include <Core/Geometry/IndexedGeometry.hpp>
 #include <Core/Geometry/MeshPrimitives.hpp>
 #include <Core/Geometry/StandardAttribNames.hpp>
+#include <Core/Utils/MemoryAccounting.hpp>
 #include <catch2/catch_test_macros.hpp>
 
 struct CustomTriangleIndexLayer : public Ra::Core::Geometry::TriangleIndexLayer {
@@ -315,3 +316,81 @@ TEST_CASE( "Core/Geometry/IndexedGeometry/CopyAllAttributes",
     m3.getAttribBase( "vector5_attrib" )->setName( "better" );
     REQUIRE( m3.getAttrib( handleM3 ).getName() == "better" );
 }
+
+TEST_CASE( "Core/Geometry/IndexedGeometry/NotificationBatch",
+           "[unittests][Core][Core/Geometry][IndexedGeometry]" ) {
+    using namespace Ra::Core::Geometry;
+
+    MultiIndexedGeometry geo( Ra::Core::Geometry::makeBox() );
+    int geometryCount = 0;
+    int positionCount = 0;
+    geo.attach( [&geometryCount]() { ++geometryCount; } );
+    auto h_pos = geo.getAttribHandle<Ra::Core::Vector3>( getAttribName( VERTEX_POSITION ) );
+    geo.getAttrib( h_pos ).attach( [&positionCount]() { ++positionCount; } );
+
+    {
+        auto batch = geo.getScopedNotificationBatch();
+        auto pil   = std::make_unique<PointCloudIndexLayer>();
+        pil->linearIndices( geo );
+        auto key = std::make_pair( pil->semantics(), std::string {} );
+        geo.addLayer( std::move( pil ) );
+        geo.getLayerWithLock( key );
+        geo.unlockLayer( key );
+        for ( int i = 0; i < 3; ++i ) {
+            geo.getAttrib( h_pos ).getDataWithLock();
+            geo.getAttrib( h_pos ).unlock();
+        }
+        REQUIRE( geometryCount == 0 );
+        REQUIRE( positionCount == 0 );
+    }
+    REQUIRE( geometryCount == 1 );
+    REQUIRE( positionCount == 1 );
+}
+
+TEST_CASE( "Core/Geometry/IndexedGeometry/MemoryAccounting",
+           "[unittests][Core][Core/Geometry][IndexedGeometry]" ) {
+    using namespace Ra::Core::Geometry;
+    using namespace Ra::Core::Utils;
+    const auto cpu    = MemoryCategory::CpuAttributes;
+    const auto copies = MemoryCategory::MeshCopies;
+
+    const auto before = MemoryAccounting::getUsage();
+    {
+        TriangleMesh mesh = makeBox();
+        const size_t indicesSize =
+            mesh.getIndices().capacity() * sizeof( TriangleMesh::IndexType );
+        MemoryUsage usage;
+        mesh.addMemoryUsage( usage );
+        REQUIRE( indicesSize > 0 );
+        REQUIRE( usage[cpu] == mesh.vertexAttribs().getMemorySize() + indicesSize );
+        REQUIRE( MemoryAccounting::getUsage()[cpu] == before[cpu] + usage[cpu] );
+
+        // a copy accounts its indices, and moves them with its attributes
+        TriangleMesh copy( mesh );
+        copy.setMemoryCategory( copies );
+        MemoryUsage copyUsage;
+        copy.addMemoryUsage( copyUsage );
+        REQUIRE( copyUsage[cpu] == 0 );
+        REQUIRE( copyUsage[copies] == usage[cpu] );
+        REQUIRE( MemoryAccounting::getUsage()[copies] == before[copies] + usage[cpu] );
+
+        // layers added to the copy are accounted in its category
+        auto pil = std::make_unique<PointCloudIndexLayer>();
+        pil->linearIndices( copy );
+        const size_t layerSize = pil->getMemorySize();
+        copy.addLayer( std::move( pil ) );
+        REQUIRE( MemoryAccounting::getUsage()[copies] ==
+                 before[copies] + usage[cpu] + layerSize );
+
+        // replaced indices are accounted
+        copy.setIndices( TriangleMesh::IndexContainerType( 100 ) );
+        copyUsage = {};
+        copy.addMemoryUsage( copyUsage );
+        REQUIRE( copyUsage[copies] == copy.vertexAttribs().getMemorySize() + layerSize +
+                                          copy.getIndices().capacity() *
+                                              sizeof( TriangleMesh::IndexType ) );
+        REQUIRE( MemoryAccounting::getUsage()[copies] == before[copies] + copyUsage[copies] );
+    }
+    REQUIRE( MemoryAccounting::getUsage()[cpu] == before[cpu] );
+    REQUIRE( MemoryAccounting::getUsage()[copies] == before[copies] );
+}
@@ -0,0 +1,105 @@
+#include <Core/Utils/Log.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <csignal>
+#include <cstdio>
+#include <iomanip>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifndef OS_WINDOWS
+#    include <sys/wait.h>
+#    include <unistd.h>
+#endif
+
+using namespace Ra::Core::Utils;
+
+namespace {
+/// Return the content of \p file, from its beginning.
+std::string readAll( FILE* file ) {
+    std::fflush( file );
+    std::rewind( file );
+    std::string content;
+    char buffer[256];
+    size_t n;
+    while ( ( n = std::fread( buffer, 1, sizeof( buffer ), file ) ) > 0 ) {
+        content.append( buffer, n );
+    }
+    return content;
+}
+} // namespace
+
+TEST_CASE( "Core/Utils/Log", "[unittests][Core][Core/Utils][Log]" ) {
+    FILE* file = std::tmpfile();
+    REQUIRE( file != nullptr );
+    FILE* previous        = Output2FILE::Stream();
+    Output2FILE::Stream() = file;
+
+    SECTION( "Synchronous output" ) {
+        REQUIRE( !AsyncLog::IsRunning() );
+        LOG( logWARNING ) << "value " << std::hex << 255;
+        // formatting flags do not leak to the next message
+        LOG( logWARNING ) << 255;
+        const auto content = readAll( file );
+        REQUIRE( content.find( "WARNING: value ff\n" ) != std::string::npos );
+        REQUIRE( content.find( "WARNING: 255\n" ) != std::string::npos );
+        REQUIRE( content.rfind( "- ", 0 ) == 0 );
+    }
+
+    SECTION( "Asynchronous output" ) {
+        // small buffers, so that producers have to wait for the writer
+        AsyncLog::Start( 1024 );
+        REQUIRE( AsyncLog::IsRunning() );
+        const int threadCount  = 4;
+        const int messageCount = 200;
+        std::vector<std::thread> threads;
+        for ( int t = 0; t < threadCount; ++t ) {
+            threads.emplace_back( [t]() {
+                for ( int i = 0; i < messageCount; ++i ) {
+                    LOG( logINFO ) << "thread " << t << " message " << i;
+                }
+            } );
+        }
+        for ( auto& thread : threads ) {
+            thread.join();
+        }
+        // messages larger than the buffers are written synchronously
+        LOG( logERROR ) << std::string( 2000, 'x' );
+        AsyncLog::Flush();
+        auto content = readAll( file );
+        REQUIRE( std::count( content.begin(), content.end(), '\n' ) ==
+                 threadCount * messageCount + 1 );
+        REQUIRE( content.find( "INFO: thread 3 message 199\n" ) != std::string::npos );
+
+        AsyncLog::Stop();
+        REQUIRE( !AsyncLog::IsRunning() );
+        LOG( logINFO ) << "stopped";
+        content = readAll( file );
+        REQUIRE( content.find( "INFO: stopped\n" ) != std::string::npos );
+    }
+
+#if !defined( OS_WINDOWS ) && defined( SIGTRAP )
+    SECTION( "Crash output" ) {
+        const pid_t pid = fork();
+        REQUIRE( pid >= 0 );
+        if ( pid == 0 ) {
+            AsyncLog::Start();
+            LOG( logERROR ) << "before crash";
+            std::raise( SIGTRAP );
+            _exit( 0 );
+        }
+        int status = 0;
+        REQUIRE( waitpid( pid, &status, 0 ) == pid );
+        // the signal is forwarded once the pending messages are written
+        REQUIRE( WIFSIGNALED( status ) );
+        REQUIRE( WTERMSIG( status ) == SIGTRAP );
+        const auto content = readAll( file );
+        REQUIRE( content.find( "ERROR: before crash\n" ) != std::string::npos );
+    }
+#endif
+
+    Output2FILE::Stream() = previous;
+    std::fclose( file );
+}
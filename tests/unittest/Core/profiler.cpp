@@ -0,0 +1,83 @@
+#include <Core/Utils/Profiler.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <chrono>
+#include <sstream>
+#include <thread>
+
+using namespace Ra::Core::Utils;
+
+TEST_CASE( "Core/Utils/Profiler", "[unittests][Core][Core/Utils][Profiler]" ) {
+    Profiler::setWindowSize( 10 );
+    Profiler::setEnabled( false );
+    {
+        // zones opened while disabled are ignored
+        ScopedProfileZone zone( "disabled" );
+    }
+    Profiler::nextFrame();
+    REQUIRE( Profiler::getStats().empty() );
+
+    Profiler::setEnabled( true );
+    const auto work = []( int ms ) {
+        ScopedProfileZone zone( "work" );
+        std::this_thread::sleep_for( std::chrono::milliseconds( ms ) );
+    };
+    for ( int frame = 0; frame < 20; ++frame ) {
+        ScopedProfileZone zone( "frame" );
+        // last frame is slower
+        work( frame == 19 ? 10 : 1 );
+        work( 1 );
+        std::thread( [&work]() { work( 1 ); } ).join();
+    }
+    // frame totals are pushed at each frame end, here only once for all the frames
+    Profiler::nextFrame();
+    auto stats = Profiler::getStats();
+    REQUIRE( stats.size() == 3 );
+    REQUIRE( stats[0].m_name == "frame" );
+    REQUIRE( stats[0].m_parent == -1 );
+    REQUIRE( stats[0].m_frameCount == 1 );
+    REQUIRE( stats[0].m_callsPerFrame == 20. );
+    // same name, different parents give different zones, in depth-first order
+    REQUIRE( stats[1].m_name == "work" );
+    REQUIRE( stats[1].m_parent == 0 );
+    REQUIRE( stats[1].m_depth == 1 );
+    REQUIRE( stats[1].m_callsPerFrame == 40. );
+    REQUIRE( stats[1].m_mean >= 49. );
+    REQUIRE( stats[0].m_mean >= stats[1].m_mean );
+    REQUIRE( stats[2].m_name == "work" );
+    REQUIRE( stats[2].m_parent == -1 );
+    REQUIRE( stats[2].m_callsPerFrame == 20. );
+
+    // rolling window over the last frames
+    Profiler::reset();
+    for ( int frame = 0; frame < 15; ++frame ) {
+        work( frame == 14 ? 10 : 1 );
+        Profiler::nextFrame();
+    }
+    stats = Profiler::getStats();
+    REQUIRE( stats.size() == 1 );
+    REQUIRE( stats[0].m_frameCount == 10 );
+    REQUIRE( stats[0].m_p50 < 10. );
+    REQUIRE( stats[0].m_p50 <= stats[0].m_p95 );
+    REQUIRE( stats[0].m_p95 <= stats[0].m_p99 );
+    REQUIRE( stats[0].m_p99 == stats[0].m_max );
+    REQUIRE( stats[0].m_max >= 10. );
+
+    std::ostringstream out;
+    Profiler::printStats( out );
+    REQUIRE( out.str().find( "work" ) != std::string::npos );
+    REQUIRE( out.str().find( "p99" ) != std::string::npos );
+
+    // names built at runtime
+    const std::string name = "runtime " + std::to_string( 1 );
+    const char* interned   = Profiler::internName( name );
+    REQUIRE( std::string( interned ) == name );
+    REQUIRE( Profiler::internName( "runtime 1" ) == interned );
+    REQUIRE( Profiler::internName( "runtime 2" ) != interned );
+
+    // unnamed zones are not opened
+    REQUIRE( !Profiler::beginZone( nullptr ) );
+
+    Profiler::setEnabled( false );
+    Profiler::reset();
+}
@@ -2,6 +2,7 @@
 #include <unittestUtils.hpp>
 
 #include <Core/Random/RandomPointSet.hpp>
+#include <Core/Random/SurfaceSampler.hpp>
 using namespace Ra::Core::Random;
 
 #define CHECK_SEQ1                                     \
@@ -93,3 +94,87 @@ TEST_CASE( "Core/Random/RandomPointSet", "[unittests][Core][Core/Random][PointSe
         CHECK_SEQ2
     }
 }
+
+TEST_CASE( "Core/Random/SurfaceSampler", "[unittests][Core][Core/Random][SurfaceSampler]" ) {
+    using Ra::Core::Vector3;
+    using Ra::Core::Vector4;
+    using namespace Ra::Core::Geometry;
+
+    // a 2x1 rectangle in the z=0 plane, with a small and a large triangle
+    TriangleMesh mesh;
+    mesh.setVertices( { { 0_ra, 0_ra, 0_ra },
+                        { 0.5_ra, 0_ra, 0_ra },
+                        { 2_ra, 0_ra, 0_ra },
+                        { 2_ra, 1_ra, 0_ra },
+                        { 0_ra, 1_ra, 0_ra } } );
+    mesh.setNormals( Ra::Core::Vector3Array( 5, Vector3::UnitZ() ) );
+    mesh.addAttrib<Vector4>( getAttribName( VERTEX_COLOR ),
+                             Ra::Core::Vector4Array { { 0_ra, 0_ra, 0_ra, 1_ra },
+                                                      { 0.5_ra, 0_ra, 0_ra, 1_ra },
+                                                      { 2_ra, 0_ra, 0_ra, 1_ra },
+                                                      { 2_ra, 1_ra, 0_ra, 1_ra },
+                                                      { 0_ra, 1_ra, 0_ra, 1_ra } } );
+    mesh.setIndices( { { 0, 1, 4 }, { 1, 2, 3 }, { 1, 3, 4 } } );
+
+    SurfaceSampler sampler( mesh );
+    REQUIRE( isApprox( sampler.getArea(), 2_ra ) );
+
+    SECTION( "Alias table" ) {
+        AliasTable table( { 1_ra, 0_ra, 3_ra } );
+        REQUIRE( table.size() == 3 );
+        std::array<size_t, 3> count { 0, 0, 0 };
+        const size_t n = 300;
+        for ( size_t i = 0; i < n; ++i ) {
+            ++count[table.sample( ( Scalar( i ) + 0.5_ra ) / Scalar( n ),
+                                  Scalar( ( i * 7 ) % n ) / Scalar( n ) )];
+        }
+        REQUIRE( count[1] == 0 );
+        REQUIRE( count[0] + count[2] == n );
+        REQUIRE( count[2] > 2 * count[0] );
+    }
+
+    SECTION( "Uniform sampling" ) {
+        const size_t n = 20000;
+        auto samples   = sampler.sampleUniform( n, 42 );
+        REQUIRE( samples.size() == n );
+        // same seed, same samples
+        auto samples2 = sampler.sampleUniform( n, 42 );
+        REQUIRE( samples2[n - 1].m_position == samples[n - 1].m_position );
+
+        // area proportional: the small triangle covers 1/8 of the surface
+        size_t inSmall = 0;
+        for ( const auto& s : samples ) {
+            REQUIRE( isApprox( s.m_barycentric.sum(), 1_ra ) );
+            REQUIRE( ( s.m_barycentric.array() >= 0_ra ).all() );
+            REQUIRE( s.m_position.z() == 0_ra );
+            if ( s.m_triangle == 0 ) ++inSmall;
+        }
+        REQUIRE( std::abs( Scalar( inSmall ) / Scalar( n ) - 0.125_ra ) < 0.02_ra );
+
+        // attributes are interpolated, here colors equal positions
+        auto cloud        = sampler.toPointCloud( samples );
+        const auto& color = cloud.getAttrib<Vector4>( getAttribName( VERTEX_COLOR ) ).data();
+        REQUIRE( cloud.vertices().size() == n );
+        REQUIRE( color.size() == n );
+        for ( size_t i = 0; i < n; i += 97 ) {
+            REQUIRE( color[i].head<3>().isApprox( samples[i].m_position ) );
+            REQUIRE( cloud.normals()[i].isApprox( Vector3::UnitZ() ) );
+        }
+    }
+
+    SECTION( "Poisson disk sampling" ) {
+        const Scalar r = 0.05_ra;
+        auto samples   = sampler.samplePoissonDisk( r, 3 );
+        REQUIRE( !samples.empty() );
+        Scalar minDist = std::numeric_limits<Scalar>::max();
+        for ( size_t i = 0; i < samples.size(); ++i ) {
+            for ( size_t j = i + 1; j < samples.size(); ++j ) {
+                minDist = std::min( minDist,
+                                    ( samples[i].m_position - samples[j].m_position ).norm() );
+            }
+        }
+        REQUIRE( minDist >= r );
+        // a maximal distribution has more than half of the hexagonal packing density
+        REQUIRE( Scalar( samples.size() ) > 0.5_ra * 2_ra / ( std::sqrt( 3_ra ) / 2 * r * r ) );
+    }
+}
@@ -1,7 +1,12 @@
+#include <Core/Containers/FrameArena.hpp>
+#include <Core/Geometry/MeshPrimitives.hpp>
 #include <Core/Geometry/RayCast.hpp>
+#include <Core/Geometry/TriangleMesh.hpp>
 #include <Core/Math/Math.hpp>
 #include <catch2/catch_test_macros.hpp>
 
+#include <algorithm>
+
 TEST_CASE( "Core/Geometry/RayCast", "[unittests][Core][Core/Geometry][RayCast]" ) {
     using namespace Ra::Core;
     Aabb ones( -Vector3::Ones(), Vector3::Ones() );
@@ -69,3 +74,30 @@ TEST_CASE( "Core/Geometry/RayCast", "[unittests][Core][Core/Geometry][RayCast]"
         }
     }
 }
+
+TEST_CASE( "Core/Geometry/RayCastTriangleMesh", "[unittests][Core][Core/Geometry][RayCast]" ) {
+    using namespace Ra::Core;
+    const auto box = Geometry::makeBox();
+    const Ray ray( Vector3 { 0_ra, 0_ra, -2_ra }, Vector3::UnitZ() );
+
+    std::vector<Scalar> hits;
+    std::vector<Vector3ui> triangles;
+    REQUIRE( Geometry::RayCastTriangleMesh( ray, box, hits, triangles ) );
+
+    // same hits, stored in the frame arena
+    auto& arena           = FrameArena::getThreadArena();
+    const size_t usedSize = arena.getUsedSize();
+    {
+        FrameVector<Scalar> frameHits;
+        FrameVector<Vector3ui> frameTriangles;
+        REQUIRE( Geometry::RayCastTriangleMesh( ray, box, frameHits, frameTriangles ) );
+        REQUIRE( std::equal( hits.begin(), hits.end(), frameHits.begin(), frameHits.end() ) );
+        REQUIRE( frameTriangles.size() == triangles.size() );
+        REQUIRE( arena.getUsedSize() > usedSize );
+    }
+
+    // the ray enters at z = -0.5 and leaves at z = 0.5
+    std::sort( hits.begin(), hits.end() );
+    REQUIRE( Math::areApproxEqual( hits.front(), 1.5_ra ) );
+    REQUIRE( Math::areApproxEqual( hits.back(), 2.5_ra ) );
+}
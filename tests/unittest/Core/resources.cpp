@@ -45,6 +45,13 @@ TEST_CASE( "Core/Resources", "[unittests][Core]" ) {
     popDataPath();
     currentDataPath = getDataPath();
     REQUIRE( currentDataPath == fs::current_path().string() );
+
+    setCachePath( "data/tmp/cache/" );
+    REQUIRE( getCachePath() == "data/tmp/cache/" );
+    REQUIRE( fs::is_directory( "data/tmp/cache/" ) );
+    setCachePath( "" );
+    REQUIRE( fs::path( getCachePath() ).filename() == "Radium" );
+    fs::remove( "data/tmp/cache/" );
     fs::remove( "data/tmp/foo/" );
     fs::remove( "data/tmp/bar/" );
     fs::remove( "data/tmp/" );
@@ -1,7 +1,9 @@
 #include <Core/Tasks/Task.hpp>
 #include <Core/Tasks/TaskQueue.hpp>
 #include <Core/Utils/Index.hpp>
+#include <Core/Utils/Profiler.hpp>
 #include <catch2/catch_test_macros.hpp>
+#include <algorithm>
 #include <chrono>
 #include <memory>
 #include <sstream>
@@ -193,3 +195,34 @@ TEST_CASE( "Core/TaskQueue", "[unittests][Core][TaskQueue]" ) {
         REQUIRE( array[6] == -1 ); // task 6 removed
     }
 }
+
+#ifdef RA_ENABLE_PROFILER
+TEST_CASE( "Core/TaskQueue/Profiler", "[unittests][Core][TaskQueue]" ) {
+    using Ra::Core::Utils::Profiler;
+    Profiler::setEnabled( true );
+    Profiler::reset();
+    TaskQueue taskQueue( 2 );
+    for ( int i = 0; i < 4; ++i ) {
+        taskQueue.registerTask( std::make_unique<FunctionTask>(
+            []() { std::this_thread::sleep_for( std::chrono::milliseconds( 1 ) ); },
+            "profiled task" ) );
+    }
+    taskQueue.startTasks();
+    taskQueue.waitForTasks();
+    taskQueue.flushTaskQueue();
+    Profiler::nextFrame();
+
+    // the tasks run by the workers have a zone named after them
+    const auto stats = Profiler::getStats();
+    auto it          = std::find_if( stats.begin(), stats.end(), []( const auto& zone ) {
+        return zone.m_name == "profiled task";
+    } );
+    REQUIRE( it != stats.end() );
+    REQUIRE( it->m_parent == -1 );
+    REQUIRE( it->m_callsPerFrame == 4. );
+    REQUIRE( it->m_mean >= 4. );
+
+    Profiler::setEnabled( false );
+    Profiler::reset();
+}
+#endif
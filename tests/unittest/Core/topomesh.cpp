@@ -1,11 +1,16 @@
 #include <Core/Geometry/MeshPrimitives.hpp>
+#include <Core/Geometry/NormalStencil.hpp>
 #include <Core/Geometry/StandardAttribNames.hpp>
 #include <Core/Geometry/TopologicalMesh.hpp>
 #include <Core/Geometry/TriangleMesh.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
 #include <catch2/catch_test_macros.hpp>
 
 #include <OpenMesh/Tools/Subdivider/Uniform/CatmullClarkT.hh>
 
+#include <algorithm>
+#include <set>
+
 using namespace Ra::Core;
 using namespace Ra::Core::Utils;
 using namespace Ra::Core::Geometry;
@@ -1313,3 +1318,235 @@ TEST_CASE( "Core/Geometry/TopologicalMesh/Updates",
         testConverter( Ra::Core::Geometry::makePlaneGrid( 2, 2 ) );
     }
 }
+
+TEST_CASE( "Core/Geometry/NormalStencil", "[unittests][Core][Core/Geometry][NormalStencil]" ) {
+    using Ra::Core::Vector3;
+    using Ra::Core::Vector3Array;
+    using Ra::Core::Geometry::NormalStencil;
+    using Ra::Core::Geometry::TopologicalMesh;
+    using Ra::Core::Geometry::TriangleMesh;
+
+    auto requireEqual = []( const Vector3Array& a, const Vector3Array& b ) {
+        REQUIRE( a.size() == b.size() );
+        for ( size_t i = 0; i < a.size(); ++i ) {
+            REQUIRE( a[i].isApprox( b[i] ) );
+        }
+    };
+
+    SECTION( "Stencils" ) {
+        // sharp box: 4 vertices per face, one per face at each corner
+        auto box = Ra::Core::Geometry::makeSharpBox();
+        NormalStencil sharp( box.vertices(), box.getIndices(), box.normals() );
+        // a face vertex only sees the triangles of its face
+        for ( uint v = 0; v < box.vertices().size(); ++v ) {
+            auto [begin, end] = sharp.getStencil( v );
+            REQUIRE( end > begin );
+            REQUIRE( end - begin <= 2 );
+        }
+        Vector3Array normals( box.vertices().size() );
+        sharp.computeNormals( box.vertices(), normals );
+        requireEqual( normals, box.normals() );
+
+        // without reference normals, duplicated vertices are not merged either
+        NormalStencil noMerge( box.vertices(), box.getIndices() );
+        noMerge.computeNormals( box.vertices(), normals );
+        requireEqual( normals, box.normals() );
+    }
+
+    SECTION( "Weighting" ) {
+        // all the weightings give the plane normal on a planar grid
+        auto grid = Ra::Core::Geometry::makePlaneGrid( 2, 2 );
+        Vector3Array positions = grid.vertices();
+        Vector3Array normals( positions.size() );
+        for ( auto weighting : { NormalStencil::Weighting::UNIFORM,
+                                 NormalStencil::Weighting::AREA,
+                                 NormalStencil::Weighting::ANGLE } ) {
+            NormalStencil stencil( positions, grid.getIndices(), grid.normals(), weighting );
+            REQUIRE( stencil.getWeighting() == weighting );
+            stencil.computeNormals( positions, normals );
+            requireEqual( normals, grid.normals() );
+        }
+
+        // a single fan of two triangles with different areas and angles
+        Vector3Array fan { Vector3( 0_ra, 0_ra, 0_ra ),
+                           Vector3( 1_ra, 0_ra, 0_ra ),
+                           Vector3( 0_ra, 1_ra, 0_ra ),
+                           Vector3( 0_ra, 0_ra, 2_ra ) };
+        Ra::Core::VectorArray<Ra::Core::Vector3ui> triangles {
+            Ra::Core::Vector3ui( 0, 1, 2 ), Ra::Core::Vector3ui( 0, 3, 1 ) };
+        Vector3Array fanNormals( fan.size() );
+        NormalStencil uniform( fan, triangles, {}, NormalStencil::Weighting::UNIFORM );
+        uniform.computeNormals( fan, fanNormals );
+        REQUIRE( fanNormals[0].isApprox( Vector3( 0_ra, 1_ra, 1_ra ).normalized() ) );
+        NormalStencil area( fan, triangles, {}, NormalStencil::Weighting::AREA );
+        area.computeNormals( fan, fanNormals );
+        REQUIRE( fanNormals[0].isApprox( Vector3( 0_ra, 2_ra, 1_ra ).normalized() ) );
+        NormalStencil angle( fan, triangles, {}, NormalStencil::Weighting::ANGLE );
+        angle.computeNormals( fan, fanNormals );
+        // both corners at vertex 0 are right angles
+        REQUIRE( fanNormals[0].isApprox( Vector3( 0_ra, 1_ra, 1_ra ).normalized() ) );
+        // vertex 1 corner angles are pi/4 and atan(2)
+        const Scalar a1 = Ra::Core::Math::Pi / 4_ra;
+        const Scalar a2 = std::atan( 2_ra );
+        REQUIRE( fanNormals[1].isApprox( Vector3( 0_ra, a2, a1 ).normalized() ) );
+    }
+
+    SECTION( "Incremental update" ) {
+        auto sphere = Ra::Core::Geometry::makeGeodesicSphere( 1_ra, 2 );
+        NormalStencil stencil( sphere.vertices(), sphere.getIndices(), sphere.normals() );
+        Vector3Array positions = sphere.vertices();
+        Vector3Array normals( positions.size() );
+        stencil.computeNormals( positions, normals );
+        const Vector3Array initial = normals;
+
+        // move a single vertex
+        std::vector<bool> moved( positions.size(), false );
+        moved[0] = true;
+        positions[0] *= 1.5_ra;
+        const size_t count = stencil.computeNormals( positions, moved, normals );
+        REQUIRE( count > 1 );
+        REQUIRE( count < positions.size() );
+
+        Vector3Array reference( positions.size() );
+        NormalStencil full( sphere.vertices(), sphere.getIndices(), sphere.normals() );
+        full.computeNormals( positions, reference );
+        requireEqual( normals, reference );
+        for ( uint v = 0; v < positions.size(); ++v ) {
+            if ( !stencil.wasUpdated( v ) ) { REQUIRE( normals[v] == initial[v] ); }
+        }
+
+        std::fill( moved.begin(), moved.end(), false );
+        REQUIRE( stencil.computeNormals( positions, moved, normals ) == 0 );
+    }
+
+    SECTION( "Consistency with TopologicalMesh" ) {
+        for ( auto mesh : { Ra::Core::Geometry::makeBox(),
+                            Ra::Core::Geometry::makeSharpBox(),
+                            Ra::Core::Geometry::makeGeodesicSphere( 1_ra, 2 ) } ) {
+            TopologicalMesh topo( mesh );
+            NormalStencil stencil( mesh.vertices(),
+                                   mesh.getIndices(),
+                                   mesh.normals(),
+                                   NormalStencil::Weighting::UNIFORM );
+            Vector3Array positions = mesh.vertices();
+            for ( size_t i = 0; i < positions.size(); ++i ) {
+                positions[i] += 0.1_ra * Vector3( Scalar( i % 3 ), Scalar( i % 5 ), 0_ra );
+            }
+            Vector3Array expected = mesh.normals();
+            topo.updatePositions( positions );
+            topo.updateWedgeNormals();
+            topo.updateTriangleMeshNormals( expected );
+            Vector3Array normals( positions.size() );
+            stencil.computeNormals( positions, normals );
+            requireEqual( normals, expected );
+        }
+    }
+}
+
+TEST_CASE( "Core/Geometry/TopologicalMesh/WedgeBookkeeping",
+           "[unittests][Core][Core/Geometry][TopologicalMesh]" ) {
+    using namespace Ra::Core;
+    using namespace Ra::Core::Geometry;
+
+    auto mesh = makeGeodesicSphere( 1_ra, 3 );
+
+    auto checkVertexWedges = []( const TopologicalMesh& topo ) {
+        for ( auto itr = topo.vertices_sbegin(); itr != topo.vertices_end(); ++itr ) {
+            auto wedges = topo.getVertexWedges( *itr );
+            REQUIRE( !wedges.empty() );
+            REQUIRE( std::is_sorted( wedges.begin(), wedges.end() ) );
+            REQUIRE( std::adjacent_find( wedges.begin(), wedges.end() ) == wedges.end() );
+        }
+    };
+
+    SECTION( "Split" ) {
+        TopologicalMesh topo { mesh };
+        std::vector<TopologicalMesh::EdgeHandle> edges( topo.edges_begin(), topo.edges_end() );
+        for ( const auto& eh : edges ) {
+            topo.splitEdge( eh, 0.5_ra );
+        }
+        REQUIRE( topo.checkIntegrity() );
+        checkVertexWedges( topo );
+
+        // split wedges are already shared, merge does not change them
+        auto countWedges = [&topo]() {
+            std::set<TopologicalMesh::WedgeIndex> wedgesIndices;
+            for ( auto itr = topo.halfedges_begin(); itr != topo.halfedges_end(); ++itr ) {
+                wedgesIndices.insert( topo.getWedgeIndex( *itr ) );
+            }
+            return wedgesIndices.size();
+        };
+        const auto nWedges = countWedges();
+        topo.mergeEqualWedges();
+        REQUIRE( topo.checkIntegrity() );
+        REQUIRE( nWedges == countWedges() );
+    }
+
+    SECTION( "Collapse and garbage collection" ) {
+        TopologicalMesh topo { mesh };
+        const auto nFaces = topo.n_faces();
+        int count         = 0;
+        for ( auto itr = topo.halfedges_begin(); itr != topo.halfedges_end(); ++itr ) {
+            if ( !topo.status( *itr ).deleted() && topo.is_collapse_ok( *itr ) &&
+                 ( ++count % 3 == 0 ) ) {
+                topo.collapseWedge( *itr );
+            }
+        }
+        REQUIRE( topo.checkIntegrity() );
+        topo.garbage_collection();
+        REQUIRE( topo.n_faces() < nFaces );
+        REQUIRE( topo.checkIntegrity() );
+        checkVertexWedges( topo );
+
+        // wedges created after compaction are found by add
+        TopologicalMesh::EdgeHandle eh = *topo.edges_begin();
+        topo.splitEdge( eh, 0.5_ra );
+        REQUIRE( topo.checkIntegrity() );
+    }
+}
+
+TEST_CASE( "Core/Geometry/TopologicalMesh/WedgeBookkeeping/Benchmark",
+           "[.][benchmark][Core][Core/Geometry][TopologicalMesh]" ) {
+    using namespace Ra::Core;
+    using namespace Ra::Core::Geometry;
+
+    auto mesh = makeGeodesicSphere( 1_ra, 6 );
+
+    BENCHMARK( "split all edges" ) {
+        TopologicalMesh topo { mesh };
+        std::vector<TopologicalMesh::EdgeHandle> edges( topo.edges_begin(), topo.edges_end() );
+        for ( const auto& eh : edges ) {
+            topo.splitEdge( eh, 0.5_ra );
+        }
+        return topo.n_vertices();
+    };
+
+    BENCHMARK( "collapse and garbage collection" ) {
+        TopologicalMesh topo { mesh };
+        int count = 0;
+        for ( auto itr = topo.halfedges_begin(); itr != topo.halfedges_end(); ++itr ) {
+            if ( !topo.status( *itr ).deleted() && topo.is_collapse_ok( *itr ) &&
+                 ( ++count % 3 == 0 ) ) {
+                topo.collapseWedge( *itr );
+            }
+        }
+        topo.garbage_collection();
+        return topo.n_vertices();
+    };
+
+    BENCHMARK( "merge equal wedges" ) {
+        TopologicalMesh topo { mesh };
+        topo.mergeEqualWedges();
+        topo.garbage_collection();
+        return topo.n_vertices();
+    };
+
+    TopologicalMesh topo { mesh };
+    BENCHMARK( "vertex wedges" ) {
+        size_t n = 0;
+        for ( auto itr = topo.vertices_begin(); itr != topo.vertices_end(); ++itr ) {
+            n += topo.getVertexWedges( *itr ).size();
+        }
+        return n;
+    };
+}
@@ -365,3 +365,46 @@ TEST_CASE( "Core/Container/VariableSet/Clear", "[unittests][Core][Container][Var
     REQUIRE( !params.existsVariableType<int>() );
     REQUIRE( !params.existsVariableType<std::string>() );
 }
+
+TEST_CASE( "Core/Container/VariableSet/Layout version",
+           "[unittests][Core][Container][VariableSet]" ) {
+    VariableSet params;
+    auto version = params.getLayoutVersion();
+    auto changed = [&params, &version]() {
+        auto v  = params.getLayoutVersion();
+        bool c  = v != version;
+        version = v;
+        return c;
+    };
+
+    params.insertVariable( "a", 1 );
+    REQUIRE( changed() );
+    params.insertVariable( "a", 2 );
+    REQUIRE( !changed() );
+    params.setVariable( "a", 3 );
+    REQUIRE( !changed() );
+    params.getVariable<int>( "a" ) = 4;
+    REQUIRE( !changed() );
+    params.setVariable( "b", 1 );
+    REQUIRE( changed() );
+
+    int x = 0, y = 1;
+    params.setVariable( "r", std::ref( x ) );
+    REQUIRE( changed() );
+    params.setVariable( "r", std::ref( y ) );
+    REQUIRE( changed() );
+
+    REQUIRE( !params.deleteVariable<int>( "c" ) );
+    REQUIRE( !changed() );
+    REQUIRE( params.deleteVariable<int>( "b" ) );
+    REQUIRE( changed() );
+
+    VariableSet other;
+    other.insertVariable( "s", std::string { "s" } );
+    params.mergeKeepVariables( other );
+    REQUIRE( changed() );
+    params = other;
+    REQUIRE( changed() );
+    params.clear();
+    REQUIRE( changed() );
+}
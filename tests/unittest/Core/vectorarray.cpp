@@ -1,4 +1,5 @@
 #include <Core/Containers/VectorArray.hpp>
+#include <Core/Containers/VectorArrayKernels.hpp>
 #include <Core/Types.hpp>
 
 #include <catch2/catch_test_macros.hpp>
@@ -104,3 +105,76 @@ TEST_CASE( "Core/Container/VectorArray", "[unittests][Core][Container][VectorArr
     // intPtrMap( 0 );
     // funMap( 0 );
 }
+
+TEST_CASE( "Core/Container/VectorArrayKernels", "[unittests][Core][Container][VectorArray]" ) {
+    // more than one block to exercise the parallel path
+    const size_t n = size_t( 2 * Kernels::BlockSize + 17 );
+    Vector3Array points( n );
+    for ( size_t i = 0; i < n; ++i ) {
+        points[i] = Vector3 { Scalar( i ), -Scalar( i ), Scalar( i % 7 ) };
+    }
+
+    SECTION( "reduce" ) {
+        const Vector3 minRef { 0_ra, -Scalar( n - 1 ), 0_ra };
+        const Vector3 maxRef { Scalar( n - 1 ), 0_ra, 6_ra };
+        REQUIRE( Kernels::minCoeffs( points ).isApprox( minRef ) );
+        REQUIRE( Kernels::maxCoeffs( points ).isApprox( maxRef ) );
+
+        Aabb ref;
+        for ( const auto& p : points )
+            ref.extend( p );
+        auto aabb = Kernels::computeAabb( points );
+        REQUIRE( aabb.min().isApprox( ref.min() ) );
+        REQUIRE( aabb.max().isApprox( ref.max() ) );
+        REQUIRE( Kernels::computeAabb( Vector3Array {} ).isEmpty() );
+    }
+
+    SECTION( "map" ) {
+        Transform t = Transform::Identity();
+        t.rotate( AngleAxis( 0.3_ra, Vector3 { 1_ra, 2_ra, 3_ra }.normalized() ) );
+        t.scale( Vector3 { 1_ra, 2_ra, 3_ra } );
+        t.pretranslate( Vector3 { 4_ra, 5_ra, 6_ra } );
+
+        Vector3Array transformed = points;
+        Kernels::applyTransform( transformed, t );
+        Vector3Array mapped;
+        Kernels::transform( points, mapped, [&t]( const Vector3& p ) -> Vector3 { return t * p; } );
+        REQUIRE( mapped.size() == n );
+        for ( size_t i = 0; i < n; ++i ) {
+            REQUIRE( transformed[i].isApprox( t * points[i] ) );
+            REQUIRE( mapped[i].isApprox( transformed[i] ) );
+        }
+
+        Vector3Array normals = points;
+        normals[0]           = Vector3::Zero();
+        Kernels::normalize( normals );
+        REQUIRE( normals[0] == Vector3::Zero() );
+        for ( size_t i = 1; i < n; ++i ) {
+            REQUIRE( normals[i].isApprox( points[i].normalized() ) );
+        }
+
+        normals                    = points;
+        const Matrix3 normalMatrix = t.linear().inverse().transpose();
+        Kernels::applyNormalTransform( normals, t );
+        for ( size_t i = 1; i < n; ++i ) {
+            REQUIRE( normals[i].isApprox( ( normalMatrix * points[i] ).normalized() ) );
+        }
+
+        Vector3Array half;
+        Kernels::lerp( points, transformed, 0.5_ra, half );
+        for ( size_t i = 0; i < n; ++i ) {
+            REQUIRE( half[i].isApprox( 0.5_ra * ( points[i] + transformed[i] ) ) );
+        }
+    }
+
+    SECTION( "attrib" ) {
+        Utils::Attrib<Vector3> attrib { "points" };
+        attrib.setData( points );
+        int notified = 0;
+        attrib.attach( [&notified]() { ++notified; } );
+        Kernels::applyTransform( attrib, Transform { Translation { 1_ra, 1_ra, 1_ra } } );
+        REQUIRE( notified == 1 );
+        REQUIRE( !attrib.isLocked() );
+        REQUIRE( attrib.data()[3].isApprox( points[3] + Vector3::Ones() ) );
+    }
+}
@@ -0,0 +1,157 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <Core/Animation/Skeleton.hpp>
+#include <Core/Math/Math.hpp>
+#include <Core/Utils/MemoryAccounting.hpp>
+#include <Engine/Data/ShaderConfigFactory.hpp>
+#include <Engine/RadiumEngine.hpp>
+#include <Engine/Scene/Entity.hpp>
+#include <Engine/Scene/EntityManager.hpp>
+#include <Engine/Scene/SkeletonComponent.hpp>
+
+using namespace Ra::Core;
+using namespace Ra::Engine;
+using SpaceType = Ra::Core::Animation::HandleArray::SpaceType;
+
+namespace {
+Transform translation( Scalar x ) {
+    Transform T = Transform::Identity();
+    T.translation() << x, 0_ra, 0_ra;
+    return T;
+}
+
+Scalar boneTranslation( Scene::SkeletonComponent* component ) {
+    return component->getSkeleton()->getPose( SpaceType::LOCAL )[1].translation().x();
+}
+} // namespace
+
+TEST_CASE( "Engine/Scene/SkeletonComponent/AnimationEdition",
+           "[unittests][Engine][Engine/Scene][SkeletonComponent]" ) {
+    auto engine = RadiumEngine::createInstance();
+    engine->initialize();
+    // the bone display only needs the configuration to exist, no OpenGL context is needed
+    if ( !Data::ShaderConfigurationFactory::getConfiguration( "BlinnPhong" ) ) {
+        Data::ShaderConfigurationFactory::addConfiguration(
+            Data::ShaderConfiguration( "BlinnPhong" ) );
+    }
+
+    auto entity    = engine->getEntityManager()->createEntity( "test entity" );
+    auto component = new Scene::SkeletonComponent( "test skeleton", entity );
+
+    // a root and a leaf bone, none of them being displayed
+    Animation::Skeleton skeleton;
+    const uint root = skeleton.addRoot( Transform::Identity(), "root" );
+    skeleton.addBone( root, translation( 0_ra ), SpaceType::LOCAL, "leaf" );
+    component->setSkeleton( skeleton );
+
+    auto& animation = component->addNewAnimation();
+    animation[1].insertKeyFrame( 1_ra, translation( 1_ra ) );
+    component->notifyAnimationChanged( 0 );
+
+    SECTION( "Paused edition" ) {
+        component->update( 1_ra );
+        REQUIRE( Math::areApproxEqual( boneTranslation( component ), 1_ra ) );
+
+        // same time, e.g. when the animation is paused
+        component->getAnimation( 0 )[1].insertKeyFrame( 1_ra, translation( 2_ra ) );
+        component->notifyAnimationChanged( 0 );
+        component->update( 1_ra );
+        REQUIRE( Math::areApproxEqual( boneTranslation( component ), 2_ra ) );
+    }
+
+    SECTION( "Baked poses edition" ) {
+        component->setPoseCache( 1024 * 1024, 0.5_ra );
+        REQUIRE( component->hasPoseCache() );
+        REQUIRE( component->needsBaking() );
+        component->bakePoses( 3 );
+        REQUIRE( !component->needsBaking() );
+        component->updateFromCache( 1_ra );
+        REQUIRE( Math::areApproxEqual( boneTranslation( component ), 1_ra ) );
+        component->updateFromCache( 0.5_ra );
+        REQUIRE( Math::areApproxEqual( boneTranslation( component ), 0.5_ra ) );
+
+        component->getAnimation( 0 )[1].insertKeyFrame( 1_ra, translation( 2_ra ) );
+        component->notifyAnimationChanged( 0 );
+        REQUIRE( component->needsBaking() );
+        component->bakePoses( 3 );
+        component->updateFromCache( 1_ra );
+        REQUIRE( Math::areApproxEqual( boneTranslation( component ), 2_ra ) );
+        component->updateFromCache( 0.5_ra );
+        REQUIRE( Math::areApproxEqual( boneTranslation( component ), 1_ra ) );
+    }
+
+    SECTION( "Playback" ) {
+        // other animations, e.g. blendshape weights, are wrapped into their own interval
+        component->autoRepeat( true );
+        component->update( 2.5_ra );
+        REQUIRE( Math::areApproxEqual( *component->getTimeOutput(), 0.5_ra ) );
+        const auto playback = component->getPlaybackOutput();
+        REQUIRE( Math::areApproxEqual( playback->m_time, 2.5_ra ) );
+        REQUIRE( Math::areApproxEqual( playback->wrap( 0_ra, 2_ra ), 0.5_ra ) );
+        REQUIRE( Math::areApproxEqual( playback->wrap( 0_ra, 4_ra ), 2.5_ra ) );
+
+        component->pingPong( true );
+        component->update( 3_ra );
+        REQUIRE( Math::areApproxEqual( playback->wrap( 0_ra, 2_ra ), 1_ra ) );
+    }
+
+    SECTION( "Compressed clip" ) {
+        std::vector<Animation::KeyFramedValue<Transform>> channels {
+            Animation::KeyFramedValue<Transform>( 0_ra, translation( 0_ra ) ) };
+        channels[0].insertKeyFrame( 1_ra, translation( 1_ra ) );
+        Asset::AnimationData data;
+        data.setHandleData( Animation::CompressedAnimation( channels, { "leaf" } ) );
+        component->handleAnimationLoading( { &data } );
+        REQUIRE( component->getAnimationTimeInterval() == std::make_pair( 0_ra, 1_ra ) );
+
+        // played from the clip, within the compression tolerance
+        component->update( 0.5_ra );
+        REQUIRE( std::abs( boneTranslation( component ) - 0.5_ra ) < 1e-2_ra );
+
+        // converted to keyframes for edition
+        const auto& animation = component->getAnimation( 0 );
+        REQUIRE( animation.size() == 2 );
+        REQUIRE( animation[1].size() >= 2 );
+        component->getAnimation( 0 )[1].insertKeyFrame( 1_ra, translation( 2_ra ) );
+        component->notifyAnimationChanged( 0 );
+        component->update( 1_ra );
+        REQUIRE( Math::areApproxEqual( boneTranslation( component ), 2_ra ) );
+    }
+
+    SECTION( "Loaded clip" ) {
+        // keyframes compressed as by the asset loaders, then played and materialized
+        Asset::HandleAnimation handle( "leaf" );
+        handle.m_anim = Animation::KeyFramedValue<Transform>( 0_ra, translation( 0_ra ) );
+        handle.m_anim.insertKeyFrame( 1_ra, translation( 1_ra ) );
+        handle.m_anim.insertKeyFrame( 2_ra, translation( 4_ra ) );
+        handle.m_animationTime = Asset::AnimationTime( 0_ra, 2_ra );
+        Asset::AnimationData data;
+        data.setHandleData( { handle } );
+        data.setHandleData( data.compress() );
+        REQUIRE( data.getClip() != nullptr );
+        component->handleAnimationLoading( { &data } );
+
+        for ( const auto& [t, x] : { std::make_pair( 0.5_ra, 0.5_ra ),
+                                     std::make_pair( 1_ra, 1_ra ),
+                                     std::make_pair( 1.5_ra, 2.5_ra ) } ) {
+            component->update( t );
+            REQUIRE( std::abs( boneTranslation( component ) - x ) < 1e-2_ra );
+        }
+
+        // the keyframes are only created, and accounted, when requested
+        const auto& constComponent = *component;
+        REQUIRE( constComponent.getAnimation( 0 ).empty() );
+        Utils::MemoryUsage before;
+        component->addMemoryUsage( before );
+        const auto animation = component->getAnimationOutput();
+        REQUIRE( animation->size() == 2 );
+        REQUIRE( ( *animation )[1].size() >= 2 );
+        Utils::MemoryUsage after;
+        component->addMemoryUsage( after );
+        REQUIRE( after[Utils::MemoryCategory::Animation] >
+                 before[Utils::MemoryCategory::Animation] );
+    }
+
+    engine->cleanup();
+    RadiumEngine::destroyInstance();
+}